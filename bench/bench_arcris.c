@@ -0,0 +1,498 @@
+/*
+ * bench_arcris.c - Microbenchmarks de las funciones más usadas del instalador
+ *
+ * Casos:
+ *   vars_upsert/N, vars_update/N   variables.sh de N líneas (100, 1000, 10000)
+ *   vars_update_tx/N               guardado de 10 variables en una transacción
+ *   i18n_lookup/<idioma>           búsqueda de textos reales en los seis idiomas
+ *   partition_load                 array PARTITIONS con partition_manager_load_from_variables
+ *   mirrorlist_process/_escape     mirrorlist completa (todos los servidores comentados)
+ *   find_gpu                       modelos de extra/hardware_video.c
+ *
+ * Cada caso repite la operación hasta llenar BENCH_ROUND_USEC y se queda con
+ * la mejor de BENCH_ROUNDS rondas (ns por operación). Los resultados se
+ * escriben en --output; con --baseline se comparan con los de una ejecución
+ * anterior y el programa falla si algún caso es más de --tolerance por ciento
+ * más lento. --update-baseline guarda los resultados como nueva línea base.
+ *
+ * Trabaja en un directorio temporal: variables_utils y partition_manager
+ * usan la ruta relativa ./data/bash/variables.sh.
+ *
+ * Uso:
+ *   meson test -C builddir --benchmark -v
+ *   bench-arcris --baseline bench/baseline.json [--update-baseline]
+ *
+ * Códigos de salida: 0 correcto, 1 regresión, 2 argumentos o E/S.
+ */
+
+#include "variables_utils.h"
+#include "i18n.h"
+#include "mirrorlist_utils.h"
+#include "partition_manager.h"
+#include "hardware_video_bench.h"
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#define BENCH_ROUNDS     5
+#define BENCH_ROUND_USEC (G_USEC_PER_SEC / 5)
+
+typedef void (*BenchFunc)(gpointer user_data);
+
+typedef struct {
+    gchar *name;
+    gdouble ns_per_op;
+    guint64 iterations;
+} BenchResult;
+
+static GPtrArray *results;
+static const gchar *filter;
+
+/* Mejor de BENCH_ROUNDS rondas. La primera ronda calibra cuántas
+ * iteraciones caben en BENCH_ROUND_USEC. */
+static void bench_run(const gchar *name, BenchFunc func, gpointer user_data)
+{
+    if (filter && !strstr(name, filter))
+        return;
+
+    guint64 iterations = 1;
+    gdouble best = G_MAXDOUBLE;
+
+    for (;;) {
+        gint64 start = g_get_monotonic_time();
+        for (guint64 i = 0; i < iterations; i++)
+            func(user_data);
+        gint64 elapsed = g_get_monotonic_time() - start;
+        if (elapsed >= BENCH_ROUND_USEC / 10 || iterations >= (guint64)1 << 30) {
+            iterations = MAX(1, iterations * BENCH_ROUND_USEC / MAX(elapsed, 1));
+            break;
+        }
+        iterations *= 10;
+    }
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        gint64 start = g_get_monotonic_time();
+        for (guint64 i = 0; i < iterations; i++)
+            func(user_data);
+        gint64 elapsed = g_get_monotonic_time() - start;
+        best = MIN(best, elapsed * 1000.0 / iterations);
+    }
+
+    BenchResult *result = g_new0(BenchResult, 1);
+    result->name = g_strdup(name);
+    result->ns_per_op = best;
+    result->iterations = iterations;
+    g_ptr_array_add(results, result);
+
+    g_print("%-28s %14.1f ns/op  (%" G_GUINT64_FORMAT " iteraciones)\n", name, best, iterations);
+}
+
+static void bench_result_free(gpointer data)
+{
+    BenchResult *result = data;
+    g_free(result->name);
+    g_free(result);
+}
+
+/* ---------------------------------------------------------------------------
+ * Datos de prueba
+ * ------------------------------------------------------------------------- */
+
+/* variables.sh parecido al que genera la interfaz, con lines líneas */
+static gchar *make_variables(guint lines)
+{
+    GString *content = g_string_new("#!/bin/bash\n# Variables de configuración generadas por Arcris\n\n");
+    guint written = 3;
+
+    g_string_append(content, "SELECTED_DISK=\"/dev/nvme0n1\"\nPARTITION_MODE=\"manual\"\n"
+                             "PARTITIONS=(\n"
+                             "    \"/dev/nvme0n1p1 fat32 /boot/efi\"\n"
+                             "    \"/dev/nvme0n1p2 linux-swap swap\"\n"
+                             "    \"/dev/nvme0n1p3 btrfs /\"\n"
+                             "    \"/dev/nvme0n1p4 ext4 /home\"\n"
+                             "    \"/dev/sda1 xfs /srv\"\n"
+                             "    \"/dev/sda2 ext4 /var\"\n"
+                             ")\n"
+                             "INSTALLATION_TYPE=\"DESKTOP\"\nSELECTED_KERNEL=\"linux\"\n");
+    written += 13;
+
+    for (guint i = 0; written < lines; i++) {
+        if (i % 10 == 0) {
+            g_string_append_printf(content, "# Bloque %u\n", i / 10);
+            written++;
+        }
+        g_string_append_printf(content, "BENCH_VAR_%05u=\"valor %u\"\n", i, i);
+        written++;
+    }
+    return g_string_free(content, FALSE);
+}
+
+static gboolean write_variables(const gchar *content)
+{
+    GError *error = NULL;
+    if (!g_file_set_contents(VARIABLES_FILE_PATH, content, -1, &error)) {
+        g_printerr("bench-arcris: %s\n", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Mirrorlist completa de Arch: servidores comentados agrupados por país */
+static gchar *make_mirrorlist(void)
+{
+    static const gchar *countries[] = {
+        "Worldwide", "Argentina", "Brazil", "Chile", "France", "Germany",
+        "Mexico", "Portugal", "Russia", "Spain", "Sweden", "United States"
+    };
+    GString *list = g_string_new("##\n## Arch Linux repository mirrorlist\n"
+                                 "## Generated on 2026-10-01\n##\n\n");
+
+    for (guint c = 0; c < G_N_ELEMENTS(countries); c++) {
+        g_string_append_printf(list, "## %s\n", countries[c]);
+        for (guint i = 0; i < 100; i++)
+            g_string_append_printf(list, "#Server = https://mirror%u.%s.example.org/archlinux/$repo/os/$arch\n",
+                                   i, countries[c]);
+    }
+    return g_string_free(list, FALSE);
+}
+
+/* ---------------------------------------------------------------------------
+ * Casos
+ * ------------------------------------------------------------------------- */
+
+#define VARS_BENCH_NAMES 10
+
+typedef struct {
+    GString *content;
+    gchar *names[VARS_BENCH_NAMES];
+    guint current;
+    guint toggle;
+} VarsBench;
+
+static void bench_vars_upsert(gpointer user_data)
+{
+    VarsBench *bench = user_data;
+    vars_upsert(bench->content, bench->names[0], "valor nuevo");
+}
+
+static void apply_toggle(GString *content, gpointer user_data)
+{
+    VarsBench *bench = user_data;
+    vars_upsert(content, bench->names[bench->current], bench->toggle % 2 ? "uno" : "dos");
+}
+
+/* Cada llamada cambia el valor: siempre hay escritura */
+static void bench_vars_update(gpointer user_data)
+{
+    VarsBench *bench = user_data;
+    bench->toggle++;
+    bench->current = 0;
+    vars_update(apply_toggle, bench);
+}
+
+/* Un guardado de ventana: diez variables y una sola escritura */
+static void bench_vars_update_tx(gpointer user_data)
+{
+    VarsBench *bench = user_data;
+    bench->toggle++;
+    vars_begin();
+    for (bench->current = 0; bench->current < VARS_BENCH_NAMES; bench->current++)
+        vars_update(apply_toggle, bench);
+    vars_commit();
+}
+
+static void bench_variables(guint lines)
+{
+    gchar *content = make_variables(lines);
+    VarsBench bench = { g_string_new(content), { NULL }, 0, 0 };
+    gchar *name;
+
+    // Variables repartidas por el archivo (del 20 % al 65 %)
+    for (guint i = 0; i < VARS_BENCH_NAMES; i++)
+        bench.names[i] = g_strdup_printf("BENCH_VAR_%05u", lines * (4 + i) / 20);
+
+    name = g_strdup_printf("vars_upsert/%u", lines);
+    bench_run(name, bench_vars_upsert, &bench);
+    g_free(name);
+
+    if (write_variables(content)) {
+        name = g_strdup_printf("vars_update/%u", lines);
+        bench_run(name, bench_vars_update, &bench);
+        g_free(name);
+
+        name = g_strdup_printf("vars_update_tx/%u", lines);
+        bench_run(name, bench_vars_update_tx, &bench);
+        g_free(name);
+    }
+
+    g_string_free(bench.content, TRUE);
+    for (guint i = 0; i < VARS_BENCH_NAMES; i++)
+        g_free(bench.names[i]);
+    g_free(content);
+}
+
+/* Textos de i18n.c: principio, mitad y final de la tabla, y uno sin traducción */
+static const gchar *i18n_keys[] = {
+    "Salir", "Guardar", "Cancelar", "Borrado completo", "Repositorios",
+    "Mirrorlist inválida", "Apagar", "Reiniciar", "Texto sin traducción"
+};
+
+static void bench_i18n(gpointer user_data)
+{
+    (void)user_data;
+    for (guint i = 0; i < G_N_ELEMENTS(i18n_keys); i++)
+        i18n_lookup(i18n_keys[i]);
+}
+
+static void bench_partition_load(gpointer user_data)
+{
+    partition_manager_load_from_variables(user_data);
+}
+
+static void bench_mirrorlist_process(gpointer user_data)
+{
+    g_free(mirrorlist_process(user_data));
+}
+
+static void bench_mirrorlist_escape(gpointer user_data)
+{
+    g_free(mirrorlist_escape_for_bash(user_data));
+}
+
+static const gchar *gpu_inputs[] = {
+    "nvidia geforce rtx 4070 ti", "rtx 5090", "gtx 1060", "geforce gt 710",
+    "4090", "quadro desconocida"
+};
+
+static void bench_find_gpu(gpointer user_data)
+{
+    (void)user_data;
+    for (guint i = 0; i < G_N_ELEMENTS(gpu_inputs); i++)
+        hardware_video_find_gpu(gpu_inputs[i]);
+}
+
+/* ---------------------------------------------------------------------------
+ * Resultados y línea base
+ * ------------------------------------------------------------------------- */
+
+/* Una línea por caso, para que load_baseline no necesite un parser JSON */
+static gboolean write_results(const gchar *path)
+{
+    GString *json = g_string_new("{\n  \"version\": 1,\n  \"benchmarks\": {\n");
+
+    for (guint i = 0; i < results->len; i++) {
+        BenchResult *result = g_ptr_array_index(results, i);
+        g_string_append_printf(json, "    \"%s\": { \"ns_per_op\": %.1f, \"iterations\": %" G_GUINT64_FORMAT " }%s\n",
+                               result->name, result->ns_per_op, result->iterations,
+                               i + 1 < results->len ? "," : "");
+    }
+    g_string_append(json, "  }\n}\n");
+
+    GError *error = NULL;
+    gboolean ok = g_file_set_contents(path, json->str, json->len, &error);
+    if (!ok) {
+        g_printerr("bench-arcris: %s\n", error->message);
+        g_error_free(error);
+    }
+    g_string_free(json, TRUE);
+    return ok;
+}
+
+/* nombre → ns por operación, o NULL si no hay línea base */
+static GHashTable *load_baseline(const gchar *path)
+{
+    gchar *content = NULL;
+    if (!g_file_get_contents(path, &content, NULL, NULL))
+        return NULL;
+
+    GHashTable *baseline = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    GRegex *regex = g_regex_new("\"([^\"]+)\": \\{ \"ns_per_op\": ([0-9.]+)", 0, 0, NULL);
+    GMatchInfo *match = NULL;
+
+    g_regex_match(regex, content, 0, &match);
+    while (g_match_info_matches(match)) {
+        gchar *value = g_match_info_fetch(match, 2);
+        gdouble *ns = g_new(gdouble, 1);
+        *ns = g_ascii_strtod(value, NULL);
+        g_hash_table_insert(baseline, g_match_info_fetch(match, 1), ns);
+        g_free(value);
+        g_match_info_next(match, NULL);
+    }
+
+    g_match_info_free(match);
+    g_regex_unref(regex);
+    g_free(content);
+    return baseline;
+}
+
+/* Número de casos más lentos que la línea base más la tolerancia */
+static guint compare_baseline(GHashTable *baseline, gdouble tolerance)
+{
+    guint regressions = 0;
+
+    g_print("\n%-28s %14s %14s %9s\n", "caso", "ns/op", "línea base", "cambio");
+    for (guint i = 0; i < results->len; i++) {
+        BenchResult *result = g_ptr_array_index(results, i);
+        gdouble *base = g_hash_table_lookup(baseline, result->name);
+
+        if (!base || *base <= 0) {
+            g_print("%-28s %14.1f %14s %9s\n", result->name, result->ns_per_op, "-", "nuevo");
+            continue;
+        }
+
+        gdouble change = (result->ns_per_op / *base - 1.0) * 100.0;
+        gboolean regression = change > tolerance;
+        g_print("%-28s %14.1f %14.1f %+8.1f%%%s\n", result->name, result->ns_per_op, *base,
+                change, regression ? "  REGRESIÓN" : "");
+        if (regression)
+            regressions++;
+    }
+    return regressions;
+}
+
+/* Los LOG_INFO de partition_manager por cada iteración taparían los resultados */
+static GLogWriterOutput bench_log_writer(GLogLevelFlags level, const GLogField *fields,
+                                         gsize n_fields, gpointer user_data)
+{
+    if (level & (G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING))
+        return g_log_writer_default(level, fields, n_fields, user_data);
+    return G_LOG_WRITER_HANDLED;
+}
+
+int main(int argc, char *argv[])
+{
+    gchar *baseline_path = NULL;
+    gchar *output_path = NULL;
+    gboolean update_baseline = FALSE;
+    gdouble tolerance = 25.0;
+    gchar *filter_arg = NULL;
+
+    GOptionEntry entries[] = {
+        { "baseline", 'b', 0, G_OPTION_ARG_FILENAME, &baseline_path, "Línea base JSON con la que comparar", "ARCHIVO" },
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output_path, "Dónde escribir los resultados JSON", "ARCHIVO" },
+        { "update-baseline", 'u', 0, G_OPTION_ARG_NONE, &update_baseline, "Guardar los resultados como línea base", NULL },
+        { "tolerance", 't', 0, G_OPTION_ARG_DOUBLE, &tolerance, "Porcentaje más lento admitido (25)", "PCT" },
+        { "filter", 'f', 0, G_OPTION_ARG_STRING, &filter_arg, "Solo los casos cuyo nombre contiene TEXTO", "TEXTO" },
+        { NULL }
+    };
+
+    GError *error = NULL;
+    GOptionContext *context = g_option_context_new("- microbenchmarks de Arcris");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("bench-arcris: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return 2;
+    }
+    g_option_context_free(context);
+
+    if (update_baseline && !baseline_path) {
+        g_printerr("bench-arcris: --update-baseline necesita --baseline\n");
+        return 2;
+    }
+
+    // Rutas absolutas antes de cambiar al directorio temporal
+    if (baseline_path) {
+        gchar *absolute = g_canonicalize_filename(baseline_path, NULL);
+        g_free(baseline_path);
+        baseline_path = absolute;
+    }
+    if (output_path) {
+        gchar *absolute = g_canonicalize_filename(output_path, NULL);
+        g_free(output_path);
+        output_path = absolute;
+    }
+    filter = filter_arg;
+
+    gchar *workdir = g_dir_make_tmp("arcris-bench-XXXXXX", &error);
+    if (!workdir) {
+        g_printerr("bench-arcris: %s\n", error->message);
+        g_error_free(error);
+        return 2;
+    }
+    gchar *bash_dir = g_build_filename(workdir, "data", "bash", NULL);
+    if (g_mkdir_with_parents(bash_dir, 0755) != 0 || g_chdir(workdir) != 0) {
+        g_printerr("bench-arcris: no se pudo preparar %s\n", workdir);
+        return 2;
+    }
+
+    g_log_set_writer_func(bench_log_writer, NULL, NULL);
+    results = g_ptr_array_new_with_free_func(bench_result_free);
+
+    bench_variables(100);
+    bench_variables(1000);
+    bench_variables(10000);
+
+    static const struct { AppLang lang; const gchar *name; } langs[] = {
+        { LANG_ES, "es" }, { LANG_EN, "en" }, { LANG_RU, "ru" },
+        { LANG_PT, "pt" }, { LANG_FR, "fr" }, { LANG_DE, "de" }
+    };
+    for (guint i = 0; i < G_N_ELEMENTS(langs); i++) {
+        gchar *name = g_strdup_printf("i18n_lookup/%s", langs[i].name);
+        i18n_set_lang(langs[i].lang);
+        bench_run(name, bench_i18n, NULL);
+        g_free(name);
+    }
+    i18n_set_lang(LANG_ES);
+
+    gchar *variables = make_variables(1000);
+    if (write_variables(variables)) {
+        PartitionManager *manager = partition_manager_new();
+        bench_run("partition_load", bench_partition_load, manager);
+        partition_manager_free(manager);
+    }
+    g_free(variables);
+
+    gchar *mirrorlist = make_mirrorlist();
+    bench_run("mirrorlist_process", bench_mirrorlist_process, mirrorlist);
+    gchar *processed = mirrorlist_process(mirrorlist);
+    bench_run("mirrorlist_escape", bench_mirrorlist_escape, processed);
+    g_free(processed);
+    g_free(mirrorlist);
+
+    bench_run("find_gpu", bench_find_gpu, NULL);
+
+    // Limpieza del directorio temporal
+    g_unlink(VARIABLES_FILE_PATH);
+    g_rmdir(bash_dir);
+    gchar *data_dir = g_path_get_dirname(bash_dir);
+    g_rmdir(data_dir);
+    g_free(data_dir);
+    g_chdir("/");
+    g_rmdir(workdir);
+    g_free(bash_dir);
+    g_free(workdir);
+
+    int status = 0;
+    if (output_path && !write_results(output_path))
+        status = 2;
+
+    if (baseline_path && update_baseline) {
+        if (write_results(baseline_path))
+            g_print("\nLínea base guardada en %s\n", baseline_path);
+        else
+            status = 2;
+    } else if (baseline_path) {
+        GHashTable *baseline = load_baseline(baseline_path);
+        if (!baseline) {
+            g_print("\nSin línea base en %s; se crea con --update-baseline\n", baseline_path);
+        } else {
+            guint regressions = compare_baseline(baseline, tolerance);
+            if (regressions > 0) {
+                g_print("\n%u casos más de un %.0f%% más lentos que la línea base\n", regressions, tolerance);
+                if (status == 0)
+                    status = 1;
+            }
+            g_hash_table_destroy(baseline);
+        }
+    }
+
+    g_ptr_array_free(results, TRUE);
+    g_free(baseline_path);
+    g_free(output_path);
+    g_free(filter_arg);
+    return status;
+}
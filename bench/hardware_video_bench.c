@@ -0,0 +1,17 @@
+/* extra/hardware_video.c es un programa independiente: se incluye sin su
+ * main() para medir la búsqueda en la tabla de GPUs */
+#define HARDWARE_VIDEO_NO_MAIN
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include "hardware_video.c"
+
+#include "hardware_video_bench.h"
+
+const char *hardware_video_find_gpu(const char *model)
+{
+    char lower[128];
+    str_lower(model, lower, sizeof(lower));
+
+    const Gpu *gpu = find_gpu(lower);
+    return gpu ? gpu->name : NULL;
+}
@@ -0,0 +1,8 @@
+#ifndef HARDWARE_VIDEO_BENCH_H
+#define HARDWARE_VIDEO_BENCH_H
+
+/* find_gpu de extra/hardware_video.c con el modelo tal como lo escribe el
+ * usuario. Devuelve el nombre del registro encontrado o NULL. */
+const char *hardware_video_find_gpu(const char *model);
+
+#endif /* HARDWARE_VIDEO_BENCH_H */
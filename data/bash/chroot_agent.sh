@@ -0,0 +1,119 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Agente persistente dentro del chroot
+#
+# En lugar de lanzar chroot + bash nuevo para cada comando, setup_chroot_mounts
+# arranca un único bash dentro de /mnt como coproceso. Los scripts le envían
+# comandos separados por NUL y el agente ejecuta cada uno en un subshell (sin
+# estado compartido entre comandos, igual que bash -c) y responde una línea
+# "estado milisegundos". La salida de los comandos va directamente a la
+# terminal de la instalación.
+#
+#   chroot_run "cmd"         → un comando; devuelve su estado
+#   chroot_batch "c1" "c2"…  → envía todos y luego lee las respuestas; devuelve
+#                              el número de comandos que fallaron
+#   chroot_enable u1 u2…     → systemctl enable de varias unidades en un lote
+#
+# Cada comando queda en el diario de tiempos como "command". Sin agente (antes
+# de los montajes o dentro de un subshell, donde el coproceso no es accesible)
+# se usa chroot /mnt /bin/bash -c como siempre.
+# -----------------------------------------------------------------------------------
+
+CHROOT_AGENT_COMMANDS=0
+CHROOT_AGENT_MS=0
+
+# Bucle del agente; las variables del bucle llevan prefijo para no pisar las
+# que usen los comandos
+CHROOT_AGENT_LOOP='
+while IFS= read -r -d "" __agent_cmd; do
+    __agent_start=${EPOCHREALTIME/[.,]/}
+    ( eval "$__agent_cmd" ) < /dev/null >&"$CHROOT_AGENT_OUT_FD" 2>&"$CHROOT_AGENT_ERR_FD"
+    __agent_rc=$?
+    __agent_end=${EPOCHREALTIME/[.,]/}
+    printf "%s %s\n" "$__agent_rc" "$(( (__agent_end - __agent_start) / 1000 ))"
+done'
+
+_chroot_agent_running() {
+    [ -n "${CHROOT_AGENT[1]:-}" ] && [ "${BASH_SUBSHELL:-0}" -eq 0 ]
+}
+
+chroot_agent_start() {
+    _chroot_agent_running && return 0
+    [ -x /mnt/bin/bash ] || return 1
+
+    # Descriptores de la terminal actual para la salida de los comandos
+    exec {CHROOT_AGENT_OUT_FD}>&1 {CHROOT_AGENT_ERR_FD}>&2
+    export CHROOT_AGENT_OUT_FD CHROOT_AGENT_ERR_FD
+    coproc CHROOT_AGENT { exec chroot /mnt /bin/bash --noprofile --norc -c "$CHROOT_AGENT_LOOP"; }
+    echo -e "${GREEN}✓ Agente chroot iniciado (PID ${CHROOT_AGENT_PID})${NC}"
+}
+
+chroot_agent_stop() {
+    _chroot_agent_running || return 0
+
+    local pid=$CHROOT_AGENT_PID in_fd=${CHROOT_AGENT[1]}
+    exec {in_fd}>&-
+    wait "$pid" 2>/dev/null
+    exec {CHROOT_AGENT_OUT_FD}>&- {CHROOT_AGENT_ERR_FD}>&-
+    echo -e "${CYAN}  • Agente chroot: ${CHROOT_AGENT_COMMANDS} comandos en $(( CHROOT_AGENT_MS / 1000 )) s${NC}"
+}
+
+# Respuesta del agente para el comando $1; deja el estado en CHROOT_AGENT_RC
+_chroot_agent_result() {
+    local ms
+    if ! read -r CHROOT_AGENT_RC ms <&"${CHROOT_AGENT[0]}"; then
+        echo -e "${RED}ERROR: el agente chroot terminó inesperadamente${NC}"
+        CHROOT_AGENT_RC=1
+        return 1
+    fi
+    # Una línea por comando en el diario TSV
+    local name=${1//[$'\n\t']/ }
+    timing_now
+    timing_record command "${name:0:160}" $(( TIMING_NOW - ms )) "$ms" 0 0 0 \
+        "$([ "$CHROOT_AGENT_RC" -eq 0 ] && echo ok || echo failed)"
+    CHROOT_AGENT_COMMANDS=$(( CHROOT_AGENT_COMMANDS + 1 ))
+    CHROOT_AGENT_MS=$(( CHROOT_AGENT_MS + ms ))
+}
+
+chroot_run() {
+    if ! _chroot_agent_running; then
+        chroot /mnt /bin/bash -c "$1"
+        return
+    fi
+    printf '%s\0' "$1" >&"${CHROOT_AGENT[1]}"
+    _chroot_agent_result "$1"
+    return "$CHROOT_AGENT_RC"
+}
+
+chroot_batch() {
+    local cmd failed=0
+
+    if ! _chroot_agent_running; then
+        for cmd in "$@"; do
+            chroot /mnt /bin/bash -c "$cmd" || failed=$(( failed + 1 ))
+        done
+        return $(( failed > 255 ? 255 : failed ))
+    fi
+
+    # Todos los comandos primero: el agente encadena uno tras otro sin esperar
+    # a que se lea cada respuesta
+    for cmd in "$@"; do
+        printf '%s\0' "$cmd" >&"${CHROOT_AGENT[1]}"
+    done
+    for cmd in "$@"; do
+        _chroot_agent_result "$cmd" || return 1
+        if [ "$CHROOT_AGENT_RC" -ne 0 ]; then
+            echo -e "${YELLOW}  ⚠ Falló ($CHROOT_AGENT_RC): $cmd${NC}"
+            failed=$(( failed + 1 ))
+        fi
+    done
+    return $(( failed > 255 ? 255 : failed ))
+}
+
+chroot_enable() {
+    local unit commands=()
+    for unit in "$@"; do
+        commands+=("systemctl enable $unit")
+    done
+    chroot_batch "${commands[@]}"
+}
@@ -83,7 +83,7 @@ update_system_chroot() {
         wait_for_internet
 
         # Ejecutar actualización del sistema
-        if chroot /mnt /bin/bash -c "pacman -Syu --noconfirm"; then
+        if chroot_run "pacman -Syu --noconfirm"; then
             echo -e "${GREEN}✅ Sistema actualizado correctamente${NC}"
             return 0
         else
@@ -124,7 +124,13 @@ update_repositories() {
 
 }
 
-# Función para instalar paquete con pacstrap con bucle infinito
+# Caché de pacstrap -c (la del LiveCD). package_fetch host adelanta ahí los
+# paquetes y el diario de tiempos mide cuánto crece.
+PACSTRAP_CACHE_DIR="/var/cache/pacman/pkg"
+
+# Función para instalar paquete con pacstrap con bucle infinito.
+# pacstrap -c descarga en la caché del LiveCD en lugar de la de /mnt: las
+# instancias del modo multi-disco comparten así cada paquete descargado.
 install_pacstrap_with_retry() {
     local package="$1"
     local attempt=1
@@ -135,6 +141,7 @@ install_pacstrap_with_retry() {
     fi
 
     echo -e "${GREEN}📦 Instalando: ${YELLOW}$package${GREEN} con pacstrap${NC}"
+    timing_package_begin "$PACSTRAP_CACHE_DIR"
 
     while true; do
         echo -e "${CYAN}🔄 Intento #$attempt para instalar: $package${NC}"
@@ -142,13 +149,17 @@ install_pacstrap_with_retry() {
         # Verificar conectividad antes del intento
         wait_for_internet
 
+        # Primer intento: los paquetes se adelantan repartidos entre espejos
+        [ $attempt -eq 1 ] && package_fetch host $package
+
         # Ejecutar instalación con pacstrap
-        if pacstrap /mnt "$package"; then
+        if pacstrap -c /mnt "$package"; then
             echo -e "${GREEN}✅ $package instalado correctamente con pacstrap${NC}"
+            timing_package_end pacstrap "$package" "$attempt" ok
             return 0
         else
             echo -e "${YELLOW}⚠️  Falló la instalación de $package (intento #$attempt)${NC}"
-            echo -e "${RED}🔍 Comando ejecutado: pacstrap /mnt \"$package\"${NC}"
+            echo -e "${RED}🔍 Comando ejecutado: pacstrap -c /mnt \"$package\"${NC}"
             echo -e "${CYAN}🔄 Reintentando en 5 segundos...${NC}"
             sleep 5
             ((attempt++))
@@ -170,6 +181,7 @@ install_pacman_chroot_with_retry() {
     fi
 
     echo -e "${GREEN}📦 Instalando: ${YELLOW}$package${GREEN} con pacman en chroot${NC}"
+    timing_package_begin /mnt/var/cache/pacman/pkg
 
     while [[ $attempt -le 30 ]]; do
         echo -e "${CYAN}🔄 Intento #$attempt para instalar: $package${NC}"
@@ -177,9 +189,12 @@ install_pacman_chroot_with_retry() {
         # Verificar conectividad antes del intento
         wait_for_internet
 
+        [ $attempt -eq 1 ] && package_fetch chroot $package
+
         # Ejecutar instalación con pacman en chroot
-        if chroot /mnt /bin/bash -c "pacman -S $package $extra_args --noconfirm"; then
+        if chroot_run "pacman -S $package $extra_args --noconfirm"; then
             echo -e "${GREEN}✅ $package instalado correctamente con pacman en chroot${NC}"
+            timing_package_end pacman "$package" "$attempt" ok
             return 0
         else
             echo -e "${YELLOW}⚠️  Falló la instalación de $package (intento #$attempt)${NC}"
@@ -192,6 +207,7 @@ install_pacman_chroot_with_retry() {
 
     # Si llegamos aquí, significa que se agotaron los 30 intentos
     echo -e "${RED}❌ Error: Se agotaron los 30 intentos para instalar $package con pacman en chroot${NC}"
+    timing_package_end pacman "$package" $(( attempt - 1 )) failed
     return 1
 
 
@@ -211,6 +227,7 @@ install_yay_chroot_with_retry() {
     fi
 
     echo -e "${GREEN}📦 Instalando: ${YELLOW}$package${GREEN} con yay en chroot${NC}"
+    timing_package_begin "/mnt/home/$user/.cache/yay"
 
     while [ $attempt -le 30 ]; do
         echo -e "${CYAN}🔄 Intento #$attempt para instalar: $package${NC}"
@@ -219,8 +236,9 @@ install_yay_chroot_with_retry() {
         wait_for_internet
 
         # Ejecutar instalación con yay en chroot
-        if chroot /mnt /bin/bash -c "sudo -u $user yay -S $package $extra_args --noansweredit --noconfirm --needed"; then
+        if chroot_run "sudo -u $user yay -S $package $extra_args --noansweredit --noconfirm --needed"; then
             echo -e "${GREEN}✅ $package instalado correctamente con yay en chroot${NC}"
+            timing_package_end yay "$package" "$attempt" ok
             return 0
         else
             echo -e "${YELLOW}⚠️  Falló la instalación de $package (intento #$attempt)${NC}"
@@ -234,6 +252,7 @@ install_yay_chroot_with_retry() {
     # Si superó los 30 intentos
     if [ $attempt -gt 30 ]; then
         echo -e "${RED}❌ ERROR: No se pudo instalar $package con yay en chroot después de 30 intentos${NC}"
+        timing_package_end yay "$package" $(( attempt - 1 )) failed
         return 1
     fi
 }
@@ -249,6 +268,7 @@ install_aur_with_retry() {
     fi
 
     echo -e "${GREEN}📦 Instalando paquete AUR: ${YELLOW}$package${GREEN} desde AUR${NC}"
+    timing_package_begin "/mnt/tmp/$package"
 
     while true; do
         echo -e "${CYAN}🔄 Intento #$attempt para instalar: $package${NC}"
@@ -259,6 +279,7 @@ install_aur_with_retry() {
         # Ejecutar instalación desde AUR
         if chroot /mnt bash -c "cd /tmp && git clone https://aur.archlinux.org/$package.git && cd $package && chown -R $USER:$USER . && su $USER -c 'makepkg -si --noconfirm'"; then
             echo -e "${GREEN}✅ $package instalado correctamente desde AUR${NC}"
+            timing_package_end aur "$package" "$attempt" ok
             sleep 2
             return 0
         else
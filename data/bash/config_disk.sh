@@ -12,64 +12,226 @@ FIRMWARE_TYPE=$(detect_firmware)
 echo -e "${GREEN}| Firmware detectado: $FIRMWARE_TYPE |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
-sleep 2
-clear
+
+# Perfil de almacenamiento: Arcris escribe STORAGE_* en variables.sh según
+# /sys/block/<disco>/queue (NVMe, SSD o disco mecánico). Si no está, se usan
+# opciones genéricas válidas para cualquier dispositivo.
+# Las opciones de mkfs se expanden sin comillas a propósito (varias palabras).
+STORAGE_MKFS_EXT4="${STORAGE_MKFS_EXT4-}"
+STORAGE_MKFS_BTRFS="${STORAGE_MKFS_BTRFS-}"
+STORAGE_MKFS_XFS="${STORAGE_MKFS_XFS-}"
+STORAGE_MOUNT_EXT4="${STORAGE_MOUNT_EXT4:-noatime}"
+STORAGE_MOUNT_BTRFS="${STORAGE_MOUNT_BTRFS:-noatime,compress=zstd:3,space_cache=v2}"
+STORAGE_MOUNT_XFS="${STORAGE_MOUNT_XFS:-noatime}"
+echo -e "${CYAN}Perfil de almacenamiento: ${STORAGE_CLASS:-genérico}${NC}"
+
+# Parámetros de LUKS: cifrado y clave elegidos midiendo este equipo (LUKS_*),
+# sector y colas de trabajo de dm-crypt según el perfil (STORAGE_LUKS_*).
+# --iter-time calibra argon2id para que desbloquear tarde ese tiempo.
+LUKS_FORMAT_ARGS=(
+    --type luks2
+    --cipher "${LUKS_CIPHER:-aes-xts-plain64}"
+    --key-size "${LUKS_KEY_SIZE:-512}"
+    --pbkdf argon2id
+    --iter-time "${LUKS_ITER_TIME:-2000}"
+)
+if [ -n "$STORAGE_LUKS_SECTOR_SIZE" ]; then
+    LUKS_FORMAT_ARGS+=(--sector-size "$STORAGE_LUKS_SECTOR_SIZE")
+fi
+LUKS_OPEN_ARGS=()
+if [ "$STORAGE_LUKS_NO_WORKQUEUE" = "true" ]; then
+    # --persistent guarda los flags en la cabecera LUKS2, así el hook encrypt también los usa
+    LUKS_OPEN_ARGS+=(--perf-no_read_workqueue --perf-no_write_workqueue --persistent)
+fi
+
+# Espera a que udev publique los dispositivos indicados (ruta /dev, UUID=,
+# PARTUUID=, LABEL= o DM=nombre) en lugar de dormir un tiempo fijo.
+# arcris-wait-dev vuelve en cuanto llega el evento de udev; si no está
+# instalado se recurre a udevadm settle.
+DEVICE_WAIT_TIMEOUT="${DEVICE_WAIT_TIMEOUT:-30}"
+wait_for_devices() {
+    if command -v arcris-wait-dev >/dev/null 2>&1; then
+        arcris-wait-dev --timeout "$DEVICE_WAIT_TIMEOUT" "$@"
+        return
+    fi
+
+    udevadm settle --timeout="$DEVICE_WAIT_TIMEOUT"
+    local spec path
+    for spec in "$@"; do
+        case "$spec" in
+            UUID=*)     path="/dev/disk/by-uuid/${spec#UUID=}" ;;
+            PARTUUID=*) path="/dev/disk/by-partuuid/${spec#PARTUUID=}" ;;
+            LABEL=*)    path="/dev/disk/by-label/${spec#LABEL=}" ;;
+            DM=*)       path="/dev/mapper/${spec#DM=}" ;;
+            *)          path="$spec" ;;
+        esac
+        if [ ! -b "$path" ]; then
+            echo -e "${YELLOW}Warning: $spec no apareció tras udevadm settle${NC}"
+            return 1
+        fi
+    done
+}
+
+# Espera a que udev procese el sistema de archivos recién creado en $1:
+# mkfs/mkswap generan un evento change y el symlink by-uuid indica que terminó.
+wait_for_filesystem() {
+    local uuid
+    uuid=$(blkid -p -s UUID -o value "$1" 2>/dev/null)
+    if [ -n "$uuid" ]; then
+        wait_for_devices "UUID=$uuid"
+    else
+        wait_for_devices "$1"
+    fi
+}
 
 # =============================================================================
 # FUNCIONES HELPER PARA partition_auto
 # =============================================================================
 
-# Calcula el tamaño de swap en MiB según SWAP_TYPE y la RAM del sistema.
-# Exporta SWAP_SIZE_MIB=0 si es zram (sin partición en disco).
-_auto_calc_swap() {
-    local ram_mib
-    ram_mib=$(awk '/MemTotal/ {printf "%d", $2/1024}' /proc/meminfo)
-
-    # Redondear al GB superior si fracción >= 512MB y RAM total >= 3584MB (3.5G)
-    local ram_remainder=$(( ram_mib % 1024 ))
-    local ram_gb=$(( ram_mib / 1024 ))
-    if [ $ram_mib -ge 3584 ] && [ $ram_remainder -ge 512 ]; then
-        ram_mib=$(( (ram_gb + 1) * 1024 ))
+# Porcentaje del borrado completo (una línea "0".."100") que muestra la página 8
+WIPE_PROGRESS_FILE="${WIPE_PROGRESS_FILE:-${ARCRIS_TMP_DIR:-/tmp}/arcris-wipe-progress}"
+
+_wipe_progress() {
+    echo "$1" > "$WIPE_PROGRESS_FILE"
+}
+
+# Recorre el disco en bloques de 1 GiB para poder informar el progreso.
+# $1 = zeroout (ceros delegados al disco), secure_discard o zero (dd)
+_wipe_by_chunks() {
+    local mode="$1"
+    local chunk=$((1024 * 1024 * 1024))
+    local total offset=0 len
+    total=$(blockdev --getsize64 "$SELECTED_DISK") || return 1
+
+    while [ "$offset" -lt "$total" ]; do
+        len=$(( total - offset < chunk ? total - offset : chunk ))
+        case "$mode" in
+            zeroout)
+                blkdiscard -f --zeroout -o "$offset" -l "$len" "$SELECTED_DISK" || return 1
+                ;;
+            secure_discard)
+                blkdiscard -f --secure -o "$offset" -l "$len" "$SELECTED_DISK" || return 1
+                ;;
+            *)
+                # El resto de menos de 1 MiB al final lo limpia sgdisk (copia GPT)
+                dd if=/dev/zero of="$SELECTED_DISK" bs=1M count=$(( len / 1048576 )) \
+                   seek=$(( offset / 1048576 )) oflag=direct conv=notrunc status=none || return 1
+                ;;
+        esac
+        offset=$(( offset + len ))
+        _wipe_progress $(( offset * 100 / total ))
+    done
+}
+
+# Espacios de nombres activos del controlador NVMe de SELECTED_DISK (0 si no
+# se pueden contar, p. ej. con multipath)
+_nvme_namespace_count() {
+    local ctrl
+    ctrl=$(basename "$(readlink -f "/sys/block/${SELECTED_DISK##*/}/device")")
+    nvme list-ns "/dev/$ctrl" 2>/dev/null | grep -c '^\['
+}
+
+# Borrado de un solo espacio de nombres: nvme format con User Data Erase.
+# Falla si el controlador aplica el formateo o el borrado seguro a todos los
+# espacios de nombres a la vez (bits 0 y 1 de FNA).
+_wipe_nvme_format() {
+    local fna
+    fna=$(nvme id-ctrl "$SELECTED_DISK" -o json 2>/dev/null | grep -o '"fna"[^0-9]*[0-9]*' | grep -o '[0-9]*$')
+    (( ${fna:-3} & 3 )) && return 1
+
+    nvme format "$SELECTED_DISK" --ses=1 --force || return 1
+    _wipe_progress 100
+}
+
+# Sanitize NVMe (borrado por bloques hecho por el controlador).
+# Falla si nvme-cli no está o el controlador no lo anuncia en SANICAP.
+_wipe_nvme_sanitize() {
+    command -v nvme >/dev/null 2>&1 || return 1
+
+    # Sanitize borra el controlador entero: con otros espacios de nombres se
+    # perderían también sus datos, así que solo se formatea SELECTED_DISK
+    if [ "$(_nvme_namespace_count)" -ne 1 ]; then
+        echo -e "${YELLOW}Warning: el controlador NVMe no tiene un único espacio de nombres; se formatea solo $SELECTED_DISK${NC}"
+        _wipe_nvme_format
+        return
     fi
 
-    case "$SWAP_TYPE" in
-        "zram")
-            SWAP_SIZE_MIB=0
-            echo -e "${CYAN}  • Swap: zram (sin partición en disco, RAM=${ram_mib}MiB)${NC}"
-            ;;
-        "half")
-            SWAP_SIZE_MIB=$(( ram_mib / 2 ))
-            echo -e "${CYAN}  • Swap: mitad de RAM = ${SWAP_SIZE_MIB}MiB${NC}"
-            ;;
-        "equal")
-            SWAP_SIZE_MIB=$ram_mib
-            echo -e "${CYAN}  • Swap: igual a RAM = ${SWAP_SIZE_MIB}MiB${NC}"
-            ;;
-        "custom")
-            SWAP_SIZE_MIB=$(( SWAP_CUSTOM_SIZE * 1024 ))
-            echo -e "${CYAN}  • Swap: custom = ${SWAP_SIZE_MIB}MiB${NC}"
+    local sanicap
+    sanicap=$(nvme id-ctrl "$SELECTED_DISK" -o json 2>/dev/null | grep -o '"sanicap"[^0-9]*[0-9]*' | grep -o '[0-9]*$')
+    # Bit 1 de SANICAP: Block Erase
+    (( ${sanicap:-0} & 2 )) || return 1
+
+    nvme sanitize "$SELECTED_DISK" --sanact=2 || return 1
+
+    # SPROG va de 0 a 65535 y vuelve a 65535 cuando no hay ningún sanitize en curso
+    local sprog=0
+    while true; do
+        sleep 2
+        sprog=$(nvme sanitize-log "$SELECTED_DISK" -o json 2>/dev/null | grep -o '"sprog"[^0-9]*[0-9]*' | grep -o '[0-9]*$')
+        [ "${sprog:-65535}" -ge 65535 ] && break
+        _wipe_progress $(( sprog * 100 / 65536 ))
+    done
+}
+
+# Borrado completo con el método elegido por Arcris (WIPE_METHOD); si el
+# dispositivo lo rechaza se recurre a escribir ceros.
+_wipe_full() {
+    local method="$1"
+    echo -e "${YELLOW}Borrado completo de $SELECTED_DISK ($method): puede tardar varios minutos${NC}"
+    _wipe_progress 0
+
+    case "$method" in
+        sanitize)
+            if ! _wipe_nvme_sanitize; then
+                echo -e "${YELLOW}Warning: sanitize NVMe no disponible, se escriben ceros${NC}"
+                _wipe_by_chunks zeroout || _wipe_by_chunks zero
+            fi
             ;;
-        "none")
-            SWAP_SIZE_MIB=0
-            echo -e "${CYAN}  • Swap: ninguna (sin zram ni partición)${NC}"
+        secure_discard|zeroout)
+            if ! _wipe_by_chunks "$method"; then
+                echo -e "${YELLOW}Warning: $method rechazado por el dispositivo, se escriben ceros${NC}"
+                _wipe_by_chunks zero
+            fi
             ;;
         *)
-            SWAP_SIZE_MIB=0
-            echo -e "${YELLOW}  • Swap: tipo desconocido '$SWAP_TYPE', sin swap${NC}"
+            _wipe_by_chunks zero
             ;;
     esac
+    local status=$?
+
+    rm -f "$WIPE_PROGRESS_FILE"
+    if [ "$status" -ne 0 ]; then
+        echo -e "${RED}ERROR: no se pudo borrar $SELECTED_DISK${NC}"
+        exit 1
+    fi
+    echo -e "${GREEN}✓ Borrado completo terminado${NC}"
 }
 
-# Limpia el disco completamente antes de particionar.
+# Limpia el disco antes de particionar según WIPE_METHOD (calculado por Arcris
+# a partir de las capacidades del dispositivo). Siempre termina quitando la
+# tabla de particiones (incluida la copia GPT del final) y las firmas.
 _auto_wipe_disk() {
-    echo -e "${CYAN}Limpiando disco completamente...${NC}"
+    local method="${WIPE_METHOD:-signatures}"
+    echo -e "${CYAN}Limpiando disco ($method)...${NC}"
+    # El de una instalación anterior interrumpida no es un borrado en curso
+    rm -f "$WIPE_PROGRESS_FILE"
+
+    case "$method" in
+        discard)
+            # En memoria flash deja todos los bloques libres en pocos segundos
+            blkdiscard -f "$SELECTED_DISK" ||
+                echo -e "${YELLOW}Warning: blkdiscard falló, se borran solo las firmas${NC}"
+            ;;
+        sanitize|secure_discard|zeroout|zero)
+            _wipe_full "$method"
+            ;;
+    esac
+
     sgdisk --zap-all "$SELECTED_DISK"
-    sleep 2
-    partprobe "$SELECTED_DISK"
     wipefs -af "$SELECTED_DISK"
     sync
-    sleep 2
-    udevadm settle --timeout=10
+    partprobe "$SELECTED_DISK"
+    wait_for_devices "$SELECTED_DISK"
 }
 
 # Formatea la partición root según FILESYSTEM_TYPE.
@@ -79,18 +241,18 @@ _auto_format_root() {
     case "$FILESYSTEM_TYPE" in
         "btrfs")
             echo -e "${CYAN}Formateando root como BTRFS...${NC}"
-            mkfs.btrfs -f "$dev"
+            mkfs.btrfs -f $STORAGE_MKFS_BTRFS "$dev"
             ;;
         "xfs")
             echo -e "${CYAN}Formateando root como XFS...${NC}"
-            mkfs.xfs -f "$dev"
+            mkfs.xfs -f $STORAGE_MKFS_XFS "$dev"
             ;;
         *)
             echo -e "${CYAN}Formateando root como EXT4...${NC}"
-            mkfs.ext4 -F "$dev"
+            mkfs.ext4 -F $STORAGE_MKFS_EXT4 "$dev"
             ;;
     esac
-    sleep 2
+    wait_for_filesystem "$dev"
 }
 
 # Monta root, home y crea subvolúmenes BTRFS si aplica.
@@ -118,22 +280,22 @@ _auto_mount_root_and_home() {
             umount /mnt
 
             # Montar subvolumen root
-            mount -o noatime,compress=zstd,space_cache=v2,subvol=@ "$root_dev" /mnt
+            mount -o "$STORAGE_MOUNT_BTRFS,subvol=@" "$root_dev" /mnt
             mkdir -p /mnt/var/log
-            mount -o noatime,compress=zstd,space_cache=v2,subvol=@var_log "$root_dev" /mnt/var/log
+            mount -o "$STORAGE_MOUNT_BTRFS,subvol=@var_log" "$root_dev" /mnt/var/log
 
             # Montar home según configuración
             case "$HOME_PARTITION" in
                 "subvolume")
                     mkdir -p /mnt/home
-                    mount -o noatime,compress=zstd,space_cache=v2,subvol=@home "$root_dev" /mnt/home
+                    mount -o "$STORAGE_MOUNT_BTRFS,subvol=@home" "$root_dev" /mnt/home
                     ;;
                 "partition")
                     if [ -n "$home_dev" ]; then
-                        mkfs.btrfs -f "$home_dev"
-                        sleep 2
+                        mkfs.btrfs -f $STORAGE_MKFS_BTRFS "$home_dev"
+                        wait_for_filesystem "$home_dev"
                         mkdir -p /mnt/home
-                        mount -o noatime,compress=zstd,space_cache=v2 "$home_dev" /mnt/home
+                        mount -o "$STORAGE_MOUNT_BTRFS" "$home_dev" /mnt/home
                     fi
                     ;;
                 "no")
@@ -143,21 +305,21 @@ _auto_mount_root_and_home() {
             esac
             ;;
         "xfs")
-            mount -t xfs "$root_dev" /mnt
+            mount -t xfs -o "$STORAGE_MOUNT_XFS" "$root_dev" /mnt
             if [ "$HOME_PARTITION" = "partition" ] && [ -n "$home_dev" ]; then
-                mkfs.xfs -f "$home_dev"
-                sleep 2
+                mkfs.xfs -f $STORAGE_MKFS_XFS "$home_dev"
+                wait_for_filesystem "$home_dev"
                 mkdir -p /mnt/home
-                mount -t xfs -o noatime "$home_dev" /mnt/home
+                mount -t xfs -o "$STORAGE_MOUNT_XFS" "$home_dev" /mnt/home
             fi
             ;;
         *)
-            mount "$root_dev" /mnt
+            mount -o "$STORAGE_MOUNT_EXT4" "$root_dev" /mnt
             if [ "$HOME_PARTITION" = "partition" ] && [ -n "$home_dev" ]; then
-                mkfs.ext4 -F "$home_dev"
-                sleep 2
+                mkfs.ext4 -F $STORAGE_MKFS_EXT4 "$home_dev"
+                wait_for_filesystem "$home_dev"
                 mkdir -p /mnt/home
-                mount "$home_dev" /mnt/home
+                mount -o "$STORAGE_MOUNT_EXT4" "$home_dev" /mnt/home
             fi
             ;;
     esac
@@ -178,72 +340,72 @@ _auto_setup_luks_lvm() {
     wipefs -af "$luks_dev" 2>/dev/null || true
     dd if=/dev/zero of="$luks_dev" bs=1M count=10 2>/dev/null || true
     sync
-    sleep 2
 
-    echo -n "$ENCRYPTION_KEY" > /tmp/luks_pass
-    if ! cryptsetup luksFormat --batch-mode --key-file /tmp/luks_pass "$luks_dev"; then
-        rm -f /tmp/luks_pass
+    echo -n "$ENCRYPTION_KEY" > "$ARCRIS_TMP_DIR/luks_pass"
+    if ! cryptsetup luksFormat --batch-mode "${LUKS_FORMAT_ARGS[@]}" --key-file "$ARCRIS_TMP_DIR/luks_pass" "$luks_dev"; then
+        rm -f "$ARCRIS_TMP_DIR/luks_pass"
         echo -e "${RED}ERROR: falló luksFormat en $luks_dev${NC}"
         exit 1
     fi
-    if ! cryptsetup open --key-file /tmp/luks_pass "$luks_dev" cryptlvm; then
-        rm -f /tmp/luks_pass
+    if ! cryptsetup open "${LUKS_OPEN_ARGS[@]}" --key-file "$ARCRIS_TMP_DIR/luks_pass" "$luks_dev" ${LUKS_MAPPER_NAME}; then
+        rm -f "$ARCRIS_TMP_DIR/luks_pass"
         echo -e "${RED}ERROR: falló cryptsetup open en $luks_dev${NC}"
         exit 1
     fi
-    rm -f /tmp/luks_pass
+    rm -f "$ARCRIS_TMP_DIR/luks_pass"
 
     # Obtener UUID del header LUKS (necesario para GRUB y crypttab)
-    sync
-    udevadm settle --timeout=10
-    CRYPT_LUKS_UUID=$(blkid -s UUID -o value "$luks_dev")
+    CRYPT_LUKS_UUID=$(cryptsetup luksUUID "$luks_dev")
     if [ -z "$CRYPT_LUKS_UUID" ]; then
         echo -e "${RED}ERROR: no se pudo obtener UUID de $luks_dev${NC}"
         exit 1
     fi
+    wait_for_devices "DM=${LUKS_MAPPER_NAME}" "UUID=$CRYPT_LUKS_UUID"
     export CRYPT_LUKS_UUID
-    echo -e "${GREEN}✓ LUKS abierto: /dev/mapper/cryptlvm (UUID: $CRYPT_LUKS_UUID)${NC}"
+    echo -e "${GREEN}✓ LUKS abierto: /dev/mapper/${LUKS_MAPPER_NAME} (UUID: $CRYPT_LUKS_UUID)${NC}"
 
     # Crear LVM sobre el mapper
-    echo -e "${CYAN}Configurando LVM sobre cryptlvm...${NC}"
-    pvcreate /dev/mapper/cryptlvm
-    vgcreate vg0 /dev/mapper/cryptlvm
+    echo -e "${CYAN}Configurando LVM sobre ${LUKS_MAPPER_NAME}...${NC}"
+    pvcreate /dev/mapper/${LUKS_MAPPER_NAME}
+    vgcreate ${LVM_VG_NAME} /dev/mapper/${LUKS_MAPPER_NAME}
 
     # LV swap (si SWAP_SIZE_MIB > 0)
     if [ "$SWAP_SIZE_MIB" -gt 0 ]; then
-        lvcreate -L "${SWAP_SIZE_MIB}MiB" vg0 -n swap
+        lvcreate -L "${SWAP_SIZE_MIB}MiB" ${LVM_VG_NAME} -n swap
         echo -e "${CYAN}  • LV swap: ${SWAP_SIZE_MIB}MiB${NC}"
     fi
 
     # LV root y opcionalmente home
     if [ "$HOME_PARTITION" = "partition" ]; then
-        lvcreate -L "${ROOT_SIZE}G" vg0 -n root
-        lvcreate -l 100%FREE vg0 -n home
+        lvcreate -L "${ROOT_SIZE}G" ${LVM_VG_NAME} -n root
+        lvcreate -l 100%FREE ${LVM_VG_NAME} -n home
         echo -e "${CYAN}  • LV root: ${ROOT_SIZE}GB | LV home: resto del disco${NC}"
     else
-        lvcreate -l 100%FREE vg0 -n root
+        lvcreate -l 100%FREE ${LVM_VG_NAME} -n root
         echo -e "${CYAN}  • LV root: 100% del espacio libre${NC}"
     fi
 
-    vgchange -a y vg0
-    sleep 2
-    udevadm settle --timeout=10
-    echo -e "${GREEN}✓ LVM configurado: vg0${NC}"
-    lvs vg0
+    vgchange -a y ${LVM_VG_NAME}
+    local lv_devices=(/dev/${LVM_VG_NAME}/root)
+    [ "$SWAP_SIZE_MIB" -gt 0 ] && lv_devices+=(/dev/${LVM_VG_NAME}/swap)
+    [ "$HOME_PARTITION" = "partition" ] && lv_devices+=(/dev/${LVM_VG_NAME}/home)
+    wait_for_devices "${lv_devices[@]}"
+    echo -e "${GREEN}✓ LVM configurado: ${LVM_VG_NAME}${NC}"
+    lvs ${LVM_VG_NAME}
 
     # Activar swap cifrada
     if [ "$SWAP_SIZE_MIB" -gt 0 ]; then
-        mkswap /dev/vg0/swap
-        swapon /dev/vg0/swap
-        echo -e "${GREEN}✓ Swap cifrada activada: /dev/vg0/swap${NC}"
+        mkswap /dev/${LVM_VG_NAME}/swap
+        swapon /dev/${LVM_VG_NAME}/swap
+        echo -e "${GREEN}✓ Swap cifrada activada: /dev/${LVM_VG_NAME}/swap${NC}"
     fi
 
     # Formatear y montar root (y home LV si aplica)
     local home_lv=""
-    [ "$HOME_PARTITION" = "partition" ] && home_lv="/dev/vg0/home"
+    [ "$HOME_PARTITION" = "partition" ] && home_lv="/dev/${LVM_VG_NAME}/home"
 
-    _auto_format_root "/dev/vg0/root"
-    _auto_mount_root_and_home "/dev/vg0/root" "$home_lv"
+    _auto_format_root "/dev/${LVM_VG_NAME}/root"
+    _auto_mount_root_and_home "/dev/${LVM_VG_NAME}/root" "$home_lv"
 }
 
 # Activa swap en disco si SWAP_SIZE_MIB > 0.
@@ -255,19 +417,60 @@ _auto_activate_swap() {
     fi
 
     echo -e "${CYAN}Verificando partición swap antes de activar...${NC}"
-    sleep 3
-    udevadm settle --timeout=10
-    partprobe "$SELECTED_DISK"
+    wait_for_filesystem "$swap_dev"
 
     if ! blkid "$swap_dev" | grep -q "TYPE=\"swap\""; then
         echo -e "${YELLOW}Warning: swap no detectada, reformateando...${NC}"
         mkswap "$swap_dev" || { echo -e "${RED}ERROR: No se pudo reformatear swap${NC}"; exit 1; }
-        sleep 2
+        wait_for_filesystem "$swap_dev"
     fi
     swapon "$swap_dev"
     echo -e "${GREEN}✓ Swap activada: $swap_dev (${SWAP_SIZE_MIB}MiB)${NC}"
 }
 
+# Crea la tabla de particiones de PARTITION_PLAN en una sola transacción de sfdisk.
+# Arcris calcula el plan (offsets alineados a 1 MiB, en sectores lógicos) y lo
+# guarda en variables.sh como "rol inicio tamaño tipo [bootable]"; tamaño 0 es
+# "hasta el final del disco". Exporta PLAN_PART_<ROL> con el dispositivo de cada
+# partición (EFI, BOOT, SWAP, ROOT, HOME, LUKS).
+_auto_apply_partition_plan() {
+    unset PLAN_PART_EFI PLAN_PART_BOOT PLAN_PART_SWAP PLAN_PART_ROOT PLAN_PART_HOME PLAN_PART_LUKS
+
+    if [ ${#PARTITION_PLAN[@]} -eq 0 ]; then
+        echo -e "${RED}ERROR: PARTITION_PLAN está vacío; vuelve a guardar la configuración del disco${NC}"
+        exit 1
+    fi
+
+    local sfdisk_script="label: ${PARTITION_TABLE:-gpt}"$'\n'"unit: sectors"$'\n'
+    local num=1 entry role start size type flag line part_dev
+    local plan_devices=()
+    for entry in "${PARTITION_PLAN[@]}"; do
+        read -r role start size type flag <<< "$entry"
+        line="start=$start"
+        [ "$size" != "0" ] && line="$line, size=$size"
+        line="$line, type=$type"
+        [ "$flag" = "bootable" ] && line="$line, bootable"
+        sfdisk_script+="$line"$'\n'
+        part_dev=$(get_partition_name "$SELECTED_DISK" "$num")
+        printf -v "PLAN_PART_${role^^}" '%s' "$part_dev"
+        plan_devices+=("$part_dev")
+        (( num++ ))
+    done
+
+    echo -e "${CYAN}Aplicando plan de particiones ($PARTITION_TABLE):${NC}"
+    echo "$sfdisk_script"
+
+    # sfdisk escribe la tabla completa y pide al kernel releerla una sola vez
+    if ! echo "$sfdisk_script" | sfdisk --wipe always --wipe-partitions always "$SELECTED_DISK"; then
+        echo -e "${RED}ERROR: sfdisk no pudo aplicar el plan de particiones en $SELECTED_DISK${NC}"
+        exit 1
+    fi
+    if ! wait_for_devices "${plan_devices[@]}"; then
+        echo -e "${RED}ERROR: las particiones nuevas no aparecieron en $SELECTED_DISK${NC}"
+        exit 1
+    fi
+}
+
 # =============================================================================
 # FUNCIÓN PRINCIPAL: partition_auto
 # Soporta FILESYSTEM_TYPE=ext4|btrfs|xfs
@@ -282,24 +485,18 @@ partition_auto() {
     echo -e "${CYAN}  • Filesystem: $FILESYSTEM_TYPE${NC}"
     echo -e "${CYAN}  • Home: $HOME_PARTITION${NC}"
     echo -e "${CYAN}  • Root size: ${ROOT_SIZE}GB${NC}"
-    sleep 2
-
-    # Calcular tamaño de swap
-    _auto_calc_swap
-
-    local swap_has_partition=false
-    [ "$SWAP_SIZE_MIB" -gt 0 ] && swap_has_partition=true
 
-    # Calcular offsets de particiones (en MiB)
-    local efi_start=1 efi_end=513          # 512MiB EFI (UEFI) o inicio BIOS
-    local swap_start swap_end
-    local root_start root_end
-    local home_start="100%"
+    if ! wait_for_devices "$SELECTED_DISK"; then
+        echo -e "${RED}ERROR: $SELECTED_DISK no está disponible${NC}"
+        exit 1
+    fi
 
-    # ROOT_SIZE en GB → MiB
-    local root_size_mib=$(( ROOT_SIZE * 1024 ))
+    # El tamaño de la swap lo calcula Arcris junto con el plan de particiones
+    SWAP_SIZE_MIB="${SWAP_SIZE_MIB:-0}"
+    echo -e "${CYAN}  • Swap: $SWAP_TYPE (${SWAP_SIZE_MIB}MiB en disco)${NC}"
 
     _auto_wipe_disk
+    _auto_apply_partition_plan
 
     # ── PATH CIFRADO: LUKS + LVM ──────────────────────────────────────────────
     # Layout UEFI: [EFI 512MB] + [LUKS → vg0 (swap?, root, home?)]
@@ -307,125 +504,39 @@ partition_auto() {
     # swap, root y home viven como LVs dentro de vg0, respetando
     # SWAP_TYPE, FILESYSTEM_TYPE y HOME_PARTITION.
     if [ "$ENCRYPTION" = "true" ]; then
-        if [ "$FIRMWARE_TYPE" = "UEFI" ]; then
+        if [ -n "$PLAN_PART_EFI" ]; then
             echo -e "${GREEN}| Configurando particiones UEFI + LUKS+LVM |${NC}"
-            parted "$SELECTED_DISK" --script --align optimal mklabel gpt
-            parted "$SELECTED_DISK" --script --align optimal mkpart ESP fat32 1MiB 513MiB
-            parted "$SELECTED_DISK" --script set 1 esp on
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary 513MiB 100%
-
-            partprobe "$SELECTED_DISK"; sleep 3; udevadm settle --timeout=10
-
-            local efi_part; efi_part=$(get_partition_name "$SELECTED_DISK" "1")
-            local luks_part; luks_part=$(get_partition_name "$SELECTED_DISK" "2")
-
-            mkfs.fat -F32 -v "$efi_part"
-            _auto_setup_luks_lvm "$luks_part"
-
-            mkdir -p /mnt/boot
-            mount "$efi_part" /mnt/boot
-
+            mkfs.fat -F32 -v "$PLAN_PART_EFI"
         else
             echo -e "${GREEN}| Configurando particiones BIOS Legacy + LUKS+LVM |${NC}"
-            parted "$SELECTED_DISK" --script --align optimal mklabel msdos
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary ext4 1MiB 513MiB
-            parted "$SELECTED_DISK" --script set 1 boot on
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary 513MiB 100%
-
-            partprobe "$SELECTED_DISK"; sleep 3; udevadm settle --timeout=10
-
-            local boot_part; boot_part=$(get_partition_name "$SELECTED_DISK" "1")
-            local luks_part; luks_part=$(get_partition_name "$SELECTED_DISK" "2")
-
-            mkfs.ext4 -F "$boot_part"
-            _auto_setup_luks_lvm "$luks_part"
-
-            mkdir -p /mnt/boot
-            mount "$boot_part" /mnt/boot
-        fi
-
-    # ── PATH SIN CIFRADO ─────────────────────────────────────────────────────
-    elif [ "$FIRMWARE_TYPE" = "UEFI" ]; then
-        echo -e "${GREEN}| Configurando particiones UEFI |${NC}"
-        parted "$SELECTED_DISK" --script --align optimal mklabel gpt
-        parted "$SELECTED_DISK" --script --align optimal mkpart ESP fat32 1MiB 513MiB
-        parted "$SELECTED_DISK" --script set 1 esp on
-
-        local next_offset=513
-        local part_num=2
-        local swap_part="" root_part="" home_part=""
-
-        if [ "$swap_has_partition" = true ]; then
-            local swap_end_mib=$(( next_offset + SWAP_SIZE_MIB ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary linux-swap "${next_offset}MiB" "${swap_end_mib}MiB"
-            swap_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-            next_offset=$swap_end_mib
-            (( part_num++ ))
+            mkfs.ext4 -F $STORAGE_MKFS_EXT4 "$PLAN_PART_BOOT"
         fi
 
-        if [ "$HOME_PARTITION" = "partition" ]; then
-            local root_end_mib=$(( next_offset + root_size_mib ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "${root_end_mib}MiB"
-            root_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-            next_offset=$root_end_mib
-            (( part_num++ ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "100%"
-            home_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-        else
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "100%"
-            root_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-        fi
-
-        partprobe "$SELECTED_DISK"; sleep 3; udevadm settle --timeout=10
-
-        mkfs.fat -F32 -v "$(get_partition_name "$SELECTED_DISK" "1")"
-        [ "$swap_has_partition" = true ] && mkswap "$swap_part"
-        _auto_format_root "$root_part"
-        _auto_activate_swap "$swap_part"
-        _auto_mount_root_and_home "$root_part" "$home_part"
+        _auto_setup_luks_lvm "$PLAN_PART_LUKS"
 
         mkdir -p /mnt/boot
-        mount "$(get_partition_name "$SELECTED_DISK" "1")" /mnt/boot
+        mount "${PLAN_PART_EFI:-$PLAN_PART_BOOT}" /mnt/boot
 
+    # ── PATH SIN CIFRADO ─────────────────────────────────────────────────────
+    # Layout UEFI: [EFI 512MB] + [swap?] + [root] + [home?]
+    # Layout BIOS: [swap?] + [root (boot)] + [home?]
     else
-        echo -e "${GREEN}| Configurando particiones BIOS Legacy |${NC}"
-        parted "$SELECTED_DISK" --script --align optimal mklabel msdos
-
-        local next_offset=1
-        local part_num=1
-        local swap_part="" root_part="" home_part=""
-
-        if [ "$swap_has_partition" = true ]; then
-            local swap_end_mib=$(( next_offset + SWAP_SIZE_MIB ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary linux-swap "${next_offset}MiB" "${swap_end_mib}MiB"
-            swap_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-            next_offset=$swap_end_mib
-            (( part_num++ ))
-        fi
-
-        if [ "$HOME_PARTITION" = "partition" ]; then
-            local root_end_mib=$(( next_offset + root_size_mib ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "${root_end_mib}MiB"
-            root_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-            parted "$SELECTED_DISK" --script set "$part_num" boot on
-            next_offset=$root_end_mib
-            (( part_num++ ))
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "100%"
-            home_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
+        if [ -n "$PLAN_PART_EFI" ]; then
+            echo -e "${GREEN}| Configurando particiones UEFI |${NC}"
+            mkfs.fat -F32 -v "$PLAN_PART_EFI"
         else
-            parted "$SELECTED_DISK" --script --align optimal mkpart primary "$FILESYSTEM_TYPE" "${next_offset}MiB" "100%"
-            root_part=$(get_partition_name "$SELECTED_DISK" "$part_num")
-            parted "$SELECTED_DISK" --script set "$part_num" boot on
+            echo -e "${GREEN}| Configurando particiones BIOS Legacy |${NC}"
         fi
 
-        partprobe "$SELECTED_DISK"; sleep 3; udevadm settle --timeout=10
-
-        [ "$swap_has_partition" = true ] && mkswap "$swap_part"
-        _auto_format_root "$root_part"
-        _auto_activate_swap "$swap_part"
-        _auto_mount_root_and_home "$root_part" "$home_part"
+        [ -n "$PLAN_PART_SWAP" ] && mkswap "$PLAN_PART_SWAP"
+        _auto_format_root "$PLAN_PART_ROOT"
+        _auto_activate_swap "$PLAN_PART_SWAP"
+        _auto_mount_root_and_home "$PLAN_PART_ROOT" "$PLAN_PART_HOME"
 
         mkdir -p /mnt/boot
+        if [ -n "$PLAN_PART_EFI" ]; then
+            mount "$PLAN_PART_EFI" /mnt/boot
+        fi
     fi
 
     # Instalar herramientas según filesystem
@@ -443,809 +554,6 @@ partition_auto() {
 
     echo -e "${GREEN}✓ Particionado automático completado${NC}"
     lsblk -o NAME,FSTYPE,SIZE,MOUNTPOINT "$SELECTED_DISK"
-    sleep 3
-}
-
-# Función legacy (reemplazada por partition_auto con FILESYSTEM_TYPE=btrfs)
-partition_auto_btrfs() {
-    echo -e "${GREEN}| Particionando automáticamente disco: $SELECTED_DISK (BTRFS) |${NC}"
-    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-    echo ""
-    sleep 2
-
-    # Limpieza agresiva del disco ANTES de cualquier particionado
-    echo -e "${CYAN}Desmontando todas las particiones del disco ${SELECTED_DISK}...${NC}"
-
-    # Desmontar todas las particiones montadas del disco seleccionado
-    for partition in $(lsblk -lno NAME ${SELECTED_DISK} | grep -v "^$(basename ${SELECTED_DISK})$" | sort -r); do
-        partition_path="/dev/$partition"
-        if mountpoint -q "/mnt" && grep -q "$partition_path" /proc/mounts; then
-            echo -e "${YELLOW}Desmontando $partition_path de /mnt...${NC}"
-            umount -R /mnt 2>/dev/null || umount -l /mnt 2>/dev/null || true
-        fi
-        if grep -q "$partition_path" /proc/mounts; then
-            echo -e "${YELLOW}Desmontando $partition_path...${NC}"
-            umount -f "$partition_path" 2>/dev/null || umount -l "$partition_path" 2>/dev/null || true
-        fi
-    done
-
-    # Desactivar swap si está en el disco seleccionado
-    echo -e "${CYAN}Desactivando swap en ${SELECTED_DISK}...${NC}"
-    for partition in $(lsblk -lno NAME ${SELECTED_DISK} | grep -v "^$(basename ${SELECTED_DISK})$"); do
-        swapoff "/dev/$partition" 2>/dev/null || true
-    done
-
-    # Limpiar estructuras BTRFS existentes
-    echo -e "${CYAN}Limpiando estructuras BTRFS existentes...${NC}"
-    for partition in $(lsblk -lno NAME ${SELECTED_DISK} | grep -v "^$(basename ${SELECTED_DISK})$"); do
-        wipefs -af "/dev/$partition" 2>/dev/null || true
-    done
-
-    # Limpiar completamente el disco - cabecera y final
-    echo -e "${CYAN}Limpieza completa del disco ${SELECTED_DISK}...${NC}"
-    # Limpiar los primeros 100MB (tablas de partición, etc.)
-    dd if=/dev/zero of=$SELECTED_DISK bs=1M count=100 2>/dev/null || true
-    # Limpiar los últimos 100MB (backup de tablas GPT)
-    DISK_SIZE=$(blockdev --getsz $SELECTED_DISK)
-    DISK_SIZE_MB=$((DISK_SIZE * 512 / 1024 / 1024))
-    if [ $DISK_SIZE_MB -gt 200 ]; then
-        dd if=/dev/zero of=$SELECTED_DISK bs=1M seek=$((DISK_SIZE_MB - 100)) count=100 2>/dev/null || true
-    fi
-    sync
-    sleep 5
-
-    # Forzar re-lectura de la tabla de particiones
-    blockdev --rereadpt $SELECTED_DISK 2>/dev/null || true
-    partprobe $SELECTED_DISK 2>/dev/null || true
-
-    # Reinicializar kernel sobre el dispositivo
-    echo -e "${CYAN}Reinicializando kernel sobre el dispositivo...${NC}"
-    # Intentar rescan solo si el archivo existe y tenemos permisos
-    RESCAN_FILE="/sys/block/$(basename $SELECTED_DISK)/device/rescan"
-    if [ -w "$RESCAN_FILE" ]; then
-        echo 1 > "$RESCAN_FILE" 2>/dev/null || true
-    fi
-    udevadm settle --timeout=10
-    udevadm trigger --subsystem-match=block
-    udevadm settle --timeout=10
-
-    # Verificaciones adicionales
-    echo -e "${CYAN}Verificando estado del disco después de la limpieza...${NC}"
-    if ! [ -b "$SELECTED_DISK" ]; then
-        echo -e "${RED}ERROR: El disco $SELECTED_DISK no es un dispositivo de bloque válido${NC}"
-        exit 1
-    fi
-
-    # Verificar que no hay particiones activas
-    if [ $(lsblk -n -o NAME $SELECTED_DISK | grep -c "├─\|└─") -gt 0 ]; then
-        echo -e "${YELLOW}Warning: Aún se detectan particiones. Realizando limpieza adicional...${NC}"
-        sgdisk --clear $SELECTED_DISK 2>/dev/null || true
-        wipefs -af $SELECTED_DISK 2>/dev/null || true
-        partprobe $SELECTED_DISK 2>/dev/null || true
-        sleep 2
-    fi
-
-    echo -e "${GREEN}✓ Disco limpio y listo para particionado${NC}"
-    sleep 3
-
-    if [ "$FIRMWARE_TYPE" = "UEFI" ]; then
-        # Configuración para UEFI
-        echo -e "${GREEN}| Configurando particiones BTRFS para UEFI |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Borrar completamente el disco
-        echo -e "${CYAN}Creando nueva tabla de particiones...${NC}"
-        sgdisk --zap-all $SELECTED_DISK
-        sleep 2
-        partprobe $SELECTED_DISK
-        wipefs -af $SELECTED_DISK
-
-        # Crear tabla de particiones GPT
-        echo -e "${CYAN}Creando tabla de particiones GPT...${NC}"
-        parted $SELECTED_DISK --script --align optimal mklabel gpt || {
-            echo -e "${RED}ERROR: No se pudo crear tabla GPT${NC}"
-            exit 1
-        }
-        sleep 2
-        partprobe $SELECTED_DISK
-
-        # Crear partición EFI (512MB)
-        echo -e "${CYAN}Creando partición EFI...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart ESP fat32 1MiB 513MiB || {
-            echo -e "${RED}ERROR: No se pudo crear partición EFI${NC}"
-            exit 1
-        }
-        parted $SELECTED_DISK --script set 1 esp on
-        sleep 1
-
-        # Crear partición swap (8GB)
-        echo -e "${CYAN}Creando partición swap...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart primary linux-swap 513MiB 8705MiB || {
-            echo -e "${RED}ERROR: No se pudo crear partición swap${NC}"
-            exit 1
-        }
-        sleep 1
-
-        # Crear partición root (resto del disco)
-        echo -e "${CYAN}Creando partición root...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart primary btrfs 8705MiB 100% || {
-            echo -e "${RED}ERROR: No se pudo crear partición root${NC}"
-            exit 1
-        }
-
-        # Verificar creación de particiones
-        partprobe $SELECTED_DISK
-        sleep 3
-        udevadm settle --timeout=10
-
-        # Formatear particiones
-        echo -e "${GREEN}| Formateando particiones BTRFS UEFI |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-        mkfs.fat -F32 -v $(get_partition_name "$SELECTED_DISK" "1")
-        mkswap $(get_partition_name "$SELECTED_DISK" "2")
-
-        # Verificar que el sistema reconozca la nueva swap BTRFS
-        echo -e "${CYAN}Esperando reconocimiento del sistema para partición swap...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-        partprobe $SELECTED_DISK
-
-        mkfs.btrfs -f $(get_partition_name "$SELECTED_DISK" "3")
-        sleep 2
-
-        # Verificar que las particiones estén disponibles y no montadas
-        echo -e "${CYAN}Verificando particiones creadas...${NC}"
-        sleep 5
-        partprobe $SELECTED_DISK
-        sleep 2
-
-        # Verificar que las particiones no estén montadas
-        for i in 1 2 3; do
-            if mountpoint -q "${SELECTED_DISK}${i}" 2>/dev/null; then
-                echo -e "${YELLOW}Desmontando ${SELECTED_DISK}${i}...${NC}"
-                umount -f "${SELECTED_DISK}${i}" 2>/dev/null || true
-            fi
-            if swapon --show=NAME --noheadings 2>/dev/null | grep -q "${SELECTED_DISK}${i}"; then
-                echo -e "${YELLOW}Desactivando swap ${SELECTED_DISK}${i}...${NC}"
-                swapoff "${SELECTED_DISK}${i}" 2>/dev/null || true
-            fi
-        done
-
-        lsblk $SELECTED_DISK
-        sleep 2
-
-        # Montar y crear subvolúmenes BTRFS
-        echo -e "${GREEN}| Creando subvolúmenes BTRFS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Verificar que la partición no esté montada antes de montar
-        echo -e "${CYAN}Preparando montaje de partición BTRFS...${NC}"
-        if mountpoint -q /mnt; then
-            echo -e "${YELLOW}Desmontando /mnt recursivamente...${NC}"
-            umount -R /mnt 2>/dev/null || umount -l /mnt 2>/dev/null || true
-            sleep 2
-        fi
-
-        # Verificar específicamente la partición BTRFS
-        PARTITION_3=$(get_partition_name "$SELECTED_DISK" "3")
-        if mountpoint -q "$PARTITION_3" 2>/dev/null; then
-            echo -e "${YELLOW}Desmontando $PARTITION_3...${NC}"
-            umount -f "$PARTITION_3" 2>/dev/null || true
-            sleep 2
-        fi
-
-        echo -e "${CYAN}Montando partición BTRFS $PARTITION_3 en /mnt...${NC}"
-        mount "$PARTITION_3" /mnt || {
-            echo -e "${RED}ERROR: No se pudo montar $PARTITION_3${NC}"
-            exit 1
-        }
-
-        # Limpiar contenido existente del filesystem BTRFS
-        echo -e "${CYAN}Limpiando contenido existente del filesystem BTRFS...${NC}"
-        find /mnt -mindepth 1 -maxdepth 1 -not -name 'lost+found' -exec rm -rf {} + 2>/dev/null || true
-
-        # No necesitamos eliminar subvolúmenes porque el filesystem está recién formateado
-
-        # Crear subvolúmenes BTRFS
-        echo -e "${CYAN}Creando subvolúmenes BTRFS...${NC}"
-        btrfs subvolume create /mnt/@
-        btrfs subvolume create /mnt/@home
-        btrfs subvolume create /mnt/@var_log
-        umount /mnt
-
-        # Montar subvolúmenes
-        PARTITION_1=$(get_partition_name "$SELECTED_DISK" "1")
-        PARTITION_2=$(get_partition_name "$SELECTED_DISK" "2")
-        PARTITION_3=$(get_partition_name "$SELECTED_DISK" "3")
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@ "$PARTITION_3" /mnt
-
-        # Verificar que la partición swap esté formateada correctamente antes de activar
-        echo -e "${CYAN}Verificando partición swap antes de activar...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-        partprobe $SELECTED_DISK
-
-        if ! blkid "$PARTITION_2" | grep -q "TYPE=\"swap\""; then
-            echo -e "${RED}ERROR: Partición swap no está formateada correctamente${NC}"
-            echo -e "${YELLOW}Intentando reformatear la partición swap...${NC}"
-            mkswap "$PARTITION_2" || {
-                echo -e "${RED}ERROR: No se pudo reformatear la partición swap${NC}"
-                exit 1
-            }
-            sleep 2
-        fi
-
-        echo -e "${CYAN}Activando partición swap...${NC}"
-        swapon "$PARTITION_2"
-        mkdir -p /mnt/{boot/efi,home,var/log}
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@home "$PARTITION_3" /mnt/home
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@var_log "$PARTITION_3" /mnt/var/log
-        mount "$PARTITION_1" /mnt/boot
-
-        # Instalar herramientas específicas para BTRFS
-        install_pacstrap_with_retry "btrfs-progs"
-        install_pacstrap_with_retry "btrfsmaintenance"
-        install_pacstrap_with_retry "snapper"
-        install_pacstrap_with_retry "btrfs-assistant"
-
-    else
-        # Configuración para BIOS Legacy
-        echo -e "${GREEN}| Configurando particiones BTRFS para BIOS Legacy |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Crear tabla de particiones MBR
-        echo -e "${CYAN}Creando tabla de particiones MBR...${NC}"
-        parted $SELECTED_DISK --script --align optimal mklabel msdos || {
-            echo -e "${RED}ERROR: No se pudo crear tabla MBR${NC}"
-            exit 1
-        }
-        sleep 2
-        partprobe $SELECTED_DISK
-
-        # Crear partición boot (1GB) - necesaria para GRUB en BIOS Legacy con BTRFS
-        echo -e "${CYAN}Creando partición boot...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart primary ext4 1MiB 1025MiB || {
-            echo -e "${RED}ERROR: No se pudo crear partición boot${NC}"
-            exit 1
-        }
-        parted $SELECTED_DISK --script set 1 boot on
-        sleep 1
-
-        # Crear partición swap (8GB)
-        echo -e "${CYAN}Creando partición swap...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart primary linux-swap 1025MiB 9217MiB || {
-            echo -e "${RED}ERROR: No se pudo crear partición swap${NC}"
-            exit 1
-        }
-        sleep 1
-
-        # Crear partición root (resto del disco)
-        echo -e "${CYAN}Creando partición root...${NC}"
-        parted $SELECTED_DISK --script --align optimal mkpart primary btrfs 9217MiB 100% || {
-            echo -e "${RED}ERROR: No se pudo crear partición root${NC}"
-            exit 1
-        }
-
-        # Verificar creación de particiones
-        partprobe $SELECTED_DISK
-        sleep 3
-        udevadm settle --timeout=10
-
-        # Formatear particiones
-        echo -e "${GREEN}| Formateando particiones BTRFS BIOS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-        mkfs.ext4 -F $(get_partition_name "$SELECTED_DISK" "1")
-        mkswap $(get_partition_name "$SELECTED_DISK" "2")
-
-        # Verificar que el sistema reconozca la nueva swap BTRFS BIOS
-        echo -e "${CYAN}Esperando reconocimiento del sistema para partición swap...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-        partprobe $SELECTED_DISK
-
-        mkfs.btrfs -f $(get_partition_name "$SELECTED_DISK" "3")
-        sleep 2
-
-        # Verificar que las particiones estén disponibles y no montadas
-        echo -e "${CYAN}Verificando particiones creadas...${NC}"
-        sleep 5
-        partprobe $SELECTED_DISK
-        sleep 2
-
-        # Verificar que las particiones no estén montadas
-        for i in 1 2 3; do
-            if mountpoint -q "${SELECTED_DISK}${i}" 2>/dev/null; then
-                echo -e "${YELLOW}Desmontando ${SELECTED_DISK}${i}...${NC}"
-                umount -f "${SELECTED_DISK}${i}" 2>/dev/null || true
-            fi
-            if swapon --show=NAME --noheadings 2>/dev/null | grep -q "${SELECTED_DISK}${i}"; then
-                echo -e "${YELLOW}Desactivando swap ${SELECTED_DISK}${i}...${NC}"
-                swapoff "${SELECTED_DISK}${i}" 2>/dev/null || true
-            fi
-        done
-
-        lsblk $SELECTED_DISK
-        sleep 2
-
-        # Montar y crear subvolúmenes BTRFS
-        echo -e "${GREEN}| Creando subvolúmenes BTRFS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Verificar que la partición no esté montada antes de montar
-        echo -e "${CYAN}Preparando montaje de partición BTRFS...${NC}"
-        if mountpoint -q /mnt; then
-            echo -e "${YELLOW}Desmontando /mnt recursivamente...${NC}"
-            umount -R /mnt 2>/dev/null || umount -l /mnt 2>/dev/null || true
-            sleep 2
-        fi
-
-        # Verificar específicamente la partición BTRFS
-        PARTITION_3=$(get_partition_name "$SELECTED_DISK" "3")
-        if mountpoint -q "$PARTITION_3" 2>/dev/null; then
-            echo -e "${YELLOW}Desmontando $PARTITION_3...${NC}"
-            umount -f "$PARTITION_3" 2>/dev/null || true
-            sleep 2
-        fi
-
-        echo -e "${CYAN}Montando partición BTRFS $PARTITION_3 en /mnt...${NC}"
-        mount "$PARTITION_3" /mnt || {
-            echo -e "${RED}ERROR: No se pudo montar $PARTITION_3${NC}"
-            exit 1
-        }
-
-        # Limpiar contenido existente del filesystem BTRFS
-        echo -e "${CYAN}Limpiando contenido existente del filesystem BTRFS...${NC}"
-        find /mnt -mindepth 1 -maxdepth 1 -not -name 'lost+found' -exec rm -rf {} + 2>/dev/null || true
-
-        # No necesitamos eliminar subvolúmenes porque el filesystem está recién formateado
-
-        # Crear subvolúmenes BTRFS
-        echo -e "${CYAN}Creando subvolúmenes BTRFS...${NC}"
-        btrfs subvolume create /mnt/@
-        btrfs subvolume create /mnt/@home
-        btrfs subvolume create /mnt/@var_log
-        umount /mnt
-
-        # Montar subvolúmenes
-        PARTITION_1=$(get_partition_name "$SELECTED_DISK" "1")
-        PARTITION_2=$(get_partition_name "$SELECTED_DISK" "2")
-        PARTITION_3=$(get_partition_name "$SELECTED_DISK" "3")
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@ "$PARTITION_3" /mnt
-
-        # Verificar que la partición swap esté formateada correctamente antes de activar
-        echo -e "${CYAN}Verificando partición swap antes de activar...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-        partprobe $SELECTED_DISK
-
-        if ! blkid "$PARTITION_2" | grep -q "TYPE=\"swap\""; then
-            echo -e "${RED}ERROR: Partición swap no está formateada correctamente${NC}"
-            echo -e "${YELLOW}Intentando reformatear la partición swap...${NC}"
-            mkswap "$PARTITION_2" || {
-                echo -e "${RED}ERROR: No se pudo reformatear la partición swap${NC}"
-                exit 1
-            }
-            sleep 2
-        fi
-
-        echo -e "${CYAN}Activando partición swap...${NC}"
-        swapon "$PARTITION_2"
-        mkdir -p /mnt/{boot,home,var/log}
-        mount "$PARTITION_1" /mnt/boot
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@home "$PARTITION_3" /mnt/home
-        mount -o noatime,compress=zstd,space_cache=v2,subvol=@var_log "$PARTITION_3" /mnt/var/log
-
-        # Instalar herramientas específicas para BTRFS
-        install_pacstrap_with_retry "btrfs-progs"
-        install_pacstrap_with_retry "btrfsmaintenance"
-        install_pacstrap_with_retry "snapper"
-        install_pacstrap_with_retry "btrfs-assistant"
-    fi
-}
-
-# Función para particionado con cifrado LUKS (simplificada)
-partition_cifrado() {
-    echo -e "${GREEN}| Particionando disco con cifrado LUKS: $SELECTED_DISK |${NC}"
-    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-    echo ""
-    echo -e "${CYAN}Esta configuración implementa LUKS+LVM:${NC}"
-    echo -e "${CYAN}  • Cifrado completo del sistema (excepto boot)${NC}"
-    echo -e "${CYAN}  • Compatible con UEFI y BIOS Legacy${NC}"
-    echo -e "${CYAN}  • ⚠️  SIN LA CONTRASEÑA PERDERÁS TODOS LOS DATOS${NC}"
-    echo ""
-
-    echo -e "${GREEN}✓ Usando contraseña de cifrado configurada${NC}"
-    sleep 1
-
-    if [ "$FIRMWARE_TYPE" = "UEFI" ]; then
-        # Configuración para UEFI con cifrado (siguiendo mejores prácticas)
-        echo -e "${GREEN}| Configurando particiones cifradas para UEFI |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Borrar completamente el disco
-        echo -e "${CYAN}Limpiando disco completamente...${NC}"
-        sgdisk --zap-all $SELECTED_DISK
-        sleep 4
-        partprobe $SELECTED_DISK
-        wipefs -af $SELECTED_DISK
-
-        # Crear tabla de particiones GPT
-        parted $SELECTED_DISK --script --align optimal mklabel gpt
-
-        # Crear partición EFI (512MB)
-        parted $SELECTED_DISK --script --align optimal mkpart ESP fat32 1MiB 513MiB
-        parted $SELECTED_DISK --script set 1 esp on
-
-        # Crear partición boot sin cifrar (1GB)
-        parted $SELECTED_DISK --script --align optimal mkpart primary ext4 513MiB 1537MiB
-
-        # Crear partición principal cifrada (resto del disco)
-        parted $SELECTED_DISK --script --align optimal mkpart primary 1537MiB 100%
-
-        # Formatear particiones
-        mkfs.fat -F32 $(get_partition_name "$SELECTED_DISK" "1")
-        mkfs.ext4 -F $(get_partition_name "$SELECTED_DISK" "2")
-
-        # Sincronizar y esperar reconocimiento de particiones
-        echo -e "${CYAN}Sincronizando sistema de archivos...${NC}"
-        sync
-        partprobe $SELECTED_DISK
-        sleep 4
-
-        # Configurar LUKS en la partición principal
-        # Aplicar cifrado LUKS
-        echo -e "${GREEN}| Configurando cifrado LUKS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Limpiar firmas de sistemas de archivos existentes
-        echo -e "${CYAN}Limpiando firmas de sistemas de archivos...${NC}"
-        PARTITION_3=$(get_partition_name "$SELECTED_DISK" "3")
-        wipefs -af "$PARTITION_3" 2>/dev/null || true
-        dd if=/dev/zero of="$PARTITION_3" bs=1M count=10 2>/dev/null || true
-
-        # Cifrar partición principal con LUKS
-        echo -e "${GREEN}| Cifrando $PARTITION_3 con LUKS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo -e "${CYAN}Aplicando cifrado... (puede tardar unos minutos)${NC}"
-
-        # Crear dispositivo LUKS usando archivo temporal para contraseña
-        echo -n "$ENCRYPTION_KEY" > /tmp/luks_pass
-
-        if ! cryptsetup luksFormat --batch-mode --key-file /tmp/luks_pass "$PARTITION_3"; then
-            rm -f /tmp/luks_pass
-            echo -e "${RED}ERROR: Falló el cifrado LUKS${NC}"
-            exit 1
-        fi
-
-        if ! cryptsetup open --key-file /tmp/luks_pass "$PARTITION_3" cryptlvm; then
-            rm -f /tmp/luks_pass
-            echo -e "${RED}ERROR: No se pudo abrir dispositivo cifrado${NC}"
-            exit 1
-        fi
-
-        rm -f /tmp/luks_pass
-        echo -e "${GREEN}✓ Cifrado LUKS aplicado y dispositivo abierto${NC}"
-
-        # Crear backup del header LUKS (recomendación de seguridad)
-        echo -e "${CYAN}Creando backup del header LUKS...${NC}"
-        cryptsetup luksHeaderBackup "$PARTITION_3" --header-backup-file /tmp/luks-header-backup
-        echo -e "${GREEN}✓ Backup del header LUKS guardado en /tmp/luks-header-backup${NC}"
-        echo -e "${YELLOW}IMPORTANTE: Copia este archivo a un lugar seguro después de la instalación${NC}"
-
-        # Configurar LVM sobre LUKS (Simplificado)
-        echo -e "${GREEN}| Configurando LVM sobre dispositivo cifrado |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-
-        # Crear LVM sobre el dispositivo cifrado
-        echo -e "${CYAN}Configurando LVM...${NC}"
-        pvcreate /dev/mapper/cryptlvm
-        vgcreate vg0 /dev/mapper/cryptlvm
-        lvcreate -L 8G vg0 -n swap
-        lvcreate -l 100%FREE vg0 -n root
-
-        # Activar volúmenes
-        vgchange -a y vg0
-        sleep 2
-
-        echo -e "${GREEN}✓ LVM configurado: vg0 con swap(8GB) y root${NC}"
-
-        # Sincronizar antes de verificar LVM
-        echo -e "${CYAN}Sincronizando dispositivos del sistema...${NC}"
-        sync
-        udevadm settle
-        sleep 2
-
-        # Verificar que los volúmenes LVM estén disponibles
-        if ! verify_lvm_devices; then
-            echo -e "${RED}FALLO CRÍTICO: No se pudieron verificar los dispositivos LVM${NC}"
-            exit 1
-        fi
-
-        # Formatear volúmenes LVM
-        echo -e "${CYAN}Formateando volúmenes LVM...${NC}"
-        if ! mkfs.ext4 -F /dev/vg0/root; then
-            echo -e "${RED}ERROR: No se pudo formatear /dev/vg0/root${NC}"
-            exit 1
-        fi
-
-        if ! mkswap /dev/vg0/swap; then
-            echo -e "${RED}ERROR: No se pudo formatear /dev/vg0/swap${NC}"
-            exit 1
-        fi
-
-        # Verificar que el sistema reconozca el swap LVM
-        echo -e "${CYAN}Esperando reconocimiento del sistema para swap LVM...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-
-        # Montar sistema de archivos root
-        echo -e "${CYAN}Montando sistema raíz...${NC}"
-        if ! mount /dev/vg0/root /mnt; then
-            echo -e "${RED}ERROR: No se pudo montar /dev/vg0/root en /mnt${NC}"
-            exit 1
-        fi
-
-        # Verificar que el swap LVM esté disponible antes de activar
-        echo -e "${CYAN}Verificando swap LVM antes de activar...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-
-        if ! blkid /dev/vg0/swap | grep -q "TYPE=\"swap\""; then
-            echo -e "${RED}ERROR: Swap LVM no está formateada correctamente${NC}"
-            echo -e "${YELLOW}Intentando reformatear el swap LVM...${NC}"
-            mkswap /dev/vg0/swap || {
-                echo -e "${RED}ERROR: No se pudo reformatear el swap LVM${NC}"
-                exit 1
-            }
-            sleep 2
-        fi
-
-        if ! swapon /dev/vg0/swap; then
-            echo -e "${YELLOW}ADVERTENCIA: No se pudo activar el swap${NC}"
-        fi
-
-        # Verificar que las particiones existan antes de montar
-        echo -e "${CYAN}Verificando particiones antes del montaje...${NC}"
-        PARTITION_1=$(get_partition_name "$SELECTED_DISK" "1")
-        if [ ! -b "$PARTITION_1" ]; then
-            echo -e "${RED}ERROR: Partición EFI $PARTITION_1 no existe${NC}"
-            exit 1
-        fi
-        if [ ! -b "$PARTITION_1" ]; then
-            echo -e "${RED}ERROR: Partición boot $PARTITION_1 no existe${NC}"
-            exit 1
-        fi
-
-        # Esperar que las particiones estén completamente listas
-        sleep 2
-        sync
-
-        echo -e "${CYAN}Creando directorio de montaje boot...${NC}"
-        mkdir -p /mnt/boot
-
-        echo -e "${CYAN}Montando partición boot...${NC}"
-        if ! mount "$PARTITION_1" /mnt/boot; then
-            echo -e "${RED}ERROR: Falló el montaje de la partición boot${NC}"
-            exit 1
-        fi
-
-        echo -e "${CYAN}Creando directorio boot...${NC}"
-        mkdir -p /mnt/boot
-
-        echo -e "${CYAN}Montando partición EFI...${NC}"
-        if ! mount "$PARTITION_1" /mnt/boot; then
-            echo -e "${RED}ERROR: Falló el montaje de la partición EFI${NC}"
-            exit 1
-        fi
-
-        # Verificar que los montajes sean exitosos (en orden correcto)
-        if ! mountpoint -q /mnt/boot; then
-            echo -e "${RED}ERROR: /mnt/boot no está montado correctamente${NC}"
-            exit 1
-        fi
-        if ! mountpoint -q /mnt/boot; then
-            echo -e "${RED}ERROR: /mnt/boot no está montado correctamente${NC}"
-            exit 1
-        fi
-
-        echo -e "${GREEN}✓ Todas las particiones montadas correctamente${NC}"
-        echo -e "${GREEN}✓ Esquema LUKS+LVM configurado:${NC}"
-        echo -e "${GREEN}  • UEFI: EFI (512MB) + boot (1GB) sin cifrar, resto cifrado${NC}"
-
-        # Instalar herramientas específicas para cifrado
-        install_pacstrap_with_retry "cryptsetup"
-        install_pacstrap_with_retry "lvm2"
-        install_pacstrap_with_retry "device-mapper"
-        install_pacstrap_with_retry "thin-provisioning-tools"
-
-    else
-        # Configuración para BIOS Legacy con cifrado (siguiendo mejores prácticas)
-        echo -e "${GREEN}| Configurando particiones cifradas para BIOS Legacy |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Borrar completamente el disco
-        echo -e "${CYAN}Limpiando disco completamente...${NC}"
-        sgdisk --zap-all $SELECTED_DISK
-        sleep 2
-        partprobe $SELECTED_DISK
-        wipefs -af $SELECTED_DISK
-
-        # Crear tabla de particiones MBR
-        parted $SELECTED_DISK --script --align optimal mklabel msdos
-
-        # Crear partición de boot sin cifrar (512MB) - mínima necesaria
-        parted $SELECTED_DISK --script --align optimal mkpart primary ext4 1MiB 513MiB
-        parted $SELECTED_DISK --script set 1 boot on
-
-        # Crear partición cifrada (resto del disco)
-        parted $SELECTED_DISK --script --align optimal mkpart primary 513MiB 100%
-
-        # Formatear partición boot
-        mkfs.ext4 -F $(get_partition_name "$SELECTED_DISK" "1")
-
-        # Sincronizar y esperar reconocimiento de particiones
-        echo -e "${CYAN}Sincronizando sistema de archivos...${NC}"
-        sync
-        partprobe $SELECTED_DISK
-        sleep 3
-
-        # Configurar LUKS en la partición principal
-        # Configurar cifrado LUKS
-        echo -e "${GREEN}| Configurando cifrado LUKS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo ""
-
-        # Limpiar firmas de sistemas de archivos existentes
-        echo -e "${CYAN}Limpiando firmas de sistemas de archivos...${NC}"
-        PARTITION_2=$(get_partition_name "$SELECTED_DISK" "2")
-        wipefs -af "$PARTITION_2" 2>/dev/null || true
-        # Cifrar partición principal con LUKS
-        echo -e "${GREEN}| Cifrando $PARTITION_2 con LUKS |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-        echo -e "${CYAN}Aplicando cifrado... (puede tardar unos minutos)${NC}"
-
-        # Crear dispositivo LUKS usando archivo temporal para contraseña
-        echo -n "$ENCRYPTION_KEY" > /tmp/luks_pass
-
-        if ! cryptsetup luksFormat --batch-mode --key-file /tmp/luks_pass "$PARTITION_2"; then
-            rm -f /tmp/luks_pass
-            echo -e "${RED}ERROR: Falló el cifrado LUKS${NC}"
-            exit 1
-        fi
-
-        if ! cryptsetup open --key-file /tmp/luks_pass "$PARTITION_2" cryptlvm; then
-            rm -f /tmp/luks_pass
-            echo -e "${RED}ERROR: No se pudo abrir dispositivo cifrado${NC}"
-            exit 1
-        fi
-
-        rm -f /tmp/luks_pass
-        echo -e "${GREEN}✓ Cifrado LUKS aplicado y dispositivo abierto${NC}"
-
-        # Crear backup del header LUKS (recomendación de seguridad)
-        echo -e "${CYAN}Creando backup del header LUKS...${NC}"
-        cryptsetup luksHeaderBackup "$PARTITION_2" --header-backup-file /tmp/luks-header-backup
-        echo -e "${GREEN}✓ Backup del header LUKS guardado en /tmp/luks-header-backup${NC}"
-        echo -e "${YELLOW}IMPORTANTE: Copia este archivo a un lugar seguro después de la instalación${NC}"
-
-        # Configurar LVM sobre LUKS (Simplificado)
-        echo -e "${GREEN}| Configurando LVM sobre dispositivo cifrado |${NC}"
-        printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
-
-        # Crear LVM sobre el dispositivo cifrado
-        echo -e "${CYAN}Configurando LVM...${NC}"
-        pvcreate /dev/mapper/cryptlvm
-        vgcreate vg0 /dev/mapper/cryptlvm
-        lvcreate -L 8G vg0 -n swap
-        lvcreate -l 100%FREE vg0 -n root
-
-        # Activar volúmenes
-        vgchange -a y vg0
-        sleep 2
-
-        echo -e "${GREEN}✓ LVM configurado: vg0 con swap(8GB) y root${NC}"
-
-        # Sincronizar antes de verificar LVM
-        echo -e "${CYAN}Sincronizando dispositivos del sistema...${NC}"
-        sync
-        udevadm settle
-        sleep 2
-
-        # Verificar que los volúmenes LVM estén disponibles
-        if ! verify_lvm_devices; then
-            echo -e "${RED}FALLO CRÍTICO: No se pudieron verificar los dispositivos LVM${NC}"
-            exit 1
-        fi
-
-        # Formatear volúmenes LVM
-        echo -e "${CYAN}Formateando volúmenes LVM...${NC}"
-        if ! mkfs.ext4 -F /dev/vg0/root; then
-            echo -e "${RED}ERROR: No se pudo formatear /dev/vg0/root${NC}"
-            exit 1
-        fi
-
-        if ! mkswap /dev/vg0/swap; then
-            echo -e "${RED}ERROR: No se pudo formatear /dev/vg0/swap${NC}"
-            exit 1
-        fi
-
-        # Verificar que el sistema reconozca el swap LVM BIOS
-        echo -e "${CYAN}Esperando reconocimiento del sistema para swap LVM...${NC}"
-        sleep 3
-        udevadm settle --timeout=10
-
-        # Montar sistema de archivos root
-        echo -e "${CYAN}Montando sistema raíz...${NC}"
-        if ! mount /dev/vg0/root /mnt; then
-            echo -e "${RED}ERROR: No se pudo montar /dev/vg0/root en /mnt${NC}"
-            exit 1
-        fi
-
-        # Verificar que el swap LVM esté disponible antes de activar
-        echo -e "${CYAN}Verificando swap LVM antes de activar...${NC}"
-        sleep 2
-
-        if ! blkid /dev/vg0/swap | grep -q "TYPE=\"swap\""; then
-            echo -e "${RED}ERROR: Swap LVM no está formateada correctamente${NC}"
-            echo -e "${YELLOW}Intentando reformatear el swap LVM...${NC}"
-            mkswap /dev/vg0/swap || {
-                echo -e "${RED}ERROR: No se pudo reformatear el swap LVM${NC}"
-                exit 1
-            }
-            sleep 2
-        fi
-
-        if ! swapon /dev/vg0/swap; then
-            echo -e "${YELLOW}ADVERTENCIA: No se pudo activar el swap${NC}"
-        fi
-
-        # Verificar que la partición boot exista
-        echo -e "${CYAN}Verificando partición boot antes del montaje...${NC}"
-        PARTITION_1=$(get_partition_name "$SELECTED_DISK" "1")
-        if [ ! -b "$PARTITION_1" ]; then
-            echo -e "${RED}ERROR: Partición boot $PARTITION_1 no existe${NC}"
-            exit 1
-        fi
-
-        # Esperar que la partición esté completamente lista
-        sleep 2
-        sync
-
-        # Montar partición boot
-        echo -e "${CYAN}Creando directorio /boot...${NC}"
-        mkdir -p /mnt/boot
-
-        echo -e "${CYAN}Montando partición boot...${NC}"
-        if ! mount "$PARTITION_1" /mnt/boot; then
-            echo -e "${RED}ERROR: Falló el montaje de la partición boot${NC}"
-            exit 1
-        fi
-
-        # Verificar que el montaje sea exitoso
-        if ! mountpoint -q /mnt/boot; then
-            echo -e "${RED}ERROR: /mnt/boot no está montado correctamente${NC}"
-            exit 1
-        fi
-
-        echo -e "${GREEN}✓ Partición boot montada correctamente${NC}"
-        echo -e "${GREEN}✓ Esquema LUKS+LVM configurado:${NC}"
-        echo -e "${GREEN}  • BIOS Legacy: boot (512MB) sin cifrar, resto cifrado${NC}"
-
-        # Instalar herramientas específicas para cifrado
-        install_pacstrap_with_retry "cryptsetup"
-        install_pacstrap_with_retry "lvm2"
-        install_pacstrap_with_retry "device-mapper"
-        install_pacstrap_with_retry "thin-provisioning-tools"
-    fi
 }
 
 # Función para particionado manual
@@ -1267,7 +575,7 @@ partition_manual() {
                 echo -e "${CYAN}Sin formatear: $device${NC}"
                 ;;
             "mkfs.ext4")
-                mkfs.ext4 -F $device
+                mkfs.ext4 -F $STORAGE_MKFS_EXT4 $device
                 ;;
             "mkfs.ext3")
                 mkfs.ext3 -F $device
@@ -1276,10 +584,10 @@ partition_manual() {
                 mkfs.ext2 -F $device
                 ;;
             "mkfs.btrfs")
-                mkfs.btrfs -f $device
+                mkfs.btrfs -f $STORAGE_MKFS_BTRFS $device
                 ;;
             "mkfs.xfs")
-                mkfs.xfs -f $device
+                mkfs.xfs -f $STORAGE_MKFS_XFS $device
                 # Aplicar optimizaciones XFS
                 xfs_admin -O bigtime=1 $device
                 ;;
@@ -1320,6 +628,10 @@ partition_manual() {
         esac
     done
 
+    # mkfs y parted generan eventos de udev: los montajes y genfstab necesitan
+    # los nodos y UUID ya actualizados
+    udevadm settle --timeout="$DEVICE_WAIT_TIMEOUT"
+
     # Validaciones antes del montaje
     echo -e "${CYAN}=== VALIDACIONES ===${NC}"
 
@@ -1373,7 +685,7 @@ partition_manual() {
                 mkdir -p "$ROOT_MOUNT_POINT"
 
                 # Montar filesystem btrfs temporalmente
-                mount -t btrfs -o noatime,compress=zstd:3,space_cache=v2,autodefrag $device "$ROOT_MOUNT_POINT"
+                mount -t btrfs -o "$STORAGE_MOUNT_BTRFS" $device "$ROOT_MOUNT_POINT"
 
                 # Crear subvolúmenes BTRFS
                 echo -e "${CYAN}Creando subvolúmenes BTRFS...${NC}"
@@ -1386,7 +698,7 @@ partition_manual() {
                 rmdir "$ROOT_MOUNT_POINT"
 
                 echo -e "${CYAN}Montando subvolumen @ de btrfs con opciones optimizadas...${NC}"
-                mount -t btrfs -o noatime,subvol=@,compress=zstd:3,space_cache=v2,autodefrag $device /mnt
+                mount -t btrfs -o "$STORAGE_MOUNT_BTRFS,subvol=@" $device /mnt
             else
                 mount $device /mnt
             fi
@@ -1418,9 +730,9 @@ partition_manual() {
             mkdir -p /mnt/home
             # Opciones específicas según filesystem
             if [ "$format" = "mkfs.xfs" ]; then
-                mount -t xfs -o defaults,noatime $device /mnt/home
+                mount -t xfs -o "$STORAGE_MOUNT_XFS" $device /mnt/home
             elif [ "$format" = "mkfs.btrfs" ]; then
-                mount -t btrfs -o noatime,compress=zstd:3,space_cache=v2,autodefrag $device /mnt/home
+                mount -t btrfs -o "$STORAGE_MOUNT_BTRFS" $device /mnt/home
             else
                 mount $device /mnt/home
             fi
@@ -1445,11 +757,11 @@ partition_manual() {
 
         # Montar @var_log
         mkdir -p /mnt/var/log
-        mount -t btrfs -o noatime,subvol=@var_log,compress=zstd:3,space_cache=v2,autodefrag "$ROOT_DEVICE" /mnt/var/log
+        mount -t btrfs -o "$STORAGE_MOUNT_BTRFS,subvol=@var_log" "$ROOT_DEVICE" /mnt/var/log
 
         # Montar @var_cache
         mkdir -p /mnt/var/cache
-        mount -t btrfs -o noatime,subvol=@var_cache,compress=zstd:3,space_cache=v2,autodefrag "$ROOT_DEVICE" /mnt/var/cache
+        mount -t btrfs -o "$STORAGE_MOUNT_BTRFS,subvol=@var_cache" "$ROOT_DEVICE" /mnt/var/cache
     fi
 
     # 5. Montar todas las demás particiones (/var, /tmp, /usr, /opt, etc.)
@@ -1466,14 +778,13 @@ partition_manual() {
 
         # Opciones específicas según filesystem y punto de montaje
         if [ "$format" = "mkfs.xfs" ]; then
-            mount -t xfs -o defaults,noatime $device /mnt$mountpoint
+            mount -t xfs -o "$STORAGE_MOUNT_XFS" $device /mnt$mountpoint
         elif [ "$format" = "mkfs.btrfs" ]; then
-            mount -t btrfs -o noatime,compress=zstd:3,space_cache=v2,autodefrag $device /mnt$mountpoint
+            mount -t btrfs -o "$STORAGE_MOUNT_BTRFS" $device /mnt$mountpoint
         else
             mount $device /mnt$mountpoint
         fi
     done
 
     lsblk -o NAME,FSTYPE,SIZE,MOUNTPOINT
-    sleep 3
 }
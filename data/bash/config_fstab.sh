@@ -1,49 +1,165 @@
-# Generar fstab usando genfstab -U
-echo -e "${GREEN}| Generando fstab con genfstab -U |${NC}"
+# -----------------------------------------------------------------------------------
+# fstab y crypttab generados desde el esquema del instalador
+#
+# config_disk.sh deja montado en /mnt el esquema elegido (particiones, volúmenes LVM
+# y subvolúmenes btrfs) y activa el swap. Cada entrada se emite directamente con las
+# opciones del perfil de almacenamiento (STORAGE_MOUNT_*), las mismas que usaron las
+# llamadas a mount, en lugar de copiar la salida de genfstab y retocarla con sed.
+# Los UUID salen de una sola consulta a lsblk (base de datos de udev, sin volver a
+# sondear los discos) y la verificación final es una sola lectura de
+# /dev/disk/by-uuid.
+# -----------------------------------------------------------------------------------
+
+echo -e "${GREEN}| Generando fstab y crypttab desde el esquema de particiones |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
 
-genfstab -U /mnt > /mnt/etc/fstab
+declare -A FSTAB_UUID FSTAB_FSTYPE
 
-# Modificar opciones de btrfs si existe partición raíz con subvolumen @
-if grep -q "subvol=@" /mnt/etc/fstab; then
-    echo -e "${CYAN}Optimizando opciones de btrfs en fstab...${NC}"
-    sed -i 's/subvol=@[^,]*/subvol=@,compress=zstd:3,space_cache=v2,autodefrag/' /mnt/etc/fstab
-    echo -e "${GREEN}✓ Opciones de btrfs optimizadas${NC}"
-fi
+# dispositivo real (/dev/sda2, /dev/dm-1...) → UUID y tipo, en una sola pasada
+while read -r kname fstype uuid; do
+    [ -n "$uuid" ] || continue
+    FSTAB_UUID[$kname]=$uuid
+    FSTAB_FSTYPE[$kname]=$fstype
+done < <(lsblk -rnpo KNAME,FSTYPE,UUID 2>/dev/null)
+
+# Opciones de montaje por sistema de archivos; $2 es la raíz del montaje dentro
+# del sistema de archivos (/@, /@home... en btrfs)
+_fstab_options() {
+    case "$1" in
+        ext4)  echo "$STORAGE_MOUNT_EXT4" ;;
+        xfs)   echo "$STORAGE_MOUNT_XFS" ;;
+        btrfs)
+            if [ "$2" != "/" ]; then
+                echo "${STORAGE_MOUNT_BTRFS},subvol=${2}"
+            else
+                echo "$STORAGE_MOUNT_BTRFS"
+            fi
+            ;;
+        vfat)  echo "umask=0077" ;;
+        *)     echo "defaults" ;;
+    esac
+}
+
+# fsck al arrancar: la raíz primero, el resto después; btrfs y xfs no lo usan
+_fstab_pass() {
+    case "$1" in
+        btrfs|xfs) echo 0 ;;
+        *) [ "$2" = "/" ] && echo 1 || echo 2 ;;
+    esac
+}
+
+FSTAB_TMP=$(mktemp)
+FSTAB_ERRORS=0
+echo "# /etc/fstab generado por Arcris (perfil de almacenamiento: ${STORAGE_CLASS:-genérico})" > "$FSTAB_TMP"
+echo "# <file system>  <dir>  <type>  <options>  <dump>  <pass>" >> "$FSTAB_TMP"
+
+# Montajes reales bajo /mnt en orden de montaje (padres antes que hijos); los
+# sistemas virtuales de setup_chroot_mounts no tienen dispositivo de bloques
+while read -r source target fstype fsroot; do
+    [ -b "$source" ] || continue
+    dev=$(readlink -f "$source")
+    uuid=${FSTAB_UUID[$dev]}
+    target=${target#/mnt}
+    target=${target:-/}
+    if [ -z "$uuid" ]; then
+        echo -e "${RED}ERROR: $source ($target) no tiene UUID${NC}"
+        FSTAB_ERRORS=1
+        continue
+    fi
+    printf '\n# %s\nUUID=%s\t%s\t%s\t%s\t0 %s\n' "$source" "$uuid" "$target" "$fstype" \
+        "$(_fstab_options "$fstype" "$fsroot")" "$(_fstab_pass "$fstype" "$target")" >> "$FSTAB_TMP"
+done < <(findmnt -rn -R --nofsroot -o SOURCE,TARGET,FSTYPE,FSROOT /mnt)
+
+# Swap en disco activado por config_disk.sh; prioridad 10, menor que zram (100).
+# swapon lista todos los del LiveCD (el del host, los de otras instalaciones en
+# paralelo): solo valen los que están en SELECTED_DISK o en el grupo LVM propio
+declare -A FSTAB_TARGET_DEVS=()
+while read -r source; do
+    FSTAB_TARGET_DEVS[$(readlink -f "$source")]=1
+done < <(lsblk -lnpo NAME "$SELECTED_DISK" 2>/dev/null)
+
+_fstab_target_swap() {
+    local dev="$1" dm_name
+
+    [ -n "${FSTAB_TARGET_DEVS[$dev]}" ] && return 0
+    dm_name=$(cat "/sys/class/block/${dev#/dev/}/dm/name" 2>/dev/null) || return 1
+    [[ "$dm_name" == "${LVM_VG_NAME}-"* ]]
+}
+
+while read -r source; do
+    [[ "$source" == /dev/zram* ]] && continue
+    dev=$(readlink -f "$source")
+    if ! _fstab_target_swap "$dev"; then
+        echo -e "${YELLOW}Swap $source ajeno a $SELECTED_DISK, no se agrega a fstab${NC}"
+        continue
+    fi
+    uuid=${FSTAB_UUID[$dev]}
+    if [ -z "$uuid" ] || [ "${FSTAB_FSTYPE[$dev]}" != "swap" ]; then
+        echo -e "${RED}ERROR: el swap $source no tiene UUID${NC}"
+        FSTAB_ERRORS=1
+        continue
+    fi
+    printf '\n# %s\nUUID=%s\tnone\tswap\tdefaults,pri=10\t0 0\n' "$source" "$uuid" >> "$FSTAB_TMP"
+done < <(swapon --show=NAME --noheadings --raw 2>/dev/null)
+
+mv "$FSTAB_TMP" /mnt/etc/fstab
+chmod 644 /mnt/etc/fstab
+echo -e "${CYAN}Opciones de montaje del perfil ${STORAGE_CLASS:-genérico} aplicadas en fstab${NC}"
 
-# Modificar prioridad del swap tradicional de -2 a 10 (menor que zram que tiene 100)
-if grep -q "swap" /mnt/etc/fstab; then
-    echo -e "${CYAN}Configurando prioridad del swap tradicional a 10...${NC}"
-    sed -i 's/\(.*swap.*defaults\)\(.*0.*0\)/\1,pri=10\2/' /mnt/etc/fstab
-    echo -e "${GREEN}✓ Prioridad del swap tradicional configurada a 10${NC}"
+# crypttab: una sola entrada para la partición LUKS (LVM está dentro)
+if [ "$ENCRYPTION" = "true" ]; then
+    # Sin el UUID de config_disk.sh se busca la partición LUKS solo en
+    # SELECTED_DISK: el LiveCD puede tener otras (el disco del host, otras
+    # instalaciones en paralelo)
+    if [ -z "$CRYPT_LUKS_UUID" ]; then
+        for dev in "${!FSTAB_TARGET_DEVS[@]}"; do
+            if [ "${FSTAB_FSTYPE[$dev]}" = "crypto_LUKS" ]; then
+                CRYPT_LUKS_UUID=${FSTAB_UUID[$dev]}
+                export CRYPT_LUKS_UUID
+                break
+            fi
+        done
+    fi
+    if [ -z "$CRYPT_LUKS_UUID" ]; then
+        echo -e "${RED}ERROR: no hay partición LUKS en $SELECTED_DISK para crypttab${NC}"
+        FSTAB_ERRORS=1
+    fi
+    CRYPTTAB_OPTIONS="luks,discard"
+    if [ "$STORAGE_LUKS_NO_WORKQUEUE" = "true" ]; then
+        CRYPTTAB_OPTIONS="$CRYPTTAB_OPTIONS,no-read-workqueue,no-write-workqueue"
+    fi
+    {
+        echo "# /etc/crypttab generado por Arcris"
+        echo "# <name>  <device>  <password>  <options>"
+        echo "${LUKS_MAPPER_NAME} UUID=${CRYPT_LUKS_UUID} none $CRYPTTAB_OPTIONS"
+    } > /mnt/etc/crypttab
+    echo -e "${GREEN}✓ crypttab configurado (UUID: $CRYPT_LUKS_UUID)${NC}"
 fi
 
 echo -e "${GREEN}✓ fstab generado correctamente${NC}"
 
 echo ""
-chroot /mnt /bin/bash -c "cat /etc/fstab"
+cat /mnt/etc/fstab
 
-# Verificación final de fstab antes de continuar
+# Verificación final: cada UUID de fstab y crypttab debe existir en
+# /dev/disk/by-uuid, que se lee una sola vez
 echo -e "${CYAN}Realizando verificación final de fstab...${NC}"
-FSTAB_ERRORS=0
+declare -A FSTAB_BY_UUID
+for link in /dev/disk/by-uuid/*; do
+    FSTAB_BY_UUID[${link##*/}]=1
+done
 
-# Verificar que todas las particiones swap en fstab existan
-while IFS= read -r line; do
-    if [[ "$line" =~ ^UUID=.*[[:space:]].*[[:space:]]swap ]]; then
-        SWAP_UUID=$(echo "$line" | grep -o 'UUID=[a-fA-F0-9-]*' | cut -d'=' -f2)
-        if [ -n "$SWAP_UUID" ] && ! blkid | grep -q "$SWAP_UUID"; then
-            echo -e "${RED}ERROR: UUID de swap $SWAP_UUID en fstab no existe en el sistema${NC}"
-            FSTAB_ERRORS=1
-        fi
-    elif [[ "$line" =~ ^/dev/.*[[:space:]].*[[:space:]]swap ]]; then
-        SWAP_DEVICE=$(echo "$line" | awk '{print $1}')
-        if [ -n "$SWAP_DEVICE" ] && [ ! -b "$SWAP_DEVICE" ]; then
-            echo -e "${RED}ERROR: Dispositivo swap $SWAP_DEVICE en fstab no existe${NC}"
-            FSTAB_ERRORS=1
-        fi
+if ! grep -q "^UUID=[^[:space:]]*[[:space:]]\+/[[:space:]]" /mnt/etc/fstab; then
+    echo -e "${RED}ERROR: fstab no contiene el sistema de archivos raíz${NC}"
+    FSTAB_ERRORS=1
+fi
+while read -r uuid; do
+    if [ -z "${FSTAB_BY_UUID[$uuid]}" ]; then
+        echo -e "${RED}ERROR: UUID $uuid en fstab/crypttab no existe en el sistema${NC}"
+        FSTAB_ERRORS=1
     fi
-done < /mnt/etc/fstab
+done < <(grep -ho '^[^#]*UUID=[a-fA-F0-9-]*' /mnt/etc/fstab /mnt/etc/crypttab 2>/dev/null | sed 's/.*UUID=//')
 
 if [ $FSTAB_ERRORS -eq 0 ]; then
     echo -e "${GREEN}✓ Verificación de fstab completada sin errores${NC}"
@@ -53,37 +169,15 @@ else
     echo -e "${CYAN}Presiona Enter para continuar o Ctrl+C para abortar...${NC}"
     read
 fi
+unset FSTAB_UUID FSTAB_FSTYPE FSTAB_BY_UUID
 
+sleep 3
+clear
 
-# Optimizaciones específicas para particionado manual con BTRFS
-if [ "$PARTITION_MODE" = "manual" ]; then
-    # Verificar si hay particiones btrfs configuradas
-    HAS_BTRFS=false
-    for partition_config in "${PARTITIONS[@]}"; do
-        IFS=' ' read -r device format mountpoint <<< "$partition_config"
-        if [ "$format" = "mkfs.btrfs" ] || [ "$format" = "btrfs" ]; then
-            HAS_BTRFS=true
-            break
-        fi
-    done
-
-    if [ "$HAS_BTRFS" = true ]; then
-        # Optimizar fstab para BTRFS
-        echo -e "${CYAN}Optimizando fstab para BTRFS...${NC}"
-        chroot /mnt /bin/bash -c "sed -i 's/relatime/noatime/g' /etc/fstab"
-
-        # Agregar opciones de montaje optimizadas para todos los subvolúmenes
-        chroot /mnt /bin/bash -c "sed -i 's/subvol=@/subvol=@,compress=zstd:3,space_cache=v2,autodefrag,/' /etc/fstab" 2>/dev/null || true
-
-        # Verificar configuración final de fstab
-        echo -e "${CYAN}Verificando configuración final de fstab...${NC}"
-        if chroot /mnt /bin/bash -c "mount -a --fake" 2>/dev/null; then
-            echo -e "${GREEN}✓ Configuración fstab válida${NC}"
-        else
-            echo -e "${YELLOW}Warning: Posibles issues en fstab, pero continuando...${NC}"
-        fi
-    fi
-fi
-
+# Actualización de mirrors en el sistema instalado
+cp /etc/pacman.d/mirrorlist /mnt/etc/pacman.d/mirrorlist
+#chroot /mnt /bin/bash -c "reflector --verbose --latest 6 --protocol https --sort rate --save /etc/pacman.d/mirrorlist"
+clear
+cat /mnt/etc/pacman.d/mirrorlist
 sleep 3
 clear
@@ -1,3 +1,15 @@
+# Asigna KEY="valor" en /mnt/etc/default/grub: reemplaza la línea (aunque
+# esté comentada) o la agrega si no existe. Con una imagen maestra el archivo
+# ya trae los valores del equipo donde se capturó, así que nada se agrega dos veces.
+_grub_default_set() {
+    local key="$1" value="$2" file=/mnt/etc/default/grub
+    if grep -q "^#\?${key}=" "$file"; then
+        sed -i "s|^#\?${key}=.*|${key}=\"${value}\"|" "$file"
+    else
+        echo "${key}=\"${value}\"" >> "$file"
+    fi
+}
+
 # Detectar tipo de firmware
 FIRMWARE_TYPE=$(detect_firmware)
 echo -e "${GREEN}| Firmware detectado: $FIRMWARE_TYPE |${NC}"
@@ -95,20 +107,20 @@ if true; then
                 exit 1
             fi
             echo -e "${GREEN}✓ UUID partición LUKS: ${CRYPT_LUKS_UUID}${NC}"
-            _grub_cmdline="cryptdevice=UUID=${CRYPT_LUKS_UUID}:cryptlvm root=/dev/vg0/root"
+            _grub_cmdline="cryptdevice=UUID=${CRYPT_LUKS_UUID}:${LUKS_MAPPER_NAME} root=/dev/${LVM_VG_NAME}/root"
             [ "$FILESYSTEM_TYPE" = "btrfs" ] && _grub_cmdline="$_grub_cmdline rootflags=subvol=@"
-            [ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && _grub_cmdline="$_grub_cmdline resume=/dev/vg0/swap"
+            [ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && _grub_cmdline="$_grub_cmdline resume=/dev/${LVM_VG_NAME}/swap"
             _grub_cmdline="$_grub_cmdline splash loglevel=3"
-            sed -i "s|GRUB_CMDLINE_LINUX=\"\"|GRUB_CMDLINE_LINUX=\"${_grub_cmdline}\"|" /mnt/etc/default/grub
-            echo "GRUB_ENABLE_CRYPTODISK=y" >> /mnt/etc/default/grub
-            echo "GRUB_PRELOAD_MODULES=\"part_gpt part_msdos lvm luks gcry_rijndael gcry_sha256 gcry_sha512\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_CMDLINE_LINUX "${_grub_cmdline}"
+            _grub_default_set GRUB_ENABLE_CRYPTODISK y
+            _grub_default_set GRUB_PRELOAD_MODULES "part_gpt part_msdos lvm luks gcry_rijndael gcry_sha256 gcry_sha512"
             sed -i 's/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=3 quiet"/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=5"/' /mnt/etc/default/grub
             echo -e "${GREEN}✓ Configuración GRUB UEFI para LUKS+LVM:${NC}"
             echo -e "${CYAN}  • ${_grub_cmdline}${NC}"
             echo -e "${CYAN}  • GRUB_ENABLE_CRYPTODISK=y${NC}"
         elif [ "$PARTITION_MODE" = "auto" ] && [ "$FILESYSTEM_TYPE" = "btrfs" ]; then
             sed -i 's/^GRUB_CMDLINE_LINUX_DEFAULT=.*/GRUB_CMDLINE_LINUX_DEFAULT=\"rootflags=subvol=@ loglevel=3\"/' /mnt/etc/default/grub
-            sed -i 's/^GRUB_PRELOAD_MODULES=.*/GRUB_PRELOAD_MODULES=\"part_gpt part_msdos btrfs\"/' /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "part_gpt part_msdos btrfs"
             echo -e "${GREEN}✓ Configuración GRUB UEFI simplificada para BTRFS${NC}"
         elif [ "$PARTITION_MODE" = "manual" ]; then
             echo -e "${CYAN}Configurando GRUB para particionado manual...${NC}"
@@ -159,7 +171,7 @@ if true; then
             GRUB_MODULES_LIST=$(echo "$GRUB_MODULES_LIST" | tr ' ' '\n' | sort -u | tr '\n' ' ' | sed 's/ $//')
 
             # Configurar GRUB_PRELOAD_MODULES
-            echo "GRUB_PRELOAD_MODULES=\"$GRUB_MODULES_LIST\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "$GRUB_MODULES_LIST"
 
             # Configurar GRUB_CMDLINE_LINUX_DEFAULT con rootflags si es necesario
             if [ -n "$ROOTFLAGS" ]; then
@@ -173,7 +185,7 @@ if true; then
             echo -e "${CYAN}  • Módulos GRUB configurados: ${GRUB_MODULES_LIST}${NC}"
         else
             sed -i 's/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=3 quiet"/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=5"/' /mnt/etc/default/grub
-            echo "GRUB_PRELOAD_MODULES=\"part_gpt part_msdos\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "part_gpt part_msdos"
         fi
 
         sleep 2
@@ -183,7 +195,7 @@ if true; then
 
         # Instalar GRUB en modo removible (crea /EFI/BOOT/bootx64.efi)
         echo -e "${CYAN}Instalando GRUB en modo removible...${NC}"
-        chroot /mnt /bin/bash -c "grub-install --target=x86_64-efi --efi-directory=/boot --removable --force --recheck" || {
+        chroot_run "grub-install --target=x86_64-efi --efi-directory=/boot --removable --force --recheck" || {
             echo -e "${RED}ERROR: Falló la instalación de GRUB UEFI (modo removible)${NC}"
             exit 1
         }
@@ -191,7 +203,7 @@ if true; then
 
         # Instalar GRUB con entrada NVRAM (crea /EFI/GRUB/grubx64.efi)
         echo -e "${CYAN}Instalando GRUB...${NC}"
-        chroot /mnt /bin/bash -c "grub-install --target=x86_64-efi --efi-directory=/boot --bootloader-id=GRUB --force --recheck" || {
+        chroot_run "grub-install --target=x86_64-efi --efi-directory=/boot --bootloader-id=GRUB --force --recheck" || {
             echo -e "${RED}ERROR: Falló la instalación de GRUB UEFI${NC}"
             exit 1
         }
@@ -211,7 +223,7 @@ if true; then
         echo -e "${GREEN}✓ Ambos bootloaders creados exitosamente${NC}"
 
         echo -e "${CYAN}Generando configuración de GRUB...${NC}"
-        if ! chroot /mnt /bin/bash -c "grub-mkconfig -o /boot/grub/grub.cfg"; then
+        if ! chroot_run "grub-mkconfig -o /boot/grub/grub.cfg"; then
             echo -e "${RED}ERROR: Falló la generación de grub.cfg${NC}"
             exit 1
         fi
@@ -235,21 +247,21 @@ if true; then
                 exit 1
             fi
             echo -e "${GREEN}✓ UUID partición LUKS: ${CRYPT_LUKS_UUID}${NC}"
-            _grub_cmdline="cryptdevice=UUID=${CRYPT_LUKS_UUID}:cryptlvm root=/dev/vg0/root"
+            _grub_cmdline="cryptdevice=UUID=${CRYPT_LUKS_UUID}:${LUKS_MAPPER_NAME} root=/dev/${LVM_VG_NAME}/root"
             [ "$FILESYSTEM_TYPE" = "btrfs" ] && _grub_cmdline="$_grub_cmdline rootflags=subvol=@"
-            [ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && _grub_cmdline="$_grub_cmdline resume=/dev/vg0/swap"
+            [ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && _grub_cmdline="$_grub_cmdline resume=/dev/${LVM_VG_NAME}/swap"
             _grub_cmdline="$_grub_cmdline splash loglevel=3"
-            sed -i "s|GRUB_CMDLINE_LINUX=\"\"|GRUB_CMDLINE_LINUX=\"${_grub_cmdline}\"|" /mnt/etc/default/grub
+            _grub_default_set GRUB_CMDLINE_LINUX "${_grub_cmdline}"
             sed -i 's/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=3 quiet"/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=3"/' /mnt/etc/default/grub
-            echo "GRUB_ENABLE_CRYPTODISK=y" >> /mnt/etc/default/grub
-            echo "GRUB_PRELOAD_MODULES=\"part_msdos lvm luks gcry_rijndael gcry_sha256 gcry_sha512\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_ENABLE_CRYPTODISK y
+            _grub_default_set GRUB_PRELOAD_MODULES "part_msdos lvm luks gcry_rijndael gcry_sha256 gcry_sha512"
             echo -e "${GREEN}✓ Configuración GRUB BIOS Legacy para LUKS+LVM:${NC}"
             echo -e "${CYAN}  • ${_grub_cmdline}${NC}"
             echo -e "${CYAN}  • GRUB_ENABLE_CRYPTODISK=y${NC}"
 
         elif [ "$PARTITION_MODE" = "auto" ] && [ "$FILESYSTEM_TYPE" = "btrfs" ]; then
             sed -i 's/^GRUB_CMDLINE_LINUX_DEFAULT=.*/GRUB_CMDLINE_LINUX_DEFAULT=\"rootflags=subvol=@ loglevel=3\"/' /mnt/etc/default/grub
-            sed -i 's/^GRUB_PRELOAD_MODULES=.*/GRUB_PRELOAD_MODULES=\"part_msdos btrfs\"/' /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "part_msdos btrfs"
             echo -e "${GREEN}✓ Configuración GRUB BIOS Legacy simplificada para BTRFS${NC}"
         elif [ "$PARTITION_MODE" = "manual" ]; then
             echo -e "${CYAN}Configurando GRUB BIOS para particionado manual...${NC}"
@@ -300,7 +312,7 @@ if true; then
             GRUB_MODULES_LIST=$(echo "$GRUB_MODULES_LIST" | tr ' ' '\n' | sort -u | tr '\n' ' ' | sed 's/ $//')
 
             # Configurar GRUB_PRELOAD_MODULES
-            echo "GRUB_PRELOAD_MODULES=\"$GRUB_MODULES_LIST\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "$GRUB_MODULES_LIST"
 
             # Configurar GRUB_CMDLINE_LINUX_DEFAULT con rootflags si es necesario
             if [ -n "$ROOTFLAGS" ]; then
@@ -314,13 +326,13 @@ if true; then
             echo -e "${CYAN}  • Módulos GRUB BIOS configurados: ${GRUB_MODULES_LIST}${NC}"
         else
             sed -i 's/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=3 quiet"/GRUB_CMDLINE_LINUX_DEFAULT="loglevel=5"/' /mnt/etc/default/grub
-            echo "GRUB_PRELOAD_MODULES=\"part_msdos\"" >> /mnt/etc/default/grub
+            _grub_default_set GRUB_PRELOAD_MODULES "part_msdos"
         fi
 
         sleep 4
 
         echo -e "${CYAN}Instalando GRUB en disco...${NC}"
-        if ! chroot /mnt /bin/bash -c "grub-install --target=i386-pc $SELECTED_DISK"; then
+        if ! chroot_run "grub-install --target=i386-pc $SELECTED_DISK"; then
             echo -e "${RED}ERROR: Falló la instalación de GRUB BIOS${NC}"
             exit 1
         fi
@@ -328,7 +340,7 @@ if true; then
         sleep 4
 
         echo -e "${CYAN}Generando configuración de GRUB...${NC}"
-        if ! chroot /mnt /bin/bash -c "grub-mkconfig -o /boot/grub/grub.cfg"; then
+        if ! chroot_run "grub-mkconfig -o /boot/grub/grub.cfg"; then
             echo -e "${RED}ERROR: Falló la generación de grub.cfg${NC}"
             exit 1
         fi
@@ -381,13 +393,6 @@ clear
 echo -e "${GREEN}| Detectando otros sistemas operativos |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
-# Instalar os-prober para detectar otros sistemas
-echo -e "${CYAN}Instalando os-prober...${NC}"
-install_pacman_chroot_with_retry "os-prober"
-install_pacman_chroot_with_retry "ntfs-3g"
-echo "GRUB_DISABLE_OS_PROBER=false" >> /mnt/etc/default/grub
-sleep 2
-clear
 
 # Detectar tipo de firmware y múltiples sistemas operativos
 echo -e "${CYAN}Detectando tipo de firmware y sistemas operativos...${NC}"
@@ -396,7 +401,20 @@ echo -e "${CYAN}Detectando tipo de firmware y sistemas operativos...${NC}"
 MULTIPLE_OS_DETECTED=false
 SYSTEM_TYPE=""
 
-if [ -d "/sys/firmware/efi" ]; then
+if [ -n "$OS_PROBER_NEEDED" ]; then
+    # La interfaz ya buscó otros sistemas con UDisks (tipos de partición,
+    # etiquetas y contenido de las ESP, montadas en solo lectura) y descartó
+    # el disco que se va a borrar; os-prober solo hace falta si encontró algo
+    [ -d "/sys/firmware/efi" ] && SYSTEM_TYPE="UEFI" || SYSTEM_TYPE="BIOS_Legacy"
+    read -ra EFI_PARTITIONS <<< "$OTHER_OS_ESPS"
+    MULTIPLE_OS_DETECTED=$OS_PROBER_NEEDED
+    if [ "$MULTIPLE_OS_DETECTED" = true ]; then
+        echo -e "${GREEN}✓ Detección previa ($SYSTEM_TYPE): ${OTHER_OS_FOUND}${NC}"
+    else
+        echo -e "${GREEN}✓ Detección previa ($SYSTEM_TYPE): no hay otros sistemas operativos${NC}"
+    fi
+
+elif [ -d "/sys/firmware/efi" ]; then
     SYSTEM_TYPE="UEFI"
     echo -e "${GREEN}✓ Sistema UEFI detectado${NC}"
 
@@ -497,6 +515,12 @@ fi
 if [ "$MULTIPLE_OS_DETECTED" = true ]; then
     echo -e "${GREEN}✓ ${#EFI_PARTITIONS[@]} particiones EFI detectadas - Iniciando detección de múltiples sistemas${NC}"
 
+    # Instalar os-prober para detectar otros sistemas
+    echo -e "${CYAN}Instalando os-prober...${NC}"
+    install_pacman_chroot_with_retry "os-prober"
+    install_pacman_chroot_with_retry "ntfs-3g"
+    _grub_default_set GRUB_DISABLE_OS_PROBER false
+
     # Crear directorio base de montaje temporal
     mkdir -p /mnt/mnt 2>/dev/null || true
     MOUNT_COUNTER=1
@@ -647,7 +671,7 @@ if [ "$MULTIPLE_OS_DETECTED" = true ]; then
 
         # Regenerar configuración de GRUB con los sistemas detectados
         echo -e "${CYAN}Regenerando configuración de GRUB con sistemas detectados...${NC}"
-        chroot /mnt /bin/bash -c "grub-mkconfig -o /boot/grub/grub.cfg"
+        chroot_run "grub-mkconfig -o /boot/grub/grub.cfg"
 
         # Verificar que se agregaron entradas
         GRUB_ENTRIES=$(chroot /mnt /bin/bash -c "grep -c 'menuentry' /boot/grub/grub.cfg" 2>/dev/null || echo "0")
@@ -0,0 +1,143 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Perfil de generación del initramfs
+#
+# INITRAMFS_PROFILE (ventana de kernels):
+#   default → configuración de mkinitcpio de Arch, un preset detrás de otro
+#   zstd    → zstd multihilo de nivel bajo: la imagen se genera antes
+#   lz4     → lz4: imagen algo mayor que se descomprime más rápido al arrancar
+# Con zstd y lz4 la imagen es solo para este equipo (hook autodetect) y los
+# presets de cada kernel se generan en paralelo.
+#
+# INITRAMFS_FALLBACK="false" quita la imagen fallback (la que no usa autodetect)
+# de los presets: una imagen menos que generar por kernel.
+#
+# Cada imagen queda en el diario de tiempos como "initramfs" con el tiempo de su
+# preset y su tamaño; el informe JSON las agrupa para comparar perfiles.
+# -----------------------------------------------------------------------------------
+
+INITRAMFS_PROFILE="${INITRAMFS_PROFILE:-default}"
+INITRAMFS_FALLBACK="${INITRAMFS_FALLBACK:-true}"
+
+case "$INITRAMFS_PROFILE" in
+    default|zstd|lz4) ;;
+    *)
+        echo -e "${YELLOW}Warning: INITRAMFS_PROFILE desconocido ($INITRAMFS_PROFILE); se usará default${NC}"
+        INITRAMFS_PROFILE="default"
+        ;;
+esac
+
+# Reemplaza KEY=... en mkinitcpio.conf (las variantes comentadas se dejan como están)
+initramfs_set_conf() {
+    local key="$1" value="$2" conf=/mnt/etc/mkinitcpio.conf
+    sed -i "/^${key}=/d" "$conf"
+    echo "${key}=${value}" >> "$conf"
+}
+
+# Aplica el perfil a mkinitcpio.conf y a los presets; se llama después de
+# fijar HOOKS y MODULES
+initramfs_configure() {
+    local preset
+
+    case "$INITRAMFS_PROFILE" in
+        zstd)
+            initramfs_set_conf COMPRESSION '"zstd"'
+            initramfs_set_conf COMPRESSION_OPTIONS '(-1 -T0)'
+            ;;
+        lz4)
+            initramfs_set_conf COMPRESSION '"lz4"'
+            initramfs_set_conf COMPRESSION_OPTIONS '()'
+            ;;
+    esac
+
+    # Imagen solo para este equipo: autodetect deja los módulos del hardware presente
+    if [ "$INITRAMFS_PROFILE" != "default" ] && ! grep -q '^HOOKS=.*autodetect' /mnt/etc/mkinitcpio.conf; then
+        sed -i '/^HOOKS=/s/udev/udev autodetect/' /mnt/etc/mkinitcpio.conf
+    fi
+
+    if [ "$INITRAMFS_FALLBACK" = "false" ]; then
+        for preset in /mnt/etc/mkinitcpio.d/*.preset; do
+            [ -f "$preset" ] || continue
+            sed -i "s/^PRESETS=.*/PRESETS=('default')/" "$preset"
+        done
+        # Las que dejó pacstrap al instalar el kernel
+        rm -f /mnt/boot/initramfs-*-fallback.img
+    fi
+
+    echo -e "${CYAN}  • Perfil de initramfs: ${INITRAMFS_PROFILE} (fallback: ${INITRAMFS_FALLBACK})${NC}"
+}
+
+# Rutas (dentro del chroot) de las imágenes que genera un preset
+initramfs_preset_images() {
+    (
+        # shellcheck disable=SC1090
+        source "/mnt/etc/mkinitcpio.d/$1.preset" 2>/dev/null || exit 0
+        local name uki image
+        for name in "${PRESETS[@]}"; do
+            uki="${name}_uki"
+            image="${name}_image"
+            if [ -n "${!uki}" ]; then
+                echo "${!uki}"
+            elif [ -n "${!image}" ]; then
+                echo "${!image}"
+            fi
+        done
+    )
+}
+
+# Genera un preset y registra el tiempo y el tamaño de cada imagen
+initramfs_build_preset() {
+    local name="$1" start rc image size status=ok
+
+    timing_now
+    start=$TIMING_NOW
+    chroot_run "mkinitcpio -p $name"
+    rc=$?
+    timing_now
+    [ $rc -eq 0 ] || status=failed
+
+    for image in $(initramfs_preset_images "$name"); do
+        size=$(stat -c %s "/mnt${image}" 2>/dev/null || echo 0)
+        timing_record initramfs "${name}:${image##*/}" "$start" $(( TIMING_NOW - start )) "$size" 0 0 "$status"
+        echo -e "${CYAN}  • ${image##*/}: $(( size / 1024 )) KiB en $(( (TIMING_NOW - start) / 1000 )) s${NC}"
+    done
+    return $rc
+}
+
+# Genera las imágenes de todos los kernels instalados (sustituye a mkinitcpio -P).
+# Con un perfil rápido cada preset corre en su propio proceso y su salida se
+# muestra entera al terminar, sin mezclar líneas. Devuelve el número de fallos.
+initramfs_build() {
+    local presets=() preset i failed=0
+
+    for preset in /mnt/etc/mkinitcpio.d/*.preset; do
+        [ -f "$preset" ] && presets+=("$(basename "$preset" .preset)")
+    done
+    if [ ${#presets[@]} -eq 0 ]; then
+        echo -e "${RED}ERROR: No hay presets de mkinitcpio en /mnt/etc/mkinitcpio.d${NC}"
+        return 1
+    fi
+
+    if [ "$INITRAMFS_PROFILE" = "default" ] || [ ${#presets[@]} -eq 1 ]; then
+        for preset in "${presets[@]}"; do
+            initramfs_build_preset "$preset" || failed=$(( failed + 1 ))
+        done
+        return $failed
+    fi
+
+    # En segundo plano chroot_run no usa el agente sino un chroot propio
+    local pids=() logs=()
+    for preset in "${presets[@]}"; do
+        logs+=("$(mktemp /tmp/arcris-initramfs-XXXXXX.log)")
+        initramfs_build_preset "$preset" > "${logs[-1]}" 2>&1 &
+        pids+=($!)
+    done
+    echo -e "${CYAN}  • Generando ${#presets[@]} presets en paralelo: ${presets[*]}${NC}"
+
+    for i in "${!pids[@]}"; do
+        wait "${pids[$i]}" || failed=$(( failed + 1 ))
+        cat "${logs[$i]}"
+        rm -f "${logs[$i]}"
+    done
+    return $failed
+}
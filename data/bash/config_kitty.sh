@@ -235,5 +235,5 @@ map kitty_mod+e combine : clear_terminal scroll active : send_text normal,applic
 EOF
 
         # Establecer permisos correctos para las configuraciones
-        chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config/kitty"
+        chroot_run "chown -R $USER:$USER /home/$USER/.config/kitty"
 fi
@@ -0,0 +1,77 @@
+# -----------------------------------------------------------------------------------
+# Perfil de rendimiento del sistema instalado
+#
+# Aplica los valores PERF_* que Arcris calcula para PERFORMANCE_PROFILE (balanced,
+# throughput, desktop o server) según la CPU, la RAM, la red, el disco y el driver
+# de video de este equipo:
+#   • reglas udev con el planificador de E/S por clase de dispositivo
+#   • gobernador de frecuencia y EPP de la CPU (tmpfiles.d, en cada arranque)
+#   • vm.dirty_* y búferes de red (sysctl.d)
+# -----------------------------------------------------------------------------------
+
+echo -e "${GREEN}| Aplicando perfil de rendimiento: ${PERFORMANCE_PROFILE:-balanced} |${NC}"
+printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+echo ""
+
+if [ -z "$PERF_SCHED_NVME" ]; then
+    echo -e "${YELLOW}  • Sin valores PERF_* en variables.sh, se mantienen los de la distribución${NC}"
+    return 0 2>/dev/null || exit 0
+fi
+
+mkdir -p /mnt/etc/udev/rules.d /mnt/etc/tmpfiles.d /mnt/etc/sysctl.d /mnt/etc/modules-load.d
+
+# Planificador de E/S: solo discos completos (las particiones no tienen queue/)
+cat > /mnt/etc/udev/rules.d/60-ioschedulers.rules << EOF
+# Perfil de rendimiento de Arcris: ${PERFORMANCE_PROFILE}
+# NVMe
+ACTION=="add|change", KERNEL=="nvme[0-9]*n[0-9]*", ENV{DEVTYPE}=="disk", ATTR{queue/scheduler}="${PERF_SCHED_NVME}"
+# SSD SATA y eMMC
+ACTION=="add|change", KERNEL=="sd[a-z]*|mmcblk[0-9]*", ENV{DEVTYPE}=="disk", ATTR{queue/rotational}=="0", ATTR{queue/scheduler}="${PERF_SCHED_SSD}"
+# Discos mecánicos
+ACTION=="add|change", KERNEL=="sd[a-z]*", ENV{DEVTYPE}=="disk", ATTR{queue/rotational}=="1", ATTR{queue/scheduler}="${PERF_SCHED_HDD}"
+# Discos virtio: la cola la gestiona el anfitrión
+ACTION=="add|change", KERNEL=="vd[a-z]*", ENV{DEVTYPE}=="disk", ATTR{queue/scheduler}="none"
+EOF
+echo -e "${CYAN}  • E/S: NVMe ${PERF_SCHED_NVME}, SSD ${PERF_SCHED_SSD}, HDD ${PERF_SCHED_HDD}${NC}"
+
+# Gobernador y EPP: el EPP se escribe después del gobernador porque con
+# "performance" el driver lo ignora
+if [ -n "$PERF_GOVERNOR" ]; then
+    {
+        echo "# Perfil de rendimiento de Arcris: ${PERFORMANCE_PROFILE}"
+        echo "w /sys/devices/system/cpu/cpu*/cpufreq/scaling_governor - - - - ${PERF_GOVERNOR}"
+        if [ -n "$PERF_EPP" ]; then
+            echo "w /sys/devices/system/cpu/cpu*/cpufreq/energy_performance_preference - - - - ${PERF_EPP}"
+        fi
+    } > /mnt/etc/tmpfiles.d/arcris-cpufreq.conf
+    echo -e "${CYAN}  • CPU: gobernador ${PERF_GOVERNOR}${PERF_EPP:+, EPP ${PERF_EPP}}${NC}"
+else
+    rm -f /mnt/etc/tmpfiles.d/arcris-cpufreq.conf
+    echo -e "${CYAN}  • CPU: sin cpufreq (máquina virtual o sin driver), se mantiene el predeterminado${NC}"
+fi
+
+{
+    echo "# Perfil de rendimiento de Arcris: ${PERFORMANCE_PROFILE}"
+    echo "vm.dirty_background_bytes = ${PERF_DIRTY_BACKGROUND_BYTES}"
+    echo "vm.dirty_bytes = ${PERF_DIRTY_BYTES}"
+    echo "vm.dirty_expire_centisecs = ${PERF_DIRTY_EXPIRE_CENTISECS}"
+    echo "net.core.rmem_max = ${PERF_NET_BUFFER_MAX}"
+    echo "net.core.wmem_max = ${PERF_NET_BUFFER_MAX}"
+    echo "net.ipv4.tcp_rmem = 4096 131072 ${PERF_NET_BUFFER_MAX}"
+    echo "net.ipv4.tcp_wmem = 4096 16384 ${PERF_NET_BUFFER_MAX}"
+    if [ "$PERF_NET_BBR" = "true" ]; then
+        echo "net.core.default_qdisc = fq"
+        echo "net.ipv4.tcp_congestion_control = bbr"
+    fi
+} > /mnt/etc/sysctl.d/90-arcris-performance.conf
+echo -e "${CYAN}  • vm.dirty: $((PERF_DIRTY_BACKGROUND_BYTES / 1048576))/$((PERF_DIRTY_BYTES / 1048576)) MiB, red: $((PERF_NET_BUFFER_MAX / 1048576)) MiB$([ "$PERF_NET_BBR" = "true" ] && echo " con fq + BBR")${NC}"
+
+# BBR es un módulo: cargarlo en el arranque para que el sysctl lo encuentre
+if [ "$PERF_NET_BBR" = "true" ]; then
+    echo "tcp_bbr" > /mnt/etc/modules-load.d/arcris-bbr.conf
+fi
+
+echo -e "${GREEN}✓ Perfil de rendimiento aplicado${NC}"
+# ------------------------------------------------------------------------------------------------------------------
+sleep 2
+clear
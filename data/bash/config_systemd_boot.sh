@@ -0,0 +1,195 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Arranque rápido: systemd-boot con imágenes de kernel unificadas (UKI)
+#
+# Con BOOTLOADER="systemd-boot" en un equipo UEFI, mkinitcpio genera una sola UKI
+# por kernel instalado en /boot/EFI/Linux (kernel, initramfs, microcódigo y línea
+# de comandos en un único ejecutable EFI) que systemd-boot detecta sin archivos de
+# entrada. No hay imagen fallback, grub-mkconfig ni os-prober: el firmware carga
+# el cargador y éste la UKI. En BIOS Legacy se usa GRUB como siempre.
+#
+# También instala el servicio de primer arranque que añade al informe de la
+# instalación los tiempos medidos por systemd (firmware → espacio de usuario).
+# -----------------------------------------------------------------------------------
+
+SDBOOT_UKI_DIR="/boot/EFI/Linux"
+
+if [ "${BOOTLOADER:-grub}" = "systemd-boot" ] && [ ! -d /sys/firmware/efi ]; then
+    echo -e "${YELLOW}Warning: systemd-boot requiere UEFI; se usará GRUB${NC}"
+    BOOTLOADER="grub"
+fi
+
+# Devuelve 0 si la instalación usa systemd-boot
+sdboot_enabled() {
+    [ "${BOOTLOADER:-grub}" = "systemd-boot" ]
+}
+
+# Línea de comandos del kernel: mismos parámetros que config_grub.sh escribe en
+# GRUB_CMDLINE_LINUX, pero con root= explícito porque no hay grub-mkconfig
+sdboot_kernel_cmdline() {
+    local cmdline partition_config device format mountpoint
+
+    if [ "$ENCRYPTION" = "true" ]; then
+        cmdline="cryptdevice=UUID=${CRYPT_LUKS_UUID}:${LUKS_MAPPER_NAME} root=/dev/${LVM_VG_NAME}/root"
+        [ "$FILESYSTEM_TYPE" = "btrfs" ] && cmdline="$cmdline rootflags=subvol=@"
+        [ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && cmdline="$cmdline resume=/dev/${LVM_VG_NAME}/swap"
+        cmdline="$cmdline rw splash loglevel=3"
+    else
+        cmdline="root=UUID=$(findmnt -no UUID /mnt) rw"
+        if [ "$PARTITION_MODE" = "auto" ] && [ "$FILESYSTEM_TYPE" = "btrfs" ]; then
+            cmdline="$cmdline rootflags=subvol=@"
+        elif [ "$PARTITION_MODE" = "manual" ]; then
+            for partition_config in "${PARTITIONS[@]}"; do
+                IFS=' ' read -r device format mountpoint <<< "$partition_config"
+                if [ "$format" = "mkfs.btrfs" ] && [ "$mountpoint" = "/" ]; then
+                    cmdline="$cmdline rootflags=subvol=@"
+                fi
+            done
+        fi
+        cmdline="$cmdline loglevel=3 quiet"
+    fi
+
+    # config_zram.sh deshabilita zswap en GRUB; con UKI va en la misma línea
+    [ -f /mnt/etc/systemd/zram-generator.conf ] && cmdline="zswap.enabled=0 $cmdline"
+    echo "$cmdline"
+}
+
+# Ajusta mkinitcpio para generar UKI: se llama tras configurar HOOKS/MODULES y
+# sustituye a initramfs_build en la etapa mkinitcpio (la generación real ocurre
+# una sola vez en sdboot_install, cuando la línea de comandos ya está completa)
+sdboot_prepare_mkinitcpio() {
+    local preset kernel
+
+    # El microcódigo va dentro de la UKI mediante el hook microcode
+    sed -i '/^HOOKS=/{/microcode/!s/autodetect/autodetect microcode/}' /mnt/etc/mkinitcpio.conf
+
+    for preset in /mnt/etc/mkinitcpio.d/*.preset; do
+        [ -f "$preset" ] || continue
+        kernel=$(basename "$preset" .preset)
+        cat > "$preset" << EOF
+# mkinitcpio preset para '${kernel}': una UKI por kernel (Arcris, systemd-boot)
+ALL_kver="/boot/vmlinuz-${kernel}"
+PRESETS=('default')
+default_uki="${SDBOOT_UKI_DIR}/arch-${kernel}.efi"
+EOF
+        echo -e "${CYAN}  • ${kernel} → ${SDBOOT_UKI_DIR}/arch-${kernel}.efi${NC}"
+    done
+    echo -e "${GREEN}✓ mkinitcpio configurado para imágenes unificadas (UKI)${NC}"
+}
+
+# Instala systemd-boot en la ESP montada en /mnt/boot y genera las UKI
+sdboot_install() {
+    local loader_timeout=0
+
+    echo -e "${GREEN}| Instalando systemd-boot con UKI |${NC}"
+    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+    echo ""
+
+    if ! mountpoint -q /mnt/boot; then
+        echo -e "${RED}ERROR: Partición EFI no está montada en /mnt/boot${NC}"
+        exit 1
+    fi
+    if [ "$ENCRYPTION" = "true" ] && [ -z "$CRYPT_LUKS_UUID" ]; then
+        echo -e "${RED}ERROR: CRYPT_LUKS_UUID no disponible${NC}"
+        exit 1
+    fi
+
+    mkdir -p /mnt/etc/kernel "/mnt${SDBOOT_UKI_DIR}"
+    sdboot_kernel_cmdline > /mnt/etc/kernel/cmdline
+    echo -e "${CYAN}  • Línea de comandos: $(cat /mnt/etc/kernel/cmdline)${NC}"
+
+    echo -e "${CYAN}Generando imágenes unificadas del kernel...${NC}"
+    if ! initramfs_build; then
+        echo -e "${RED}ERROR: No se pudieron generar las UKI${NC}"
+        exit 1
+    fi
+    # Los initramfs sueltos que dejó pacstrap ya no se usan
+    rm -f /mnt/boot/initramfs-*.img
+    echo -e "${GREEN}✓ UKI generadas en ${SDBOOT_UKI_DIR}${NC}"
+
+    if ! chroot_run "bootctl install --esp-path=/boot"; then
+        echo -e "${RED}ERROR: Falló la instalación de systemd-boot${NC}"
+        exit 1
+    fi
+
+    # Sin menú salvo que Windows comparta la ESP (mantener Espacio lo muestra)
+    [ -d /mnt/boot/EFI/Microsoft ] && loader_timeout=3
+    cat > /mnt/boot/loader/loader.conf << EOF
+default arch-${SELECTED_KERNEL}.efi
+timeout ${loader_timeout}
+console-mode keep
+editor no
+EOF
+    chroot_run "systemctl enable systemd-boot-update.service 2>/dev/null" || true
+
+    echo -e "${GREEN}✓ systemd-boot instalado (entrada por defecto: arch-${SELECTED_KERNEL}.efi)${NC}"
+}
+
+# Servicio de un solo uso: en el primer arranque espera a que termine el boot y
+# añade "first_boot" a /var/log/arcris-install-report.json con los tiempos que
+# systemd-analyze calcula (firmware y cargador solo con systemd-boot)
+boot_report_install() {
+    cat > /mnt/usr/local/bin/arcris-boot-report << 'BOOTREPORT'
+#!/bin/bash
+REPORT=/var/log/arcris-install-report.json
+STAMP=/var/lib/arcris/boot-report-done
+
+# FinishTimestamp solo existe cuando el arranque terminó
+systemctl is-system-running --wait >/dev/null 2>&1
+
+declare -A ts
+while IFS='=' read -r key value; do
+    ts[$key]=$value
+done < <(systemctl show -p FirmwareTimestampMonotonic -p LoaderTimestampMonotonic \
+    -p InitRDTimestampMonotonic -p UserspaceTimestampMonotonic -p FinishTimestampMonotonic)
+
+firmware=${ts[FirmwareTimestampMonotonic]:-0}
+loader=${ts[LoaderTimestampMonotonic]:-0}
+initrd=${ts[InitRDTimestampMonotonic]:-0}
+userspace=${ts[UserspaceTimestampMonotonic]:-0}
+finish=${ts[FinishTimestampMonotonic]:-0}
+kernel_end=$(( initrd > 0 ? initrd : userspace ))
+initrd_ms=$(( initrd > 0 ? (userspace - initrd) / 1000 : 0 ))
+summary=$(systemd-analyze time 2>/dev/null | head -n1 | sed 's/\\/\\\\/g; s/"/\\"/g')
+
+if [ -f "$REPORT" ]; then
+    # Quitar la llave final del JSON y añadir el bloque first_boot
+    sed -i '$ d' "$REPORT"
+    sed -i '$ s/$/,/' "$REPORT"
+    cat >> "$REPORT" << EOF
+  "first_boot": {
+    "firmware_ms": $(( (firmware - loader) / 1000 )),
+    "loader_ms": $(( loader / 1000 )),
+    "kernel_ms": $(( kernel_end / 1000 )),
+    "initrd_ms": ${initrd_ms},
+    "userspace_ms": $(( (finish - userspace) / 1000 )),
+    "firmware_to_userspace_ms": $(( (firmware + userspace) / 1000 )),
+    "total_ms": $(( (firmware + finish) / 1000 )),
+    "summary": "${summary}"
+  }
+}
+EOF
+fi
+
+mkdir -p "$(dirname "$STAMP")"
+touch "$STAMP"
+systemctl disable arcris-boot-report.service >/dev/null 2>&1
+BOOTREPORT
+    chmod +x /mnt/usr/local/bin/arcris-boot-report
+
+    cat > /mnt/etc/systemd/system/arcris-boot-report.service << 'BOOTREPORTUNIT'
+[Unit]
+Description=Arcris: tiempos del primer arranque en el informe de instalación
+ConditionPathExists=!/var/lib/arcris/boot-report-done
+
+[Service]
+# simple y no oneshot: el arranque debe poder terminar mientras espera
+Type=simple
+ExecStart=/usr/local/bin/arcris-boot-report
+
+[Install]
+WantedBy=multi-user.target
+BOOTREPORTUNIT
+    chroot_run "systemctl enable arcris-boot-report.service 2>/dev/null" || true
+    echo -e "${GREEN}✓ Informe de tiempos del primer arranque programado${NC}"
+}
@@ -213,7 +213,7 @@ fi
 
 # 10. Establecer permisos correctos
 echo -e "${CYAN}10. Estableciendo permisos correctos...${NC}"
-if chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER" 2>/dev/null; then
+if chroot_run "chown -R $USER:$USER /home/$USER 2>/dev/null"; then
     echo -e "${GREEN}  ✓ Permisos del directorio home establecidos${NC}"
 else
     echo -e "${YELLOW}  ⚠ Warning: No se pudieron establecer permisos del home${NC}"
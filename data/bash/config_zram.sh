@@ -1,101 +1,164 @@
 # -----------------------------------------------------------------------------------
+# Ajuste adaptativo de zram y swap
+#
+# El algoritmo de compresión se elige con una prueba rápida en el propio equipo:
+# se crean dispositivos zram temporales con lz4 y zstd, se escribe una muestra de
+# bibliotecas del sistema (parecida a la memoria de un escritorio) y se mide la
+# velocidad de compresión, de descompresión y la relación obtenida. A partir de
+# eso, la RAM, los núcleos, SWAP_TYPE y el tipo de disco (STORAGE_CLASS) se
+# calculan el tamaño de zram, vm.swappiness, vm.page-cluster y la prioridad del
+# swap en disco, y se escriben zram-generator.conf y el drop-in de sysctl.
+# -----------------------------------------------------------------------------------
+
+ZRAM_BENCH_MB=64
+ZRAM_BENCH_SAMPLE="${ARCRIS_TMP_DIR:-/tmp}/arcris-zram-sample"
+
+# Mide un algoritmo en un zram temporal; imprime "escritura_MiB/s lectura_MiB/s ratio×100"
+_zram_benchmark() {
+    local algo=$1 id dev start end write_us read_us orig compr
+
+    [ -e /sys/class/zram-control/hot_add ] || modprobe zram num_devices=0 2>/dev/null
+    [ -e /sys/class/zram-control/hot_add ] || return 1
+    id=$(cat /sys/class/zram-control/hot_add 2>/dev/null) || return 1
+    dev="/sys/block/zram${id}"
+
+    if ! grep -qw "$algo" "$dev/comp_algorithm" 2>/dev/null ||
+       ! echo "$algo" > "$dev/comp_algorithm" ||
+       ! echo "$((ZRAM_BENCH_MB * 2))M" > "$dev/disksize"; then
+        echo "$id" > /sys/class/zram-control/hot_remove 2>/dev/null
+        return 1
+    fi
+
+    start=${EPOCHREALTIME/[.,]/}
+    dd if="$ZRAM_BENCH_SAMPLE" of="/dev/zram${id}" bs=1M oflag=direct status=none
+    end=${EPOCHREALTIME/[.,]/}
+    write_us=$(( end - start ))
+    read -r orig compr _ < "$dev/mm_stat"
+
+    start=${EPOCHREALTIME/[.,]/}
+    dd if="/dev/zram${id}" of=/dev/null bs=1M count="$ZRAM_BENCH_MB" iflag=direct status=none
+    end=${EPOCHREALTIME/[.,]/}
+    read_us=$(( end - start ))
+
+    echo 1 > "$dev/reset"
+    echo "$id" > /sys/class/zram-control/hot_remove 2>/dev/null
+
+    [ "${compr:-0}" -gt 0 ] && [ "$write_us" -gt 0 ] && [ "$read_us" -gt 0 ] || return 1
+    echo "$(( ZRAM_BENCH_MB * 1000000 / write_us )) $(( ZRAM_BENCH_MB * 1000000 / read_us )) $(( orig * 100 / compr ))"
+}
 
-# Configuración oficial de zram usando zram-generator
-echo -e "${GREEN}| Configurando zram oficial con zram-generator |${NC}"
+echo -e "${GREEN}| Configurando zram con ajuste adaptativo |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
 
-# Detectar RAM total del sistema
+# Si no hay swap de ningún tipo, salir sin configurar nada
+if [ "$SWAP_TYPE" = "none" ]; then
+    echo -e "${CYAN}  • SWAP_TYPE=none: sin zram ni swap${NC}"
+    return 0 2>/dev/null || exit 0
+fi
+
 TOTAL_RAM_KB=$(grep MemTotal /proc/meminfo | awk '{print $2}')
 TOTAL_RAM_MB=$((TOTAL_RAM_KB / 1024))
-TOTAL_RAM_GB=$((TOTAL_RAM_MB / 1024))
+CPU_CORES=$(nproc 2>/dev/null || echo 1)
+echo -e "${CYAN}  • RAM total: ${TOTAL_RAM_MB}MB, núcleos: ${CPU_CORES}, SWAP_TYPE: ${SWAP_TYPE}${NC}"
+
+# Muestra en tmpfs para que la prueba no dependa del disco
+cat /usr/lib/*.so* 2>/dev/null | head -c "$((ZRAM_BENCH_MB * 1024 * 1024))" > "$ZRAM_BENCH_SAMPLE"
+read -r LZ4_WRITE LZ4_READ LZ4_RATIO <<< "$(_zram_benchmark lz4)"
+read -r ZSTD_WRITE ZSTD_READ ZSTD_RATIO <<< "$(_zram_benchmark zstd)"
+rm -f "$ZRAM_BENCH_SAMPLE"
 
-# Redondear al GB superior si la fracción >= 512MB (≥ 0.5G) y la RAM total >= 3584MB (3.5G)
-RAM_REMAINDER=$((TOTAL_RAM_MB % 1024))
-if [ $TOTAL_RAM_MB -ge 3584 ] && [ $RAM_REMAINDER -ge 512 ]; then
-    TOTAL_RAM_MB=$(( (TOTAL_RAM_GB + 1) * 1024 ))
-    echo -e "${CYAN}  • RAM redondeada a $((TOTAL_RAM_MB / 1024))G (fracción >= 0.5G)${NC}"
+[ -n "$LZ4_RATIO" ] && echo -e "${CYAN}  • lz4:  ${LZ4_WRITE} MiB/s compresión, ${LZ4_READ} MiB/s descompresión, ratio $((LZ4_RATIO / 100)).$((LZ4_RATIO % 100 / 10))${NC}"
+[ -n "$ZSTD_RATIO" ] && echo -e "${CYAN}  • zstd: ${ZSTD_WRITE} MiB/s compresión, ${ZSTD_READ} MiB/s descompresión, ratio $((ZSTD_RATIO / 100)).$((ZSTD_RATIO % 100 / 10))${NC}"
+
+# Algoritmo: zstd cuando la CPU lo comprime lo bastante rápido (≥ 400 MiB/s por
+# núcleo) o cuando la RAM es escasa y su ratio compensa; si no, lz4
+if [ -z "$ZSTD_RATIO" ] && [ -z "$LZ4_RATIO" ]; then
+    echo -e "${YELLOW}  • Prueba de compresión no disponible, usando zstd${NC}"
+    ZRAM_ALGORITHM="zstd"; ZRAM_RATIO=250; ZRAM_READ=1000
+elif [ -z "$ZSTD_RATIO" ]; then
+    ZRAM_ALGORITHM="lz4"; ZRAM_RATIO=$LZ4_RATIO; ZRAM_READ=$LZ4_READ
+elif [ -z "$LZ4_RATIO" ] || [ "$ZSTD_WRITE" -ge 400 ] ||
+     { [ "$TOTAL_RAM_MB" -le 4096 ] && [ "$ZSTD_WRITE" -ge 150 ] &&
+       [ $(( ZSTD_RATIO * 100 / LZ4_RATIO )) -ge 115 ]; }; then
+    ZRAM_ALGORITHM="zstd"; ZRAM_RATIO=$ZSTD_RATIO; ZRAM_READ=$ZSTD_READ
+else
+    ZRAM_ALGORITHM="lz4"; ZRAM_RATIO=$LZ4_RATIO; ZRAM_READ=$LZ4_READ
 fi
 
-# Si no hay swap de ningún tipo, salir sin configurar nada
-if [ "$SWAP_TYPE" = "none" ]; then
-    echo -e "${CYAN}  • SWAP_TYPE=none: sin zram ni swap${NC}"
-    return 0 2>/dev/null || exit 0
+# Tamaño: la memoria que ocuparía zram lleno es la mitad de la RAM sin swap en
+# disco y un cuarto con él (el disco absorbe el resto); el tamaño declarado es
+# esa cantidad por el ratio medido, entre RAM/4 y 2×RAM (solo zram) o RAM
+if [ "$SWAP_TYPE" = "zram" ]; then
+    ZRAM_SIZE_MB=$(( TOTAL_RAM_MB / 2 * ZRAM_RATIO / 100 ))
+    ZRAM_MAX_MB=$(( TOTAL_RAM_MB * 2 ))
+else
+    ZRAM_SIZE_MB=$(( TOTAL_RAM_MB / 4 * ZRAM_RATIO / 100 ))
+    ZRAM_MAX_MB=$TOTAL_RAM_MB
 fi
+[ "$ZRAM_SIZE_MB" -gt "$ZRAM_MAX_MB" ] && ZRAM_SIZE_MB=$ZRAM_MAX_MB
+[ "$ZRAM_SIZE_MB" -lt $(( TOTAL_RAM_MB / 4 )) ] && ZRAM_SIZE_MB=$(( TOTAL_RAM_MB / 4 ))
 
-# Calcular tamaño de zram según SWAP_TYPE (misma regla que la partición en disco)
-case "$SWAP_TYPE" in
-    "zram")
-        # Solo zram, sin disco → 50% de RAM
-        ZRAM_SIZE_MB=$((TOTAL_RAM_MB / 2))
-        ;;
-    "half")
-        # Zram + disco de mitad RAM → zram también es mitad de RAM
-        ZRAM_SIZE_MB=$((TOTAL_RAM_MB / 2))
-        ;;
-    "equal")
-        # Zram + disco igual a RAM → zram igual a RAM
-        ZRAM_SIZE_MB=$TOTAL_RAM_MB
-        ;;
-    "custom")
-        # Zram + disco de tamaño custom → zram del mismo tamaño custom
-        ZRAM_SIZE_MB=$(( SWAP_CUSTOM_SIZE * 1024 ))
-        ;;
-    *)
-        ZRAM_SIZE_MB=$((TOTAL_RAM_MB / 2))
-        ;;
-esac
-
-ZRAM_SIZE_GB=$((ZRAM_SIZE_MB / 1024))
-
-echo -e "${CYAN}  • RAM total: ${TOTAL_RAM_GB}GB (${TOTAL_RAM_MB}MB)${NC}"
-echo -e "${CYAN}  • SWAP_TYPE: ${SWAP_TYPE}${NC}"
-echo -e "${CYAN}  • zram calculado: ${ZRAM_SIZE_GB}GB (${ZRAM_SIZE_MB}MB)${NC}"
-echo ""
+# vm.swappiness / vm.page-cluster / prioridad del swap en disco:
+#   solo zram        → 180 (150 si descomprimir es lento), sin lectura anticipada
+#   zram + SSD/NVMe  → 100, page-cluster 0, disco con prioridad 50
+#   zram + HDD       → 60, page-cluster 2 (agrupa lecturas cuando se llega al disco), prioridad 10
+DISK_SWAP_PRIORITY=""
+VM_PAGE_CLUSTER=0
+if [ "$SWAP_TYPE" = "zram" ]; then
+    if [ "$ZRAM_READ" -ge 1000 ]; then
+        VM_SWAPPINESS=180
+    else
+        VM_SWAPPINESS=150
+    fi
+elif [ "$STORAGE_CLASS" = "hdd" ]; then
+    VM_SWAPPINESS=60
+    VM_PAGE_CLUSTER=2
+    DISK_SWAP_PRIORITY=10
+else
+    VM_SWAPPINESS=100
+    DISK_SWAP_PRIORITY=50
+fi
 
 # Instalar zram-generator (método oficial)
 install_pacman_chroot_with_retry "zram-generator"
 
-# Crear configuración oficial de zram-generator con valor exacto
 cat > /mnt/etc/systemd/zram-generator.conf << EOF
-# Configuración oficial zram-generator
-# RAM detectada: ${TOTAL_RAM_GB}GB (${TOTAL_RAM_MB}MB)
-# zram calculado: ${ZRAM_SIZE_GB}GB (${ZRAM_SIZE_MB}MB exactos)
+# Configuración zram-generator (ajuste adaptativo de Arcris)
+# RAM: ${TOTAL_RAM_MB}MB, núcleos: ${CPU_CORES}, SWAP_TYPE: ${SWAP_TYPE}
+# Prueba: lz4 ${LZ4_WRITE:-?}/${LZ4_READ:-?} MiB/s ratio ${LZ4_RATIO:-?}%, zstd ${ZSTD_WRITE:-?}/${ZSTD_READ:-?} MiB/s ratio ${ZSTD_RATIO:-?}%
 
 [zram0]
 zram-size = ${ZRAM_SIZE_MB}
-compression-algorithm = zstd
+compression-algorithm = ${ZRAM_ALGORITHM}
 swap-priority = 100
 EOF
 
-# Deshabilitar zswap para evitar conflictos con zram (ArchWiki)
-if [ -f /mnt/etc/default/grub ]; then
+# Deshabilitar zswap para evitar conflictos con zram (ArchWiki); una imagen
+# maestra ya lo trae
+if [ -f /mnt/etc/default/grub ] && ! grep -q 'zswap.enabled=0' /mnt/etc/default/grub; then
     sed -i 's/GRUB_CMDLINE_LINUX_DEFAULT="/&zswap.enabled=0 /' /mnt/etc/default/grub
 fi
 
-# vm.swappiness:
-#   zram puro (sin disco)  → 180  (el kernel puede swapear agresivamente, es RAM comprimida)
-#   zram + partición disco → 60   (preferir zram pero no ignorar la partición)
-if [ "$SWAP_TYPE" = "zram" ]; then
-    VM_SWAPPINESS=180
-else
-    VM_SWAPPINESS=60
-fi
-
 cat > /mnt/etc/sysctl.d/99-vm-zram-parameters.conf << EOF
-# Optimización para zram — SWAP_TYPE=${SWAP_TYPE}
+# Optimización para zram — SWAP_TYPE=${SWAP_TYPE}, ${ZRAM_ALGORITHM}, disco ${STORAGE_CLASS:-genérico}
 vm.swappiness = ${VM_SWAPPINESS}
 vm.watermark_boost_factor = 0
 vm.watermark_scale_factor = 125
-vm.page-cluster = 0
+vm.page-cluster = ${VM_PAGE_CLUSTER}
 EOF
 
+# config_fstab.sh deja el swap en disco con pri=10
+if [ -n "$DISK_SWAP_PRIORITY" ]; then
+    sed -i "/[[:space:]]swap[[:space:]]/s/pri=[0-9]*/pri=${DISK_SWAP_PRIORITY}/" /mnt/etc/fstab
+fi
+
 echo -e "${GREEN}✓ zram configurado:${NC}"
-echo -e "${CYAN}  • zram: ${ZRAM_SIZE_GB}GB (${ZRAM_SIZE_MB}MB) con zstd, prioridad 100${NC}"
+echo -e "${CYAN}  • zram: ${ZRAM_SIZE_MB}MB con ${ZRAM_ALGORITHM}, prioridad 100${NC}"
 echo -e "${CYAN}  • zswap: DESHABILITADO${NC}"
-echo -e "${CYAN}  • vm.swappiness: ${VM_SWAPPINESS}${NC}"
-if [ "$SWAP_TYPE" != "zram" ]; then
-    echo -e "${CYAN}  • Partición swap en disco activa con prioridad 10 (inferior a zram)${NC}"
+echo -e "${CYAN}  • vm.swappiness: ${VM_SWAPPINESS}, vm.page-cluster: ${VM_PAGE_CLUSTER}${NC}"
+if [ -n "$DISK_SWAP_PRIORITY" ]; then
+    echo -e "${CYAN}  • Partición swap en disco activa con prioridad ${DISK_SWAP_PRIORITY} (inferior a zram)${NC}"
 fi
 # ------------------------------------------------------------------------------------------------------------------
 sleep 3
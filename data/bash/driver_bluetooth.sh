@@ -10,13 +10,13 @@ case "$DRIVER_BLUETOOTH" in
     "bluetoothctl (terminal)")
         install_pacman_chroot_with_retry "bluez"
         install_pacman_chroot_with_retry "bluez-utils"
-        chroot /mnt /bin/bash -c "systemctl enable bluetooth" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+        chroot_enable bluetooth || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
         ;;
     "blueman (Graphical)")
         install_pacman_chroot_with_retry "bluez"
         install_pacman_chroot_with_retry "bluez-utils"
         install_pacman_chroot_with_retry "blueman"
-        chroot /mnt /bin/bash -c "systemctl enable bluetooth" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+        chroot_enable bluetooth || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
         ;;
 esac
 sleep 2
@@ -82,7 +82,7 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "vulkan-tools"
             install_pacman_chroot_with_retry "radeontop"
 
-            chroot /mnt /bin/bash -c "usermod -aG render,video $USER"
+            chroot_run "usermod -aG render,video $USER"
 
 
         elif echo "$VGA_LINE" | grep -i nvidia > /dev/null; then
@@ -109,7 +109,7 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "lib32-vulkan-radeon"
             install_pacman_chroot_with_retry "vulkan-tools"
             install_pacman_chroot_with_retry "radeontop"
-            chroot /mnt /bin/bash -c "usermod -aG render,video $USER"
+            chroot_run "usermod -aG render,video $USER"
 
         elif echo "$VGA_LINE" | grep -i intel > /dev/null; then
             echo "Detectado hardware Intel - Instalando driver open source intel"
@@ -127,7 +127,7 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "lib32-libva"
             install_pacman_chroot_with_retry "libva-utils"
             install_pacman_chroot_with_retry "libvdpau-va-gl"
-            chroot /mnt /bin/bash -c "usermod -aG render,video $USER"
+            chroot_run "usermod -aG render,video $USER"
 
 
         elif echo "$VGA_LINE" | grep -i "virtio\|qemu\|red hat.*virtio" > /dev/null; then
@@ -138,8 +138,8 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "virglrenderer"
             install_pacman_chroot_with_retry "libgl"
             install_pacman_chroot_with_retry "libglvnd"
-            chroot /mnt /bin/bash -c "systemctl enable qemu-guest-agent.service" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
-            chroot /mnt /bin/bash -c "systemctl start qemu-guest-agent.service"
+            chroot_enable qemu-guest-agent.service || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_run "systemctl start qemu-guest-agent.service"
 
 
 
@@ -148,14 +148,14 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "xf86-video-fbdev"
             install_pacman_chroot_with_retry "virtualbox-guest-utils"
             install_pacman_chroot_with_retry "virglrenderer"
-            chroot /mnt /bin/bash -c "systemctl enable vboxservice" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_enable vboxservice || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
         elif echo "$VGA_LINE" | grep -i vmware > /dev/null; then
             echo "Detectado VMware - Instalando driver vmware"
             install_pacman_chroot_with_retry "xf86-video-fbdev"
             install_pacman_chroot_with_retry "virtualbox-guest-utils"
             install_pacman_chroot_with_retry "virglrenderer"
-            chroot /mnt /bin/bash -c "systemctl enable vboxservice" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_enable vboxservice || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
         else
             echo "Hardware no detectado - Instalando driver genérico vesa"
@@ -359,8 +359,8 @@ case "$DRIVER_VIDEO" in
             install_pacman_chroot_with_retry "virglrenderer"
             install_pacman_chroot_with_retry "libgl"
             install_pacman_chroot_with_retry "libglvnd"
-            chroot /mnt /bin/bash -c "systemctl enable qemu-guest-agent.service" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
-            chroot /mnt /bin/bash -c "systemctl start qemu-guest-agent.service"
+            chroot_enable qemu-guest-agent.service || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_run "systemctl start qemu-guest-agent.service"
 
 
         elif echo "$VGA_LINE" | grep -i virtualbox > /dev/null; then
@@ -377,7 +377,7 @@ case "$DRIVER_VIDEO" in
 
             install_pacman_chroot_with_retry "virtualbox-guest-utils"
             install_pacman_chroot_with_retry "virglrenderer"
-            chroot /mnt /bin/bash -c "systemctl enable vboxservice" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_enable vboxservice || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
         elif echo "$VGA_LINE" | grep -i vmware > /dev/null; then
             echo "Detectado VMware - Instalando driver vmware"
@@ -393,7 +393,7 @@ case "$DRIVER_VIDEO" in
 
             install_pacman_chroot_with_retry "virtualbox-guest-utils"
             install_pacman_chroot_with_retry "virglrenderer"
-            chroot /mnt /bin/bash -c "systemctl enable vboxservice" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+            chroot_enable vboxservice || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
         else
             echo "Hardware no detectado - Instalando driver genérico vesa"
@@ -73,7 +73,7 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "eyedropper"
                 echo "Installing extension-manager..."
                 install_pacman_chroot_with_retry "extension-manager"
-                chroot /mnt /bin/bash -c "systemctl enable gdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable gdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
                 ;;
             "BUDGIE")
@@ -97,14 +97,14 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "lightdm-slick-greeter"
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "CINNAMON")
                 echo -e "${CYAN}Instalando Cinnamon Desktop...${NC}"
@@ -132,14 +132,14 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "lightdm-slick-greeter"
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "COSMIC")
                 echo -e "${CYAN}Instalando COSMIC Desktop...${NC}"
@@ -152,7 +152,7 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "showtime"
                 install_pacman_chroot_with_retry "papers"
                 install_pacman_chroot_with_retry "cosmic-greeter"
-                chroot /mnt /bin/bash -c "systemctl enable cosmic-greeter.service" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable cosmic-greeter.service || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "CUTEFISH")
                 echo -e "${CYAN}Instalando CUTEFISH Desktop...${NC}"
@@ -163,7 +163,7 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "papers"
                 install_pacman_chroot_with_retry "sddm"
                 install_pacman_chroot_with_retry "sddm-kcm"
-                chroot /mnt /bin/bash -c "systemctl enable sddm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable sddm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "UKUI")
                 echo -e "${CYAN}Instalando UKUI Desktop...${NC}"
@@ -177,14 +177,14 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "lightdm-slick-greeter"
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "PANTHEON")
                 echo -e "${CYAN}Instalando PANTHEON Desktop...${NC}"
@@ -197,9 +197,9 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "gnome-keyring"
                 install_pacman_chroot_with_retry "lightdm"
                 install_pacman_chroot_with_retry "lightdm-pantheon-greeter"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
-                chroot /mnt /bin/bash -c "pacman -Q orca >/dev/null 2>&1 && pacman -Rdd orca --noconfirm; exit 0"
-                chroot /mnt /bin/bash -c "pacman -Q onboard >/dev/null 2>&1 && pacman -Rdd onboard --noconfirm; exit 0"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_run "pacman -Q orca >/dev/null 2>&1 && pacman -Rdd orca --noconfirm; exit 0"
+                chroot_run "pacman -Q onboard >/dev/null 2>&1 && pacman -Rdd onboard --noconfirm; exit 0"
                 sed -i '$d' /mnt/etc/lightdm/Xsession
                 sed -i '$a io.elementary.wingpanel &\nplank &\nexec gala' /mnt/etc/lightdm/Xsession
                 ;;
@@ -219,14 +219,14 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "gnome-keyring"
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "KDE")
                 echo -e "${CYAN}Instalando KDE Plasma Desktop...${NC}"
@@ -303,7 +303,7 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "plasma-firewall"       # Configurar firewall
                 install_pacman_chroot_with_retry "kgamma"                # Calibración de gamma
 
-                chroot /mnt /bin/bash -c "systemctl enable sddm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable sddm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "LXDE")
                 echo -e "${CYAN}Instalando LXDE Desktop...${NC}"
@@ -319,14 +319,14 @@ case "$INSTALLATION_TYPE" in
 
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "LXQT")
                 echo -e "${CYAN}Instalando LXQt Desktop...${NC}"
@@ -353,7 +353,7 @@ case "$INSTALLATION_TYPE" in
                 install_yay_chroot_with_retry "nm-tray"
                 # Display manager
                 install_pacman_chroot_with_retry "sddm"
-                chroot /mnt /bin/bash -c "systemctl enable sddm"
+                chroot_enable sddm
                 ;;
             "MATE")
                 echo -e "${CYAN}Instalando MATE Desktop...${NC}"
@@ -383,12 +383,12 @@ case "$INSTALLATION_TYPE" in
                 # Configuración de LightDM
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             "XFCE4")
                 echo -e "${CYAN}Instalando XFCE4 Desktop...${NC}"
@@ -418,14 +418,14 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "lightdm-slick-greeter"
                 sed -i 's/^#greeter-session=example-gtk-gnome$/greeter-session=lightdm-slick-greeter/' /mnt/etc/lightdm/lightdm.conf
                 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpge
-                chroot /mnt /bin/bash -c "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
+                chroot_run "sudo -u $USER touch /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "[Greeter]" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "background=/usr/share/pixmaps/backgroundarch.jpge" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "theme-name=Adwaita-dark" >> /etc/lightdm/slick-greeter.conf"
                 chroot /mnt /bin/bash -c "sudo -u $USER echo "clock-format=%b %e %H:%M" >> /etc/lightdm/slick-greeter.conf"
                 install_pacman_chroot_with_retry "accountsservice"
                 install_pacman_chroot_with_retry "mugshot"
-                chroot /mnt /bin/bash -c "systemctl enable lightdm" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+                chroot_enable lightdm || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
                 ;;
             *)
                 echo -e "${YELLOW}Entorno de escritorio no reconocido: $DESKTOP_ENVIRONMENT${NC}"
@@ -460,7 +460,7 @@ case "$INSTALLATION_TYPE" in
         install_yay_chroot_with_retry "ly"
         install_pacman_chroot_with_retry "xorg-xauth"
         install_pacman_chroot_with_retry "brightnessctl"
-        chroot /mnt /bin/bash -c "systemctl enable ly@tty1.service" || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
+        chroot_enable ly@tty1.service || echo -e "${RED}ERROR: Falló systemctl enable${NC}"
 
         case "$WINDOW_MANAGER" in
             "I3WM"|"I3")
@@ -499,11 +499,11 @@ case "$INSTALLATION_TYPE" in
                 sudo cp -rT /mnt/home/$USER/.config/i3-config/ /mnt/home/$USER/.config/
                 rm /mnt/home/$USER/.config/i3-config.zip
                 rm -rf /mnt/home/$USER/.config/i3-config
-                chroot /mnt /bin/bash -c "chmod +x /home/$USER/.config/i3/powermenu.sh"
-                chroot /mnt /bin/bash -c "chmod +x /home/$USER/.config/i3status-rust/mem.sh"
-                chroot /mnt /bin/bash -c "betterlockscreen -u /usr/share/pixmaps/backgroundarch.jpg"
-                chroot /mnt /bin/bash -c "install -Dm644 /etc/i3status.conf /home/$USER/.config/i3status/config"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "chmod +x /home/$USER/.config/i3/powermenu.sh"
+                chroot_run "chmod +x /home/$USER/.config/i3status-rust/mem.sh"
+                chroot_run "betterlockscreen -u /usr/share/pixmaps/backgroundarch.jpg"
+                chroot_run "install -Dm644 /etc/i3status.conf /home/$USER/.config/i3status/config"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "AWESOME")
                 echo -e "${CYAN}Instalando Extras de Awesome Window Manager...${NC}"
@@ -532,8 +532,8 @@ case "$INSTALLATION_TYPE" in
                 install_pacman_chroot_with_retry "vicious"
                 # Crear configuración básica de awesome
                 mkdir -p /mnt/home/$USER/.config/awesome
-                chroot /mnt /bin/bash -c "install -Dm755 /etc/xdg/awesome/rc.lua /home/$USER/.config/awesome/rc.lua"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "install -Dm755 /etc/xdg/awesome/rc.lua /home/$USER/.config/awesome/rc.lua"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "BSPWM")
                 echo -e "${CYAN}Instalando BSPWM Window Manager...${NC}"
@@ -566,11 +566,11 @@ case "$INSTALLATION_TYPE" in
                 mkdir -p /mnt/home/$USER/.config/bspwm
                 mkdir -p /mnt/home/$USER/.config/sxhkd
                 mkdir -p /mnt/home/$USER/.config/polybar/
-                chroot /mnt /bin/bash -c "install -Dm755 /usr/share/doc/bspwm/examples/bspwmrc /home/$USER/.config/bspwm/bspwmrc"
-                chroot /mnt /bin/bash -c "install -Dm644 /usr/share/doc/bspwm/examples/sxhkdrc /home/$USER/.config/sxhkd/sxhkdrc"
-                chroot /mnt /bin/bash -c "install -Dm644 /etc/polybar/config.ini /home/$USER/.config/polybar/config.ini"
-                chroot /mnt /bin/bash -c "echo polybar >> /home/$USER/.config/bspwm/bspwmrc"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "install -Dm755 /usr/share/doc/bspwm/examples/bspwmrc /home/$USER/.config/bspwm/bspwmrc"
+                chroot_run "install -Dm644 /usr/share/doc/bspwm/examples/sxhkdrc /home/$USER/.config/sxhkd/sxhkdrc"
+                chroot_run "install -Dm644 /etc/polybar/config.ini /home/$USER/.config/polybar/config.ini"
+                chroot_run "echo polybar >> /home/$USER/.config/bspwm/bspwmrc"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "DWM")
                 echo -e "${CYAN}Instalando Extras Window Manager...${NC}"
@@ -636,16 +636,16 @@ case "$INSTALLATION_TYPE" in
                 install_yay_chroot_with_retry "dwl"
 
                 # Crear directorio temporal para compilación
-                chroot /mnt /bin/bash -c "mkdir -p /home/$USER/.config/src && chown $USER:$USER /home/$USER/.config/src"
+                chroot_run "mkdir -p /home/$USER/.config/src && chown $USER:$USER /home/$USER/.config/src"
 
                 # Compilar e instalar dwl
                 # https://github.com/yukiisen/waydots
-                chroot /mnt /bin/bash -c "cd /home/$USER/.config/src && sudo -u $USER git clone https://github.com/CodigoCristo/dwl"
-                chroot /mnt /bin/bash -c "cd /home/$USER/.config/src/dwl && sudo -u $USER make clean && sudo make install"
+                chroot_run "cd /home/$USER/.config/src && sudo -u $USER git clone https://github.com/CodigoCristo/dwl"
+                chroot_run "cd /home/$USER/.config/src/dwl && sudo -u $USER make clean && sudo make install"
 
                 # Compilar e instalar slstatus
-                chroot /mnt /bin/bash -c "cd /home/$USER/.config/src && sudo -u $USER git clone https://git.suckless.org/slstatus"
-                chroot /mnt /bin/bash -c "cd /home/$USER/.config/src/slstatus && sudo -u $USER make clean && sudo make install"
+                chroot_run "cd /home/$USER/.config/src && sudo -u $USER git clone https://git.suckless.org/slstatus"
+                chroot_run "cd /home/$USER/.config/src/slstatus && sudo -u $USER make clean && sudo make install"
 
                 # Mantener directorio src para futuras compilaciones y configuraciones personalizadas
                 # chroot /mnt /bin/bash -c "rm -rf /home/$USER/.config/src"
@@ -669,7 +669,7 @@ EOF
 
                 # Dar permisos de ejecución al script
                 chmod +x /mnt/home/$USER/start_dwl.sh
-                chroot /mnt /bin/bash -c "chown $USER:$USER /home/$USER/start_dwl.sh"
+                chroot_run "chown $USER:$USER /home/$USER/start_dwl.sh"
 
                 # Crear/modificar el archivo dwl.desktop
                 echo -e "${YELLOW}Configurando dwl.desktop...${NC}"
@@ -713,11 +713,11 @@ EOF
                 install_pacman_chroot_with_retry "brightnessctl"                # Control de brillo de pantalla desde terminal
                 # Crear configuración básica de hyprland
                 mkdir -p /mnt/home/$USER/.config/hypr
-                chroot /mnt /bin/bash -c "install -Dm644 /usr/share/hypr/hyprland.conf /home/$USER/.config/hypr/hyprland.conf"
-                chroot /mnt /bin/bash -c "echo exec-once = waybar >> /home/$USER/.config/hypr/hyprland.conf"
-                chroot /mnt /bin/bash -c "echo exec-once = systemctl --user start hyprpolkitagent >> /home/$USER/.config/hypr/hyprland.conf"
-                chroot /mnt /bin/bash -c "sudo -u $USER hyprctl keyword input:kb_layout $KEYBOARD_LAYOUT"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "install -Dm644 /usr/share/hypr/hyprland.conf /home/$USER/.config/hypr/hyprland.conf"
+                chroot_run "echo exec-once = waybar >> /home/$USER/.config/hypr/hyprland.conf"
+                chroot_run "echo exec-once = systemctl --user start hyprpolkitagent >> /home/$USER/.config/hypr/hyprland.conf"
+                chroot_run "sudo -u $USER hyprctl keyword input:kb_layout $KEYBOARD_LAYOUT"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "MANGO")
                 echo -e "${CYAN}Instalando MANGO Window Manager...${NC}"
@@ -769,10 +769,10 @@ EOF
                 cp /usr/share/arcrisgui/data/bash/mango/mango.zip /mnt/home/$USER/.config/
                 unzip -o /mnt/home/$USER/.config/mango.zip -d /mnt/home/$USER/
                 rm /mnt/home/$USER/.config/mango.zip
-                chroot /mnt /bin/bash -c "chmod +x /home/$USER/.config/mango/*.sh"
-                chroot /mnt /bin/bash -c "chmod +x /home/$USER/.config/waybar/scripts/*.sh"
-                chroot /mnt /bin/bash -c "echo xkb_rules_layout=$KEYBOARD_LAYOUT >> /home/$USER/.config/mango/config.conf"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "chmod +x /home/$USER/.config/mango/*.sh"
+                chroot_run "chmod +x /home/$USER/.config/waybar/scripts/*.sh"
+                chroot_run "echo xkb_rules_layout=$KEYBOARD_LAYOUT >> /home/$USER/.config/mango/config.conf"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "NIRI")
                 echo -e "${CYAN}Instalando Niri Window Manager...${NC}"
@@ -799,8 +799,8 @@ EOF
                 install_pacman_chroot_with_retry "nwg-look"                     # Configurador de temas GTK para Wayland
                 # Crear configuración básica de niri
                 mkdir -p /mnt/home/$USER/.config/niri
-                chroot /mnt /bin/bash -c "niri validate --config /dev/null || true"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "niri validate --config /dev/null || true"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "OPENBOX")
                 echo -e "${CYAN}Instalando Openbox Window Manager...${NC}"
@@ -834,9 +834,9 @@ EOF
                 install_pacman_chroot_with_retry "alacritty" #Emulador de terminal acelerado por GPU
                 # Crear configuración básica de openbox
                 mkdir -p /mnt/home/$USER/.config/openbox
-                chroot /mnt /bin/bash -c "obmenu-generator -i -p"
-                chroot /mnt /bin/bash -c "cp -a /etc/xdg/openbox /home/$USER/.config/"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "obmenu-generator -i -p"
+                chroot_run "cp -a /etc/xdg/openbox /home/$USER/.config/"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "QTITLE"|"QTILE")
                 echo -e "${CYAN}Instalando Qtile Window Manager...${NC}"
@@ -876,7 +876,7 @@ EOF
                 install_pacman_chroot_with_retry "alacritty"          # Terminal moderna
                 # Crear configuración básica de qtile
                 mkdir -p /mnt/home/$USER/.config/qtile
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "SWAY")
                 echo -e "${CYAN}Instalando Sway Window Manager...${NC}"
@@ -931,8 +931,8 @@ EOF
                 install_pacman_chroot_with_retry "kitty"              # Terminal moderna con buen soporte Wayland
                 # Crear configuración básica de sway
                 mkdir -p /mnt/home/$USER/.config/sway
-                chroot /mnt /bin/bash -c "install -Dm644 /etc/sway/config /home/$USER/.config/sway/config"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "install -Dm644 /etc/sway/config /home/$USER/.config/sway/config"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             "XMONAD")
                 echo -e "${CYAN}Instalando XMonad Window Manager...${NC}"
@@ -985,8 +985,8 @@ EOF
                 # Crear configuración básica de xmonad
                 mkdir -p /mnt/home/$USER/.config/xmonad
                 guardar_configuraciones_xmonad
-                chroot /mnt /bin/bash -c "sudo -u $USER xmonad --recompile /home/$USER/.config/xmonad/xmonad.hs"
-                chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config"
+                chroot_run "sudo -u $USER xmonad --recompile /home/$USER/.config/xmonad/xmonad.hs"
+                chroot_run "chown -R $USER:$USER /home/$USER/.config"
                 ;;
             *)
                 echo -e "${YELLOW}Gestor de ventanas no reconocido: $WINDOW_MANAGER${NC}"
@@ -0,0 +1,157 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Imágenes maestras para el modo desatendido (arcris --unattended --image-dir)
+#
+#   ARCRIS_CAPTURE_IMAGE: al terminar una instalación normal, guardar /mnt en
+#                         esa ruta (tar + zstd); Arcris escribe luego el .sha256
+#   ARCRIS_GOLDEN_IMAGE:  imagen ya verificada por Arcris; se vuelca en /mnt y
+#                         solo se ejecutan los pasos propios de cada máquina
+#
+# Se incluye desde install.sh, por lo que usa sus funciones y colores.
+# -----------------------------------------------------------------------------------
+
+# Rutas que no forman parte del sistema instalado o que se regeneran en cada equipo
+GOLDEN_IMAGE_EXCLUDES=(
+    "./proc/*"
+    "./sys/*"
+    "./dev/*"
+    "./run/*"
+    "./tmp/*"
+    "./var/cache/pacman/pkg/*"
+    "./etc/machine-id"
+    "./etc/fstab"
+    "./etc/crypttab"
+    "./etc/ssh/ssh_host_*"
+    "./var/lib/systemd/random-seed"
+    "./var/lib/systemd/credential.secret"
+    "./var/log/*"
+)
+
+golden_image_capture() {
+    local image="$ARCRIS_CAPTURE_IMAGE"
+    local exclude_args=()
+
+    echo -e "${GREEN}| Capturando imagen maestra: $image |${NC}"
+    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+    echo ""
+
+    for pattern in "${GOLDEN_IMAGE_EXCLUDES[@]}"; do
+        exclude_args+=("--exclude=$pattern")
+    done
+
+    mkdir -p "$(dirname "$image")"
+
+    # Se escribe en un temporal para no dejar una imagen a medias si falla
+    if tar --zstd --xattrs --acls --numeric-owner -cpf "$image.partial" \
+           "${exclude_args[@]}" -C /mnt .; then
+        mv -f "$image.partial" "$image"
+        echo -e "${GREEN}✓ Imagen capturada ($(du -h "$image" | cut -f1))${NC}"
+    else
+        rm -f "$image.partial"
+        echo -e "${YELLOW}Warning: No se pudo capturar la imagen maestra${NC}"
+    fi
+}
+
+golden_image_deploy() {
+    local image="$ARCRIS_GOLDEN_IMAGE"
+
+    timing_phase "imagen_maestra"
+    echo -e "${GREEN}| Volcando imagen maestra: $image |${NC}"
+    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+    echo ""
+
+    if ! tar --zstd --xattrs --acls --numeric-owner -xpf "$image" -C /mnt; then
+        echo -e "${RED}ERROR: Falló el volcado de la imagen${NC}"
+        return 1
+    fi
+    echo -e "${GREEN}✓ Imagen volcada${NC}"
+    sleep 2
+    clear
+
+    timing_phase "configuracion_maquina"
+    setup_chroot_mounts
+
+    # Identidad de la máquina. Las claves SSH del equipo, la semilla aleatoria
+    # y el secreto de credenciales no van en la imagen; por si vienen de una
+    # imagen antigua se borran para que se generen en el primer arranque
+    rm -f /mnt/etc/ssh/ssh_host_* /mnt/var/lib/systemd/random-seed \
+          /mnt/var/lib/systemd/credential.secret
+    chroot_run "systemd-machine-id-setup"
+
+    # fstab con los UUID de las particiones recién creadas
+    # -------------------------------------------------
+    source "$(dirname "$0")/config_fstab.sh"
+    # -------------------------------------------------
+
+    # Configuración de hostname
+    echo -e "${GREEN}| Configurando hostname y usuarios |${NC}"
+    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+    echo ""
+
+    echo "$HOSTNAME" > /mnt/etc/hostname
+    cat > /mnt/etc/hosts << EOF
+127.0.0.1	localhost
+::1		localhost
+127.0.1.1	$HOSTNAME.localdomain	$HOSTNAME
+EOF
+
+    # El usuario de la imagen se renombra para conservar su configuración de escritorio
+    local image_user
+    image_user=$(awk -F':' '$3 == 1000 {print $1}' /mnt/etc/passwd 2>/dev/null)
+    if [[ -n "$image_user" && "$image_user" != "$USER" ]]; then
+        chroot_run "usermod -l $USER -d /home/$USER -m $image_user"
+        chroot_run "groupmod -n $USER $image_user 2>/dev/null" || true
+        echo "✓ Usuario $image_user renombrado a $USER"
+    elif [[ -z "$image_user" ]]; then
+        chroot_run "useradd -m -G wheel,audio,video,optical,storage,input -s /bin/bash $USER"
+    fi
+
+    echo "root:$PASSWORD_ROOT" | chroot /mnt /bin/bash -c "chpasswd"
+    echo "$USER:$PASSWORD_USER" | chroot /mnt /bin/bash -c "chpasswd"
+    sleep 2
+    clear
+
+    # Initramfs: con LUKS+LVM el autodetect necesita vg0 activo
+    echo -e "${GREEN}| Configurando mkinitcpio |${NC}"
+    printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
+    echo ""
+    if [ "$ENCRYPTION" = "true" ]; then
+        vgchange -ay ${LVM_VG_NAME} 2>/dev/null || true
+        wait_for_devices /dev/${LVM_VG_NAME}/root
+    fi
+    initramfs_configure
+    if sdboot_enabled; then
+        sdboot_prepare_mkinitcpio
+    else
+        initramfs_build
+    fi
+
+    # zram depende de la RAM de cada equipo
+    # -------------------------------------------------
+    if [ "$SWAP_TYPE" != "none" ]; then
+        source "$(dirname "$0")/config_zram.sh"
+    fi
+    # -------------------------------------------------
+    source "$(dirname "$0")/config_performance.sh"
+    # -------------------------------------------------
+    if sdboot_enabled; then
+        sdboot_install
+    else
+        source "$(dirname "$0")/config_grub.sh"
+    fi
+    boot_report_install
+    # -------------------------------------------------
+    source "$(dirname "$0")/driver_video.sh"
+    # -------------------------------------------------
+    source "$(dirname "$0")/driver_audio.sh"
+    # -------------------------------------------------
+    source "$(dirname "$0")/driver_wifi.sh"
+    # -------------------------------------------------
+    source "$(dirname "$0")/driver_bluetooth.sh"
+    # -------------------------------------------------
+
+    cleanup_chroot_mounts
+    echo -e "${GREEN}✓ Instalación desde imagen maestra completada${NC}"
+    timing_finish
+    return 0
+}
@@ -3,8 +3,14 @@
 export LANG=C
 export LC_ALL=C
 
-# Importar variables de configuración
-source "$(dirname "$0")/variables.sh"
+# Importar variables de configuración (el modo desatendido multi-disco indica
+# un archivo por disco en ARCRIS_VARIABLES_FILE)
+source "${ARCRIS_VARIABLES_FILE:-$(dirname "$0")/variables.sh}"
+
+# Nombres del mapeo LUKS y del grupo LVM en el LiveCD. En el modo multi-disco
+# cada destino trae los suyos en su variables.sh para no chocar con los demás
+LUKS_MAPPER_NAME="${LUKS_MAPPER_NAME:-cryptlvm}"
+LVM_VG_NAME="${LVM_VG_NAME:-vg0}"
 
 
 # Verificar tamaño mínimo del disco (30GB)
@@ -28,9 +34,33 @@ if [ "$EUID" -ne 0 ]; then
     echo -e "\033[1;33mEste script requiere privilegios de root.\033[0m"
     echo -e "\033[0;36mEjecutando con sudo su...\033[0m"
     echo ""
-    exec sudo su -c "bash '$0'"
+    exec sudo su -c "ARCRIS_VARIABLES_FILE='${ARCRIS_VARIABLES_FILE}' ARCRIS_GOLDEN_IMAGE='${ARCRIS_GOLDEN_IMAGE}' ARCRIS_CAPTURE_IMAGE='${ARCRIS_CAPTURE_IMAGE}' ARCRIS_TIMING_JOURNAL='${ARCRIS_TIMING_JOURNAL}' ARCRIS_TMP_DIR='${ARCRIS_TMP_DIR}' ARCRIS_LIVE_LOCK='${ARCRIS_LIVE_LOCK}' ARCRIS_INSTALL_LOG='${ARCRIS_INSTALL_LOG}' ARCRIS_RESOURCE_JOURNAL='${ARCRIS_RESOURCE_JOURNAL}' bash '$0'"
 fi
 
+# Archivos temporales de esta instancia (clave LUKS, progreso del borrado...);
+# el modo multi-disco indica un directorio por destino
+ARCRIS_TMP_DIR="${ARCRIS_TMP_DIR:-/tmp}"
+mkdir -p "$ARCRIS_TMP_DIR"
+
+# ================================================================================================
+# FASES DEL LIVECD EN EL MODO MULTI-DISCO
+# ================================================================================================
+# Con ARCRIS_LIVE_LOCK varias instancias comparten el LiveCD: lo que modifica el
+# sistema vivo (pacman, llavero, mirrorlist, caché de paquetes) se ejecuta en
+# una instancia a la vez. Sin ARCRIS_LIVE_LOCK no se bloquea nada.
+live_lock() {
+    [ -n "$ARCRIS_LIVE_LOCK" ] || return 0
+    exec {ARCRIS_LIVE_LOCK_FD}>>"$ARCRIS_LIVE_LOCK"
+    flock "$ARCRIS_LIVE_LOCK_FD"
+}
+
+live_unlock() {
+    [ -n "$ARCRIS_LIVE_LOCK" ] && [ -n "$ARCRIS_LIVE_LOCK_FD" ] || return 0
+    flock -u "$ARCRIS_LIVE_LOCK_FD"
+    exec {ARCRIS_LIVE_LOCK_FD}>&-
+    ARCRIS_LIVE_LOCK_FD=""
+}
+
 # Colores
 RED='\033[0;31m'
 BOLD_RED='\033[1;31m'
@@ -56,7 +86,14 @@ get_partition_name() {
     fi
 }
 # =============================================
+source "$(dirname "$0")/install_timing.sh"
+source "$(dirname "$0")/chroot_agent.sh"
+source "$(dirname "$0")/config_systemd_boot.sh"
+source "$(dirname "$0")/config_initramfs.sh"
+# =============================================
 source "$(dirname "$0")/config_conectividad.sh"
+source "$(dirname "$0")/package_fetch.sh"
+source "$(dirname "$0")/keyring.sh"
 # =============================================
 
 # Función para imprimir en rojo
@@ -113,7 +150,7 @@ configurar_btrfs() {
 
     # Verificar que BTRFS esté montado correctamente
     echo -e "${CYAN}Verificando sistema de archivos BTRFS...${NC}"
-    if ! chroot /mnt /bin/bash -c "btrfs filesystem show" >/dev/null 2>&1; then
+    if ! chroot_run "btrfs filesystem show >/dev/null 2>&1"; then
         echo -e "${RED}ERROR: No se pudo verificar el sistema BTRFS${NC}"
         exit 1
     fi
@@ -133,75 +170,81 @@ configurar_btrfs() {
     install_pacman_chroot_with_retry "btrfsmaintenance"
     install_pacman_chroot_with_retry "snapper"
     install_pacman_chroot_with_retry "btrfs-assistant"
-    install_pacman_chroot_with_retry "grub-btrfs" "--needed" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo instalar grub-btrfs${NC}"
-    install_pacman_chroot_with_retry "inotify-tools" "--needed" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo instalar inotify-tools${NC}"
 
-    # Configurar grub-btrfs para boot desde snapshots
-    if chroot /mnt /bin/bash -c "pacman -Qq grub-btrfs" 2>/dev/null; then
-        echo -e "${CYAN}Configurando grub-btrfs para boot desde snapshots...${NC}"
+    # grub-btrfs solo sirve con GRUB: con systemd-boot no hay grub.cfg que regenerar
+    if ! sdboot_enabled; then
+        install_pacman_chroot_with_retry "grub-btrfs" "--needed" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo instalar grub-btrfs${NC}"
+        install_pacman_chroot_with_retry "inotify-tools" "--needed" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo instalar inotify-tools${NC}"
+
+        # Configurar grub-btrfs para boot desde snapshots
+        if chroot_run "pacman -Qq grub-btrfs 2>/dev/null"; then
+            echo -e "${CYAN}Configurando grub-btrfs para boot desde snapshots...${NC}"
 
-        # Habilitar servicio de actualización automática de grub con snapshots
-        chroot /mnt /bin/bash -c "systemctl enable grub-btrfsd.service" 2>/dev/null || echo -e "${YELLOW}Warning: grub-btrfsd.service no disponible${NC}"
+            # Habilitar servicio de actualización automática de grub con snapshots
+            chroot_run "systemctl enable grub-btrfsd.service 2>/dev/null" || echo -e "${YELLOW}Warning: grub-btrfsd.service no disponible${NC}"
 
-        # Configurar grub-btrfs para detectar snapshots en /.snapshots
-        if [ ! -f /mnt/etc/default/grub-btrfs/config ]; then
-            mkdir -p /mnt/etc/default/grub-btrfs
-            cp /usr/share/arcrisgui/data/bash/btrfs/config /mnt/etc/default/grub-btrfs/config
-            cat /mnt/etc/default/grub-btrfs/config
+            # Configurar grub-btrfs para detectar snapshots en /.snapshots
+            if [ ! -f /mnt/etc/default/grub-btrfs/config ]; then
+                mkdir -p /mnt/etc/default/grub-btrfs
+                cp /usr/share/arcrisgui/data/bash/btrfs/config /mnt/etc/default/grub-btrfs/config
+                cat /mnt/etc/default/grub-btrfs/config
+            fi
+            echo -e "${GREEN}✓ grub-btrfs configurado para detectar snapshots automáticamente${NC}"
+        else
+            echo -e "${YELLOW}Warning: grub-btrfs no instalado, boot desde snapshots no disponible${NC}"
         fi
-        echo -e "${GREEN}✓ grub-btrfs configurado para detectar snapshots automáticamente${NC}"
     else
-        echo -e "${YELLOW}Warning: grub-btrfs no instalado, boot desde snapshots no disponible${NC}"
+        echo -e "${CYAN}systemd-boot en uso: se omite grub-btrfs${NC}"
     fi
 
     # Habilitar servicios de mantenimiento BTRFS
     echo -e "${CYAN}Configurando servicios de mantenimiento BTRFS...${NC}"
-    chroot /mnt /bin/bash -c "systemctl enable btrfs-scrub@-.timer" 2>/dev/null || echo -e "${YELLOW}Warning: btrfs-scrub timer no disponible${NC}"
-    chroot /mnt /bin/bash -c "systemctl enable fstrim.timer" || echo -e "${RED}ERROR: Falló habilitar fstrim.timer${NC}"
+    chroot_run "systemctl enable btrfs-scrub@-.timer 2>/dev/null" || echo -e "${YELLOW}Warning: btrfs-scrub timer no disponible${NC}"
+    chroot_enable fstrim.timer || echo -e "${RED}ERROR: Falló habilitar fstrim.timer${NC}"
 
     # Instalar y configurar snapshots automáticos con Snapper
     echo -e "${CYAN}Instalando Snapper para snapshots automáticos...${NC}"
     install_pacman_chroot_with_retry "snapper" "--needed" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo instalar snapper${NC}"
 
-    if chroot /mnt /bin/bash -c "pacman -Qq snapper" 2>/dev/null; then
+    if chroot_run "pacman -Qq snapper 2>/dev/null"; then
         echo -e "${CYAN}Configurando Snapper para snapshots automáticos...${NC}"
 
         # Crear configuración para el subvolumen raíz (esto crea automáticamente /.snapshots)
         echo -e "${CYAN}Configurando Snapper para el sistema raíz (/)...${NC}"
 
         # Crear directorio de configuración si no existe
-        chroot /mnt /bin/bash -c "mkdir -p /etc/snapper/configs"
+        chroot_run "mkdir -p /etc/snapper/configs"
 
         # Intentar crear configuración con --no-dbus para LiveCD
-        if chroot /mnt /bin/bash -c "snapper --no-dbus -c root create-config /" 2>/dev/null; then
-            chroot /mnt /bin/bash -c "snapper --no-dbus -c root set-config TIMELINE_LIMIT_HOURLY=0 TIMELINE_LIMIT_DAILY=0 TIMELINE_LIMIT_WEEKLY=1 TIMELINE_LIMIT_MONTHLY=0 TIMELINE_LIMIT_YEARLY=0" 2>/dev/null
+        if chroot_run "snapper --no-dbus -c root create-config / 2>/dev/null"; then
+            chroot_run "snapper --no-dbus -c root set-config TIMELINE_LIMIT_HOURLY=0 TIMELINE_LIMIT_DAILY=0 TIMELINE_LIMIT_WEEKLY=1 TIMELINE_LIMIT_MONTHLY=0 TIMELINE_LIMIT_YEARLY=0 2>/dev/null"
             echo -e "${GREEN}✓ Configuración de snapper para raíz creada exitosamente${NC}"
         else
             # Crear configuración manualmente si falla
             cp /usr/share/arcrisgui/data/bash/btrfs/root /mnt/etc/snapper/configs/root
             cat /mnt/etc/snapper/configs/root
             # Crear directorio de snapshots manualmente
-            chroot /mnt /bin/bash -c "mkdir -p /.snapshots"
-            chroot /mnt /bin/bash -c "chmod 755 /.snapshots"
+            chroot_run "mkdir -p /.snapshots"
+            chroot_run "chmod 755 /.snapshots"
 
             echo -e "${GREEN}✓ Configuración manual de snapper para raíz completada${NC}"
         fi
 
         # Crear configuración para /home si el subvolumen existe
-        if chroot /mnt /bin/bash -c "mountpoint -q /home"; then
+        if chroot_run "mountpoint -q /home"; then
             echo -e "${CYAN}Configurando Snapper para /home...${NC}"
 
             # Intentar crear configuración para /home con --no-dbus para LiveCD
-            if chroot /mnt /bin/bash -c "snapper --no-dbus -c home create-config /home" 2>/dev/null; then
-                chroot /mnt /bin/bash -c "snapper --no-dbus -c home set-config TIMELINE_LIMIT_HOURLY=0 TIMELINE_LIMIT_DAILY=0 TIMELINE_LIMIT_WEEKLY=1 TIMELINE_LIMIT_MONTHLY=0 TIMELINE_LIMIT_YEARLY=0" 2>/dev/null
+            if chroot_run "snapper --no-dbus -c home create-config /home 2>/dev/null"; then
+                chroot_run "snapper --no-dbus -c home set-config TIMELINE_LIMIT_HOURLY=0 TIMELINE_LIMIT_DAILY=0 TIMELINE_LIMIT_WEEKLY=1 TIMELINE_LIMIT_MONTHLY=0 TIMELINE_LIMIT_YEARLY=0 2>/dev/null"
                 echo -e "${GREEN}✓ Configuración de snapper para /home creada exitosamente${NC}"
             else
                 # Crear configuración manualmente si falla
                 cp /usr/share/arcrisgui/data/bash/btrfs/home /mnt/etc/snapper/configs/home
                 cat /mnt/etc/snapper/configs/home
                 # Crear directorio de snapshots manualmente
-                chroot /mnt /bin/bash -c "mkdir -p /home/.snapshots"
-                chroot /mnt /bin/bash -c "chmod 755 /home/.snapshots"
+                chroot_run "mkdir -p /home/.snapshots"
+                chroot_run "chmod 755 /home/.snapshots"
 
                 echo -e "${GREEN}✓ Configuración manual de snapper para /home completada${NC}"
             fi
@@ -210,8 +253,8 @@ configurar_btrfs() {
         fi
 
         # Habilitar servicios de Snapper
-        chroot /mnt /bin/bash -c "systemctl enable snapper-timeline.timer" 2>/dev/null || echo -e "${YELLOW}Warning: Falló habilitar snapper-timeline.timer${NC}"
-        chroot /mnt /bin/bash -c "systemctl enable snapper-cleanup.timer" 2>/dev/null || echo -e "${YELLOW}Warning: Falló habilitar snapper-cleanup.timer${NC}"
+        chroot_batch "systemctl enable snapper-timeline.timer 2>/dev/null" \
+                     "systemctl enable snapper-cleanup.timer 2>/dev/null" || echo -e "${YELLOW}Warning: Falló habilitar los timers de snapper${NC}"
 
         echo -e "${GREEN}✓ Servicios automáticos de Snapper habilitados:${NC}"
         echo -e "${CYAN}  • snapper-timeline.timer: Crea snapshots automáticos${NC}"
@@ -251,35 +294,31 @@ configurar_btrfs() {
         echo -e "${CYAN}  • root: Snapshots del sistema con retención completa${NC}"
         echo -e "${CYAN}  • home: Snapshots de datos de usuario con retención extendida${NC}"
 
-        echo -e "\n${GREEN}✓ grub-btrfs configurado:${NC}"
-        echo -e "${CYAN}  • Boot desde snapshots disponible en GRUB${NC}"
-        echo -e "${CYAN}  • Recuperación de emergencia habilitada${NC}"
+        if ! sdboot_enabled; then
+            echo -e "\n${GREEN}✓ grub-btrfs configurado:${NC}"
+            echo -e "${CYAN}  • Boot desde snapshots disponible en GRUB${NC}"
+            echo -e "${CYAN}  • Recuperación de emergencia habilitada${NC}"
+        fi
 
     else
         echo -e "${RED}ERROR: No se pudo instalar Snapper${NC}"
     fi
 
-    # Optimizar fstab para BTRFS
-    echo -e "${CYAN}Optimizando fstab para BTRFS...${NC}"
-    chroot /mnt /bin/bash -c "sed -i 's/relatime/noatime/g' /etc/fstab"
-
-    # Agregar opciones de montaje optimizadas para todos los subvolúmenes
-    chroot /mnt /bin/bash -c "sed -i 's/subvol=@,/subvol=@,compress=zstd:3,space_cache=v2,autodefrag,/' /etc/fstab" 2>/dev/null || true
-    chroot /mnt /bin/bash -c "sed -i 's/subvol=@home,/subvol=@home,compress=zstd:3,space_cache=v2,autodefrag,/' /etc/fstab" 2>/dev/null || true
-    chroot /mnt /bin/bash -c "sed -i 's/subvol=@var_log,/subvol=@var_log,compress=zstd:3,space_cache=v2,/' /etc/fstab" 2>/dev/null || true
+    # noatime y la compresión de cada subvolumen ya vienen del perfil de
+    # almacenamiento (STORAGE_MOUNT_BTRFS) en el fstab de config_fstab.sh
 
     # Verificar configuración final de fstab
     echo -e "${CYAN}Verificando configuración final de fstab...${NC}"
-    if chroot /mnt /bin/bash -c "mount -a --fake" 2>/dev/null; then
+    if chroot_run "mount -a --fake 2>/dev/null"; then
         echo -e "${GREEN}✓ Configuración fstab válida${NC}"
     else
         echo -e "${YELLOW}Warning: Posibles issues en fstab, pero continuando...${NC}"
     fi
 
     # Regenerar GRUB para incluir snapshots de grub-btrfs
-    if chroot /mnt /bin/bash -c "pacman -Qq grub-btrfs" 2>/dev/null; then
+    if ! sdboot_enabled && chroot_run "pacman -Qq grub-btrfs 2>/dev/null"; then
         echo -e "${CYAN}Regenerando GRUB para incluir snapshots...${NC}"
-        chroot /mnt /bin/bash -c "grub-mkconfig -o /boot/grub/grub.cfg" 2>/dev/null || echo -e "${YELLOW}Warning: No se pudo regenerar GRUB con snapshots${NC}"
+        chroot_run "grub-mkconfig -o /boot/grub/grub.cfg 2>/dev/null" || echo -e "${YELLOW}Warning: No se pudo regenerar GRUB con snapshots${NC}"
         echo -e "${GREEN}✓ GRUB configurado para mostrar snapshots en el menú de arranque${NC}"
     fi
 
@@ -296,8 +335,8 @@ configurar_btrfs() {
     cp /usr/share/arcrisgui/data/bash/btrfs/btrfs-maintenance.timer /mnt/etc/systemd/system/btrfs-maintenance.timer
     cat /mnt/etc/systemd/system/btrfs-maintenance.timer
 
-    chroot /mnt /bin/bash -c "systemctl daemon-reload" || echo -e "${YELLOW}Warning: No se pudo daemon-reload${NC}"
-    chroot /mnt /bin/bash -c "systemctl enable btrfs-maintenance.timer" || echo -e "${YELLOW}Warning: No se pudo habilitar btrfs-maintenance.timer${NC}"
+    chroot_run "systemctl daemon-reload" || echo -e "${YELLOW}Warning: No se pudo daemon-reload${NC}"
+    chroot_enable btrfs-maintenance.timer || echo -e "${YELLOW}Warning: No se pudo habilitar btrfs-maintenance.timer${NC}"
 
     # Crear script de documentación interactiva BTRFS y Snapper
     echo -e "${CYAN}Creando guía interactiva BTRFS y Snapper...${NC}"
@@ -393,14 +432,14 @@ verify_lvm_devices() {
     echo "• Dispositivos de mapeo:"
     ls -la /dev/mapper/ 2>/dev/null || echo "  No hay dispositivos en /dev/mapper/"
     echo "• Información de cryptsetup:"
-    cryptsetup status cryptlvm 2>/dev/null || echo "  cryptlvm no está activo"
+    cryptsetup status ${LUKS_MAPPER_NAME} 2>/dev/null || echo "  ${LUKS_MAPPER_NAME} no está activo"
 
     # Esperar a que el sistema detecte los dispositivos
     sleep 5
 
     # Verificar que cryptlvm esté disponible
-    if [ ! -b "/dev/mapper/cryptlvm" ]; then
-        echo -e "${RED}ERROR: /dev/mapper/cryptlvm no está disponible${NC}"
+    if [ ! -b "/dev/mapper/${LUKS_MAPPER_NAME}" ]; then
+        echo -e "${RED}ERROR: /dev/mapper/${LUKS_MAPPER_NAME} no está disponible${NC}"
         echo -e "${YELLOW}Información de debugging:${NC}"
         echo "• Dispositivos en /dev/mapper/:"
         ls -la /dev/mapper/ 2>/dev/null
@@ -409,7 +448,7 @@ verify_lvm_devices() {
 
     # Activar volume groups
     echo -e "${CYAN}Activando volume groups...${NC}"
-    if ! vgchange -ay vg0; then
+    if ! vgchange -ay ${LVM_VG_NAME}; then
         echo -e "${RED}ERROR: No se pudieron activar los volúmenes LVM${NC}"
         echo -e "${YELLOW}Información de debugging:${NC}"
         echo "• Volume Groups disponibles:"
@@ -429,9 +468,9 @@ verify_lvm_devices() {
     while [ "$attempt" -le "$max_attempts" ]; do
         # Forzar actualización de dispositivos
         udevadm settle
-        vgchange -ay vg0 2>/dev/null || true
+        vgchange -ay ${LVM_VG_NAME} 2>/dev/null || true
 
-        if [ -b "/dev/vg0/root" ] && [ -b "/dev/vg0/swap" ]; then
+        if [ -b "/dev/${LVM_VG_NAME}/root" ] && [ -b "/dev/${LVM_VG_NAME}/swap" ]; then
             echo -e "${GREEN}✓ Dispositivos LVM verificados correctamente${NC}"
             echo -e "${CYAN}Información final:${NC}"
             echo "• Volume Groups:"
@@ -448,15 +487,15 @@ verify_lvm_devices() {
             echo -e "${YELLOW}Información intermedia de debugging:${NC}"
             echo "• Logical Volumes disponibles:"
             lvs 2>/dev/null || echo "  No hay logical volumes"
-            echo "• Dispositivos en /dev/vg0/:"
-            ls -la /dev/vg0/ 2>/dev/null || echo "  Directorio /dev/vg0/ no existe"
+            echo "• Dispositivos en /dev/${LVM_VG_NAME}/:"
+            ls -la /dev/${LVM_VG_NAME}/ 2>/dev/null || echo "  Directorio /dev/${LVM_VG_NAME}/ no existe"
         fi
 
         if [ "$attempt" -eq 10 ]; then
             echo -e "${YELLOW}Intentando reactivar volume groups...${NC}"
-            vgchange -an vg0 2>/dev/null || true
+            vgchange -an ${LVM_VG_NAME} 2>/dev/null || true
             sleep 2
-            vgchange -ay vg0 2>/dev/null || true
+            vgchange -ay ${LVM_VG_NAME} 2>/dev/null || true
         fi
 
         sleep 3
@@ -465,8 +504,8 @@ verify_lvm_devices() {
 
     echo -e "${RED}ERROR: Los dispositivos LVM no están disponibles después de $max_attempts intentos${NC}"
     echo -e "${RED}Información completa de debugging:${NC}"
-    echo -e "${RED}  • /dev/vg0/root existe: $([ -b '/dev/vg0/root' ] && echo 'SÍ' || echo 'NO')${NC}"
-    echo -e "${RED}  • /dev/vg0/swap existe: $([ -b '/dev/vg0/swap' ] && echo 'SÍ' || echo 'NO')${NC}"
+    echo -e "${RED}  • /dev/${LVM_VG_NAME}/root existe: $([ -b "/dev/$LVM_VG_NAME/root" ] && echo 'SÍ' || echo 'NO')${NC}"
+    echo -e "${RED}  • /dev/${LVM_VG_NAME}/swap existe: $([ -b "/dev/$LVM_VG_NAME/swap" ] && echo 'SÍ' || echo 'NO')${NC}"
     echo -e "${RED}  • Volume Groups:${NC}"
     vgs 2>/dev/null || echo "    No hay volume groups disponibles"
     echo -e "${RED}  • Logical Volumes:${NC}"
@@ -480,7 +519,9 @@ verify_lvm_devices() {
     return 1
 }
 
-# Configuración inicial del LiveCD
+# Configuración inicial del LiveCD (una instancia a la vez en el modo multi-disco)
+live_lock
+timing_phase "livecd"
 echo -e "${GREEN}| Configurando LiveCD |${NC}"
 echo ""
 
@@ -507,6 +548,7 @@ sudo localectl set-x11-keymap $KEYBOARD_LAYOUT pc105 "" "" 2>/dev/null || true
 clear
 
 # Actualización de keys
+timing_phase "keys_livecd"
 echo -e "${GREEN}| Actualizando lista de Keys en LiveCD |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -514,12 +556,10 @@ update_repositories
 clear
 # Instala sin verificar firmas temporalmente
 install_pacman_livecd_with_retry "archlinux-keyring"
-# Luego reinicia las claves
+# Luego revisa las claves: init/populate solo si el anillo no está completo
 sudo chmod 700 /root/.gnupg
 sudo chmod 600 /root/.gnupg/*
-run_command_with_retry "sudo pacman-key --init"
-run_command_with_retry "sudo pacman-key --populate archlinux"
-sleep 2
+keyring_prepare_livecd
 clear
 
 # Instalación de herramientas necesarias
@@ -530,6 +570,7 @@ install_pacman_livecd_with_retry "rsync"
 clear
 
 # Actualización de mirrorlist
+timing_phase "mirrors"
 echo -e "${GREEN}| Actualizando mejores listas de Mirrors |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 barra_progreso
@@ -539,7 +580,9 @@ clear
 cat /etc/pacman.d/mirrorlist
 sleep 3
 clear
+live_unlock
 
+timing_phase "particionado"
 # -------------------------------------------------
 source "$(dirname "$0")/config_disk.sh"
 # -------------------------------------------------
@@ -655,10 +698,13 @@ setup_chroot_mounts() {
     fi
     cp /etc/resolv.conf /mnt/etc/
     echo -e "${GREEN}✓ Montajes para chroot configurados${NC}"
+    chroot_agent_start
 }
 
 cleanup_chroot_mounts() {
     echo -e "${CYAN}Limpiando montajes de chroot...${NC}"
+    # El agente tiene /mnt como raíz: terminarlo antes de desmontar
+    chroot_agent_stop
     umount -l /mnt/sys/firmware/efi/efivars 2>/dev/null || true
     umount -l /mnt/run 2>/dev/null || true
     umount -l /mnt/dev 2>/dev/null || true
@@ -667,6 +713,25 @@ cleanup_chroot_mounts() {
     echo -e "${GREEN}✓ Montajes de chroot limpiados${NC}"
 }
 
+# En el modo multi-disco el LiveCD sigue en uso al terminar cada destino: se
+# sueltan su swap, sus montajes, el grupo LVM y el mapeo LUKS para poder
+# retirar el disco sin tocar los de las otras instancias
+release_target_devices() {
+    local device
+
+    echo -e "${CYAN}Liberando los dispositivos de $SELECTED_DISK...${NC}"
+    for device in $(lsblk -lnpo NAME "$SELECTED_DISK" 2>/dev/null) \
+                  $(swapon --show=NAME --noheadings --raw 2>/dev/null | grep '^/mnt/'); do
+        swapoff "$device" 2>/dev/null || true
+    done
+    umount -R /mnt 2>/dev/null || umount -R -l /mnt 2>/dev/null || true
+    if [ "$ENCRYPTION" = "true" ]; then
+        vgchange -an "$LVM_VG_NAME" 2>/dev/null || true
+        cryptsetup close "$LUKS_MAPPER_NAME" 2>/dev/null || true
+    fi
+    echo -e "${GREEN}✓ $SELECTED_DISK liberado${NC}"
+}
+
 # Ejecutar limpieza de particiones
 unmount_selected_disk_partitions
 cleanup_chroot_mounts
@@ -695,8 +760,21 @@ echo ""
 lsblk -o NAME,FSTYPE,SIZE,MOUNTPOINT | grep -E "(NAME|/mnt)"
 sleep 3
 
+# -------------------------------------------------
+source "$(dirname "$0")/golden_image.sh"
+# -------------------------------------------------
+
+# Con una imagen maestra verificada se omite pacstrap y solo se configura la máquina
+if [ -n "$ARCRIS_GOLDEN_IMAGE" ]; then
+    golden_image_deploy
+    deploy_status=$?
+    [ -n "$ARCRIS_LIVE_LOCK" ] && release_target_devices
+    exit $deploy_status
+fi
+
 
 # Instalación de paquetes principales
+timing_phase "pacstrap_base"
 echo -e "${GREEN}| Instalando paquetes principales de la distribución |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -819,11 +897,13 @@ cat /mnt/etc/pacman.d/mirrorlist
 sleep 3
 clear
 
+timing_phase "fstab"
 # -------------------------------------------------
 source "$(dirname "$0")/config_fstab.sh"
 # -------------------------------------------------
 
 # Instalación del kernel seleccionado
+timing_phase "kernel"
 echo -e "${GREEN}| Instalando kernel: $SELECTED_KERNEL |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -862,6 +942,7 @@ clear
 
 
 # Configuración del sistema
+timing_phase "sistema_base"
 echo -e "${GREEN}| Configurando sistema base |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -869,12 +950,12 @@ echo ""
 # Instalación de paquetes principales
 echo -e "${GREEN}| Instalando paquetes principales de la distribución |${NC}"
 # Configuración de zona horaria
-chroot /mnt /bin/bash -c "ln -sf /usr/share/zoneinfo/$TIMEZONE /etc/localtime"
-chroot /mnt /bin/bash -c "hwclock --systohc"
+chroot_run "ln -sf /usr/share/zoneinfo/$TIMEZONE /etc/localtime"
+chroot_run "hwclock --systohc"
 
 # Configuración de locale
 echo "$LOCALE UTF-8" >> /mnt/etc/locale.gen
-chroot /mnt /bin/bash -c "locale-gen"
+chroot_run "locale-gen"
 echo "LANG=$LOCALE" > /mnt/etc/locale.conf
 
 # Configuración de teclado
@@ -893,6 +974,7 @@ sleep 3
 clear
 
 # Configuración de usuarios y contraseñas
+timing_phase "usuarios"
 echo -e "${GREEN}| Configurando usuarios |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -901,7 +983,7 @@ echo ""
 echo "root:$PASSWORD_ROOT" | chroot /mnt /bin/bash -c "chpasswd"
 
 # Crear usuario
-chroot /mnt /bin/bash -c "useradd -m -G wheel,audio,video,optical,storage,input -s /bin/bash $USER"
+chroot_run "useradd -m -G wheel,audio,video,optical,storage,input -s /bin/bash $USER"
 echo "$USER:$PASSWORD_USER" | chroot /mnt /bin/bash -c "chpasswd"
 
 
@@ -909,6 +991,7 @@ echo "$USER:$PASSWORD_USER" | chroot /mnt /bin/bash -c "chpasswd"
 install_pacstrap_with_retry "sudo"
 
 # Configuración temporal NOPASSWD para instalaciones
+timing_phase "sudo_temporal"
 echo -e "${GREEN}| Configurando permisos sudo temporales |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -920,8 +1003,8 @@ if [[ -n "$USUARIOS_EXISTENTES" ]]; then
     echo "✓ Usuarios detectados en el sistema:"
     echo "$USUARIOS_EXISTENTES" | while read -r usuario; do
         echo "  - $usuario"
-        chroot /mnt /bin/bash -c "userdel $usuario"
-        chroot /mnt /bin/bash -c "useradd -m -G wheel,audio,video,optical,storage -s /bin/bash $USER"
+        chroot_run "userdel $usuario"
+        chroot_run "useradd -m -G wheel,audio,video,optical,storage -s /bin/bash $USER"
         echo "$USER:$PASSWORD_USER" | chroot /mnt /bin/bash -c "chpasswd"
     done
     echo ""
@@ -956,14 +1039,14 @@ chmod 440 /mnt/etc/sudoers.d/temp-install
 echo "🔧 Verificando configuración wheel en sudoers..."
 
 # Verificar si existe la línea exacta %wheel ALL=(ALL) ALL
-if chroot /mnt /bin/bash -c "grep -q '^%wheel ALL=(ALL) ALL$' /etc/sudoers" 2>/dev/null; then
+if chroot_run "grep -q '^%wheel ALL=(ALL) ALL$' /etc/sudoers 2>/dev/null"; then
     echo "🔄 Detectada configuración wheel normal, cambiando a NOPASSWD..."
 
     # Cambiar la línea específica
     sed -i 's/^%wheel ALL=(ALL) ALL$/%wheel ALL=(ALL:ALL) NOPASSWD: ALL/' /mnt/etc/sudoers
 
     # Verificar que el cambio se aplicó correctamente
-    if chroot /mnt /bin/bash -c "grep -q '^%wheel ALL=(ALL:ALL) NOPASSWD: ALL$' /etc/sudoers" 2>/dev/null; then
+    if chroot_run "grep -q '^%wheel ALL=(ALL:ALL) NOPASSWD: ALL$' /etc/sudoers 2>/dev/null"; then
         echo "✓ Configuración wheel cambiada exitosamente a NOPASSWD"
     else
         echo "❌ Error: No se pudo cambiar la configuración wheel"
@@ -994,6 +1077,7 @@ sleep 2
 clear
 
 # Configuración de mkinitcpio según el modo de particionado
+timing_phase "mkinitcpio"
 echo -e "${GREEN}| Configurando mkinitcpio |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -1100,20 +1184,25 @@ echo -e "${YELLOW}Nota: Los warnings de firmware son normales${NC}"
 # Con LUKS+LVM: activar vg0 antes de mkinitcpio para que autodetect
 # detecte dm-crypt y lvm2 y los incluya en el initramfs
 if [ "$ENCRYPTION" = "true" ]; then
-    vgchange -ay vg0 2>/dev/null || true
-    udevadm settle --timeout=10
+    vgchange -ay ${LVM_VG_NAME} 2>/dev/null || true
+    wait_for_devices /dev/${LVM_VG_NAME}/root
 fi
 
-if chroot /mnt /bin/bash -c "mkinitcpio -P"; then
+initramfs_configure
+if sdboot_enabled; then
+    # Las UKI se generan una sola vez al instalar systemd-boot
+    sdboot_prepare_mkinitcpio
+elif initramfs_build; then
     echo -e "${GREEN}✓ Initramfs generado correctamente${NC}"
 else
     echo -e "${YELLOW}Reintentando con configuración básica...${NC}"
-    chroot /mnt /bin/bash -c "mkinitcpio -p linux"
+    chroot_run "mkinitcpio -p linux"
 fi
 sleep 2
 clear
 
 
+timing_phase "zram_bootloader"
 # -------------------------------------------------
 if [ "$SWAP_TYPE" != "none" ]; then
     source "$(dirname "$0")/config_zram.sh"
@@ -1121,19 +1210,25 @@ else
     echo -e "${CYAN}  • SWAP_TYPE=none: sin zram ni swap${NC}"
 fi
 # -------------------------------------------------
-source "$(dirname "$0")/config_grub.sh"
+source "$(dirname "$0")/config_performance.sh"
 # -------------------------------------------------
+if sdboot_enabled; then
+    sdboot_install
+else
+    source "$(dirname "$0")/config_grub.sh"
 
-# Crear script helper para actualizar GRUB después de snapshots manuales
-cat > /mnt/usr/local/bin/grub-update << 'UPDATEGRUB'
+    # Crear script helper para actualizar GRUB después de snapshots manuales
+    cat > /mnt/usr/local/bin/grub-update << 'UPDATEGRUB'
 #!/bin/bash
 # Script para actualizar GRUB
 echo "Actualizando GRUB..."
 grub-mkconfig -o /boot/grub/grub.cfg
 echo "✓ GRUB actualizado"
 UPDATEGRUB
-chmod +x /mnt/usr/local/bin/grub-update
-echo -e "${GREEN}✓ Script helper creado: /usr/local/bin/grub-update${NC}"
+    chmod +x /mnt/usr/local/bin/grub-update
+    echo -e "${GREEN}✓ Script helper creado: /usr/local/bin/grub-update${NC}"
+fi
+boot_report_install
 # -------------------------------------------------
 
 # Crear script helper para actualizar reflector-update después de snapshots manuales
@@ -1230,6 +1325,7 @@ echo -e "${GREEN}✓ Script helper creado: /usr/local/bin/clear-arch${NC}"
 # -------------------------------------------------
 sleep 3
 clear
+timing_phase "drivers"
 # -------------------------------------------------
 source "$(dirname "$0")/driver_video.sh"
 # -------------------------------------------------
@@ -1241,6 +1337,7 @@ source "$(dirname "$0")/driver_bluetooth.sh"
 # -------------------------------------------------
 
 # Instalación de herramientas de red
+timing_phase "herramientas_red"
 echo -e "${GREEN}| Instalando herramientas de red |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -1250,11 +1347,12 @@ install_pacman_chroot_with_retry "dhclient"
 install_pacman_chroot_with_retry "networkmanager"
 install_pacman_chroot_with_retry "wpa_supplicant"
 # Deshabilitar dhcpcd para evitar conflictos con NetworkManager
-chroot /mnt /bin/bash -c "systemctl enable NetworkManager dhcpcd" || echo -e "${RED}ERROR: Falló systemctl enable NetworkManager dhcpcd${NC}"
-chroot /mnt /bin/bash -c "timedatectl set-ntp true" || echo -e "${RED}ERROR: Falló set-ntp${NC}"
+chroot_enable NetworkManager dhcpcd || echo -e "${RED}ERROR: Falló systemctl enable NetworkManager dhcpcd${NC}"
+chroot_run "timedatectl set-ntp true" || echo -e "${RED}ERROR: Falló set-ntp${NC}"
 clear
 
 # Copiado de archivos de configuración de bash
+timing_phase "bashrc"
 echo -e "${GREEN}| Copiando archivos de configuración de bashrc |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -1264,16 +1362,17 @@ cp /usr/share/arcrisgui/data/config/bashrc /mnt/home/$USER/.bashrc
 cp /usr/share/arcrisgui/data/config/bashrc-root /mnt/root/.bashrc
 
 # Configurar permisos de archivos de usuario
-chroot /mnt /bin/bash -c "chown $USER:$USER /home/$USER/.bashrc"
+chroot_run "chown $USER:$USER /home/$USER/.bashrc"
 sleep 2
 clear
 
 # Configuración final del sistema
+timing_phase "configuracion_final"
 echo -e "${GREEN}| Configuración final del sistema |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
 # Configurar directorios de usuario
-chroot /mnt /bin/bash -c "su - $USER -c 'xdg-user-dirs-update'"
+chroot_run "su - $USER -c 'xdg-user-dirs-update'"
 
 # Configuración adicional para cifrado LUKS+LVM
 if [ "$ENCRYPTION" = "true" ]; then
@@ -1281,13 +1380,11 @@ if [ "$ENCRYPTION" = "true" ]; then
     printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
     echo ""
 
-    # crypttab: una sola entrada para la partición LUKS (LVM está dentro)
-    echo "cryptlvm UUID=${CRYPT_LUKS_UUID} none luks,discard" >> /mnt/etc/crypttab
-    echo -e "${GREEN}✓ crypttab configurado (UUID: $CRYPT_LUKS_UUID)${NC}"
+    # crypttab ya lo generó config_fstab.sh junto con fstab
 
     # Habilitar y activar LVM dentro del chroot
-    chroot /mnt /bin/bash -c "systemctl enable lvm2-monitor.service"
-    chroot /mnt /bin/bash -c "vgchange -ay vg0"
+    chroot_enable lvm2-monitor.service
+    chroot_run "vgchange -ay ${LVM_VG_NAME}"
     echo -e "${GREEN}✓ LVM habilitado en el sistema instalado${NC}"
 fi
 
@@ -1306,11 +1403,12 @@ sleep 3
 clear
 cp /usr/share/arcrisgui/data/config/pacman-chroot.conf /mnt/etc/pacman.conf
 cp /home/arcris/.config/xfce4/backgroundarch.jpg /mnt/usr/share/pixmaps/backgroundarch.jpg
-chroot /mnt /bin/bash -c "mkdir -p /home/$USER/.config/fastfetch"
-chroot /mnt /bin/bash -c "cp /usr/share/fastfetch/presets/screenfetch.jsonc /home/$USER/.config/fastfetch/config.jsonc" || echo -e "${RED}ERROR: No se copio el archivo config.jsonc${NC}"
-chroot /mnt /bin/bash -c "chown -R $USER:$USER /home/$USER/.config/fastfetch" || echo -e "${RED}ERROR: chown del usuario${NC}"
+chroot_run "mkdir -p /home/$USER/.config/fastfetch"
+chroot_run "cp /usr/share/fastfetch/presets/screenfetch.jsonc /home/$USER/.config/fastfetch/config.jsonc" || echo -e "${RED}ERROR: No se copio el archivo config.jsonc${NC}"
+chroot_run "chown -R $USER:$USER /home/$USER/.config/fastfetch" || echo -e "${RED}ERROR: chown del usuario${NC}"
 
 clear
+timing_phase "entorno_grafico"
 # -------------------------------------------------
 source "$(dirname "$0")/entorno_grafico.sh"
 # -------------------------------------------------
@@ -1375,6 +1473,7 @@ fi
 # --------------------------------------------------------------------------------------
 # Configuración de repositorios de Arch Linux
 echo ""
+timing_phase "repositorios"
 echo -e "${GREEN}| Configurando repositorios de Arch Linux |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
@@ -1396,9 +1495,7 @@ if [ "$REPOS_CHAOTIC_AUR" = "true" ]; then
     while true; do
         wait_for_internet || break
         echo -e "${CYAN}🔄 Intento #$_attempt para configurar Chaotic-AUR${NC}"
-        if chroot /mnt /bin/bash -c "
-            pacman-key --recv-key 3056513887B78AEB --keyserver keyserver.ubuntu.com && \
-            pacman-key --lsign-key 3056513887B78AEB && \
+        if keyring_import_chroot "${KEYRING_THIRD_PARTY[chaotic-aur]}" && chroot /mnt /bin/bash -c "
             pacman -U --noconfirm \
                 'https://cdn-mirror.chaotic.cx/chaotic-aur/chaotic-keyring.pkg.tar.zst' \
                 'https://cdn-mirror.chaotic.cx/chaotic-aur/chaotic-mirrorlist.pkg.tar.zst'
@@ -1434,7 +1531,8 @@ EOF
     while true; do
         wait_for_internet || break
         echo -e "${CYAN}🔄 Intento #$_attempt para instalar archlinuxcn-keyring${NC}"
-        if chroot /mnt /bin/bash -c "pacman -Sy --noconfirm archlinuxcn-keyring"; then
+        if keyring_lsign_arch_chroot "${KEYRING_ARCH_SIGNERS[archlinuxcn]}" &&
+           chroot_run "pacman -Sy --noconfirm archlinuxcn-keyring"; then
             echo -e "${GREEN}✓ ArchLinuxCN configurado${NC}"
             break
         else
@@ -1463,10 +1561,12 @@ if [ "$REPOS_CACHYOS" = "true" ]; then
         wait_for_internet || break
         echo -e "${CYAN}🔄 Intento #$_attempt para configurar CachyOS${NC}"
         rm -rf /tmp/cachyos-repo /tmp/cachyos-repo.tar.xz /mnt/tmp/cachyos-repo 2>/dev/null || true
-        if curl -fsSL https://mirror.cachyos.org/cachyos-repo.tar.xz -o /tmp/cachyos-repo.tar.xz && \
+        # La clave ya firmada: cachyos-repo.sh no depende del servidor de claves para confiar en ella
+        if keyring_import_chroot "${KEYRING_THIRD_PARTY[cachyos]}" && \
+           curl -fsSL https://mirror.cachyos.org/cachyos-repo.tar.xz -o /tmp/cachyos-repo.tar.xz && \
            tar xf /tmp/cachyos-repo.tar.xz -C /tmp && \
            cp -r /tmp/cachyos-repo /mnt/tmp/cachyos-repo && \
-           chroot /mnt /bin/bash -c "cd /tmp/cachyos-repo && yes | bash ./cachyos-repo.sh"; then
+           chroot_run "cd /tmp/cachyos-repo && yes | bash ./cachyos-repo.sh"; then
             rm -rf /tmp/cachyos-repo /tmp/cachyos-repo.tar.xz /mnt/tmp/cachyos-repo 2>/dev/null || true
             echo -e "${GREEN}✓ CachyOS configurado (arquitectura detectada automáticamente)${NC}"
             break
@@ -1482,7 +1582,7 @@ fi
 # Sincronizar base de datos con los nuevos repositorios
 if [ "$REPOS_CHAOTIC_AUR" = "true" ] || [ "$REPOS_ARCHLINUXCN" = "true" ] || [ "$REPOS_CACHYOS" = "true" ]; then
     echo -e "${CYAN}Sincronizando base de datos con los nuevos repositorios...${NC}"
-    chroot /mnt /bin/bash -c "pacman -Syy --noconfirm"
+    chroot_run "pacman -Syy --noconfirm"
     echo -e "${GREEN}✓ Repositorios adicionales listos${NC}"
 fi
 
@@ -1495,9 +1595,9 @@ clear
 
 # Actualizar sistema con reintentos
 update_system_chroot
-chroot /mnt /bin/bash -c "sudo -u $user yay -Scc --noconfirm"
+chroot_run "sudo -u $user yay -Scc --noconfirm"
 clear
-chroot /mnt /bin/bash -c "pacman -Syyy --noconfirm"
+chroot_run "pacman -Syyy --noconfirm"
 sleep 3
 clear
 
@@ -1508,13 +1608,14 @@ clear
 
 
 # Revertir a configuración sudo normal
+timing_phase "finalizacion"
 echo -e "${GREEN}| Revirtiendo configuración sudo temporal |${NC}"
 printf '%*s\n' "${COLUMNS:-$(tput cols)}" '' | tr ' ' _
 echo ""
 
 # Eliminar configuración temporal
 if [[ -f "/mnt/etc/sudoers.d/temp-install" ]]; then
-    chroot /mnt /bin/bash -c "rm -f /etc/sudoers.d/temp-install"
+    chroot_run "rm -f /etc/sudoers.d/temp-install"
     echo "✓ Configuración temporal eliminada"
 else
     echo "⚠️  Archivo temporal no encontrado (ya fue eliminado)"
@@ -1527,14 +1628,14 @@ echo "🔧 Configurando grupo wheel en sudoers..."
 #chmod 440 /mnt/etc/sudoers.d/wheel
 
 # Verificar si existe configuración NOPASSWD
-if chroot /mnt /bin/bash -c "grep -q '^%wheel.*NOPASSWD.*ALL' /etc/sudoers" 2>/dev/null; then
+if chroot_run "grep -q '^%wheel.*NOPASSWD.*ALL' /etc/sudoers 2>/dev/null"; then
     echo "🔄 Detectada configuración NOPASSWD, cambiando a configuración normal..."
     # Cambiar de NOPASSWD a configuración normal
-    chroot /mnt /bin/bash -c "sed -i 's/^%wheel.*NOPASSWD.*ALL$/%wheel ALL=(ALL) ALL/' /etc/sudoers"
+    chroot_run "sed -i 's/^%wheel.*NOPASSWD.*ALL$/%wheel ALL=(ALL) ALL/' /etc/sudoers"
     echo "✓ Configuración wheel cambiada a modo normal (con contraseña)"
 
 # Verificar si existe configuración normal
-elif chroot /mnt /bin/bash -c "grep -q '^%wheel.*ALL.*ALL' /etc/sudoers" 2>/dev/null; then
+elif chroot_run "grep -q '^%wheel.*ALL.*ALL' /etc/sudoers 2>/dev/null"; then
     echo "✓ Configuración wheel normal ya existe en sudoers"
 
 # Si no existe ninguna configuración wheel, agregarla
@@ -1564,6 +1665,11 @@ echo "Defaults pwfeedback" >> /mnt/etc/sudoers
 cleanup_chroot_mounts
 sleep 1
 clear
+
+# Guardar el sistema instalado como imagen maestra (modo desatendido)
+if [ -n "$ARCRIS_CAPTURE_IMAGE" ]; then
+    golden_image_capture
+fi
 # Mostrar información importante para sistemas cifrados
 if [ "$ENCRYPTION" = "true" ]; then
     clear
@@ -1579,7 +1685,7 @@ if [ "$ENCRYPTION" = "true" ]; then
     echo -e "${GREEN}✓ Configuración aplicada:${NC}"
     echo -e "${CYAN}  • Filesystem: $FILESYSTEM_TYPE | Home: $HOME_PARTITION | Swap: $SWAP_TYPE${NC}"
     echo -e "${CYAN}  • Partición LUKS UUID: $CRYPT_LUKS_UUID${NC}"
-    echo -e "${CYAN}  • LVM vg0: $([ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && echo "swap(${SWAP_SIZE_MIB}MiB) + " || echo "")root + $([ "$HOME_PARTITION" = "partition" ] && echo "home" || echo "(sin home LV)")${NC}"
+    echo -e "${CYAN}  • LVM ${LVM_VG_NAME}: $([ "${SWAP_SIZE_MIB:-0}" -gt 0 ] && echo "swap(${SWAP_SIZE_MIB}MiB) + " || echo "")root + $([ "$HOME_PARTITION" = "partition" ] && echo "home" || echo "(sin home LV)")${NC}"
     echo ""
     echo -e "${RED}⚠️  ADVERTENCIAS IMPORTANTES:${NC}"
     echo -e "${RED}  • SIN LA CONTRASEÑA LUKS PERDERÁS TODOS TUS DATOS${NC}"
@@ -1602,7 +1708,11 @@ fi
 echo ""
 echo -e "${YELLOW}IMPORTANTE:${NC}"
 echo -e "${CYAN}• Reinicia el sistema y retira el medio de instalación${NC}"
-echo -e "${CYAN}• El sistema iniciará con GRUB${NC}"
+if sdboot_enabled; then
+    echo -e "${CYAN}• El sistema iniciará con systemd-boot${NC}"
+else
+    echo -e "${CYAN}• El sistema iniciará con GRUB${NC}"
+fi
 if [ "$ENCRYPTION" = "true" ]; then
     echo -e "${CYAN}• Se solicitará la contraseña de cifrado al iniciar${NC}"
 fi
@@ -1632,3 +1742,28 @@ barra_progreso
 echo -e "${GREEN}✓ Instalación de ARCRIS LINUX completada exitosamente!${NC}"
 sleep 2
 clear
+
+# Informe de tiempos de la instalación (también lo lee la página 9)
+timing_finish
+
+# Copia del registro de la instalación al sistema instalado (lo escribe
+# arcris-log; sin él es el typescript de script)
+if [[ -n "${ARCRIS_INSTALL_LOG:-}" ]]; then
+    # arcris-log cierra el bloque comprimido en curso tras medio segundo sin salida
+    sleep 1
+    if [[ "$ARCRIS_INSTALL_LOG" == *.gz ]]; then
+        log_destino="/mnt/var/log/arcris-install.log.gz"
+    else
+        log_destino="/mnt/var/log/arcris-install.log"
+    fi
+    if [[ -f "$ARCRIS_INSTALL_LOG" ]] && mkdir -p /mnt/var/log && cp "$ARCRIS_INSTALL_LOG" "$log_destino"; then
+        chmod 600 "$log_destino"
+        echo "Registro de la instalación copiado en ${log_destino#/mnt}"
+    else
+        echo "No se pudo copiar el registro de la instalación"
+    fi
+fi
+
+if [ -n "$ARCRIS_LIVE_LOCK" ]; then
+    release_target_devices
+fi
@@ -0,0 +1,167 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Registro de tiempos de la instalación
+#
+# Cada evento se agrega como una línea TSV al diario ARCRIS_TIMING_JOURNAL, que la
+# página 9 lee para mostrar el desglose. Al terminar, timing_finish genera el
+# informe JSON en /mnt/var/log/arcris-install-report.json.
+#
+# Columnas: tipo  nombre  inicio_ms  duración_ms  bytes  reintentos  espera_ms  estado
+#   phase   → una etapa de install.sh (bytes/reintentos/espera acumulados en ella)
+#   package → una transacción de pacstrap/pacman/yay/AUR
+#   initramfs → una imagen de mkinitcpio (preset:archivo, tiempo del preset, tamaño)
+#   mirror  → un espejo en una descarga de arcris-fetch (bytes, trozos pasados a
+#             otro espejo en "reintentos", estado disabled si se descartó)
+#
+# La página 8 escribe aparte el consumo del árbol de procesos de la instalación
+# (ver src/proc_monitor.h) y pasa su ruta en ARCRIS_RESOURCE_JOURNAL; el informe
+# lo incluye como serie temporal en "resources". Sin esa variable (modo
+# desatendido o varios destinos) la serie queda vacía en lugar de leer la de
+# otra instalación.
+# -----------------------------------------------------------------------------------
+
+ARCRIS_TIMING_JOURNAL="${ARCRIS_TIMING_JOURNAL:-/tmp/arcris-timing.tsv}"
+ARCRIS_RESOURCE_JOURNAL="${ARCRIS_RESOURCE_JOURNAL:-}"
+TIMING_REPORT_PATH="/mnt/var/log/arcris-install-report.json"
+
+TIMING_PHASE_NAME=""
+TIMING_PHASE_START=0
+TIMING_PHASE_BYTES=0
+TIMING_PHASE_RETRIES=0
+TIMING_PHASE_IDLE=0
+
+: > "$ARCRIS_TIMING_JOURNAL"
+
+# Milisegundos desde epoch sin lanzar procesos (EPOCHREALTIME, bash >= 5; el
+# separador decimal depende de LC_NUMERIC y puede ser una coma)
+timing_now() {
+    local now="${EPOCHREALTIME/[.,]/}"
+    TIMING_NOW=$(( now / 1000 ))
+}
+
+timing_record() {
+    printf '%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n' "$@" >> "$ARCRIS_TIMING_JOURNAL"
+}
+
+# Cierra la etapa actual y abre otra
+timing_phase() {
+    timing_now
+    if [[ -n "$TIMING_PHASE_NAME" ]]; then
+        timing_record phase "$TIMING_PHASE_NAME" "$TIMING_PHASE_START" \
+            $(( TIMING_NOW - TIMING_PHASE_START )) \
+            "$TIMING_PHASE_BYTES" "$TIMING_PHASE_RETRIES" "$TIMING_PHASE_IDLE" ok
+    fi
+    TIMING_PHASE_NAME="$1"
+    TIMING_PHASE_START=$TIMING_NOW
+    TIMING_PHASE_BYTES=0
+    TIMING_PHASE_RETRIES=0
+    TIMING_PHASE_IDLE=0
+}
+
+# Las pausas (sleep de los scripts y esperas de wait_for_internet) cuentan como espera
+sleep() {
+    timing_now
+    local start=$TIMING_NOW
+    command sleep "$@"
+    timing_now
+    TIMING_PHASE_IDLE=$(( TIMING_PHASE_IDLE + TIMING_NOW - start ))
+}
+
+timing_cache_bytes() {
+    local bytes
+    bytes=$(du -sb "$1" 2>/dev/null | cut -f1)
+    echo "${bytes:-0}"
+}
+
+# Inicio de una transacción de paquetes; cache es el directorio donde descarga
+timing_package_begin() {
+    TIMING_PKG_CACHE="$1"
+    TIMING_PKG_BYTES=$(timing_cache_bytes "$TIMING_PKG_CACHE")
+    timing_now
+    TIMING_PKG_START=$TIMING_NOW
+}
+
+# Fin de la transacción: método, paquete, número de intentos y estado (ok|failed)
+timing_package_end() {
+    local method="$1" package="$2" attempts="$3" status="$4"
+    local bytes=$(( $(timing_cache_bytes "$TIMING_PKG_CACHE") - TIMING_PKG_BYTES ))
+    (( bytes < 0 )) && bytes=0
+    timing_now
+    timing_record package "$method:$package" "$TIMING_PKG_START" \
+        $(( TIMING_NOW - TIMING_PKG_START )) "$bytes" $(( attempts - 1 )) 0 "$status"
+    TIMING_PHASE_BYTES=$(( TIMING_PHASE_BYTES + bytes ))
+    TIMING_PHASE_RETRIES=$(( TIMING_PHASE_RETRIES + attempts - 1 ))
+}
+
+timing_json_escape() {
+    local value="${1//\\/\\\\}"
+    echo -n "${value//\"/\\\"}"
+}
+
+# Cierra la última etapa y escribe el informe JSON en el sistema instalado
+timing_finish() {
+    timing_phase ""
+
+    local mirror cpu
+    mirror=$(grep -m1 '^Server' /etc/pacman.d/mirrorlist 2>/dev/null | sed 's/^Server *= *//')
+    cpu=$(grep -m1 'model name' /proc/cpuinfo 2>/dev/null | sed 's/.*: //')
+
+    mkdir -p "$(dirname "$TIMING_REPORT_PATH")"
+    {
+        echo "{"
+        echo "  \"version\": 1,"
+        echo "  \"date\": \"$(date -Iseconds)\","
+        echo "  \"kernel\": \"$(timing_json_escape "$SELECTED_KERNEL")\","
+        echo "  \"bootloader\": \"$(timing_json_escape "${BOOTLOADER:-grub}")\","
+        echo "  \"filesystem\": \"$(timing_json_escape "$FILESYSTEM_TYPE")\","
+        echo "  \"mirror\": \"$(timing_json_escape "$mirror")\","
+        echo "  \"cpu\": \"$(timing_json_escape "$cpu")\","
+        echo "  \"disk\": \"$(timing_json_escape "$SELECTED_DISK")\","
+        awk -F'\t' -v initramfs_profile="${INITRAMFS_PROFILE:-default}" \
+                    -v initramfs_fallback="${INITRAMFS_FALLBACK:-true}" '
+            function entry(sep) {
+                gsub(/\\/, "&&", $2); gsub(/"/, "\\\"", $2)
+                return sprintf("%s    {\"name\": \"%s\", \"start_ms\": %s, \"duration_ms\": %s, \"bytes\": %s, \"retries\": %s, \"idle_ms\": %s, \"status\": \"%s\"}",
+                               sep, $2, $3, $4, $5, $6, $7, $8)
+            }
+            $1 == "phase" {
+                phases = phases entry(np++ ? ",\n" : "")
+                total += $4; idle += $7; bytes += $5; retries += $6
+            }
+            $1 == "package" { packages = packages entry(nk++ ? ",\n" : "") }
+            $1 == "initramfs" { images = images entry(ni++ ? ",\n" : "") }
+            $1 == "mirror" {
+                if (!($2 in mirror_bytes)) mirror_order[nm++] = $2
+                mirror_bytes[$2] += $5; mirror_ms[$2] += $4; mirror_failovers[$2] += $6
+                if ($8 == "disabled") mirror_disabled[$2]++
+            }
+            END {
+                printf "  \"total_ms\": %d,\n  \"idle_ms\": %d,\n  \"download_bytes\": %d,\n  \"retries\": %d,\n", total, idle, bytes, retries
+                printf "  \"phases\": [\n%s\n  ],\n", phases
+                printf "  \"packages\": [\n%s\n  ],\n", packages
+                printf "  \"initramfs\": {\n    \"profile\": \"%s\",\n    \"fallback\": %s,\n    \"images\": [\n%s\n    ]\n  },\n",
+                       initramfs_profile, initramfs_fallback == "false" ? "false" : "true", images
+                for (i = 0; i < nm; i++) {
+                    m = mirror_order[i]
+                    host = m; gsub(/\\/, "&&", host); gsub(/"/, "\\\"", host)
+                    mirrors = mirrors sprintf("%s    {\"host\": \"%s\", \"bytes\": %d, \"duration_ms\": %d, \"failovers\": %d, \"disabled\": %d}",
+                                              i ? ",\n" : "", host, mirror_bytes[m], mirror_ms[m], mirror_failovers[m], mirror_disabled[m])
+                }
+                printf "  \"mirrors\": [\n%s\n  ],\n", mirrors
+            }' "$ARCRIS_TIMING_JOURNAL"
+        # Solo la serie que la página 8 midió para esta instalación
+        { [ -n "$ARCRIS_RESOURCE_JOURNAL" ] && cat "$ARCRIS_RESOURCE_JOURNAL" 2>/dev/null || true; } | awk -F'\t' '
+            NF >= 8 {
+                samples = samples sprintf("%s      [%s, %s, %s, %s, %s, %s, %s, %s]",
+                                          n++ ? ",\n" : "", $1, $2, $3, $4, $5, $6, $7, $8)
+            }
+            END {
+                printf "  \"resources\": {\n"
+                printf "    \"columns\": [\"time_ms\", \"cpu_percent\", \"rss_bytes\", \"read_bytes_per_s\", \"write_bytes_per_s\", \"rx_bytes_per_s\", \"tx_bytes_per_s\", \"processes\"],\n"
+                printf "    \"samples\": [\n%s\n    ]\n  }\n", samples
+            }'
+        echo "}"
+    } > "$TIMING_REPORT_PATH"
+
+    echo -e "${GREEN}✓ Informe de tiempos guardado en ${TIMING_REPORT_PATH#/mnt}${NC}"
+}
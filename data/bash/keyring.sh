@@ -0,0 +1,186 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Anillo de claves de pacman
+#
+# El LiveCD de Arch ya trae el anillo inicializado y poblado (pacman-init.service),
+# y una instalación anterior en la misma sesión deja el suyo: si tiene la clave
+# local y la confianza de todas las claves maestras de archlinux-keyring no se
+# vuelve a ejecutar pacman-key --init (lento en máquinas virtuales con poca
+# entropía) ni --populate. pacstrap copia después este anillo al sistema nuevo.
+#
+# Las claves de los repositorios de terceros se descargan por HTTPS con timeout
+# en lugar de con pacman-key --recv-key, que puede quedarse esperando a
+# dirmngr, y quedan en la caché para la siguiente instalación. data/keys no se
+# versiona: solo tiene claves (<huella>.asc) si se exportaron con --export-keys
+# antes de empaquetar, y entonces se usan sin red. pacman-key --recv-key queda
+# como último recurso. Cada archivo se acepta solo si contiene una única clave
+# cuya huella completa (40 hexadecimales) es la esperada.
+#
+#   bash keyring.sh --prepare      → lo que no depende de las respuestas, en segundo
+#                                    plano desde la interfaz (ver src/keyring_prep.c)
+#   bash keyring.sh --export-keys  → descarga y verifica las claves en data/keys
+#                                    (para actualizarlas antes de publicar)
+#   source keyring.sh              → funciones para install.sh
+# -----------------------------------------------------------------------------------
+
+KEYRING_DIR=/etc/pacman.d/gnupg
+KEYRING_TRUSTED=/usr/share/pacman/keyrings/archlinux-trusted
+KEYRING_LOCK=/tmp/arcris-keyring.lock
+KEYRING_LOG=/tmp/arcris-keyring.log
+KEYRING_KEY_CACHE=/var/cache/arcris/keys
+KEYRING_SHIPPED_KEYS="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)/keys"
+
+# Huellas de las claves de los repositorios de terceros que install.sh firma
+# localmente. archlinuxcn-keyring va firmado por un empaquetador de Arch cuya
+# clave ya está en archlinux-keyring: basta con firmarla localmente
+declare -A KEYRING_THIRD_PARTY=(
+    [chaotic-aur]=EF925EA60F33D0CB85C44AD13056513887B78AEB
+    [cachyos]=882DCFE48E2051D48E2562ABF3B607488DB35A47
+)
+declare -A KEYRING_ARCH_SIGNERS=(
+    [archlinuxcn]=farseerfc@archlinux.org
+)
+
+# Anillo inicializado (clave local para firmar) y con la confianza de todas
+# las claves maestras que trae archlinux-keyring
+keyring_ready() {
+    local ownertrust fpr
+
+    [ -s "$KEYRING_TRUSTED" ] || return 1
+    gpg --homedir "$KEYRING_DIR" --batch --list-secret-keys --with-colons 2>/dev/null | grep -q '^sec' || return 1
+    ownertrust=$(gpg --homedir "$KEYRING_DIR" --batch --export-ownertrust 2>/dev/null) || return 1
+
+    while IFS=: read -r fpr _; do
+        [ -z "$fpr" ] || [[ "$fpr" == \#* ]] && continue
+        [[ "$ownertrust" == *"$fpr:"* ]] || return 1
+    done < "$KEYRING_TRUSTED"
+    return 0
+}
+
+# Ejecuta un paso de pacman-key; en install.sh con los reintentos de siempre
+keyring_run() {
+    if declare -F run_command_with_retry >/dev/null; then
+        run_command_with_retry "sudo $1"
+    else
+        eval "$1"
+    fi
+}
+
+# Deja listo el anillo del LiveCD. Si la interfaz lo está preparando en
+# segundo plano, espera a que termine
+keyring_prepare_livecd() {
+    local lock_fd
+
+    exec {lock_fd}>"$KEYRING_LOCK"
+    flock "$lock_fd"
+
+    if keyring_ready; then
+        echo -e "${GREEN}✓ Anillo de claves del LiveCD ya preparado, se reutiliza${NC}"
+    else
+        if ! gpg --homedir "$KEYRING_DIR" --batch --list-secret-keys --with-colons 2>/dev/null | grep -q '^sec'; then
+            keyring_run "pacman-key --init"
+        fi
+        keyring_run "pacman-key --populate archlinux"
+    fi
+
+    flock -u "$lock_fd"
+    exec {lock_fd}>&-
+}
+
+# El archivo contiene una sola clave pública y su huella es exactamente fpr.
+# Un sufijo (el id largo) se puede falsificar generando claves hasta que
+# coincida; la huella completa no
+keyring_key_matches() {
+    local file="$1" fpr="${2^^}" listing
+
+    [ -s "$file" ] || return 1
+    listing=$(gpg --batch --with-colons --show-keys "$file" 2>/dev/null) || return 1
+    [ "$(grep -c '^pub:' <<< "$listing")" -eq 1 ] || return 1
+    [ "$(awk -F: '$1 == "fpr" { print toupper($10); exit }' <<< "$listing")" = "$fpr" ]
+}
+
+# Imprime la ruta de la clave fpr: la de data/keys, la de la caché o una
+# descargada ahora (que queda en la caché para la próxima instalación)
+keyring_fetch_key() {
+    local fpr="${1^^}" file tmp url
+
+    for file in "$KEYRING_SHIPPED_KEYS/$fpr.asc" "$KEYRING_KEY_CACHE/$fpr.asc"; do
+        if keyring_key_matches "$file" "$fpr"; then
+            echo "$file"
+            return 0
+        fi
+    done
+
+    mkdir -p "$KEYRING_KEY_CACHE"
+    tmp=$(mktemp "$KEYRING_KEY_CACHE/.$fpr.XXXXXX") || return 1
+    for url in "https://keyserver.ubuntu.com/pks/lookup?op=get&options=mr&search=0x$fpr" \
+               "https://keys.openpgp.org/vks/v1/by-fingerprint/$fpr"; do
+        if curl -fsSL --connect-timeout 5 --max-time 20 "$url" -o "$tmp" 2>/dev/null &&
+           keyring_key_matches "$tmp" "$fpr"; then
+            mv "$tmp" "$KEYRING_KEY_CACHE/$fpr.asc"
+            echo "$KEYRING_KEY_CACHE/$fpr.asc"
+            return 0
+        fi
+    done
+    rm -f "$tmp"
+    return 1
+}
+
+# Agrega y firma localmente la clave fpr en el anillo de /mnt. Sin archivo
+# local se recurre a pacman-key --recv-key como antes
+keyring_import_chroot() {
+    local fpr="${1^^}" file
+
+    if file=$(keyring_fetch_key "$fpr"); then
+        cp "$file" "/mnt/tmp/arcris-key-$fpr.asc" &&
+        chroot /mnt /bin/bash -c "pacman-key --add /tmp/arcris-key-$fpr.asc && pacman-key --lsign-key $fpr"
+        local rc=$?
+        rm -f "/mnt/tmp/arcris-key-$fpr.asc"
+        return $rc
+    fi
+
+    echo -e "${YELLOW}Warning: clave $fpr sin copia local; se pide al servidor de claves${NC}"
+    chroot /mnt /bin/bash -c "pacman-key --recv-key $fpr --keyserver keyserver.ubuntu.com && pacman-key --lsign-key $fpr"
+}
+
+# Firma localmente en /mnt una clave que ya trae archlinux-keyring (sin descargas)
+keyring_lsign_arch_chroot() {
+    local uid="$1"
+
+    chroot /mnt /bin/bash -c "pacman-key --lsign-key '$uid'"
+}
+
+# Modo segundo plano: anillo del LiveCD y claves de terceros en la caché,
+# mientras el usuario sigue en las páginas de configuración
+if [[ "${BASH_SOURCE[0]}" == "$0" && "$1" == "--prepare" ]]; then
+    exec >> "$KEYRING_LOG" 2>&1
+    echo "== $(date -Iseconds) preparación del anillo de claves"
+    keyring_prepare_livecd
+    for repo in "${!KEYRING_THIRD_PARTY[@]}"; do
+        if keyring_fetch_key "${KEYRING_THIRD_PARTY[$repo]}" >/dev/null; then
+            echo "Clave de $repo en la caché"
+        else
+            echo "No se pudo obtener la clave de $repo; se pedirá durante la instalación"
+        fi
+    done
+    exit 0
+fi
+
+# Modo mantenimiento: deja en data/keys las claves verificadas por su huella
+if [[ "${BASH_SOURCE[0]}" == "$0" && "$1" == "--export-keys" ]]; then
+    rc=0
+    KEYRING_KEY_CACHE=$(mktemp -d)
+    mkdir -p "$KEYRING_SHIPPED_KEYS"
+    for repo in "${!KEYRING_THIRD_PARTY[@]}"; do
+        fpr="${KEYRING_THIRD_PARTY[$repo]}"
+        if file=$(keyring_fetch_key "$fpr"); then
+            [ "$file" = "$KEYRING_SHIPPED_KEYS/$fpr.asc" ] || cp "$file" "$KEYRING_SHIPPED_KEYS/$fpr.asc"
+            echo "$repo: $KEYRING_SHIPPED_KEYS/$fpr.asc"
+        else
+            echo "$repo: no se pudo obtener la clave $fpr" >&2
+            rc=1
+        fi
+    done
+    rm -rf "$KEYRING_KEY_CACHE"
+    exit $rc
+fi
@@ -0,0 +1,86 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------------
+# Descarga previa de paquetes con arcris-fetch
+#
+# Antes del primer intento de pacstrap o pacman se piden a pacman los archivos
+# que va a descargar (pacman -Sp) y arcris-fetch los baja a la caché
+# repartiéndolos entre los espejos de la mirrorlist según la velocidad que mide
+# en cada uno, con más o menos descargas simultáneas según el caudal y
+# cambiando de espejo en cuanto una descarga se para. pacman encuentra después
+# los paquetes en la caché y solo descarga lo que faltó.
+#
+# Solo se adelantan los repositorios oficiales (los que usan la mirrorlist);
+# chaotic-aur, archlinuxcn y yay siguen descargando por su cuenta. Sin
+# arcris-fetch, o con PACKAGE_FETCH="false", todo queda como antes.
+# -----------------------------------------------------------------------------------
+
+PACKAGE_FETCH="${PACKAGE_FETCH:-true}"
+PACKAGE_FETCH_REPOS='^(core|extra|multilib)$'
+
+# Escribe en out la lista "repositorio archivo tamaño sha256" de lo que
+# instalaría pacman.
+#   host   → pacstrap: bases de datos del live, paquetes ya instalados en /mnt
+#   chroot → pacman dentro de /mnt, con el agente del chroot (chroot_run). La
+#            salida del agente va a la terminal, así que la lista se deja en
+#            un archivo de /mnt/tmp y se mueve a out
+package_fetch_list() {
+    local mode="$1" out="$2" dbpath rel
+    shift 2
+
+    if [ "$mode" = "chroot" ]; then
+        rel=/tmp/arcris-fetch-list.$$
+        chroot_run "pacman -Sp --noconfirm --print-format '%r %f %s %h' $* > $rel 2>/dev/null"
+        mv -f "/mnt$rel" "$out" 2>/dev/null || : > "$out"
+        return
+    fi
+
+    # Con la base local de /mnt (vacía antes del primer pacstrap) pacman
+    # resuelve las dependencias como lo hará pacstrap
+    dbpath=$(mktemp -d /tmp/arcris-fetch-db.XXXXXX) || return 1
+    ln -s /var/lib/pacman/sync "$dbpath/sync"
+    if [ -d /mnt/var/lib/pacman/local ]; then
+        ln -s /mnt/var/lib/pacman/local "$dbpath/local"
+    else
+        mkdir "$dbpath/local"
+    fi
+    pacman --dbpath "$dbpath" -Sp --noconfirm --print-format '%r %f %s %h' "$@" > "$out" 2>/dev/null
+    rm -rf "$dbpath"
+}
+
+# package_fetch host|chroot PAQUETE... (los paquetes sin comillas, como en
+# install_pacman_chroot_with_retry "linux linux-firmware")
+package_fetch() {
+    local mode="$1" list list_file mirrorlist cachedir
+    shift
+
+    [ "$PACKAGE_FETCH" = "true" ] || return 0
+    command -v arcris-fetch >/dev/null 2>&1 || return 0
+
+    # pacstrap -c usa la caché del LiveCD; pacman en chroot, la de /mnt
+    if [ "$mode" = "chroot" ]; then
+        mirrorlist=/mnt/etc/pacman.d/mirrorlist
+        cachedir=/mnt/var/cache/pacman/pkg
+    else
+        mirrorlist=/etc/pacman.d/mirrorlist
+        cachedir="$PACSTRAP_CACHE_DIR"
+    fi
+    [ -f "$mirrorlist" ] || return 0
+
+    # Sin sustitución de comandos: en un subshell chroot_run no llega al agente
+    list_file=$(mktemp "${ARCRIS_TMP_DIR:-/tmp}/arcris-fetch-list.XXXXXX") || return 0
+    package_fetch_list "$mode" "$list_file" "$@"
+    list=$(awk -v repos="$PACKAGE_FETCH_REPOS" '$1 ~ repos' "$list_file")
+    rm -f "$list_file"
+    [ -n "$list" ] || return 0
+
+    # La caché del LiveCD es compartida en el modo multi-disco: una sola
+    # descarga a la vez, y la siguiente instancia ya encuentra los paquetes
+    [ "$mode" = "host" ] && live_lock
+    mkdir -p "$cachedir"
+    if ! arcris-fetch --mirrorlist "$mirrorlist" --cachedir "$cachedir" \
+                      ${ARCRIS_TIMING_JOURNAL:+--journal "$ARCRIS_TIMING_JOURNAL"} <<< "$list"; then
+        echo -e "${YELLOW}Warning: arcris-fetch no descargó todo; pacman bajará el resto${NC}"
+    fi
+    [ "$mode" = "host" ] && live_unlock
+    return 0
+}
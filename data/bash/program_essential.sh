@@ -11,19 +11,19 @@ if [ "${ESSENTIAL_APPS_ENABLED:-false}" = "true" ]; then
         "bash")
             install_pacman_chroot_with_retry "bash"
             install_pacman_chroot_with_retry "bash-completion"
-            chroot /mnt /bin/bash -c "chsh -s /bin/bash $USER"
+            chroot_run "chsh -s /bin/bash $USER"
             ;;
         "dash")
             install_pacman_chroot_with_retry "dash"
-            chroot /mnt /bin/bash -c "chsh -s /bin/dash $USER"
+            chroot_run "chsh -s /bin/dash $USER"
             ;;
         "ksh")
             install_pacman_chroot_with_retry "ksh"
-            chroot /mnt /bin/bash -c "chsh -s /usr/bin/ksh $USER"
+            chroot_run "chsh -s /usr/bin/ksh $USER"
             ;;
         "fish")
             install_pacman_chroot_with_retry "fish"
-            chroot /mnt /bin/bash -c "chsh -s /usr/bin/fish $USER"
+            chroot_run "chsh -s /usr/bin/fish $USER"
             ;;
         "zsh")
             install_pacman_chroot_with_retry "zsh"
@@ -32,14 +32,14 @@ if [ "${ESSENTIAL_APPS_ENABLED:-false}" = "true" ]; then
             install_pacman_chroot_with_retry "zsh-autosuggestions"
             cp /usr/share/arcrisgui/data/config/zshrc /mnt/home/$USER/.zshrc
             cp /usr/share/arcrisgui/data/config/zshrc /mnt/root/.zshrc
-            chroot /mnt /bin/bash -c "chown $USER:$USER /home/$USER/.zshrc"
-            chroot /mnt /bin/bash -c "chsh -s /bin/zsh $USER"
+            chroot_run "chown $USER:$USER /home/$USER/.zshrc"
+            chroot_run "chsh -s /bin/zsh $USER"
             ;;
         *)
             echo -e "${YELLOW}Shell no reconocida: ${SYSTEM_SHELL}, usando bash${NC}"
             install_pacman_chroot_with_retry "bash"
             install_pacman_chroot_with_retry "bash-completion"
-            chroot /mnt /bin/bash -c "chsh -s /bin/bash $USER"
+            chroot_run "chsh -s /bin/bash $USER"
             ;;
     esac
     echo -e "${GREEN}✓ Shell del sistema configurada${NC}"
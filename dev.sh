@@ -49,6 +49,8 @@ show_help() {
     echo "  install, i     - Instalar la aplicación"
     echo "  reconfigure    - Reconfigurar el sistema de build"
     echo "  test, t        - Ejecutar tests básicos"
+    echo "  bench          - Ejecutar los benchmarks y compararlos con la línea base"
+    echo "  bench-baseline - Guardar los resultados de los benchmarks como línea base"
     echo "  check          - Verificar dependencias"
     echo "  watch, w       - Compilar y ejecutar automáticamente al cambiar archivos"
     echo "  help, h        - Mostrar esta ayuda"
@@ -222,9 +224,30 @@ test_application() {
         log_success "✓ Ejecutable actualizado"
     fi
 
+    # Test 5: pruebas de meson (tests/)
+    log_info "Ejecutando meson test..."
+    if ! meson test -C "$BUILD_DIR" --print-errorlogs; then
+        log_error "Test fallido: meson test"
+        return 1
+    fi
+    log_success "✓ meson test"
+
     log_success "Todos los tests básicos pasaron"
 }
 
+# Función para ejecutar los benchmarks (bench/bench_arcris.c)
+run_benchmarks() {
+    build_project
+
+    if [ "$1" = "baseline" ]; then
+        log_info "Guardando línea base en bench/baseline.json..."
+        "$BUILD_DIR/bench/bench-arcris" --baseline bench/baseline.json --update-baseline
+    else
+        log_info "Ejecutando benchmarks..."
+        meson test -C "$BUILD_DIR" --benchmark -v
+    fi
+}
+
 # Función para watch (compilar automáticamente)
 watch_and_run() {
     log_info "Iniciando modo watch - compilación automática..."
@@ -284,6 +307,12 @@ main() {
         test|t)
             test_application
             ;;
+        bench)
+            run_benchmarks
+            ;;
+        bench-baseline)
+            run_benchmarks baseline
+            ;;
         check)
             check_dependencies
             ;;
@@ -305,6 +334,8 @@ main() {
                     install|i) install_application ;;
                     reconfigure) reconfigure_build ;;
                     test|t) test_application ;;
+                    bench) run_benchmarks ;;
+                    bench-baseline) run_benchmarks baseline ;;
                     check) check_dependencies ;;
                     *)
                         log_error "Comando desconocido: $cmd"
@@ -6,6 +6,9 @@
  *
  * Compilar:
  *   gcc hardware_video.c -o nvidia_check
+ *
+ * Con -DHARDWARE_VIDEO_NO_MAIN se omite main() para incluir el archivo en
+ * otro programa (los benchmarks de bench/ usan find_gpu).
  */
 
 #include <stdio.h>
@@ -507,6 +510,7 @@ static int query_nvidia(int psid, int pfid, char *out, int out_len) {
     return 0;
 }
 
+#ifndef HARDWARE_VIDEO_NO_MAIN
 /* ─── Main ──────────────────────────────────────────────────────────── */
 
 int main(void) {
@@ -569,3 +573,4 @@ int main(void) {
     printf("└──────────────────────────────────────────────────┘\n\n");
     return 0;
 }
+#endif /* HARDWARE_VIDEO_NO_MAIN */
@@ -0,0 +1,744 @@
+/*
+ * arcris-fetch: descarga de paquetes repartida entre varios espejos.
+ *
+ *   arcris-fetch --mirrorlist ARCHIVO --cachedir DIRECTORIO [--journal ARCHIVO] < lista
+ *
+ * Cada línea de la lista es "repositorio archivo tamaño sha256", la salida de
+ * pacman -Sp --print-format '%r %f %s %h'. Los paquetes se guardan en el
+ * directorio de caché, donde pacman los encuentra después y no los vuelve a
+ * descargar.
+ *
+ *   • Se mide la velocidad de cada espejo (Server = de la mirrorlist) con las
+ *     propias descargas y cada trozo va al espejo que más rinde en ese momento;
+ *     los que aún no se midieron se prueban con una descarga cada uno.
+ *   • El número de descargas simultáneas se ajusta cada 2 s: sube mientras el
+ *     caudal total mejora y baja cuando empeora.
+ *   • Los paquetes grandes se parten en trozos (peticiones Range) que se
+ *     reparten entre los mejores espejos.
+ *   • Una descarga sin datos durante unos segundos, o mucho más lenta que el
+ *     mejor espejo, se cancela y lo que falta pasa a otro espejo; un espejo
+ *     con varios fallos seguidos deja de usarse.
+ *   • Cada paquete se comprueba con su sha256 antes de quedar en la caché.
+ *
+ * Los paquetes que no se pudieron descargar se quedan para pacman. Con
+ * --journal se agrega una línea "mirror" por espejo al diario de tiempos
+ * (ver install_timing.sh). Para probarlo basta una mirrorlist con servidores
+ * HTTP locales (Server = http://127.0.0.1:8001/$repo/os/$arch).
+ *
+ * Sale con 0 si todo quedó en la caché, 1 si faltó algún paquete y 2 si los
+ * argumentos son inválidos.
+ */
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <libsoup/soup.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FETCH_MAX_MIRRORS      8
+#define FETCH_MIN_ACTIVE       2
+#define FETCH_MAX_ACTIVE       16
+#define FETCH_START_ACTIVE     5      /* el ParallelDownloads de pacman.conf */
+#define FETCH_PER_MIRROR       6
+#define FETCH_SPLIT_MIN        (16 * 1024 * 1024)
+#define FETCH_SEGMENT_SIZE     (8 * 1024 * 1024)
+#define FETCH_READ_SIZE        (64 * 1024)
+#define FETCH_CONNECT_MS       5000   /* sin primer byte */
+#define FETCH_STALL_MS         3000   /* sin datos a mitad de descarga */
+#define FETCH_SLOW_FACTOR      8      /* tantas veces más lento que el mejor */
+#define FETCH_SLOW_MIN_MS      5000
+#define FETCH_ADAPT_MS         2000
+#define FETCH_MIRROR_FAILURES  3
+#define FETCH_FILE_ATTEMPTS    2
+
+typedef struct {
+    gchar *url;            /* con $repo y $arch sin sustituir */
+    gchar *host;
+    gdouble rate;          /* B/s por conexión, media móvil; 0 = sin medir */
+    guint64 bytes;
+    guint64 tick_bytes;
+    guint active;
+    guint failures;        /* seguidos */
+    guint failovers;       /* trozos que hubo que pasar a otro espejo */
+    gboolean disabled;
+} FetchMirror;
+
+typedef struct {
+    gchar *repo;
+    gchar *name;
+    gchar *sha256;
+    goffset size;
+    gchar *path;
+    gchar *part_path;
+    int fd;
+    guint pending;         /* trozos sin terminar */
+    guint attempts;
+    gboolean failed;
+} FetchFile;
+
+typedef struct {
+    FetchFile *file;
+    goffset offset;        /* lo que falta es [offset, end) */
+    goffset end;
+    guint64 tried;         /* espejos que ya fallaron con este trozo */
+} FetchChunk;
+
+typedef enum {
+    FETCH_ABORT_NONE = 0,
+    FETCH_ABORT_STALLED,
+    FETCH_ABORT_SLOW,
+    FETCH_ABORT_FILE_FAILED
+} FetchAbort;
+
+typedef struct _Fetcher Fetcher;
+
+typedef struct {
+    Fetcher *fetcher;
+    FetchChunk *chunk;
+    FetchMirror *mirror;
+    SoupMessage *msg;
+    GInputStream *stream;
+    GCancellable *cancellable;
+    gint64 started;
+    gint64 last_progress;
+    guint64 received;
+    gboolean cut_at_end;   /* 200 a una petición Range: se corta al final del trozo */
+    FetchAbort abort;
+} FetchTransfer;
+
+struct _Fetcher {
+    SoupSession *session;
+    GPtrArray *mirrors;
+    GPtrArray *files;
+    GQueue queue;          /* FetchChunk pendientes, los paquetes grandes primero */
+    GPtrArray *transfers;
+    const gchar *arch;
+    guint limit;
+    gint step;
+    gdouble last_rate;
+    guint64 window_bytes;
+    gint64 window_start;
+    gint64 last_tick;
+    GMainLoop *loop;
+};
+
+static void fetch_schedule(Fetcher *f);
+
+static void fetch_mirror_free(FetchMirror *m)
+{
+    g_free(m->url);
+    g_free(m->host);
+    g_free(m);
+}
+
+static void fetch_file_free(FetchFile *file)
+{
+    if (file->fd >= 0)
+        close(file->fd);
+    g_free(file->repo);
+    g_free(file->name);
+    g_free(file->sha256);
+    g_free(file->path);
+    g_free(file->part_path);
+    g_free(file);
+}
+
+static GPtrArray *fetch_load_mirrors(const gchar *path, GError **error)
+{
+    gchar *contents = NULL;
+    if (!g_file_get_contents(path, &contents, NULL, error))
+        return NULL;
+
+    GPtrArray *mirrors = g_ptr_array_new_with_free_func((GDestroyNotify)fetch_mirror_free);
+    gchar **lines = g_strsplit(contents, "\n", -1);
+    for (gchar **l = lines; *l && mirrors->len < FETCH_MAX_MIRRORS; l++) {
+        gchar *line = g_strstrip(*l);
+        if (!g_str_has_prefix(line, "Server"))
+            continue;
+        gchar *eq = strchr(line, '=');
+        if (!eq)
+            continue;
+
+        FetchMirror *m = g_new0(FetchMirror, 1);
+        m->url = g_strdup(g_strstrip(eq + 1));
+        GUri *uri = g_uri_parse(m->url, G_URI_FLAGS_NONE, NULL);
+        m->host = g_strdup(uri && g_uri_get_host(uri) ? g_uri_get_host(uri) : m->url);
+        if (uri)
+            g_uri_unref(uri);
+        g_ptr_array_add(mirrors, m);
+    }
+    g_strfreev(lines);
+    g_free(contents);
+    return mirrors;
+}
+
+static gint fetch_file_compare_size(gconstpointer a, gconstpointer b)
+{
+    goffset sa = (*(FetchFile *const *)a)->size;
+    goffset sb = (*(FetchFile *const *)b)->size;
+    return sa < sb ? 1 : sa > sb ? -1 : 0;
+}
+
+/* Lee la lista de stdin; los paquetes que ya están en la caché se omiten */
+static GPtrArray *fetch_read_files(const gchar *cachedir)
+{
+    GPtrArray *files = g_ptr_array_new_with_free_func((GDestroyNotify)fetch_file_free);
+    gchar line[4096];
+
+    while (fgets(line, sizeof(line), stdin)) {
+        gchar **fields = g_strsplit_set(g_strstrip(line), " \t", -1);
+        if (g_strv_length(fields) < 3 || strchr(fields[1], '/')) {
+            g_strfreev(fields);
+            continue;
+        }
+
+        FetchFile *file = g_new0(FetchFile, 1);
+        file->fd = -1;
+        file->repo = g_strdup(fields[0]);
+        file->name = g_strdup(fields[1]);
+        file->size = g_ascii_strtoll(fields[2], NULL, 10);
+        file->sha256 = fields[3] && *fields[3] ? g_ascii_strdown(fields[3], -1) : NULL;
+        file->path = g_build_filename(cachedir, file->name, NULL);
+        file->part_path = g_strconcat(file->path, ".arcris-part", NULL);
+        g_strfreev(fields);
+
+        GStatBuf st;
+        if (file->size <= 0 || (g_stat(file->path, &st) == 0 && st.st_size == file->size)) {
+            fetch_file_free(file);
+            continue;
+        }
+        g_ptr_array_add(files, file);
+    }
+
+    g_ptr_array_sort(files, fetch_file_compare_size);
+    return files;
+}
+
+/* Abre el archivo parcial y encola sus trozos */
+static gboolean fetch_enqueue_file(Fetcher *f, FetchFile *file)
+{
+    if (file->fd < 0)
+        file->fd = open(file->part_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (file->fd < 0 || ftruncate(file->fd, file->size) != 0) {
+        fprintf(stderr, "arcris-fetch: no se pudo crear %s: %s\n", file->part_path, g_strerror(errno));
+        file->failed = TRUE;
+        return FALSE;
+    }
+
+    guint segments = 1;
+    if (file->size >= FETCH_SPLIT_MIN)
+        segments = MIN((file->size + FETCH_SEGMENT_SIZE - 1) / FETCH_SEGMENT_SIZE, f->mirrors->len * 2);
+    segments = MAX(segments, 1);
+
+    goffset segment = file->size / segments;
+    for (guint i = 0; i < segments; i++) {
+        FetchChunk *chunk = g_new0(FetchChunk, 1);
+        chunk->file = file;
+        chunk->offset = i * segment;
+        chunk->end = i + 1 == segments ? file->size : (i + 1) * segment;
+        g_queue_push_tail(&f->queue, chunk);
+    }
+    file->pending = segments;
+    return TRUE;
+}
+
+/* Da por perdido el paquete: sus trozos en cola se descartan y los que están
+ * descargándose se cancelan */
+static void fetch_fail_file(Fetcher *f, FetchFile *file, const gchar *reason)
+{
+    if (file->failed) return;
+    file->failed = TRUE;
+    fprintf(stderr, "arcris-fetch: %s queda para pacman (%s)\n", file->name, reason);
+
+    for (GList *l = f->queue.head; l; ) {
+        GList *next = l->next;
+        FetchChunk *chunk = l->data;
+        if (chunk->file == file) {
+            g_queue_delete_link(&f->queue, l);
+            g_free(chunk);
+        }
+        l = next;
+    }
+    for (guint i = 0; i < f->transfers->len; i++) {
+        FetchTransfer *t = g_ptr_array_index(f->transfers, i);
+        if (t->chunk->file == file && !t->abort) {
+            t->abort = FETCH_ABORT_FILE_FAILED;
+            g_cancellable_cancel(t->cancellable);
+        }
+    }
+    if (file->fd >= 0) {
+        close(file->fd);
+        file->fd = -1;
+    }
+    g_unlink(file->part_path);
+}
+
+static gboolean fetch_file_verify(FetchFile *file)
+{
+    if (!file->sha256)
+        return TRUE;
+
+    GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+    guchar buffer[FETCH_READ_SIZE];
+    ssize_t n;
+    lseek(file->fd, 0, SEEK_SET);
+    while ((n = read(file->fd, buffer, sizeof(buffer))) > 0)
+        g_checksum_update(checksum, buffer, n);
+    gboolean ok = n == 0 && g_strcmp0(g_checksum_get_string(checksum), file->sha256) == 0;
+    g_checksum_free(checksum);
+    return ok;
+}
+
+static void fetch_file_complete(Fetcher *f, FetchFile *file)
+{
+    if (!fetch_file_verify(file)) {
+        if (++file->attempts >= FETCH_FILE_ATTEMPTS) {
+            fetch_fail_file(f, file, "sha256 distinto");
+            return;
+        }
+        fprintf(stderr, "arcris-fetch: %s: sha256 distinto, se descarga de nuevo\n", file->name);
+        fetch_enqueue_file(f, file);
+        return;
+    }
+
+    close(file->fd);
+    file->fd = -1;
+    if (g_rename(file->part_path, file->path) != 0) {
+        fprintf(stderr, "arcris-fetch: no se pudo mover %s: %s\n", file->name, g_strerror(errno));
+        file->failed = TRUE;
+        g_unlink(file->part_path);
+        return;
+    }
+    printf("  ✓ %s (%.1f MiB)\n", file->name, file->size / 1048576.0);
+    fflush(stdout);
+}
+
+/* Espejo para el trozo: el de mejor velocidad por conexión, penalizado por
+ * las descargas que ya tiene. Los que no se midieron reciben una descarga de
+ * prueba antes que nada, en el orden de la mirrorlist */
+static FetchMirror *fetch_pick_mirror(Fetcher *f, FetchChunk *chunk, gboolean *exhausted)
+{
+    FetchMirror *best = NULL;
+    gdouble best_score = -1;
+    *exhausted = TRUE;
+
+    for (guint i = 0; i < f->mirrors->len; i++) {
+        FetchMirror *m = g_ptr_array_index(f->mirrors, i);
+        if (m->disabled || (chunk->tried & ((guint64)1 << i)))
+            continue;
+        *exhausted = FALSE;
+        if (m->active >= FETCH_PER_MIRROR)
+            continue;
+
+        gdouble score;
+        if (m->rate == 0)
+            score = m->active == 0 ? G_MAXDOUBLE : 0;
+        else
+            score = m->rate / (1.0 + 0.5 * m->active);
+        if (score > best_score) {
+            best = m;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+static guint fetch_mirror_index(Fetcher *f, FetchMirror *m)
+{
+    guint index = 0;
+    g_ptr_array_find(f->mirrors, m, &index);
+    return index;
+}
+
+static void fetch_mirror_failed(Fetcher *f, FetchMirror *m)
+{
+    m->failovers++;
+    m->rate *= 0.5;
+    if (++m->failures >= FETCH_MIRROR_FAILURES && !m->disabled) {
+        m->disabled = TRUE;
+        fprintf(stderr, "arcris-fetch: %s deja de usarse tras %u fallos seguidos\n", m->host, m->failures);
+    }
+}
+
+/* Termina la transferencia. Si quedó parte del trozo se devuelve a la cola
+ * (al principio: es lo más urgente) para otro espejo */
+static void fetch_transfer_finish(FetchTransfer *t, gboolean mirror_failed)
+{
+    Fetcher *f = t->fetcher;
+    FetchChunk *chunk = t->chunk;
+    FetchFile *file = chunk->file;
+
+    g_ptr_array_remove(f->transfers, t);
+    t->mirror->active--;
+
+    if (file->failed) {
+        g_free(chunk);
+    } else if (chunk->offset >= chunk->end) {
+        t->mirror->failures = 0;
+        g_free(chunk);
+        if (--file->pending == 0)
+            fetch_file_complete(f, file);
+    } else {
+        if (mirror_failed) {
+            chunk->tried |= (guint64)1 << fetch_mirror_index(f, t->mirror);
+            fetch_mirror_failed(f, t->mirror);
+        } else {
+            t->mirror->failovers++;
+        }
+        g_queue_push_head(&f->queue, chunk);
+    }
+
+    g_clear_object(&t->stream);
+    g_clear_object(&t->msg);
+    g_clear_object(&t->cancellable);
+    g_free(t);
+
+    fetch_schedule(f);
+}
+
+static void fetch_on_read(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    FetchTransfer *t = user_data;
+    FetchChunk *chunk = t->chunk;
+    GError *error = NULL;
+    GBytes *bytes = g_input_stream_read_bytes_finish(G_INPUT_STREAM(source), result, &error);
+
+    if (!bytes) {
+        /* Cancelada por lentitud no es un fallo del espejo, solo se cambia */
+        gboolean mirror_failed = t->abort != FETCH_ABORT_SLOW;
+        if (!t->abort)
+            fprintf(stderr, "arcris-fetch: %s desde %s: %s\n", chunk->file->name, t->mirror->host, error->message);
+        g_error_free(error);
+        fetch_transfer_finish(t, mirror_failed);
+        return;
+    }
+
+    gsize length = 0;
+    const guint8 *data = g_bytes_get_data(bytes, &length);
+    if (t->abort) {
+        /* La lectura terminó justo antes de cancelarla */
+        g_bytes_unref(bytes);
+        fetch_transfer_finish(t, t->abort == FETCH_ABORT_STALLED);
+        return;
+    }
+    if (length == 0) {
+        /* Fin del cuerpo: si el trozo no está completo, el espejo lo cortó */
+        g_bytes_unref(bytes);
+        fetch_transfer_finish(t, chunk->offset < chunk->end);
+        return;
+    }
+
+    /* Un servidor que ignora Range puede mandar más de lo pedido */
+    length = MIN((goffset)length, chunk->end - chunk->offset);
+    gsize written = 0;
+    while (written < length) {
+        ssize_t n = pwrite(chunk->file->fd, data + written, length - written, chunk->offset + written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            g_bytes_unref(bytes);
+            fetch_fail_file(t->fetcher, chunk->file, g_strerror(errno));
+            fetch_transfer_finish(t, FALSE);
+            return;
+        }
+        written += n;
+    }
+    g_bytes_unref(bytes);
+
+    chunk->offset += length;
+    t->received += length;
+    t->last_progress = g_get_monotonic_time();
+    t->mirror->bytes += length;
+    t->mirror->tick_bytes += length;
+    t->fetcher->window_bytes += length;
+
+    /* Con 206 se lee hasta el final del cuerpo para que libsoup pueda
+     * reutilizar la conexión con el siguiente trozo */
+    if (chunk->offset >= chunk->end && t->cut_at_end) {
+        fetch_transfer_finish(t, FALSE);
+        return;
+    }
+    g_input_stream_read_bytes_async(t->stream, FETCH_READ_SIZE, G_PRIORITY_DEFAULT,
+                                    t->cancellable, fetch_on_read, t);
+}
+
+static void fetch_on_send(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    FetchTransfer *t = user_data;
+    GError *error = NULL;
+
+    t->stream = soup_session_send_finish(SOUP_SESSION(source), result, &error);
+    if (!t->stream) {
+        if (!t->abort)
+            fprintf(stderr, "arcris-fetch: %s desde %s: %s\n", t->chunk->file->name, t->mirror->host, error->message);
+        g_error_free(error);
+        fetch_transfer_finish(t, t->abort != FETCH_ABORT_SLOW);
+        return;
+    }
+
+    /* 206 con Range; 200 solo sirve si el trozo empieza en 0 */
+    guint status = soup_message_get_status(t->msg);
+    if (status != SOUP_STATUS_PARTIAL_CONTENT && !(status == SOUP_STATUS_OK && t->chunk->offset == 0)) {
+        fprintf(stderr, "arcris-fetch: %s desde %s: HTTP %u\n", t->chunk->file->name, t->mirror->host, status);
+        fetch_transfer_finish(t, TRUE);
+        return;
+    }
+
+    t->cut_at_end = status == SOUP_STATUS_OK && t->chunk->end < t->chunk->file->size;
+    t->last_progress = g_get_monotonic_time();
+    g_input_stream_read_bytes_async(t->stream, FETCH_READ_SIZE, G_PRIORITY_DEFAULT,
+                                    t->cancellable, fetch_on_read, t);
+}
+
+static gchar *fetch_build_url(Fetcher *f, FetchMirror *m, FetchFile *file)
+{
+    GString *url = g_string_new(m->url);
+    g_string_replace(url, "$repo", file->repo, 0);
+    g_string_replace(url, "$arch", f->arch, 0);
+    if (url->len == 0 || url->str[url->len - 1] != '/')
+        g_string_append_c(url, '/');
+    g_string_append(url, file->name);
+    return g_string_free(url, FALSE);
+}
+
+static void fetch_start(Fetcher *f, FetchChunk *chunk, FetchMirror *mirror)
+{
+    gchar *url = fetch_build_url(f, mirror, chunk->file);
+    SoupMessage *msg = soup_message_new("GET", url);
+    g_free(url);
+    if (!msg) {
+        chunk->tried |= (guint64)1 << fetch_mirror_index(f, mirror);
+        fetch_mirror_failed(f, mirror);
+        g_queue_push_head(&f->queue, chunk);
+        return;
+    }
+    if (chunk->offset > 0 || chunk->end < chunk->file->size)
+        soup_message_headers_set_range(soup_message_get_request_headers(msg), chunk->offset, chunk->end - 1);
+
+    FetchTransfer *t = g_new0(FetchTransfer, 1);
+    t->fetcher = f;
+    t->chunk = chunk;
+    t->mirror = mirror;
+    t->msg = msg;
+    t->cancellable = g_cancellable_new();
+    t->started = t->last_progress = g_get_monotonic_time();
+    mirror->active++;
+    g_ptr_array_add(f->transfers, t);
+
+    soup_session_send_async(f->session, msg, G_PRIORITY_DEFAULT, t->cancellable, fetch_on_send, t);
+}
+
+static void fetch_schedule(Fetcher *f)
+{
+    guint skipped = 0;
+
+    while (f->transfers->len < f->limit && g_queue_get_length(&f->queue) > skipped) {
+        FetchChunk *chunk = g_queue_pop_nth(&f->queue, skipped);
+        gboolean exhausted;
+        FetchMirror *mirror = fetch_pick_mirror(f, chunk, &exhausted);
+
+        if (exhausted) {
+            /* Ningún espejo le queda a este trozo */
+            FetchFile *file = chunk->file;
+            g_free(chunk);
+            file->pending--;
+            fetch_fail_file(f, file, "ningún espejo lo sirvió");
+            continue;
+        }
+        if (!mirror) {
+            /* Espejos llenos; el trozo espera en su sitio */
+            g_queue_push_nth(&f->queue, chunk, skipped++);
+            break;
+        }
+        fetch_start(f, chunk, mirror);
+    }
+
+    if (f->transfers->len == 0 && g_queue_is_empty(&f->queue))
+        g_main_loop_quit(f->loop);
+}
+
+/* Cancela las descargas paradas o muy lentas */
+static void fetch_check_transfers(Fetcher *f, gint64 now)
+{
+    gdouble best_rate = 0;
+    for (guint i = 0; i < f->mirrors->len; i++)
+        best_rate = MAX(best_rate, ((FetchMirror *)g_ptr_array_index(f->mirrors, i))->rate);
+
+    for (guint i = 0; i < f->transfers->len; i++) {
+        FetchTransfer *t = g_ptr_array_index(f->transfers, i);
+        if (t->abort)
+            continue;
+
+        gint64 idle_ms = (now - t->last_progress) / 1000;
+        gint64 age_ms = (now - t->started) / 1000;
+        if (idle_ms > (t->received ? FETCH_STALL_MS : FETCH_CONNECT_MS)) {
+            fprintf(stderr, "arcris-fetch: %s desde %s: %" G_GINT64_FORMAT " ms sin datos, se cambia de espejo\n",
+                    t->chunk->file->name, t->mirror->host, idle_ms);
+            t->abort = FETCH_ABORT_STALLED;
+            g_cancellable_cancel(t->cancellable);
+        } else if (age_ms > FETCH_SLOW_MIN_MS && best_rate > 0 &&
+                   t->received * 1000.0 / age_ms * FETCH_SLOW_FACTOR < best_rate &&
+                   t->chunk->end - t->chunk->offset > FETCH_READ_SIZE * 16) {
+            t->abort = FETCH_ABORT_SLOW;
+            g_cancellable_cancel(t->cancellable);
+        }
+    }
+}
+
+static gboolean fetch_tick(gpointer user_data)
+{
+    Fetcher *f = user_data;
+    gint64 now = g_get_monotonic_time();
+    gdouble seconds = (now - f->last_tick) / (gdouble)G_USEC_PER_SEC;
+    f->last_tick = now;
+
+    /* Velocidad por conexión de cada espejo, media móvil */
+    for (guint i = 0; i < f->mirrors->len; i++) {
+        FetchMirror *m = g_ptr_array_index(f->mirrors, i);
+        if (m->active > 0 && m->tick_bytes > 0 && seconds > 0) {
+            gdouble rate = m->tick_bytes / seconds / m->active;
+            m->rate = m->rate == 0 ? rate : 0.7 * m->rate + 0.3 * rate;
+        }
+        m->tick_bytes = 0;
+    }
+
+    fetch_check_transfers(f, now);
+
+    /* Más o menos descargas simultáneas según cambió el caudal total. Solo
+     * con cola: al final la caída es porque no queda trabajo */
+    gint64 window_ms = (now - f->window_start) / 1000;
+    if (window_ms >= FETCH_ADAPT_MS) {
+        gdouble rate = f->window_bytes * 1000.0 / window_ms;
+        if (!g_queue_is_empty(&f->queue) && f->transfers->len >= f->limit) {
+            if (f->last_rate > 0 && rate < f->last_rate * 0.9)
+                f->step = f->step > 0 ? -1 : 1;
+            else if (f->last_rate > 0 && rate < f->last_rate * 1.05)
+                f->step = 0;
+            else if (f->step == 0)
+                f->step = 1;
+            f->limit = CLAMP((gint)f->limit + f->step, FETCH_MIN_ACTIVE, FETCH_MAX_ACTIVE);
+        }
+        f->last_rate = rate;
+        f->window_bytes = 0;
+        f->window_start = now;
+    }
+
+    fetch_schedule(f);
+    return G_SOURCE_CONTINUE;
+}
+
+static void fetch_write_journal(Fetcher *f, const gchar *path, gint64 start_ms, gint64 duration_ms)
+{
+    FILE *journal = fopen(path, "a");
+    if (!journal) {
+        fprintf(stderr, "arcris-fetch: no se pudo abrir %s: %s\n", path, g_strerror(errno));
+        return;
+    }
+    for (guint i = 0; i < f->mirrors->len; i++) {
+        FetchMirror *m = g_ptr_array_index(f->mirrors, i);
+        if (m->bytes == 0 && m->failovers == 0)
+            continue;
+        fprintf(journal, "mirror\t%s\t%" G_GINT64_FORMAT "\t%" G_GINT64_FORMAT "\t%" G_GUINT64_FORMAT "\t%u\t0\t%s\n",
+                m->host, start_ms, duration_ms, m->bytes, m->failovers, m->disabled ? "disabled" : "ok");
+    }
+    fclose(journal);
+}
+
+int main(int argc, char *argv[])
+{
+    gchar *mirrorlist = NULL, *cachedir = NULL, *journal = NULL, *arch = NULL;
+    GOptionEntry entries[] = {
+        { "mirrorlist", 'm', 0, G_OPTION_ARG_FILENAME, &mirrorlist,
+          "Mirrorlist de pacman con los espejos, en orden de preferencia", "ARCHIVO" },
+        { "cachedir", 'c', 0, G_OPTION_ARG_FILENAME, &cachedir,
+          "Caché de paquetes de pacman", "DIRECTORIO" },
+        { "journal", 'j', 0, G_OPTION_ARG_FILENAME, &journal,
+          "Diario de tiempos donde agregar el resumen por espejo", "ARCHIVO" },
+        { "arch", 'a', 0, G_OPTION_ARG_STRING, &arch,
+          "Valor de $arch en las URL (x86_64)", "ARQUITECTURA" },
+        { NULL }
+    };
+    g_autoptr(GOptionContext) context = g_option_context_new("< LISTA");
+    g_autoptr(GError) error = NULL;
+
+    g_option_context_add_main_entries(context, entries, NULL);
+    g_option_context_set_summary(context,
+        "Descarga a la caché de pacman los paquetes de la lista (repositorio archivo\n"
+        "tamaño sha256 por línea) repartiéndolos entre los espejos más rápidos.");
+    if (!g_option_context_parse(context, &argc, &argv, &error) || !mirrorlist || !cachedir) {
+        fprintf(stderr, "arcris-fetch: %s\n",
+                error ? error->message : "uso: arcris-fetch --mirrorlist ARCHIVO --cachedir DIRECTORIO < lista");
+        return 2;
+    }
+
+    Fetcher f = { 0 };
+    f.arch = arch ? arch : "x86_64";
+    f.mirrors = fetch_load_mirrors(mirrorlist, &error);
+    if (!f.mirrors || f.mirrors->len == 0) {
+        fprintf(stderr, "arcris-fetch: %s\n", error ? error->message : "la mirrorlist no tiene servidores");
+        return 2;
+    }
+    g_mkdir_with_parents(cachedir, 0755);
+
+    f.files = fetch_read_files(cachedir);
+    if (f.files->len == 0) {
+        g_ptr_array_free(f.files, TRUE);
+        g_ptr_array_free(f.mirrors, TRUE);
+        return 0;
+    }
+
+    goffset total = 0;
+    g_queue_init(&f.queue);
+    for (guint i = 0; i < f.files->len; i++) {
+        FetchFile *file = g_ptr_array_index(f.files, i);
+        if (fetch_enqueue_file(&f, file))
+            total += file->size;
+    }
+    printf("arcris-fetch: %u paquetes, %.1f MiB, %u espejos\n",
+           f.files->len, total / 1048576.0, f.mirrors->len);
+    fflush(stdout);
+
+    /* Sin timeout propio de libsoup: las descargas paradas se detectan en fetch_tick */
+    f.session = soup_session_new_with_options("max-conns", FETCH_MAX_ACTIVE * 2,
+                                              "max-conns-per-host", FETCH_PER_MIRROR,
+                                              "user-agent", "arcris-fetch", NULL);
+    f.transfers = g_ptr_array_new();
+    f.limit = MIN(FETCH_START_ACTIVE, f.mirrors->len * FETCH_PER_MIRROR);
+    f.step = 1;
+    f.loop = g_main_loop_new(NULL, FALSE);
+
+    gint64 start_ms = g_get_real_time() / 1000;
+    f.window_start = f.last_tick = g_get_monotonic_time();
+    guint tick_id = g_timeout_add(1000, fetch_tick, &f);
+    fetch_schedule(&f);
+    if (f.transfers->len > 0 || !g_queue_is_empty(&f.queue))
+        g_main_loop_run(f.loop);
+    g_source_remove(tick_id);
+
+    gint64 duration_ms = g_get_real_time() / 1000 - start_ms;
+    guint missing = 0;
+    for (guint i = 0; i < f.files->len; i++)
+        missing += ((FetchFile *)g_ptr_array_index(f.files, i))->failed ? 1 : 0;
+
+    for (guint i = 0; i < f.mirrors->len; i++) {
+        FetchMirror *m = g_ptr_array_index(f.mirrors, i);
+        if (m->bytes == 0 && m->failovers == 0)
+            continue;
+        printf("  %-40s %8.1f MiB  %6.2f MiB/s por conexión  %u cambios%s\n",
+               m->host, m->bytes / 1048576.0, m->rate / 1048576.0, m->failovers,
+               m->disabled ? "  (descartado)" : "");
+    }
+    printf("arcris-fetch: %.1f s, límite final de %u descargas simultáneas, %u paquetes para pacman\n",
+           duration_ms / 1000.0, f.limit, missing);
+    if (journal)
+        fetch_write_journal(&f, journal, start_ms, duration_ms);
+
+    g_main_loop_unref(f.loop);
+    g_object_unref(f.session);
+    g_ptr_array_free(f.transfers, TRUE);
+    g_ptr_array_free(f.files, TRUE);
+    g_ptr_array_free(f.mirrors, TRUE);
+    return missing == 0 ? 0 : 1;
+}
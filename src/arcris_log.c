@@ -0,0 +1,238 @@
+/*
+ * arcris-log: registro compacto de la instalación.
+ *
+ *   arcris-log ARCHIVO.gz < salida-de-la-terminal
+ *
+ * Lee la salida cruda de la terminal (lo que script escribe en su typescript)
+ * y guarda en ARCHIVO.gz una línea por cada línea de la terminal:
+ *   • sin colores ni otras secuencias de escape
+ *   • \r reescribe la línea actual, así que de cada barra de progreso queda
+ *     solo su último estado
+ *   • cada línea empieza con la hora, [HH:MM:SS]
+ * El texto se comprime en miembros gzip independientes que se cierran cuando
+ * la entrada se detiene medio segundo, cada 2 s o cada 1 MiB. El archivo es
+ * siempre un .gz válido (zcat lee los miembros concatenados como uno solo) y
+ * la memoria usada no crece con la duración de la instalación.
+ *
+ * Si no puede escribir sigue leyendo la entrada hasta el final: script no
+ * debe bloquearse ni recibir SIGPIPE por un fallo del registro.
+ */
+#include <gio/gio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LOG_MEMBER_IDLE_MS   500
+#define LOG_MEMBER_MAX_MS    2000
+#define LOG_MEMBER_MAX_BYTES (1024 * 1024)
+#define LOG_LINE_MAX_BYTES   (64 * 1024)
+#define LOG_COMPRESS_LEVEL   6
+
+typedef enum {
+    ESC_NONE = 0,
+    ESC_START,        /* después de ESC */
+    ESC_CSI,          /* ESC [ ... hasta el byte final 0x40-0x7E */
+    ESC_STRING,       /* OSC y cadenas de control, hasta BEL o ESC \ */
+    ESC_STRING_END,
+    ESC_CHARSET       /* ESC ( B y similares: un byte más */
+} EscState;
+
+typedef struct {
+    int fd;
+    gboolean failed;
+    GString *line;            /* línea en curso, ya sin escapes */
+    GString *member;          /* texto pendiente de comprimir */
+    gint64 member_start;
+    EscState esc;
+    gboolean pending_cr;
+} LogWriter;
+
+static void log_emit_line(LogWriter *w)
+{
+    GDateTime *now = g_date_time_new_now_local();
+    gchar *stamp = g_date_time_format(now, "[%H:%M:%S] ");
+
+    if (w->member->len == 0)
+        w->member_start = g_get_monotonic_time();
+    g_string_append(w->member, stamp);
+    g_string_append_len(w->member, w->line->str, w->line->len);
+    g_string_append_c(w->member, '\n');
+    g_string_truncate(w->line, 0);
+
+    g_free(stamp);
+    g_date_time_unref(now);
+}
+
+static void log_feed(LogWriter *w, const gchar *data, gsize length)
+{
+    for (gsize i = 0; i < length; i++) {
+        guchar c = data[i];
+
+        switch (w->esc) {
+            case ESC_START:
+                if (c == '[')
+                    w->esc = ESC_CSI;
+                else if (c && strchr("]PX^_", c))
+                    w->esc = ESC_STRING;
+                else if (c && strchr("()*+", c))
+                    w->esc = ESC_CHARSET;
+                else
+                    w->esc = ESC_NONE;
+                continue;
+            case ESC_CSI:
+                if (c >= 0x40 && c <= 0x7e)
+                    w->esc = ESC_NONE;
+                continue;
+            case ESC_STRING:
+                if (c == '\a')
+                    w->esc = ESC_NONE;
+                else if (c == 0x1b)
+                    w->esc = ESC_STRING_END;
+                continue;
+            case ESC_STRING_END:
+                w->esc = c == '\\' ? ESC_NONE : ESC_STRING;
+                continue;
+            case ESC_CHARSET:
+                w->esc = ESC_NONE;
+                continue;
+            case ESC_NONE:
+                break;
+        }
+
+        /* \r seguido de algo que no es \n: la terminal reescribe la línea */
+        if (w->pending_cr && c != '\r') {
+            w->pending_cr = FALSE;
+            if (c != '\n')
+                g_string_truncate(w->line, 0);
+        }
+
+        if (c == 0x1b) {
+            w->esc = ESC_START;
+        } else if (c == '\r') {
+            w->pending_cr = TRUE;
+        } else if (c == '\n') {
+            log_emit_line(w);
+        } else if (c == '\t' || (c >= 0x20 && c != 0x7f)) {
+            g_string_append_c(w->line, c);
+            if (w->line->len >= LOG_LINE_MAX_BYTES)
+                log_emit_line(w);
+        }
+    }
+}
+
+static gboolean log_write_all(int fd, const gchar *data, gsize length)
+{
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return FALSE;
+        }
+        data += n;
+        length -= n;
+    }
+    return TRUE;
+}
+
+/* Comprime el texto pendiente como un miembro gzip completo */
+static void log_flush_member(LogWriter *w)
+{
+    if (w->member->len == 0) return;
+
+    if (!w->failed) {
+        GZlibCompressor *compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP,
+                                                            LOG_COMPRESS_LEVEL);
+        const gchar *in = w->member->str;
+        gsize in_left = w->member->len;
+        gchar out[64 * 1024];
+        GConverterResult result;
+        GError *error = NULL;
+
+        do {
+            gsize bytes_read = 0, bytes_written = 0;
+            result = g_converter_convert(G_CONVERTER(compressor), in, in_left, out, sizeof(out),
+                                         G_CONVERTER_INPUT_AT_END, &bytes_read, &bytes_written, &error);
+            if (result == G_CONVERTER_ERROR) {
+                fprintf(stderr, "arcris-log: error al comprimir: %s\n", error->message);
+                g_clear_error(&error);
+                w->failed = TRUE;
+                break;
+            }
+            in += bytes_read;
+            in_left -= bytes_read;
+            if (!log_write_all(w->fd, out, bytes_written)) {
+                fprintf(stderr, "arcris-log: no se pudo escribir el registro: %s\n", g_strerror(errno));
+                w->failed = TRUE;
+                break;
+            }
+        } while (result != G_CONVERTER_FINISHED);
+
+        g_object_unref(compressor);
+    }
+
+    g_string_truncate(w->member, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "uso: arcris-log ARCHIVO.gz < salida-de-la-terminal\n");
+        return 2;
+    }
+
+    LogWriter w = { 0 };
+    w.fd = open(argv[1], O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    w.failed = w.fd < 0;
+    if (w.failed)
+        fprintf(stderr, "arcris-log: no se pudo crear %s: %s\n", argv[1], g_strerror(errno));
+    w.line = g_string_sized_new(256);
+    w.member = g_string_sized_new(LOG_MEMBER_MAX_BYTES + LOG_LINE_MAX_BYTES);
+
+    gchar buffer[64 * 1024];
+    for (;;) {
+        /* Con texto pendiente se espera como mucho hasta cerrar el miembro */
+        int timeout = -1;
+        if (w.member->len > 0) {
+            gint64 age_ms = (g_get_monotonic_time() - w.member_start) / 1000;
+            timeout = (int)CLAMP(LOG_MEMBER_MAX_MS - age_ms, 0, LOG_MEMBER_IDLE_MS);
+        }
+
+        struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (ready == 0) {
+            log_flush_member(&w);
+            continue;
+        }
+
+        ssize_t n = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            break;
+        }
+        if (n == 0)
+            break;
+
+        log_feed(&w, buffer, n);
+        if (w.member->len >= LOG_MEMBER_MAX_BYTES ||
+            (g_get_monotonic_time() - w.member_start) / 1000 >= LOG_MEMBER_MAX_MS)
+            log_flush_member(&w);
+    }
+
+    /* Última línea sin salto */
+    if (w.line->len > 0)
+        log_emit_line(&w);
+    log_flush_member(&w);
+
+    if (w.fd >= 0)
+        close(w.fd);
+    g_string_free(w.line, TRUE);
+    g_string_free(w.member, TRUE);
+    return w.failed ? 1 : 0;
+}
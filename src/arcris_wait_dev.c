@@ -0,0 +1,144 @@
+/*
+ * arcris-wait-dev: espera a que udev publique dispositivos de bloque.
+ *
+ *   arcris-wait-dev [--timeout SEGUNDOS] ESPECIFICACIÓN...
+ *
+ * Cada especificación es una ruta (/dev/sda2, /dev/vg0/root), UUID=<uuid>,
+ * PARTUUID=<uuid>, LABEL=<etiqueta> o DM=<nombre> (/dev/mapper/<nombre>).
+ * Un dispositivo está listo cuando su nodo existe y udev terminó de procesarlo
+ * (symlinks y base de datos creados), que es lo que necesitan mkfs, blkid,
+ * cryptsetup y mount. Los scripts de instalación lo usan en lugar de
+ * "sleep N; udevadm settle": vuelve en cuanto llega el evento y, en discos
+ * lentos, sigue esperando hasta el timeout en vez de continuar antes de tiempo.
+ *
+ * Sale con 0 si todos están listos, 1 si vence el timeout y 2 si los
+ * argumentos son inválidos.
+ */
+#include <glib.h>
+#include <libudev.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define WAIT_DEV_DEFAULT_TIMEOUT 30
+
+static gchar *spec_to_path(const gchar *spec)
+{
+    static const struct {
+        const gchar *prefix;
+        const gchar *dir;
+    } links[] = {
+        { "UUID=",     "/dev/disk/by-uuid/" },
+        { "PARTUUID=", "/dev/disk/by-partuuid/" },
+        { "LABEL=",    "/dev/disk/by-label/" },
+        { "DM=",       "/dev/mapper/" },
+    };
+
+    for (guint i = 0; i < G_N_ELEMENTS(links); i++) {
+        if (g_str_has_prefix(spec, links[i].prefix))
+            return g_strconcat(links[i].dir, spec + strlen(links[i].prefix), NULL);
+    }
+    return g_strdup(spec);
+}
+
+static gboolean device_ready(struct udev *udev, const gchar *path)
+{
+    struct stat st;
+
+    /* stat sigue los symlinks de /dev/disk/by-* y /dev/mapper */
+    if (stat(path, &st) != 0 || !S_ISBLK(st.st_mode))
+        return FALSE;
+
+    struct udev_device *dev = udev_device_new_from_devnum(udev, 'b', st.st_rdev);
+    if (!dev)
+        return FALSE;
+    gboolean ready = udev_device_get_is_initialized(dev) > 0;
+    udev_device_unref(dev);
+    return ready;
+}
+
+/* Quita de pending los dispositivos que ya están listos */
+static void check_pending(struct udev *udev, GPtrArray *pending)
+{
+    for (guint i = pending->len; i > 0; i--) {
+        if (device_ready(udev, g_ptr_array_index(pending, i - 1)))
+            g_ptr_array_remove_index(pending, i - 1);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    gint timeout = WAIT_DEV_DEFAULT_TIMEOUT;
+    GOptionEntry entries[] = {
+        { "timeout", 't', 0, G_OPTION_ARG_INT, &timeout,
+          "Segundos máximos de espera", "SEGUNDOS" },
+        { NULL }
+    };
+    g_autoptr(GOptionContext) context = g_option_context_new("ESPECIFICACIÓN...");
+    g_autoptr(GError) error = NULL;
+
+    g_option_context_add_main_entries(context, entries, NULL);
+    g_option_context_set_summary(context,
+        "Espera a que udev publique los dispositivos de bloque indicados\n"
+        "(ruta /dev, UUID=, PARTUUID=, LABEL= o DM=).");
+    if (!g_option_context_parse(context, &argc, &argv, &error) || argc < 2 || timeout < 0) {
+        fprintf(stderr, "arcris-wait-dev: %s\n",
+                error ? error->message : "uso: arcris-wait-dev [--timeout SEGUNDOS] ESPECIFICACIÓN...");
+        return 2;
+    }
+
+    struct udev *udev = udev_new();
+    if (!udev) {
+        fprintf(stderr, "arcris-wait-dev: no se pudo inicializar libudev\n");
+        return 2;
+    }
+
+    /* El monitor se abre antes de la primera comprobación para no perder
+     * eventos que lleguen entre ambas */
+    struct udev_monitor *monitor = udev_monitor_new_from_netlink(udev, "udev");
+    if (monitor) {
+        udev_monitor_filter_add_match_subsystem_devtype(monitor, "block", NULL);
+        if (udev_monitor_enable_receiving(monitor) < 0) {
+            udev_monitor_unref(monitor);
+            monitor = NULL;
+        }
+    }
+
+    g_autoptr(GPtrArray) pending = g_ptr_array_new_with_free_func(g_free);
+    for (int i = 1; i < argc; i++)
+        g_ptr_array_add(pending, spec_to_path(argv[i]));
+
+    gint64 deadline = g_get_monotonic_time() + (gint64)timeout * G_USEC_PER_SEC;
+    check_pending(udev, pending);
+
+    while (pending->len > 0) {
+        gint64 remaining_ms = (deadline - g_get_monotonic_time()) / 1000;
+        if (remaining_ms <= 0)
+            break;
+
+        if (monitor) {
+            struct pollfd pfd = { .fd = udev_monitor_get_fd(monitor), .events = POLLIN };
+            if (poll(&pfd, 1, (int)remaining_ms) > 0) {
+                /* Vaciar la cola: varios eventos pueden llegar juntos */
+                struct udev_device *dev;
+                while ((dev = udev_monitor_receive_device(monitor)) != NULL)
+                    udev_device_unref(dev);
+            }
+        } else {
+            /* Sin netlink (contenedores) se comprueba cada 100 ms */
+            g_usleep(MIN(remaining_ms, 100) * 1000);
+        }
+        check_pending(udev, pending);
+    }
+
+    for (guint i = 0; i < pending->len; i++)
+        fprintf(stderr, "arcris-wait-dev: %s no apareció en %d s\n",
+                (const gchar *)g_ptr_array_index(pending, i), timeout);
+
+    int status = pending->len == 0 ? 0 : 1;
+    if (monitor)
+        udev_monitor_unref(monitor);
+    udev_unref(udev);
+    return status;
+}
@@ -11,12 +11,20 @@
 #include "page8.h"
 #include "page9.h"
 #include "page10.h"
+#include "trace.h"
 
 
 #include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Inicializa una página midiendo su duración cuando ARCRIS_TRACE está activo
+#define CAROUSEL_TRACED_PAGE_INIT(init_fn) \
+    do { \
+        TRACE_SCOPE(TRACE_CAT_UI, #init_fn); \
+        init_fn(builder, manager->carousel, manager->revealer); \
+    } while (0)
+
 // Forward declaration for page change callback
 static void on_carousel_page_changed_internal(AdwCarousel *carousel, guint page, gpointer user_data);
 
@@ -54,6 +62,8 @@ void carousel_manager_init(CarouselManager *manager, GtkBuilder *builder)
         LOG_ERROR("CarouselManager o GtkBuilder son NULL");
         return;
     }
+
+    TRACE_SCOPE(TRACE_CAT_STARTUP, "carousel_manager_init");
     
     // Obtener widgets del carousel desde el builder principal
     manager->carousel = ADW_CAROUSEL(gtk_builder_get_object(builder, "carousel"));
@@ -101,38 +111,39 @@ void carousel_manager_init(CarouselManager *manager, GtkBuilder *builder)
 void carousel_init_all_pages(CarouselManager *manager, GtkBuilder *builder)
 {
     if (!manager || !builder) return;
-    
+
+    TRACE_SCOPE(TRACE_CAT_STARTUP, "carousel_init_all_pages");
     LOG_INFO("Inicializando todas las páginas del carousel...");
     
     // Inicializar página 1 (Verificación de Internet)
-    page1_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page1_init);
     
     // Inicializar página 2 (Configuración del Sistema)
-    page2_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page2_init);
     
     // Inicializar página 3 (Configuración Adicional)
-    page3_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page3_init);
     
     // Inicializar página 4 (Registro de Usuario)
-    page4_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page4_init);
     
     // Inicializar página 5 (Personalización)
-    page5_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page5_init);
     
     // Inicializar página 6 (Sistema)
-    page6_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page6_init);
     
     // Inicializar página 7 (Resumen)
-    page7_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page7_init);
     
     // Inicializar página 8 (Instalación con carousel)
-    page8_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page8_init);
     
     // Inicializar página 9 (Finalización)
-    page9_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page9_init);
 
     // Inicializar página 10 (Error de instalación)
-    page10_init(builder, manager->carousel, manager->revealer);
+    CAROUSEL_TRACED_PAGE_INIT(page10_init);
 
     
     LOG_INFO("Todas las páginas han sido inicializadas");
@@ -172,6 +183,7 @@ void carousel_navigate_to_page(CarouselManager *manager, guint page_index)
         manager->current_page = page_index;
         
         arcris_log_page_transition(old_page, page_index);
+        trace_instant(TRACE_CAT_NAVIGATION, "navigate %u -> %u", old_page, page_index);
         
         // Actualizar controles de navegación
         carousel_update_navigation_controls(manager);
@@ -428,6 +440,9 @@ static void on_carousel_page_changed_internal(AdwCarousel *carousel, guint page,
 {
     CarouselManager *manager = (CarouselManager *)user_data;
     if (!manager) return;
+
+    // Incluye los pageN_on_enter / pageN_on_page_shown llamados más abajo
+    TRACE_SCOPE(TRACE_CAT_NAVIGATION, "page-changed %u", page);
     
     // Debug: mostrar total de páginas
     guint total_pages = adw_carousel_get_n_pages(carousel);
@@ -439,8 +454,11 @@ static void on_carousel_page_changed_internal(AdwCarousel *carousel, guint page,
     manager->current_page = page;
     
     // Llamar a la función específica de page4 cuando se entra en ella (índice 3)
+    // y, al salir, escribir de una vez lo que se guardó mientras tanto
     if (page == 3) {
         page4_on_enter();
+    } else {
+        page4_on_leave();
     }
     
     // Llamar a la función específica de page6 cuando se entra en ella (índice 5)
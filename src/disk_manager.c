@@ -3,6 +3,12 @@
 #include "partitionmanual.h"
 #include "page3.h"
 #include "config.h"
+#include "trace.h"
+#include "storage_profile.h"
+#include "partition_plan.h"
+#include "wipe_strategy.h"
+#include "performance_profile.h"
+#include "os_detect.h"
 #include <string.h>
 
 // Función para liberar memoria de DiskInfo
@@ -122,6 +128,8 @@ disk_manager_free(DiskManager *manager)
 gboolean
 disk_manager_setup_udisks(DiskManager *manager)
 {
+    TRACE_SCOPE(TRACE_CAT_UDISKS, "udisks_client_new_sync");
+
     if (!manager) return FALSE;
 
     GError *error = NULL;
@@ -197,6 +205,8 @@ disk_manager_init(DiskManager *manager, GtkBuilder *builder)
 void
 disk_manager_populate_list(DiskManager *manager)
 {
+    TRACE_SCOPE(TRACE_CAT_UDISKS, "disk_manager_populate_list");
+
     if (!manager) return;
 
     GList *objects, *l;
@@ -407,6 +417,17 @@ static void apply_selected_disk(GString *content, gpointer user_data)
     DiskManager *manager = (DiskManager *)user_data;
     vars_upsert(content, "SELECTED_DISK",
                 manager->selected_disk_path ? manager->selected_disk_path : "");
+
+    /* Opciones de mkfs y montaje según el tipo de dispositivo */
+    StorageProfile profile;
+    storage_profile_detect(manager->selected_disk_path, &profile);
+    storage_profile_write_variables(content, &profile);
+    wipe_strategy_update_variables(content);
+    partition_plan_update_variables(content);
+    /* Los límites de escritura diferida dependen de la clase del disco */
+    perf_profile_update_variables(content);
+    /* Los sistemas del disco que se va a borrar no van al menú de arranque */
+    os_detect_update_variables(content);
 }
 
 gboolean
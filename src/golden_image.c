@@ -0,0 +1,160 @@
+#include "golden_image.h"
+#include "config.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#define GOLDEN_IMAGE_READ_BLOCK (1024 * 1024)
+
+/* Variables que cambian en cada máquina y se aplican después de volcar la imagen */
+static const gchar *per_machine_keys[] = {
+    "USER",
+    "PASSWORD_USER",
+    "PASSWORD_ROOT",
+    "HOSTNAME",
+    "SELECTED_DISK",
+    "PARTITIONS",
+    "PARTITION_TABLE",
+    "ENCRYPTION_KEY",
+    NULL
+};
+
+static gboolean is_per_machine_key(const gchar *key)
+{
+    /* Los drivers dependen del hardware de cada equipo */
+    if (g_str_has_prefix(key, "DRIVER_"))
+        return TRUE;
+    /* El perfil de almacenamiento depende del disco de destino y el cifrado
+     * LUKS se mide en cada CPU */
+    if (g_str_has_prefix(key, "STORAGE_") || g_str_has_prefix(key, "LUKS_"))
+        return TRUE;
+    /* El borrado del disco no cambia el contenido de la imagen */
+    if (g_str_has_prefix(key, "WIPE_"))
+        return TRUE;
+    /* El perfil de rendimiento se aplica después de volcar la imagen y sus
+     * valores PERF_* dependen de la CPU, la RAM y la red de cada equipo */
+    if (g_str_has_prefix(key, "PERF"))
+        return TRUE;
+    /* Los otros sistemas instalados son los de los discos de cada equipo */
+    if (g_str_has_prefix(key, "OTHER_OS_") || g_strcmp0(key, "OS_PROBER_NEEDED") == 0)
+        return TRUE;
+    for (int i = 0; per_machine_keys[i]; i++) {
+        if (g_strcmp0(key, per_machine_keys[i]) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+gchar *golden_image_key(GHashTable *answers)
+{
+    g_return_val_if_fail(answers != NULL, NULL);
+
+    /* Orden estable para que la clave no dependa del orden del archivo */
+    GList *keys = g_list_sort(g_hash_table_get_keys(answers), (GCompareFunc)g_strcmp0);
+    GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+
+    for (GList *l = keys; l; l = l->next) {
+        const gchar *key = l->data;
+        if (is_per_machine_key(key))
+            continue;
+        const gchar *value = g_hash_table_lookup(answers, key);
+        g_checksum_update(checksum, (const guchar *)key, -1);
+        g_checksum_update(checksum, (const guchar *)"=", 1);
+        g_checksum_update(checksum, (const guchar *)value, -1);
+        g_checksum_update(checksum, (const guchar *)"\n", 1);
+    }
+
+    gchar *key = g_strdup(g_checksum_get_string(checksum));
+    g_checksum_free(checksum);
+    g_list_free(keys);
+    return key;
+}
+
+gchar *golden_image_path(const gchar *image_dir, const gchar *key)
+{
+    gchar *file_name = g_strdup_printf("arcris-%s%s", key, GOLDEN_IMAGE_SUFFIX);
+    gchar *path = g_build_filename(image_dir, file_name, NULL);
+    g_free(file_name);
+    return path;
+}
+
+gchar *golden_image_checksum(const gchar *image_path, GError **error)
+{
+    FILE *file = fopen(image_path, "rb");
+    if (!file) {
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno),
+                    "No se pudo abrir %s: %s", image_path, g_strerror(errno));
+        return NULL;
+    }
+
+    GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+    guchar *buffer = g_malloc(GOLDEN_IMAGE_READ_BLOCK);
+    gsize bytes;
+
+    while ((bytes = fread(buffer, 1, GOLDEN_IMAGE_READ_BLOCK, file)) > 0)
+        g_checksum_update(checksum, buffer, bytes);
+
+    gchar *digest = NULL;
+    if (ferror(file)) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_IO, "Error leyendo %s", image_path);
+    } else {
+        digest = g_strdup(g_checksum_get_string(checksum));
+    }
+
+    g_free(buffer);
+    g_checksum_free(checksum);
+    fclose(file);
+    return digest;
+}
+
+gboolean golden_image_verify(const gchar *image_path, GError **error)
+{
+    gchar *manifest_path = g_strconcat(image_path, GOLDEN_IMAGE_MANIFEST_SUFFIX, NULL);
+    gchar *manifest = NULL;
+    gboolean ok = FALSE;
+
+    if (!g_file_test(image_path, G_FILE_TEST_IS_REGULAR)) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOENT, "No existe la imagen %s", image_path);
+    } else if (g_file_get_contents(manifest_path, &manifest, NULL, error)) {
+        /* Solo importa el primer campo: "<sha256>  <nombre>" */
+        gchar *expected = g_strstrip(g_strdup(manifest));
+        gchar *space = strpbrk(expected, " \t");
+        if (space) *space = '\0';
+
+        LOG_INFO("Verificando integridad de %s", image_path);
+        gchar *actual = golden_image_checksum(image_path, error);
+        if (actual) {
+            ok = g_ascii_strcasecmp(actual, expected) == 0;
+            if (!ok)
+                g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_FAILED,
+                            "La suma sha256 de %s no coincide con el manifiesto", image_path);
+        }
+        g_free(actual);
+        g_free(expected);
+    }
+
+    g_free(manifest);
+    g_free(manifest_path);
+    return ok;
+}
+
+gboolean golden_image_write_manifest(const gchar *image_path, GError **error)
+{
+    gchar *digest = golden_image_checksum(image_path, error);
+    if (!digest)
+        return FALSE;
+
+    gchar *manifest_path = g_strconcat(image_path, GOLDEN_IMAGE_MANIFEST_SUFFIX, NULL);
+    gchar *base_name = g_path_get_basename(image_path);
+    gchar *manifest = g_strdup_printf("%s  %s\n", digest, base_name);
+    gboolean ok = g_file_set_contents(manifest_path, manifest, -1, error);
+
+    if (ok)
+        LOG_INFO("Manifiesto de imagen escrito en %s", manifest_path);
+
+    g_free(manifest);
+    g_free(base_name);
+    g_free(manifest_path);
+    g_free(digest);
+    return ok;
+}
@@ -0,0 +1,32 @@
+#ifndef GOLDEN_IMAGE_H
+#define GOLDEN_IMAGE_H
+
+#include <glib.h>
+
+/* Opción del modo desatendido: directorio donde se guardan las imágenes maestras */
+#define GOLDEN_IMAGE_OPTION "--image-dir"
+
+/* Extensiones de la imagen (tar + zstd de /mnt, la genera golden_image.sh)
+ * y de su manifiesto de integridad ("<sha256>  <nombre>", formato de sha256sum) */
+#define GOLDEN_IMAGE_SUFFIX          ".tar.zst"
+#define GOLDEN_IMAGE_MANIFEST_SUFFIX ".sha256"
+
+/* Clave de la imagen para unas respuestas: sha256 de todas las variables
+ * excepto las propias de cada máquina (usuario, hostname, contraseñas,
+ * disco, particiones y drivers). Dos instalaciones con la misma clave
+ * producen el mismo sistema base. */
+gchar *golden_image_key(GHashTable *answers);
+
+/* Ruta de la imagen de una clave dentro de image_dir */
+gchar *golden_image_path(const gchar *image_dir, const gchar *key);
+
+/* Calcula el sha256 del archivo leyendo por bloques (las imágenes ocupan varios GB) */
+gchar *golden_image_checksum(const gchar *image_path, GError **error);
+
+/* Comprueba que la imagen existe y coincide con su manifiesto */
+gboolean golden_image_verify(const gchar *image_path, GError **error);
+
+/* Escribe el manifiesto de una imagen recién capturada */
+gboolean golden_image_write_manifest(const gchar *image_path, GError **error);
+
+#endif /* GOLDEN_IMAGE_H */
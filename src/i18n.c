@@ -514,6 +514,71 @@ static const TransEntry g_trans[] = {
       "Linux otimizado para o desempenho e a experiência do usuário, com patches que melhoram a interatividade, velocidade e resposta do sistema.",
       "Linux optimisé pour les performances et l'expérience utilisateur, avec des correctifs qui améliorent l'interactivité, la vitesse et la réactivité du système.",
       "Linux optimiert für Leistung und Benutzererfahrung, mit Patches, die Interaktivität, Geschwindigkeit und Systemreaktionsfähigkeit verbessern." },
+    { "Cargador de arranque",
+      "Boot loader", "Загрузчик", "Carregador de inicialização",
+      "Chargeur d'amorçage", "Bootloader" },
+    { "systemd-boot arranca directamente una imagen unificada por kernel, sin menú ni detección de otros sistemas. Solo disponible en equipos UEFI.",
+      "systemd-boot starts one unified image per kernel directly, without a menu or detection of other systems. Only available on UEFI machines.",
+      "systemd-boot напрямую загружает единый образ для каждого ядра, без меню и поиска других систем. Доступно только на компьютерах с UEFI.",
+      "O systemd-boot inicia diretamente uma imagem unificada por kernel, sem menu nem detecção de outros sistemas. Disponível apenas em computadores UEFI.",
+      "systemd-boot démarre directement une image unifiée par noyau, sans menu ni détection d'autres systèmes. Disponible uniquement sur les machines UEFI.",
+      "systemd-boot startet direkt ein vereinheitlichtes Image pro Kernel, ohne Menü und ohne Erkennung anderer Systeme. Nur auf UEFI-Rechnern verfügbar." },
+    { "Menú de arranque con detección de otros sistemas operativos y snapshots",
+      "Boot menu with detection of other operating systems and snapshots",
+      "Меню загрузки с обнаружением других операционных систем и снимков",
+      "Menu de inicialização com detecção de outros sistemas operacionais e snapshots",
+      "Menu de démarrage avec détection des autres systèmes d'exploitation et des instantanés",
+      "Bootmenü mit Erkennung anderer Betriebssysteme und Snapshots" },
+    { "Arranque rápido: el firmware carga una imagen unificada del kernel generada en la instalación",
+      "Fast boot: the firmware loads a unified kernel image generated during installation",
+      "Быстрая загрузка: прошивка загружает единый образ ядра, созданный при установке",
+      "Inicialização rápida: o firmware carrega uma imagem unificada do kernel gerada na instalação",
+      "Démarrage rapide : le firmware charge une image unifiée du noyau générée lors de l'installation",
+      "Schnellstart: Die Firmware lädt ein bei der Installation erzeugtes vereinheitlichtes Kernel-Image" },
+    { "Imagen de arranque (initramfs)",
+      "Boot image (initramfs)",
+      "Загрузочный образ (initramfs)",
+      "Imagem de inicialização (initramfs)",
+      "Image de démarrage (initramfs)",
+      "Boot-Image (initramfs)" },
+    { "Los perfiles rápidos generan una imagen solo para este equipo y todos los kernels a la vez. El informe de la instalación guarda el tiempo y el tamaño de cada imagen.",
+      "The fast profiles build an image only for this computer and all kernels at once. The installation report records the build time and size of each image.",
+      "Быстрые профили создают образ только для этого компьютера и для всех ядер одновременно. Отчёт об установке сохраняет время сборки и размер каждого образа.",
+      "Os perfis rápidos geram uma imagem apenas para este computador e todos os kernels ao mesmo tempo. O relatório da instalação guarda o tempo e o tamanho de cada imagem.",
+      "Les profils rapides génèrent une image propre à cet ordinateur et tous les noyaux en même temps. Le rapport d'installation conserve le temps et la taille de chaque image.",
+      "Die schnellen Profile erzeugen ein Image nur für diesen Computer und alle Kernel gleichzeitig. Der Installationsbericht speichert Dauer und Größe jedes Images." },
+    { "Por defecto", "Default", "По умолчанию", "Padrão", "Par défaut", "Standard" },
+    { "sin fallback", "no fallback", "без fallback", "sem fallback", "sans fallback", "ohne Fallback" },
+    { "Configuración de mkinitcpio de Arch Linux, un kernel detrás de otro",
+      "Arch Linux mkinitcpio configuration, one kernel after another",
+      "Конфигурация mkinitcpio Arch Linux, ядра по очереди",
+      "Configuração do mkinitcpio do Arch Linux, um kernel após o outro",
+      "Configuration mkinitcpio d'Arch Linux, un noyau après l'autre",
+      "mkinitcpio-Konfiguration von Arch Linux, ein Kernel nach dem anderen" },
+    { "Compresión zstd con todos los núcleos: la instalación termina antes",
+      "zstd compression on all cores: the installation finishes sooner",
+      "Сжатие zstd на всех ядрах процессора: установка завершается быстрее",
+      "Compressão zstd com todos os núcleos: a instalação termina mais cedo",
+      "Compression zstd sur tous les cœurs : l'installation se termine plus tôt",
+      "zstd-Komprimierung auf allen Kernen: Die Installation ist früher fertig" },
+    { "Compresión lz4: imagen algo mayor que se descomprime más rápido al arrancar",
+      "lz4 compression: a slightly larger image that decompresses faster at boot",
+      "Сжатие lz4: образ немного больше, но быстрее распаковывается при загрузке",
+      "Compressão lz4: imagem um pouco maior que descomprime mais rápido na inicialização",
+      "Compression lz4 : image un peu plus grande, décompressée plus vite au démarrage",
+      "lz4-Komprimierung: etwas größeres Image, das beim Booten schneller entpackt wird" },
+    { "Imagen de respaldo (fallback)",
+      "Fallback image",
+      "Резервный образ (fallback)",
+      "Imagem de reserva (fallback)",
+      "Image de secours (fallback)",
+      "Fallback-Image" },
+    { "Imagen con todos los módulos por si el equipo cambia de hardware. Desactivarla ahorra una imagen por kernel.",
+      "Image with every module in case the computer's hardware changes. Turning it off saves one image per kernel.",
+      "Образ со всеми модулями на случай смены оборудования. Отключение экономит один образ на ядро.",
+      "Imagem com todos os módulos caso o hardware do computador mude. Desativá-la economiza uma imagem por kernel.",
+      "Image avec tous les modules au cas où le matériel change. La désactiver économise une image par noyau.",
+      "Image mit allen Modulen, falls sich die Hardware ändert. Ohne sie wird pro Kernel ein Image weniger erzeugt." },
 
     /* ── Hardware Window ── */
     { "Hardware",  "Hardware",   "Оборудование", "Hardware",  "Matériel",  "Hardware"  },
@@ -605,6 +670,55 @@ static const TransEntry g_trans[] = {
       "Reprodução de todos os formatos de vídeo",
       "Lecture de tous les formats vidéo",
       "Wiedergabe aller Videoformate" },
+    { "Perfil de rendimiento",
+      "Performance profile", "Профиль производительности", "Perfil de desempenho",
+      "Profil de performances", "Leistungsprofil" },
+    { "Planificador de E/S, frecuencia de la CPU y parámetros del kernel ajustados a este equipo",
+      "I/O scheduler, CPU frequency and kernel parameters tuned to this machine",
+      "Планировщик ввода-вывода, частота ЦП и параметры ядра, настроенные под этот компьютер",
+      "Escalonador de E/S, frequência da CPU e parâmetros do kernel ajustados a este computador",
+      "Ordonnanceur d'E/S, fréquence du processeur et paramètres du noyau adaptés à cette machine",
+      "E/A-Scheduler, CPU-Frequenz und Kernelparameter passend zu diesem Rechner" },
+    { "Perfil",
+      "Profile", "Профиль", "Perfil", "Profil", "Profil" },
+    { "Equilibrado",
+      "Balanced", "Сбалансированный", "Equilibrado", "Équilibré", "Ausgewogen" },
+    { "Máximo rendimiento",
+      "Maximum throughput", "Максимальная производительность", "Desempenho máximo",
+      "Débit maximal", "Maximaler Durchsatz" },
+    { "Escritorio de baja latencia",
+      "Low-latency desktop", "Рабочий стол с низкой задержкой", "Desktop de baixa latência",
+      "Bureau à faible latence", "Desktop mit niedriger Latenz" },
+    { "Servidor",
+      "Server", "Сервер", "Servidor", "Serveur", "Server" },
+    { "Ajustes moderados según la CPU, la RAM y el disco, con ahorro de energía",
+      "Moderate settings for the CPU, RAM and disk, with power saving",
+      "Умеренные настройки под ЦП, ОЗУ и диск с энергосбережением",
+      "Ajustes moderados conforme a CPU, a RAM e o disco, com economia de energia",
+      "Réglages modérés selon le processeur, la RAM et le disque, avec économie d'énergie",
+      "Moderate Einstellungen je nach CPU, RAM und Datenträger, mit Energiesparen" },
+    { "CPU a máxima frecuencia, escritura diferida amplia y búferes de red grandes con BBR",
+      "CPU at maximum frequency, generous write-back and large network buffers with BBR",
+      "ЦП на максимальной частоте, большой объём отложенной записи и крупные сетевые буферы с BBR",
+      "CPU na frequência máxima, escrita diferida ampla e buffers de rede grandes com BBR",
+      "Processeur à fréquence maximale, écriture différée généreuse et grands tampons réseau avec BBR",
+      "CPU mit maximaler Frequenz, großzügiges Write-back und große Netzwerkpuffer mit BBR" },
+    { "bfq en discos SATA, CPU con respuesta rápida y poca escritura pendiente para evitar tirones",
+      "bfq on SATA disks, fast-responding CPU and little pending write-back to avoid stutter",
+      "bfq на дисках SATA, быстрый отклик ЦП и малый объём отложенной записи без подтормаживаний",
+      "bfq em discos SATA, CPU com resposta rápida e pouca escrita pendente para evitar travamentos",
+      "bfq sur les disques SATA, processeur réactif et peu d'écriture en attente pour éviter les saccades",
+      "bfq auf SATA-Datenträgern, schnell reagierende CPU und wenig ausstehendes Write-back gegen Ruckler" },
+    { "mq-deadline, CPU a máxima frecuencia, escritura diferida acotada y red con BBR",
+      "mq-deadline, CPU at maximum frequency, bounded write-back and BBR networking",
+      "mq-deadline, ЦП на максимальной частоте, ограниченная отложенная запись и сеть с BBR",
+      "mq-deadline, CPU na frequência máxima, escrita diferida limitada e rede com BBR",
+      "mq-deadline, processeur à fréquence maximale, écriture différée bornée et réseau avec BBR",
+      "mq-deadline, CPU mit maximaler Frequenz, begrenztes Write-back und Netzwerk mit BBR" },
+    { "Cambiar perfil de rendimiento",
+      "Change performance profile", "Изменить профиль производительности",
+      "Alterar perfil de desempenho", "Changer le profil de performances",
+      "Leistungsprofil ändern" },
 
     /* ── Apps Window ── */
     { "Categorías de Paquetes",
@@ -670,6 +784,36 @@ static const TransEntry g_trans[] = {
       "Em lista ou com espaços:",
       "En liste ou avec des espaces :",
       "Als Liste oder mit Leerzeichen:" },
+    { "Descarga:",   "Download:",   "Загрузка:",  "Download:",   "Téléchargement :", "Download:"   },
+    { "Grupo de",    "Group from",  "Группа из",  "Grupo de",    "Groupe de",        "Gruppe aus"  },
+    { "paquetes",    "packages",    "пакетов",    "pacotes",     "paquets",          "Pakete"      },
+    { "Provisto por","Provided by", "Предоставляется", "Fornecido por", "Fourni par", "Bereitgestellt von" },
+    { "Comprobando...", "Checking...", "Проверка...", "Verificando...", "Vérification...", "Wird geprüft..." },
+    { "No se pudo comprobar",
+      "Could not be checked", "Не удалось проверить",
+      "Não foi possível verificar", "Impossible de vérifier", "Konnte nicht geprüft werden" },
+    { "Se compila durante la instalación",
+      "Built during installation", "Собирается во время установки",
+      "Compilado durante a instalação", "Compilé pendant l'installation",
+      "Wird während der Installation gebaut" },
+    { "No existe en los repositorios ni en el AUR",
+      "Not found in the repositories or the AUR", "Не найден ни в репозиториях, ни в AUR",
+      "Não existe nos repositórios nem no AUR",
+      "Introuvable dans les dépôts et dans l'AUR",
+      "Weder in den Repositorys noch im AUR vorhanden" },
+    { "Nombre de paquete no válido",
+      "Invalid package name", "Недопустимое имя пакета",
+      "Nome de pacote inválido", "Nom de paquet invalide", "Ungültiger Paketname" },
+    { "Corrige los paquetes marcados antes de guardar",
+      "Fix the marked packages before saving", "Исправьте отмеченные пакеты перед сохранением",
+      "Corrija os pacotes marcados antes de salvar",
+      "Corrigez les paquets signalés avant d'enregistrer",
+      "Korrigieren Sie die markierten Pakete vor dem Speichern" },
+    { "Descarga total desde los repositorios:",
+      "Total download from the repositories:", "Общий объём загрузки из репозиториев:",
+      "Download total dos repositórios:",
+      "Téléchargement total depuis les dépôts :",
+      "Gesamter Download aus den Repositorys:" },
 
     /* ── Disk Window ── */
     { "Sistema de Archivos",
@@ -678,6 +822,94 @@ static const TransEntry g_trans[] = {
     { "Formatear el almacenamiento como:",
       "Format storage as:", "Форматировать хранилище как:",
       "Formatar o armazenamento como:", "Formater le stockage comme :", "Speicher formatieren als:" },
+    { "Rendimiento del cifrado",
+      "Encryption performance", "Производительность шифрования",
+      "Desempenho da criptografia", "Performances du chiffrement", "Verschlüsselungsleistung" },
+    { "Midiendo el rendimiento de los cifrados...",
+      "Measuring cipher performance...", "Измерение производительности шифров...",
+      "Medindo o desempenho das cifras...", "Mesure des performances des chiffrements...",
+      "Verschlüsselungsleistung wird gemessen..." },
+    { "cifrado",
+      "encryption", "шифрование",
+      "criptografia", "chiffrement", "Verschlüsselung" },
+    { "descifrado",
+      "decryption", "расшифровка",
+      "descriptografia", "déchiffrement", "Entschlüsselung" },
+    { "No se pudo medir el rendimiento, se usan los valores por defecto",
+      "Could not measure performance, using default values",
+      "Не удалось измерить производительность, используются значения по умолчанию",
+      "Não foi possível medir o desempenho, usando os valores padrão",
+      "Impossible de mesurer les performances, valeurs par défaut utilisées",
+      "Leistung konnte nicht gemessen werden, Standardwerte werden verwendet" },
+    { "Perfil del dispositivo",
+      "Device profile", "Профиль устройства",
+      "Perfil do dispositivo", "Profil du périphérique", "Geräteprofil" },
+    { "Disco mecánico",
+      "Hard disk", "Жёсткий диск",
+      "Disco rígido", "Disque dur", "Festplatte" },
+    { "Dispositivo no identificado, opciones genéricas",
+      "Unidentified device, generic options", "Устройство не определено, общие параметры",
+      "Dispositivo não identificado, opções genéricas",
+      "Périphérique non identifié, options génériques",
+      "Unbekanntes Gerät, allgemeine Optionen" },
+    { "Borrado del Disco",
+      "Disk Erase", "Очистка диска",
+      "Apagamento do Disco", "Effacement du disque", "Datenträger löschen" },
+    { "Cómo se limpia el disco antes de crear las particiones",
+      "How the disk is cleaned before creating the partitions",
+      "Как очищается диск перед созданием разделов",
+      "Como o disco é limpo antes de criar as partições",
+      "Comment le disque est nettoyé avant de créer les partitions",
+      "Wie der Datenträger vor dem Anlegen der Partitionen bereinigt wird" },
+    { "Método de borrado",
+      "Erase method", "Метод очистки",
+      "Método de apagamento", "Méthode d'effacement", "Löschmethode" },
+    { "Borrado completo",
+      "Full erase", "Полная очистка",
+      "Apagamento completo", "Effacement complet", "Vollständiges Löschen" },
+    { "Elimina todos los datos anteriores; el progreso se muestra durante la instalación",
+      "Removes all previous data; progress is shown during the installation",
+      "Удаляет все прежние данные; ход выполнения отображается во время установки",
+      "Remove todos os dados anteriores; o progresso é exibido durante a instalação",
+      "Supprime toutes les données précédentes ; la progression s'affiche pendant l'installation",
+      "Entfernt alle bisherigen Daten; der Fortschritt wird während der Installation angezeigt" },
+    { "Discard (TRIM) de todo el disco",
+      "Discard (TRIM) of the whole disk", "Discard (TRIM) всего диска",
+      "Discard (TRIM) de todo o disco", "Discard (TRIM) de tout le disque",
+      "Discard (TRIM) des gesamten Datenträgers" },
+    { "Discard seguro de todo el disco",
+      "Secure discard of the whole disk", "Безопасный discard всего диска",
+      "Discard seguro de todo o disco", "Discard sécurisé de tout le disque",
+      "Sicheres Discard des gesamten Datenträgers" },
+    { "Sanitize NVMe del controlador",
+      "NVMe controller sanitize", "Sanitize контроллера NVMe",
+      "Sanitize NVMe do controlador", "Sanitize NVMe du contrôleur",
+      "NVMe-Sanitize durch den Controller" },
+    { "Escritura de ceros delegada al disco",
+      "Zeroing offloaded to the disk", "Запись нулей средствами диска",
+      "Escrita de zeros delegada ao disco", "Écriture de zéros déléguée au disque",
+      "Nullschreiben durch den Datenträger" },
+    { "Escritura de ceros en todo el disco",
+      "Writing zeros to the whole disk", "Запись нулей на весь диск",
+      "Escrita de zeros em todo o disco", "Écriture de zéros sur tout le disque",
+      "Nullen auf den gesamten Datenträger schreiben" },
+    { "Solo tabla de particiones y firmas",
+      "Partition table and signatures only", "Только таблица разделов и сигнатуры",
+      "Somente tabela de partições e assinaturas",
+      "Table de partitions et signatures uniquement",
+      "Nur Partitionstabelle und Signaturen" },
+    { "Borrando el disco",
+      "Erasing the disk", "Идёт очистка диска",
+      "Apagando o disco", "Effacement du disque", "Datenträger wird gelöscht" },
+    { "En espera",
+      "Waiting", "Ожидание",
+      "Aguardando", "En attente", "Wartet" },
+    { "Instalación completada",
+      "Installation completed", "Установка завершена",
+      "Instalação concluída", "Installation terminée", "Installation abgeschlossen" },
+    { "La instalación falló",
+      "Installation failed", "Установка не удалась",
+      "A instalação falhou", "L'installation a échoué", "Installation fehlgeschlagen" },
     { "Separación del Directorio Personal",
       "Home Directory Separation", "Разделение домашнего каталога",
       "Separação do Diretório Pessoal",
@@ -1835,6 +2067,44 @@ static const TransEntry g_trans[] = {
       "Quitter l'installateur",
       "Installer beenden" },
 
+    /* ── Página 9 — Tiempos de instalación ── */
+    { "Tiempos de instalación",
+      "Installation timings",
+      "Время установки",
+      "Tempos de instalação",
+      "Durées de l'installation",
+      "Installationszeiten" },
+    { "Total",
+      "Total",
+      "Всего",
+      "Total",
+      "Total",
+      "Gesamt" },
+    { "Esperas",
+      "Waiting",
+      "Ожидание",
+      "Esperas",
+      "Attente",
+      "Wartezeit" },
+    { "Descargado",
+      "Downloaded",
+      "Загружено",
+      "Baixado",
+      "Téléchargé",
+      "Heruntergeladen" },
+    { "Reintentos",
+      "Retries",
+      "Повторы",
+      "Tentativas",
+      "Nouvelles tentatives",
+      "Wiederholungen" },
+    { "Paquetes más lentos",
+      "Slowest packages",
+      "Самые медленные пакеты",
+      "Pacotes mais lentos",
+      "Paquets les plus lents",
+      "Langsamste Pakete" },
+
     /* ── Tooltips — Partición manual ── */
     { "Configurar partición",
       "Configure partition",
@@ -1862,6 +2132,33 @@ static const TransEntry g_trans[] = {
       "Ver registro",
       "Voir le journal",
       "Protokoll anzeigen" },
+    { "Buscar en el registro",
+      "Search the log",
+      "Поиск в журнале",
+      "Pesquisar no registro",
+      "Rechercher dans le journal",
+      "Im Protokoll suchen" },
+    { "Siguiente error",
+      "Next error",
+      "Следующая ошибка",
+      "Próximo erro",
+      "Erreur suivante",
+      "Nächster Fehler" },
+    { "Siguiente reintento",
+      "Next retry",
+      "Следующая повторная попытка",
+      "Próxima nova tentativa",
+      "Nouvelle tentative suivante",
+      "Nächster Wiederholungsversuch" },
+    { "Cargando registro...",
+      "Loading log...",
+      "Загрузка журнала...",
+      "Carregando registro...",
+      "Chargement du journal...",
+      "Protokoll wird geladen..." },
+    { "líneas",     "lines",   "строк",    "linhas",     "lignes",     "Zeilen"      },
+    { "errores",    "errors",  "ошибок",   "erros",      "erreurs",    "Fehler"      },
+    { "reintentos", "retries", "повторов", "tentativas", "tentatives", "Wiederholungen" },
 
     /* ── Page 8 — Instalación ── */
     { "Mostrar/Ocultar Terminal",
@@ -1888,6 +2185,14 @@ static const TransEntry g_trans[] = {
       "Aqui é mostrada a saída detalhada do processo de instalação",
       "Voici la sortie détaillée du processus d'installation",
       "Hier wird die detaillierte Ausgabe des Installationsprozesses angezeigt" },
+    { "Memoria",    "Memory",    "Память",    "Memória",   "Mémoire",   "Arbeitsspeicher" },
+    { "Procesos",   "Processes", "Процессы",  "Processos", "Processus", "Prozesse"        },
+    { "Consumo de la instalación (últimos 60 s)",
+      "Installation resource usage (last 60 s)",
+      "Потребление ресурсов установкой (последние 60 с)",
+      "Consumo da instalação (últimos 60 s)",
+      "Consommation de l'installation (60 dernières s)",
+      "Ressourcenverbrauch der Installation (letzte 60 s)" },
 
     /* ── Page 9 — Completado ── */
     { "¡Bienvenido a Arch Linux!",
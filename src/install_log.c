@@ -0,0 +1,66 @@
+#include "install_log.h"
+#include <glib/gstdio.h>
+
+/* Se ejecuta con bash -c; $1 es install.sh y $2 la ruta del registro. La
+ * espera final hace que el proceso hijo (y child-exited de la VTE) termine
+ * cuando arcris-log ya cerró el archivo */
+static const gchar *install_log_pipeline =
+    "command=\"bash $(printf %q \"$1\")\"\n"
+    "if ! command -v " INSTALL_LOG_HELPER " >/dev/null 2>&1; then\n"
+    "    export ARCRIS_INSTALL_LOG=\"${2%.gz}\"\n"
+    "    exec /usr/bin/script --return -q -c \"$command\" \"$ARCRIS_INSTALL_LOG\"\n"
+    "fi\n"
+    "export ARCRIS_INSTALL_LOG=\"$2\"\n"
+    "fifo_dir=$(mktemp -d /tmp/arcris-log.XXXXXX) || exit 1\n"
+    "mkfifo -m 600 \"$fifo_dir/typescript\" || exit 1\n"
+    INSTALL_LOG_HELPER " \"$2\" < \"$fifo_dir/typescript\" &\n"
+    "/usr/bin/script --return -q --flush -c \"$command\" \"$fifo_dir/typescript\"\n"
+    "status=$?\n"
+    "wait\n"
+    "rm -rf \"$fifo_dir\"\n"
+    "exit $status\n";
+
+gchar *install_log_path(const gchar *name)
+{
+    gchar *file = name ? g_strdup_printf("install-%s.log.gz", name) : g_strdup("install.log.gz");
+    gchar *path = g_build_filename(g_get_home_dir(), file, NULL);
+    g_free(file);
+    return path;
+}
+
+gchar **install_log_build_argv(const gchar *const *prefix, const gchar *script_path,
+                               const gchar *log_path)
+{
+    GPtrArray *argv = g_ptr_array_new();
+
+    for (guint i = 0; prefix && prefix[i]; i++)
+        g_ptr_array_add(argv, g_strdup(prefix[i]));
+    g_ptr_array_add(argv, g_strdup("/bin/bash"));
+    g_ptr_array_add(argv, g_strdup("-c"));
+    g_ptr_array_add(argv, g_strdup(install_log_pipeline));
+    g_ptr_array_add(argv, g_strdup("arcris-install"));
+    g_ptr_array_add(argv, g_strdup(script_path));
+    g_ptr_array_add(argv, g_strdup(log_path));
+    g_ptr_array_add(argv, NULL);
+
+    return (gchar **)g_ptr_array_free(argv, FALSE);
+}
+
+gchar *install_log_find_latest(void)
+{
+    gchar *compressed = install_log_path(NULL);
+    gchar *typescript = g_build_filename(g_get_home_dir(), "install.log", NULL);
+    GStatBuf compressed_st, typescript_st;
+    gboolean has_compressed = g_stat(compressed, &compressed_st) == 0;
+    gboolean has_typescript = g_stat(typescript, &typescript_st) == 0;
+
+    if (has_compressed && (!has_typescript || compressed_st.st_mtime >= typescript_st.st_mtime)) {
+        g_free(typescript);
+        return compressed;
+    }
+    g_free(compressed);
+    if (has_typescript)
+        return typescript;
+    g_free(typescript);
+    return NULL;
+}
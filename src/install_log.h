@@ -0,0 +1,30 @@
+#ifndef INSTALL_LOG_H
+#define INSTALL_LOG_H
+
+#include <glib.h>
+
+/* Registro de la instalación.
+ *
+ * install.sh se ejecuta dentro de script(1) para que la terminal VTE vea la
+ * salida con colores, pero el typescript no se guarda tal cual: script lo
+ * escribe en una FIFO que lee arcris-log, que deja ~/install.log.gz sin
+ * secuencias de escape, con una línea por cada estado final de la terminal y
+ * la hora de cada una. install.sh recibe la ruta en ARCRIS_INSTALL_LOG y
+ * copia el registro al sistema instalado. Sin arcris-log (ejecución desde el
+ * árbol de fuentes) script escribe el typescript en ~/install.log como antes. */
+
+#define INSTALL_LOG_HELPER "arcris-log"
+
+/* ~/install.log.gz, o ~/install-<name>.log.gz para un destino del modo desatendido */
+gchar *install_log_path(const gchar *name);
+
+/* argv para ejecutar script_path con su registro en log_path; prefix (puede
+ * ser NULL) va delante, por ejemplo unshare. Se libera con g_strfreev */
+gchar **install_log_build_argv(const gchar *const *prefix, const gchar *script_path,
+                               const gchar *log_path);
+
+/* Registro más reciente de la última instalación (comprimido o typescript),
+ * NULL si no hay ninguno */
+gchar *install_log_find_latest(void);
+
+#endif /* INSTALL_LOG_H */
@@ -0,0 +1,161 @@
+#include "install_targets.h"
+#include "config.h"
+#include "variables_utils.h"
+#include "storage_profile.h"
+#include "partition_plan.h"
+#include "wipe_strategy.h"
+#include "performance_profile.h"
+#include "install_log.h"
+#include <glib/gstdio.h>
+#include <string.h>
+
+static gchar *g_requested_targets = NULL;
+
+InstallTarget *install_target_new(const gchar *disk)
+{
+    InstallTarget *target = g_new0(InstallTarget, 1);
+    gchar *variables_name;
+
+    target->name = g_path_get_basename(disk);
+    target->disk = g_strdup(disk);
+    variables_name = g_strdup_printf("variables-%s.sh", target->name);
+    target->variables_path = g_build_filename(g_get_current_dir(), "data", "bash", variables_name, NULL);
+    target->log_path = install_log_path(target->name);
+    target->journal_path = g_strdup_printf("/tmp/arcris-timing-%s.tsv", target->name);
+    target->tmp_dir = g_strdup_printf("/tmp/arcris-%s", target->name);
+    target->exit_code = -1;
+    g_free(variables_name);
+    return target;
+}
+
+void install_target_free(InstallTarget *target)
+{
+    if (!target) return;
+    g_free(target->name);
+    g_free(target->disk);
+    g_free(target->variables_path);
+    g_free(target->log_path);
+    g_free(target->journal_path);
+    g_free(target->tmp_dir);
+    g_free(target);
+}
+
+gboolean install_target_write_variables(InstallTarget *target, const gchar *answers_content,
+                                        GError **error)
+{
+    GString *content = g_string_new(answers_content);
+    vars_upsert(content, "SELECTED_DISK", target->disk);
+
+    /* El mapeo LUKS y el grupo LVM son globales en el LiveCD: uno por destino */
+    gchar *mapper = g_strdup_printf("cryptlvm_%s", target->name);
+    gchar *vg = g_strdup_printf("vg0_%s", target->name);
+    vars_upsert(content, "LUKS_MAPPER_NAME", mapper);
+    vars_upsert(content, "LVM_VG_NAME", vg);
+    g_free(mapper);
+    g_free(vg);
+
+    /* Cada destino puede ser de una clase distinta (NVMe, SSD, HDD) */
+    StorageProfile profile;
+    storage_profile_detect(target->disk, &profile);
+    storage_profile_write_variables(content, &profile);
+    /* Los otros sistemas de las respuestas son los del equipo donde se
+     * capturaron: config_grub.sh los vuelve a buscar en este */
+    vars_remove(content, "OS_PROBER_NEEDED");
+    vars_remove(content, "OTHER_OS_ESPS");
+    vars_remove(content, "OTHER_OS_FOUND");
+    wipe_strategy_update_variables(content);
+    /* Los offsets del plan dependen del tamaño y sector de cada disco */
+    partition_plan_update_variables(content);
+    perf_profile_update_variables(content);
+    vars_trim_trailing_newlines(content);
+
+    gboolean ok = g_file_set_contents(target->variables_path, content->str, -1, error);
+    g_string_free(content, TRUE);
+    return ok;
+}
+
+gboolean install_target_spawn(InstallTarget *target, const gchar *script_path, gchar **envp,
+                              GError **error)
+{
+    static const gchar *const unshare[] = {
+        "/usr/bin/unshare", "--mount", "--propagation", "private", NULL
+    };
+    gchar **argv = install_log_build_argv(unshare, script_path, target->log_path);
+
+    envp = g_environ_setenv(envp, "ARCRIS_VARIABLES_FILE", target->variables_path, TRUE);
+    envp = g_environ_setenv(envp, "ARCRIS_TIMING_JOURNAL", target->journal_path, TRUE);
+    envp = g_environ_setenv(envp, "ARCRIS_TMP_DIR", target->tmp_dir, TRUE);
+    envp = g_environ_setenv(envp, "ARCRIS_LIVE_LOCK", INSTALL_TARGETS_LIVE_LOCK, TRUE);
+
+    /* El avance se lee del diario: el de una instalación anterior no cuenta */
+    g_remove(target->journal_path);
+    target->exit_code = -1;
+
+    gboolean ok = g_spawn_async(NULL, argv, envp,
+                                G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_STDOUT_TO_DEV_NULL | G_SPAWN_STDERR_TO_DEV_NULL,
+                                NULL, NULL, &target->pid, error);
+    if (ok)
+        LOG_INFO("install.sh lanzado para %s (PID %d, registro: %s)", target->disk, target->pid, target->log_path);
+
+    g_strfreev(envp);
+    g_strfreev(argv);
+    return ok;
+}
+
+void install_targets_set_requested(const gchar *targets_arg)
+{
+    g_free(g_requested_targets);
+    g_requested_targets = g_strdup(targets_arg);
+}
+
+const gchar *install_targets_requested(void)
+{
+    return g_requested_targets;
+}
+
+void install_targets_take_option(int *argc, char *argv[])
+{
+    for (int i = 1; i < *argc - 1; i++) {
+        if (g_strcmp0(argv[i], INSTALL_TARGETS_OPTION) != 0)
+            continue;
+        install_targets_set_requested(argv[i + 1]);
+        LOG_INFO("Instalación en varios discos solicitada: %s", argv[i + 1]);
+        /* argv termina en NULL: se mueve también el terminador */
+        memmove(&argv[i], &argv[i + 2], (*argc - i - 1) * sizeof(char *));
+        *argc -= 2;
+        return;
+    }
+}
+
+GPtrArray *install_targets_parse(const gchar *targets_arg)
+{
+    GPtrArray *targets = g_ptr_array_new_with_free_func((GDestroyNotify)install_target_free);
+    gchar **disks = g_strsplit(targets_arg ? targets_arg : "", ",", -1);
+
+    for (int i = 0; disks[i]; i++) {
+        gchar *disk = g_strstrip(disks[i]);
+        gboolean repeated = FALSE;
+        if (disk[0] == '\0')
+            continue;
+
+        InstallTarget *target = install_target_new(disk);
+        for (guint j = 0; j < targets->len; j++) {
+            InstallTarget *other = g_ptr_array_index(targets, j);
+            if (g_strcmp0(other->name, target->name) == 0)
+                repeated = TRUE;
+        }
+        if (repeated) {
+            LOG_WARNING("Disco repetido en %s: %s", INSTALL_TARGETS_OPTION, disk);
+            install_target_free(target);
+            continue;
+        }
+        g_ptr_array_add(targets, target);
+    }
+    g_strfreev(disks);
+
+    if (targets->len == 0) {
+        g_ptr_array_unref(targets);
+        return NULL;
+    }
+    return targets;
+}
@@ -0,0 +1,56 @@
+#ifndef INSTALL_TARGETS_H
+#define INSTALL_TARGETS_H
+
+#include <glib.h>
+
+/* Instalación en varios discos a la vez.
+ *
+ * Cada destino recibe una instancia de install.sh con su propio variables.sh
+ * (SELECTED_DISK, mapeo LUKS y grupo LVM propios), su directorio temporal, su
+ * registro y su diario de tiempos, y corre con "unshare --mount" para tener un
+ * /mnt privado. Lo usan el modo desatendido (--unattended ... --targets) y la
+ * página 8 cuando la interfaz se abre con --targets. */
+
+/* Lista de discos separados por comas ("--targets /dev/sdb,/dev/sdc") */
+#define INSTALL_TARGETS_OPTION "--targets"
+
+/* Cerrojo con el que las instancias se turnan en las fases que modifican el LiveCD */
+#define INSTALL_TARGETS_LIVE_LOCK "/run/arcris-live.lock"
+
+typedef struct {
+    gchar *name;            /* nombre del dispositivo sin /dev/ (sdb, nvme0n1) */
+    gchar *disk;
+    gchar *variables_path;
+    gchar *log_path;
+    gchar *journal_path;    /* diario de tiempos: de aquí sale el avance */
+    gchar *tmp_dir;         /* temporales propios: clave LUKS, progreso del borrado... */
+    GPid   pid;
+    gint   exit_code;       /* -1 mientras no terminó */
+} InstallTarget;
+
+InstallTarget *install_target_new(const gchar *disk);
+void install_target_free(InstallTarget *target);
+
+/* Escribe el variables.sh del destino a partir de las respuestas comunes, con
+ * SELECTED_DISK, el perfil de almacenamiento y el plan de particiones de su disco */
+gboolean install_target_write_variables(InstallTarget *target, const gchar *answers_content,
+                                        GError **error);
+
+/* Lanza install.sh para el destino sin esperar a que termine; la salida va
+ * solo a su registro. envp se libera con g_strfreev (se le agregan las
+ * variables del destino). El hijo se recoge con g_child_watch_add(target->pid) */
+gboolean install_target_spawn(InstallTarget *target, const gchar *script_path, gchar **envp,
+                              GError **error);
+
+/* Guarda y recupera los discos de --targets para la interfaz gráfica */
+void install_targets_set_requested(const gchar *targets_arg);
+const gchar *install_targets_requested(void);
+
+/* Quita "--targets <discos>" de argv (antes de g_application_run) y lo guarda */
+void install_targets_take_option(int *argc, char *argv[]);
+
+/* Destinos de una lista "disco,disco,..." (InstallTarget*, se liberan con el
+ * array). Los discos repetidos se ignoran; NULL si la lista no tiene ninguno */
+GPtrArray *install_targets_parse(const gchar *targets_arg);
+
+#endif /* INSTALL_TARGETS_H */
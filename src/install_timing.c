@@ -0,0 +1,175 @@
+#include "install_timing.h"
+#include "config.h"
+#include "i18n.h"
+#include <string.h>
+
+/* Etapas de install.sh en el orden en que las abre timing_phase; con una
+ * imagen maestra, "imagen_maestra" y "configuracion_maquina" sustituyen a
+ * todo lo que va después de "particionado" */
+static const gchar *const install_timing_phases[] = {
+    "livecd", "keys_livecd", "mirrors", "particionado", "pacstrap_base", "fstab",
+    "kernel", "sistema_base", "usuarios", "sudo_temporal", "mkinitcpio",
+    "zram_bootloader", "drivers", "herramientas_red", "bashrc", "configuracion_final",
+    "entorno_grafico", "repositorios", "finalizacion", NULL
+};
+
+static const gchar *const install_timing_golden_phases[] = {
+    "livecd", "keys_livecd", "mirrors", "particionado", "imagen_maestra",
+    "configuracion_maquina", NULL
+};
+
+static void install_timing_entry_free(InstallTimingEntry *entry)
+{
+    if (!entry) return;
+    g_free(entry->name);
+    g_free(entry);
+}
+
+static gint compare_by_duration_desc(gconstpointer a, gconstpointer b)
+{
+    const InstallTimingEntry *ea = *(InstallTimingEntry * const *)a;
+    const InstallTimingEntry *eb = *(InstallTimingEntry * const *)b;
+    return (eb->duration_ms > ea->duration_ms) - (eb->duration_ms < ea->duration_ms);
+}
+
+InstallTimingReport *install_timing_load(const gchar *journal_path)
+{
+    gchar *content = NULL;
+    if (!g_file_get_contents(journal_path, &content, NULL, NULL))
+        return NULL;
+
+    InstallTimingReport *report = g_new0(InstallTimingReport, 1);
+    report->phases = g_ptr_array_new_with_free_func((GDestroyNotify)install_timing_entry_free);
+    report->packages = g_ptr_array_new_with_free_func((GDestroyNotify)install_timing_entry_free);
+
+    gchar **lines = g_strsplit(content, "\n", -1);
+    g_free(content);
+
+    for (int i = 0; lines[i]; i++) {
+        /* tipo  nombre  inicio_ms  duración_ms  bytes  reintentos  espera_ms  estado */
+        gchar **fields = g_strsplit(lines[i], "\t", 8);
+        if (g_strv_length(fields) == 8) {
+            InstallTimingEntry *entry = g_new0(InstallTimingEntry, 1);
+            entry->name = g_strdup(fields[1]);
+            entry->duration_ms = g_ascii_strtoll(fields[3], NULL, 10);
+            entry->bytes = g_ascii_strtoull(fields[4], NULL, 10);
+            entry->retries = (guint)g_ascii_strtoull(fields[5], NULL, 10);
+            entry->idle_ms = g_ascii_strtoll(fields[6], NULL, 10);
+            entry->failed = g_strcmp0(fields[7], "ok") != 0;
+
+            if (g_strcmp0(fields[0], "phase") == 0) {
+                report->total_ms += entry->duration_ms;
+                report->idle_ms += entry->idle_ms;
+                report->download_bytes += entry->bytes;
+                report->retries += entry->retries;
+                g_ptr_array_add(report->phases, entry);
+            } else if (g_strcmp0(fields[0], "package") == 0) {
+                g_ptr_array_add(report->packages, entry);
+            } else {
+                install_timing_entry_free(entry);
+            }
+        }
+        g_strfreev(fields);
+    }
+    g_strfreev(lines);
+
+    if (report->phases->len == 0) {
+        install_timing_free(report);
+        return NULL;
+    }
+
+    g_ptr_array_sort(report->packages, compare_by_duration_desc);
+    LOG_INFO("Diario de tiempos cargado: %u etapas, %u paquetes",
+             report->phases->len, report->packages->len);
+    return report;
+}
+
+void install_timing_free(InstallTimingReport *report)
+{
+    if (!report) return;
+    g_ptr_array_unref(report->phases);
+    g_ptr_array_unref(report->packages);
+    g_free(report);
+}
+
+static gchar *format_duration(gint64 ms)
+{
+    gint64 seconds = ms / 1000;
+    if (seconds >= 60)
+        return g_strdup_printf("%" G_GINT64_FORMAT "m %02" G_GINT64_FORMAT "s", seconds / 60, seconds % 60);
+    return g_strdup_printf("%" G_GINT64_FORMAT ".%01" G_GINT64_FORMAT "s", seconds, (ms % 1000) / 100);
+}
+
+gchar *install_timing_format(const InstallTimingReport *report)
+{
+    g_return_val_if_fail(report != NULL, NULL);
+
+    GString *text = g_string_new(NULL);
+    gchar *total = format_duration(report->total_ms);
+    gchar *idle = format_duration(report->idle_ms);
+    gchar *downloaded = g_format_size(report->download_bytes);
+
+    g_string_append_printf(text, "%s: %s  •  %s: %s  •  %s: %s  •  %s: %u\n\n",
+                           i18n_t("Total"), total,
+                           i18n_t("Esperas"), idle,
+                           i18n_t("Descargado"), downloaded,
+                           i18n_t("Reintentos"), report->retries);
+    g_free(total);
+    g_free(idle);
+    g_free(downloaded);
+
+    for (guint i = 0; i < report->phases->len; i++) {
+        InstallTimingEntry *phase = g_ptr_array_index(report->phases, i);
+        gchar *duration = format_duration(phase->duration_ms);
+        guint percent = report->total_ms > 0 ? (guint)(phase->duration_ms * 100 / report->total_ms) : 0;
+        g_string_append_printf(text, "%-22s %9s %3u%%\n", phase->name, duration, percent);
+        g_free(duration);
+    }
+
+    guint top = MIN(report->packages->len, INSTALL_TIMING_TOP_PACKAGES);
+    if (top > 0) {
+        g_string_append_printf(text, "\n%s:\n", i18n_t("Paquetes más lentos"));
+        for (guint i = 0; i < top; i++) {
+            InstallTimingEntry *package = g_ptr_array_index(report->packages, i);
+            gchar *duration = format_duration(package->duration_ms);
+            g_string_append_printf(text, "%-30s %9s%s\n", package->name, duration,
+                                   package->failed ? " ✗" : "");
+            g_free(duration);
+        }
+    }
+
+    g_strchomp(text->str);
+    return g_string_free(text, FALSE);
+}
+
+gdouble install_timing_progress(const gchar *journal_path, const gchar **phase)
+{
+    const gchar *const *phases = install_timing_phases;
+    guint done = 0;
+    gchar *content = NULL;
+
+    if (phase)
+        *phase = NULL;
+    if (!g_file_get_contents(journal_path, &content, NULL, NULL))
+        return 0.0;
+
+    /* El diario solo tiene las etapas cerradas: la siguiente de la lista es la actual */
+    gchar **lines = g_strsplit(content, "\n", -1);
+    g_free(content);
+    for (int i = 0; lines[i]; i++) {
+        if (!g_str_has_prefix(lines[i], "phase\t"))
+            continue;
+        gchar **fields = g_strsplit(lines[i], "\t", 3);
+        if (g_strcmp0(fields[1], "imagen_maestra") == 0)
+            phases = install_timing_golden_phases;
+        done++;
+        g_strfreev(fields);
+    }
+    g_strfreev(lines);
+
+    guint total = g_strv_length((gchar **)phases);
+    done = MIN(done, total);
+    if (phase)
+        *phase = done < total ? phases[done] : NULL;
+    return (gdouble)done / total;
+}
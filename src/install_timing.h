@@ -0,0 +1,45 @@
+#ifndef INSTALL_TIMING_H
+#define INSTALL_TIMING_H
+
+#include <glib.h>
+
+/* Diario TSV que escribe data/bash/install_timing.sh durante la instalación */
+#define INSTALL_TIMING_JOURNAL_PATH "/tmp/arcris-timing.tsv"
+
+/* Informe JSON completo dentro del sistema instalado */
+#define INSTALL_TIMING_REPORT_PATH "/var/log/arcris-install-report.json"
+
+/* Paquetes más lentos que se muestran en el resumen */
+#define INSTALL_TIMING_TOP_PACKAGES 5
+
+typedef struct {
+    gchar  *name;
+    gint64  duration_ms;
+    guint64 bytes;
+    guint   retries;
+    gint64  idle_ms;
+    gboolean failed;
+} InstallTimingEntry;
+
+typedef struct {
+    GPtrArray *phases;      /* InstallTimingEntry*, en orden de ejecución */
+    GPtrArray *packages;    /* InstallTimingEntry*, del más lento al más rápido */
+    gint64  total_ms;
+    gint64  idle_ms;
+    guint64 download_bytes;
+    guint   retries;
+} InstallTimingReport;
+
+/* Lee el diario; devuelve NULL si no existe o no contiene etapas */
+InstallTimingReport *install_timing_load(const gchar *journal_path);
+void install_timing_free(InstallTimingReport *report);
+
+/* Texto del desglose para la página 9 (una línea por etapa) */
+gchar *install_timing_format(const InstallTimingReport *report);
+
+/* Avance de una instalación en curso según las etapas ya cerradas en el
+ * diario (0.0 a 1.0). En phase (puede ser NULL) deja la etapa en curso, o
+ * NULL si el diario todavía no existe o ya se cerraron todas */
+gdouble install_timing_progress(const gchar *journal_path, const gchar **phase);
+
+#endif /* INSTALL_TIMING_H */
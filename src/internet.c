@@ -1,4 +1,5 @@
 #include "internet.h"
+#include "trace.h"
 #include <libsoup/soup.h>
 #include <stdio.h>
 #include <gtk/gtk.h>
@@ -138,6 +139,8 @@ int get_timezone_line(const char *timezone) {
 
 // Función para obtener el idioma y país desde la API
 char* get_locale_from_api() {
+    TRACE_SCOPE(TRACE_CAT_NETWORK, "ipapi.co/languages");
+
     FILE *fp = popen("curl -s https://ipapi.co/languages", "r");
     if (!fp) {
         perror("Error al ejecutar curl");
@@ -475,7 +478,9 @@ static gboolean check_internet_after_delay(gpointer data) {
     SoupSession *session = soup_session_new();
     SoupMessage *msg = soup_message_new("HEAD", "http://www.google.com");
 
+    TraceSpan span = trace_span_begin(TRACE_CAT_NETWORK, "HEAD www.google.com");
     GInputStream *response_stream = soup_session_send(session, msg, NULL, NULL);
+    trace_span_end(&span);
 
     if (response_stream) {
         g_print("Conexión Exitosa\n");
@@ -0,0 +1,60 @@
+#include "keyring_prep.h"
+#include "config.h"
+#include "trace.h"
+#include <gio/gio.h>
+#include <unistd.h>
+
+static gboolean keyring_prep_started = FALSE;
+
+static void on_keyring_prep_done(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GSubprocess *proc = G_SUBPROCESS(source);
+    TraceSpan *span = user_data;
+    GError *error = NULL;
+
+    if (g_subprocess_wait_finish(proc, result, &error) && g_subprocess_get_successful(proc))
+        LOG_INFO("Anillo de claves preparado en segundo plano");
+    else
+        LOG_WARNING("La preparación del anillo de claves falló (%s); install.sh la repetirá",
+                    error ? error->message : "ver /tmp/arcris-keyring.log");
+
+    trace_span_end(span);
+    g_free(span);
+    g_clear_error(&error);
+    g_object_unref(proc);
+}
+
+void keyring_prep_start(void)
+{
+    if (keyring_prep_started) return;
+    keyring_prep_started = TRUE;
+
+    gchar *script_path = g_build_filename(g_get_current_dir(), "data", "bash", "keyring.sh", NULL);
+    if (!g_file_test(script_path, G_FILE_TEST_EXISTS)) {
+        LOG_WARNING("No se encontró %s; las claves se prepararán durante la instalación", script_path);
+        g_free(script_path);
+        return;
+    }
+
+    /* pacman-key necesita root; sin él, sudo sin contraseña o nada */
+    const gchar *argv_root[] = { "bash", script_path, "--prepare", NULL };
+    const gchar *argv_sudo[] = { "sudo", "-n", "bash", script_path, "--prepare", NULL };
+
+    GError *error = NULL;
+    GSubprocess *proc = g_subprocess_newv(geteuid() == 0 ? argv_root : argv_sudo,
+                                          G_SUBPROCESS_FLAGS_STDOUT_SILENCE | G_SUBPROCESS_FLAGS_STDERR_SILENCE,
+                                          &error);
+    g_free(script_path);
+
+    if (!proc) {
+        LOG_WARNING("No se pudo lanzar la preparación del anillo de claves: %s",
+                    error ? error->message : "desconocido");
+        g_clear_error(&error);
+        return;
+    }
+
+    LOG_INFO("Preparando el anillo de claves de pacman en segundo plano...");
+    TraceSpan *span = g_new(TraceSpan, 1);
+    *span = trace_span_begin(TRACE_CAT_SUBPROCESS, "keyring.sh --prepare");
+    g_subprocess_wait_async(proc, NULL, on_keyring_prep_done, span);
+}
@@ -0,0 +1,18 @@
+#ifndef KEYRING_PREP_H
+#define KEYRING_PREP_H
+
+#include <glib.h>
+
+/* Preparación del anillo de claves de pacman mientras se configura la
+ * instalación.
+ *
+ * Lanza "keyring.sh --prepare" en segundo plano: comprueba el anillo del
+ * LiveCD (y solo ejecuta pacman-key --init/--populate si le falta algo) y deja
+ * en la caché las claves de los repositorios de terceros. install.sh espera a
+ * que termine si aún sigue en marcha al llegar a las claves. La salida va a
+ * /tmp/arcris-keyring.log. */
+
+/* Inicia la preparación (una sola vez por sesión) */
+void keyring_prep_start(void);
+
+#endif /* KEYRING_PREP_H */
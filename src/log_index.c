@@ -0,0 +1,299 @@
+#include "log_index.h"
+#include "config.h"
+#include "trace.h"
+#include <gio/gio.h>
+#include <string.h>
+
+struct _LogIndex {
+    gchar *text;                           /* registro sin secuencias de escape */
+    gsize length;
+    GArray *line_offsets;                  /* gsize; una entrada más que líneas */
+    GArray *markers[LOG_MARKER_COUNT];     /* guint, números de línea */
+    goffset source_size;
+};
+
+/* Descomprime un registro de arcris-log: varios miembros gzip seguidos, el
+ * último quizá a medio escribir si la instalación sigue en marcha (se
+ * conserva lo que se pudo leer) */
+static GString *log_gunzip(const gchar *data, gsize length)
+{
+    GString *out = g_string_sized_new(length * 8);
+    GZlibDecompressor *decompressor = g_zlib_decompressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP);
+    gchar buffer[64 * 1024];
+
+    while (length > 0) {
+        gsize bytes_read = 0, bytes_written = 0;
+        GError *error = NULL;
+        GConverterResult result = g_converter_convert(G_CONVERTER(decompressor), data, length,
+                                                      buffer, sizeof(buffer), G_CONVERTER_NO_FLAGS,
+                                                      &bytes_read, &bytes_written, &error);
+        if (result == G_CONVERTER_ERROR) {
+            /* Miembro incompleto al final: no hay más entrada que darle */
+            if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_PARTIAL_INPUT))
+                LOG_WARNING("Registro comprimido dañado: %s", error->message);
+            g_error_free(error);
+            break;
+        }
+        g_string_append_len(out, buffer, bytes_written);
+        data += bytes_read;
+        length -= bytes_read;
+
+        /* Fin de un miembro: el siguiente empieza con un descompresor limpio */
+        if (result == G_CONVERTER_FINISHED)
+            g_converter_reset(G_CONVERTER(decompressor));
+    }
+
+    g_object_unref(decompressor);
+    return out;
+}
+
+/* Textos que los scripts de instalación escriben al fallar o reintentar */
+static const gchar *const log_error_patterns[] = {
+    "ERROR", "Error:", "error:", "fatal:", "❌", NULL
+};
+static const gchar *const log_retry_patterns[] = {
+    "Intento #", "Reintentando", "reintentando", NULL
+};
+
+/* Devuelve la posición del último byte de la secuencia de escape que empieza
+ * en data[i] (ESC) */
+static gsize log_skip_escape(const gchar *data, gsize length, gsize i)
+{
+    if (i + 1 >= length) return i;
+    guchar kind = data[i + 1];
+    gsize j = i + 2;
+
+    switch (kind) {
+        case '[':
+            /* CSI: parámetros e intermedios hasta el byte final 0x40-0x7E */
+            while (j < length && ((guchar)data[j] < 0x40 || (guchar)data[j] > 0x7e))
+                j++;
+            return MIN(j, length - 1);
+        case ']': case 'P': case 'X': case '^': case '_':
+            /* OSC y cadenas de control: hasta BEL o ESC \ */
+            while (j < length) {
+                if (data[j] == '\a') return j;
+                if (data[j] == '\x1b' && j + 1 < length && data[j + 1] == '\\') return j + 1;
+                j++;
+            }
+            return length - 1;
+        case '(': case ')': case '*': case '+':
+            /* Juego de caracteres: ESC ( B */
+            return MIN(i + 2, length - 1);
+        default:
+            return i + 1;
+    }
+}
+
+/* Copia el registro como lo vería la terminal: sin escapes ni caracteres de
+ * control, y con \r reescribiendo la línea actual (barras de progreso) */
+static GString *log_strip_terminal(const gchar *data, gsize length)
+{
+    GString *out = g_string_sized_new(length / 2);
+    gsize line_start = 0;
+    gsize run_start = 0;
+
+    for (gsize i = 0; i < length; i++) {
+        guchar c = data[i];
+        if (c >= 0x20 && c != 0x7f) continue;
+
+        g_string_append_len(out, data + run_start, i - run_start);
+
+        if (c == '\n') {
+            g_string_append_c(out, '\n');
+            line_start = out->len;
+        } else if (c == '\t') {
+            g_string_append_c(out, '\t');
+        } else if (c == '\x1b') {
+            i = log_skip_escape(data, length, i);
+        } else if (c == '\r') {
+            /* \r\n y \r\r\n son un salto de línea normal */
+            gsize j = i;
+            while (j < length && data[j] == '\r') j++;
+            if (j < length && data[j] == '\n')
+                i = j - 1;
+            else if (j < length)
+                g_string_truncate(out, line_start);
+        }
+        run_start = i + 1;
+    }
+    if (run_start < length)
+        g_string_append_len(out, data + run_start, length - run_start);
+
+    return out;
+}
+
+static gboolean log_line_matches(const gchar *line, gsize length, const gchar *const *patterns)
+{
+    for (int i = 0; patterns[i]; i++) {
+        if (g_strstr_len(line, length, patterns[i]))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void log_index_build_lines(LogIndex *index)
+{
+    index->line_offsets = g_array_new(FALSE, FALSE, sizeof(gsize));
+    for (int k = 0; k < LOG_MARKER_COUNT; k++)
+        index->markers[k] = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    gsize offset = 0;
+    while (offset < index->length) {
+        guint line = index->line_offsets->len;
+        const gchar *start = index->text + offset;
+        const gchar *newline = memchr(start, '\n', index->length - offset);
+        gsize line_length = newline ? (gsize)(newline - start) : index->length - offset;
+
+        g_array_append_val(index->line_offsets, offset);
+        if (log_line_matches(start, line_length, log_error_patterns))
+            g_array_append_val(index->markers[LOG_MARKER_ERROR], line);
+        if (log_line_matches(start, line_length, log_retry_patterns))
+            g_array_append_val(index->markers[LOG_MARKER_RETRY], line);
+
+        offset += line_length + (newline ? 1 : 0);
+    }
+    g_array_append_val(index->line_offsets, index->length);
+}
+
+LogIndex *log_index_new(const gchar *path, GError **error)
+{
+    g_return_val_if_fail(path != NULL, NULL);
+    TRACE_SCOPE(TRACE_CAT_UI, "log_index_new");
+
+    GMappedFile *mapped = g_mapped_file_new(path, FALSE, error);
+    if (!mapped) return NULL;
+
+    gsize size = g_mapped_file_get_length(mapped);
+    const gchar *contents = g_mapped_file_get_contents(mapped);
+    if (!contents) size = 0;
+    GString *stripped;
+
+    /* Registro de arcris-log (ya limpio) o typescript crudo de script */
+    if (size >= 2 && (guchar)contents[0] == 0x1f && (guchar)contents[1] == 0x8b) {
+        GString *plain = log_gunzip(contents, size);
+        stripped = log_strip_terminal(plain->str, plain->len);
+        g_string_free(plain, TRUE);
+    } else {
+        stripped = log_strip_terminal(size ? contents : "", size);
+    }
+    g_mapped_file_unref(mapped);
+
+    LogIndex *index = g_new0(LogIndex, 1);
+    index->source_size = size;
+
+    /* GtkTextBuffer solo acepta UTF-8 válido */
+    if (!g_utf8_validate_len(stripped->str, stripped->len, NULL)) {
+        index->text = g_utf8_make_valid(stripped->str, stripped->len);
+        index->length = strlen(index->text);
+        g_string_free(stripped, TRUE);
+    } else {
+        index->length = stripped->len;
+        index->text = g_string_free(stripped, FALSE);
+    }
+
+    log_index_build_lines(index);
+    LOG_INFO("Registro indexado: %" G_GSIZE_FORMAT " → %" G_GSIZE_FORMAT " bytes, %u líneas, %u errores, %u reintentos",
+             size, index->length, log_index_get_line_count(index),
+             index->markers[LOG_MARKER_ERROR]->len, index->markers[LOG_MARKER_RETRY]->len);
+    return index;
+}
+
+void log_index_free(LogIndex *index)
+{
+    if (!index) return;
+    g_free(index->text);
+    g_array_free(index->line_offsets, TRUE);
+    for (int k = 0; k < LOG_MARKER_COUNT; k++)
+        g_array_free(index->markers[k], TRUE);
+    g_free(index);
+}
+
+goffset log_index_get_source_size(const LogIndex *index)
+{
+    return index ? index->source_size : 0;
+}
+
+guint log_index_get_line_count(const LogIndex *index)
+{
+    return index ? index->line_offsets->len - 1 : 0;
+}
+
+const gchar *log_index_get_lines(const LogIndex *index, guint first, guint end, gsize *length)
+{
+    guint count = log_index_get_line_count(index);
+    end = MIN(end, count);
+    first = MIN(first, end);
+
+    gsize start = g_array_index(index->line_offsets, gsize, first);
+    if (length)
+        *length = g_array_index(index->line_offsets, gsize, end) - start;
+    return index->text + start;
+}
+
+guint log_index_get_marker_count(const LogIndex *index, LogMarkerKind kind)
+{
+    return index ? index->markers[kind]->len : 0;
+}
+
+gboolean log_index_next_marker(const LogIndex *index, LogMarkerKind kind,
+                               guint after_line, guint *line)
+{
+    if (!index || index->markers[kind]->len == 0) return FALSE;
+
+    GArray *markers = index->markers[kind];
+    for (guint i = 0; i < markers->len; i++) {
+        guint candidate = g_array_index(markers, guint, i);
+        if (after_line == G_MAXUINT || candidate > after_line) {
+            *line = candidate;
+            return TRUE;
+        }
+    }
+    *line = g_array_index(markers, guint, 0);
+    return TRUE;
+}
+
+/* Línea que contiene el byte offset (búsqueda binaria en los desplazamientos) */
+static guint log_index_line_at(const LogIndex *index, gsize offset)
+{
+    guint low = 0, high = log_index_get_line_count(index);
+    while (high - low > 1) {
+        guint mid = low + (high - low) / 2;
+        if (g_array_index(index->line_offsets, gsize, mid) <= offset)
+            low = mid;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+static const gchar *log_find_ascii_case(const gchar *from, const gchar *to, const gchar *needle, gsize needle_length)
+{
+    gchar first = g_ascii_tolower(needle[0]);
+    for (const gchar *p = from; p + needle_length <= to; p++) {
+        if (g_ascii_tolower(*p) == first && g_ascii_strncasecmp(p, needle, needle_length) == 0)
+            return p;
+    }
+    return NULL;
+}
+
+gboolean log_index_find(const LogIndex *index, const gchar *needle, guint from_line,
+                        guint *line, gsize *line_byte)
+{
+    if (!index || !needle || !*needle || log_index_get_line_count(index) == 0) return FALSE;
+
+    gsize needle_length = strlen(needle);
+    from_line = MIN(from_line, log_index_get_line_count(index));
+    const gchar *start = index->text + g_array_index(index->line_offsets, gsize, from_line);
+    const gchar *end = index->text + index->length;
+
+    const gchar *match = log_find_ascii_case(start, end, needle, needle_length);
+    if (!match)
+        match = log_find_ascii_case(index->text, MIN(start + needle_length, end), needle, needle_length);
+    if (!match) return FALSE;
+
+    gsize offset = match - index->text;
+    *line = log_index_line_at(index, offset);
+    *line_byte = offset - g_array_index(index->line_offsets, gsize, *line);
+    return TRUE;
+}
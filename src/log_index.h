@@ -0,0 +1,49 @@
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#include <glib.h>
+
+/* Índice del registro de instalación (~/install.log.gz) para la página de error.
+ *
+ * El archivo se mapea en memoria; si es el registro comprimido de arcris-log
+ * se descomprime (también con el último miembro gzip a medio escribir) y si es
+ * un typescript antiguo de script se lee tal cual. Se copia una sola vez sin las secuencias
+ * de escape de la terminal (colores, movimientos del cursor) y sin los
+ * estados intermedios de las barras de progreso que se reescriben con \r.
+ * Sobre ese texto se guarda el desplazamiento de cada línea y las líneas con
+ * errores y reintentos, para mostrar cualquier tramo sin recorrer el resto.
+ * log_index_new() bloquea: se llama desde un hilo. */
+
+typedef struct _LogIndex LogIndex;
+
+typedef enum {
+    LOG_MARKER_ERROR = 0,
+    LOG_MARKER_RETRY,
+    LOG_MARKER_COUNT
+} LogMarkerKind;
+
+LogIndex *log_index_new(const gchar *path, GError **error);
+void log_index_free(LogIndex *index);
+
+/* Tamaño del archivo cuando se indexó, para saber si hay que rehacerlo */
+goffset log_index_get_source_size(const LogIndex *index);
+
+guint log_index_get_line_count(const LogIndex *index);
+
+/* Texto UTF-8 de las líneas [first, end), con sus saltos de línea */
+const gchar *log_index_get_lines(const LogIndex *index, guint first, guint end, gsize *length);
+
+guint log_index_get_marker_count(const LogIndex *index, LogMarkerKind kind);
+
+/* Primera línea marcada como kind después de after_line (G_MAXUINT: desde el
+ * principio), volviendo al principio al llegar al final. FALSE si no hay */
+gboolean log_index_next_marker(const LogIndex *index, LogMarkerKind kind,
+                               guint after_line, guint *line);
+
+/* Busca needle (sin distinguir mayúsculas ASCII) a partir de from_line,
+ * volviendo al principio al llegar al final; devuelve la línea y el byte
+ * dentro de ella donde empieza la coincidencia */
+gboolean log_index_find(const LogIndex *index, const gchar *needle, guint from_line,
+                        guint *line, gsize *line_byte);
+
+#endif /* LOG_INDEX_H */
@@ -0,0 +1,170 @@
+#include "luks_benchmark.h"
+#include "variables_utils.h"
+#include "config.h"
+#include "trace.h"
+#include <gio/gio.h>
+#include <string.h>
+
+/* Cifrados aptos para disco completo: nombre en la salida del benchmark → --cipher */
+static const struct {
+    const gchar *benchmark_name;
+    const gchar *cipher;
+} luks_candidates[] = {
+    { "aes-xts",                "aes-xts-plain64" },
+    { "serpent-xts",            "serpent-xts-plain64" },
+    { "twofish-xts",            "twofish-xts-plain64" },
+    /* Adiantum: para CPUs sin instrucciones AES */
+    { "xchacha12,aes-adiantum", "xchacha12,aes-adiantum-plain64" },
+    { "xchacha20,aes-adiantum", "xchacha20,aes-adiantum-plain64" },
+    { NULL, NULL }
+};
+
+typedef struct {
+    LuksBenchmarkCallback callback;
+    gpointer user_data;
+    TraceSpan span;
+} LuksBenchmarkTask;
+
+void luks_cipher_choice_set_default(LuksCipherChoice *choice)
+{
+    choice->cipher = LUKS_DEFAULT_CIPHER;
+    choice->key_size = LUKS_DEFAULT_KEY_SIZE;
+    choice->encrypt_mibs = 0;
+    choice->decrypt_mibs = 0;
+    choice->measured = FALSE;
+}
+
+static const gchar *candidate_cipher(const gchar *benchmark_name)
+{
+    for (int i = 0; luks_candidates[i].benchmark_name; i++) {
+        if (g_strcmp0(luks_candidates[i].benchmark_name, benchmark_name) == 0)
+            return luks_candidates[i].cipher;
+    }
+    return NULL;
+}
+
+gboolean luks_benchmark_parse(const gchar *output, LuksCipherChoice *choice)
+{
+    g_return_val_if_fail(choice != NULL, FALSE);
+
+    luks_cipher_choice_set_default(choice);
+    if (!output) return FALSE;
+
+    /* "        aes-xts        512b      2345.6 MiB/s      2401.2 MiB/s" */
+    GRegex *regex = g_regex_new("^\\s*(\\S+)\\s+(\\d+)b\\s+([\\d.]+)\\s+MiB/s\\s+([\\d.]+)\\s+MiB/s",
+                                G_REGEX_MULTILINE, 0, NULL);
+    GMatchInfo *match = NULL;
+    gdouble best_score = 0;
+
+    g_regex_match(regex, output, 0, &match);
+    while (g_match_info_matches(match)) {
+        gchar *name = g_match_info_fetch(match, 1);
+        gchar *bits = g_match_info_fetch(match, 2);
+        gchar *enc = g_match_info_fetch(match, 3);
+        gchar *dec = g_match_info_fetch(match, 4);
+
+        const gchar *cipher = candidate_cipher(name);
+        if (cipher) {
+            guint key_size = (guint)g_ascii_strtoull(bits, NULL, 10);
+            gdouble encrypt = g_ascii_strtod(enc, NULL);
+            gdouble decrypt = g_ascii_strtod(dec, NULL);
+            /* El cuello de botella es la dirección más lenta */
+            gdouble score = MIN(encrypt, decrypt);
+
+            /* Con diferencias menores al 5% se prefiere la clave más larga */
+            gboolean faster = score > best_score * 1.05;
+            gboolean tie_stronger = score >= best_score * 0.95 && key_size > choice->key_size;
+            if (!choice->measured || faster || tie_stronger) {
+                choice->cipher = cipher;
+                choice->key_size = key_size;
+                choice->encrypt_mibs = encrypt;
+                choice->decrypt_mibs = decrypt;
+                choice->measured = TRUE;
+                best_score = score;
+            }
+        }
+
+        g_free(dec);
+        g_free(enc);
+        g_free(bits);
+        g_free(name);
+        g_match_info_next(match, NULL);
+    }
+
+    g_match_info_free(match);
+    g_regex_unref(regex);
+    return choice->measured;
+}
+
+static void on_benchmark_done(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    LuksBenchmarkTask *task = user_data;
+    GError *error = NULL;
+    gchar *stdout_buf = NULL;
+    LuksCipherChoice choice;
+
+    trace_span_end(&task->span);
+
+    if (!g_subprocess_communicate_utf8_finish(G_SUBPROCESS(source), result,
+                                              &stdout_buf, NULL, &error)) {
+        LOG_WARNING("cryptsetup benchmark falló: %s", error ? error->message : "desconocido");
+        g_clear_error(&error);
+        luks_cipher_choice_set_default(&choice);
+    } else if (luks_benchmark_parse(stdout_buf, &choice)) {
+        LOG_INFO("Cifrado LUKS elegido: %s (%u bits) — %.0f/%.0f MiB/s",
+                 choice.cipher, choice.key_size, choice.encrypt_mibs, choice.decrypt_mibs);
+    } else {
+        LOG_WARNING("cryptsetup benchmark no midió ningún cifrado de disco, se usa %s",
+                    LUKS_DEFAULT_CIPHER);
+    }
+
+    task->callback(&choice, task->user_data);
+
+    g_free(stdout_buf);
+    g_object_unref(source);
+    g_free(task);
+}
+
+void luks_benchmark_start(LuksBenchmarkCallback callback, gpointer user_data)
+{
+    g_return_if_fail(callback != NULL);
+
+    GError *error = NULL;
+    GSubprocess *proc = g_subprocess_new(
+        G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_SILENCE,
+        &error,
+        "cryptsetup", "benchmark",
+        NULL);
+
+    if (!proc) {
+        LuksCipherChoice choice;
+        LOG_WARNING("No se pudo lanzar cryptsetup benchmark: %s",
+                    error ? error->message : "desconocido");
+        g_clear_error(&error);
+        luks_cipher_choice_set_default(&choice);
+        callback(&choice, user_data);
+        return;
+    }
+
+    LuksBenchmarkTask *task = g_new0(LuksBenchmarkTask, 1);
+    task->callback = callback;
+    task->user_data = user_data;
+    task->span = trace_span_begin(TRACE_CAT_SUBPROCESS, "cryptsetup benchmark");
+
+    LOG_INFO("Midiendo el rendimiento de los cifrados LUKS en segundo plano...");
+    g_subprocess_communicate_utf8_async(proc, NULL, NULL, on_benchmark_done, task);
+}
+
+void luks_benchmark_write_variables(GString *content, const LuksCipherChoice *choice)
+{
+    g_return_if_fail(content != NULL && choice != NULL);
+
+    gchar key_size[16];
+    gchar iter_time[16];
+    g_snprintf(key_size, sizeof(key_size), "%u", choice->key_size);
+    g_snprintf(iter_time, sizeof(iter_time), "%d", LUKS_UNLOCK_TARGET_MS);
+
+    vars_upsert(content, "LUKS_CIPHER",    choice->cipher);
+    vars_upsert(content, "LUKS_KEY_SIZE",  key_size);
+    vars_upsert(content, "LUKS_ITER_TIME", iter_time);
+}
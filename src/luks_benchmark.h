@@ -0,0 +1,36 @@
+#ifndef LUKS_BENCHMARK_H
+#define LUKS_BENCHMARK_H
+
+#include <glib.h>
+
+/* Tiempo de desbloqueo objetivo: cryptsetup calibra el coste de argon2id
+ * en el equipo de destino para que abrir el disco tarde esto (--iter-time) */
+#define LUKS_UNLOCK_TARGET_MS 2000
+
+/* Cifrado que se usa si la medición no está disponible (valor por defecto de cryptsetup) */
+#define LUKS_DEFAULT_CIPHER   "aes-xts-plain64"
+#define LUKS_DEFAULT_KEY_SIZE 512
+
+typedef struct {
+    const gchar *cipher;      /* especificación para luksFormat --cipher */
+    guint        key_size;    /* bits, para --key-size */
+    gdouble      encrypt_mibs;
+    gdouble      decrypt_mibs;
+    gboolean     measured;    /* FALSE si son los valores por defecto */
+} LuksCipherChoice;
+
+/* Resultado de la medición; choice nunca es NULL (si falla trae los valores por defecto) */
+typedef void (*LuksBenchmarkCallback)(const LuksCipherChoice *choice, gpointer user_data);
+
+/* Ejecuta "cryptsetup benchmark" en segundo plano y elige el cifrado más rápido */
+void luks_benchmark_start(LuksBenchmarkCallback callback, gpointer user_data);
+
+/* Interpreta la salida de "cryptsetup benchmark"; FALSE si no hay ningún cifrado de disco medido */
+gboolean luks_benchmark_parse(const gchar *output, LuksCipherChoice *choice);
+
+void luks_cipher_choice_set_default(LuksCipherChoice *choice);
+
+/* Escribe LUKS_CIPHER, LUKS_KEY_SIZE y LUKS_ITER_TIME en el contenido de variables.sh */
+void luks_benchmark_write_variables(GString *content, const LuksCipherChoice *choice);
+
+#endif /* LUKS_BENCHMARK_H */
@@ -25,6 +25,9 @@
 #include "page9.h"
 #include "page10.h"
 #include "i18n.h"
+#include "unattended.h"
+#include "install_targets.h"
+#include "trace.h"
 
 #include "close.h"
 #include "about.h"
@@ -167,6 +170,8 @@ static void quit_action(GSimpleAction *action, GVariant *parameter, gpointer use
 // Función principal de activación
 static void activate_cb(GtkApplication *app)
 {
+    TRACE_SCOPE(TRACE_CAT_STARTUP, "activate_cb");
+
     LOG_INFO("Iniciando aplicación %s v%s", arcris_get_app_name(), arcris_get_app_version());
 
     // Configurar tema de iconos personalizados para recoloreado automático
@@ -227,7 +232,9 @@ static void activate_cb(GtkApplication *app)
     carousel_manager_init(g_app_carousel_manager, builder);
 
     // Inicializar variables de drivers automáticamente (similar a INSTALLATION_TYPE="TERMINAL")
+    TraceSpan span = trace_span_begin(TRACE_CAT_STARTUP, "window_hardware_init_auto_variables");
     window_hardware_init_auto_variables();
+    trace_span_end(&span);
 
     // Verificar que la inicialización fue exitosa
     if (!g_app_carousel_manager->is_initialized) {
@@ -248,7 +255,9 @@ static void activate_cb(GtkApplication *app)
 
     // Configurar la aplicación y mostrar la ventana
     gtk_window_set_application(GTK_WINDOW(window), GTK_APPLICATION(app));
+    span = trace_span_begin(TRACE_CAT_STARTUP, "gtk_window_present");
     gtk_window_present(GTK_WINDOW(window));
+    trace_span_end(&span);
 
     // Liberar el builder principal
     g_object_unref(builder);
@@ -263,6 +272,9 @@ static void activate_cb(GtkApplication *app)
 // Función main
 int main(int argc, char *argv[])
 {
+    // Activar el trazado (ARCRIS_TRACE) antes que nada para medir todo el arranque
+    trace_init();
+
     // Seleccionar el renderer GL correcto antes de cualquier inicialización de GTK
     g_setenv("GSK_RENDERER", "gl", TRUE);
 
@@ -274,6 +286,16 @@ int main(int argc, char *argv[])
 
     LOG_INFO("=== Iniciando %s ===", arcris_get_app_name());
 
+    // Modo desatendido: validar el archivo de respuestas e instalar sin GTK
+    if (unattended_requested(argc, argv)) {
+        int unattended_result = unattended_main(argc, argv);
+        trace_write();
+        return unattended_result;
+    }
+
+    // Varios discos desde la interfaz: la página 8 instala en cada uno
+    install_targets_take_option(&argc, argv);
+
     // Definir las acciones de la aplicación
     const GActionEntry app_entries[] = {
         { "check_updates", check_updates_action, NULL, NULL, NULL },
@@ -306,5 +328,7 @@ int main(int argc, char *argv[])
 
     LOG_INFO("=== Finalizando %s (código: %d) ===", arcris_get_app_name(), result);
 
+    trace_write();
+
     return result;
 }
@@ -0,0 +1,48 @@
+#include "mirrorlist_utils.h"
+
+#include <string.h>
+
+/* Descomenta líneas "#Server =" → "Server =". */
+gchar *mirrorlist_process(const gchar *text)
+{
+    gchar **lines = g_strsplit(text, "\n", -1);
+    GString *result = g_string_new("");
+
+    for (int i = 0; lines[i] != NULL; i++) {
+        gchar *line = lines[i];
+        if (g_str_has_prefix(line, "#Server ="))
+            line = line + 1;
+        g_string_append(result, line);
+        if (lines[i + 1] != NULL)
+            g_string_append_c(result, '\n');
+    }
+
+    g_strfreev(lines);
+    return g_string_free(result, FALSE);
+}
+
+/* Valida que el texto contenga al menos "$repo/os/$arch". */
+gboolean mirrorlist_validate(const gchar *text)
+{
+    if (!text) return FALSE;
+    return strstr(text, "$repo/os/$arch") != NULL;
+}
+
+/* Escapa newlines y comillas para almacenar en una variable bash. */
+gchar *mirrorlist_escape_for_bash(const gchar *text)
+{
+    GString *result = g_string_new("");
+    for (const gchar *p = text; *p; p++) {
+        if (*p == '\n')
+            g_string_append(result, "\\n");
+        else if (*p == '"')
+            g_string_append(result, "\\\"");
+        else if (*p == '\\')
+            g_string_append(result, "\\\\");
+        else if (*p == '$')
+            g_string_append(result, "\\$");
+        else
+            g_string_append_c(result, *p);
+    }
+    return g_string_free(result, FALSE);
+}
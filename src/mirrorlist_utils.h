@@ -0,0 +1,17 @@
+#ifndef MIRRORLIST_UTILS_H
+#define MIRRORLIST_UTILS_H
+
+#include <glib.h>
+
+/* Uncomment "#Server =" lines so every listed mirror is used.
+ * Returns a newly allocated string. */
+gchar *mirrorlist_process(const gchar *text);
+
+/* TRUE if text contains at least one "$repo/os/$arch" entry. */
+gboolean mirrorlist_validate(const gchar *text);
+
+/* Escape text for a double-quoted bash variable: newlines become \n and
+ * ", \ and $ are backslash-escaped.  Returns a newly allocated string. */
+gchar *mirrorlist_escape_for_bash(const gchar *text);
+
+#endif /* MIRRORLIST_UTILS_H */
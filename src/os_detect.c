@@ -0,0 +1,319 @@
+#include "os_detect.h"
+#include "variables_utils.h"
+#include "config.h"
+#include "trace.h"
+#include <string.h>
+
+/* Tipos de partición GPT (en minúsculas, como los publica UDisks) y MBR */
+#define GUID_ESP           "c12a7328-f81f-11d2-ba4b-00a0c93ec93b"
+#define GUID_MS_BASIC_DATA "ebd0a0a2-b9e5-4433-87c0-68b6b72699b7"
+#define GUID_LINUX_DATA    "0fc63daf-8483-4772-8e79-3d69d8477de4"
+#define MBR_ESP            "0xef"
+#define MBR_NTFS           "0x07"
+#define MBR_LINUX          "0x83"
+
+/* Raíces de la especificación de particiones descubribles */
+static const gchar *linux_root_guids[] = {
+    "4f68bce3-e8cd-4db1-96e7-fbcaf984b709",  /* x86-64 */
+    "44479540-f297-41b2-9af7-d131d5f0458a",  /* x86 */
+    "b921b045-1df0-41c3-af44-4c6f280d3fae",  /* aarch64 */
+    NULL
+};
+
+static const gchar *linux_filesystems[] = { "ext4", "ext3", "ext2", "btrfs", "xfs", "f2fs", NULL };
+
+typedef struct {
+    gchar   *device;   /* partición, p. ej. /dev/nvme0n1p1 */
+    gchar   *disk;     /* disco que la contiene, p. ej. /dev/nvme0n1 */
+    gchar   *name;     /* "Windows", directorio del cargador o etiqueta */
+    gboolean is_esp;
+} OsCandidate;
+
+/* ESP pendiente de montar en solo lectura */
+typedef struct {
+    UDisksObject *object;
+    gchar        *device;
+    gchar        *disk;
+} EspMount;
+
+static GPtrArray *os_candidates = NULL;
+static guint pending_mounts = 0;
+static gboolean scan_started = FALSE;
+static gboolean scan_finished = FALSE;
+static TraceSpan scan_span;
+
+static void os_candidate_free(gpointer data)
+{
+    OsCandidate *candidate = data;
+    g_free(candidate->device);
+    g_free(candidate->disk);
+    g_free(candidate->name);
+    g_free(candidate);
+}
+
+static void esp_mount_free(EspMount *mount)
+{
+    g_object_unref(mount->object);
+    g_free(mount->device);
+    g_free(mount->disk);
+    g_free(mount);
+}
+
+static void add_candidate(const gchar *device, const gchar *disk, const gchar *name, gboolean is_esp)
+{
+    OsCandidate *candidate = g_new0(OsCandidate, 1);
+    candidate->device = g_strdup(device);
+    candidate->disk = g_strdup(disk);
+    /* El nombre acaba entre comillas en variables.sh */
+    candidate->name = g_strcanon(g_strdup(name),
+                                 G_CSET_a_2_z G_CSET_A_2_Z G_CSET_DIGITS " -_.", '_');
+    g_ptr_array_add(os_candidates, candidate);
+    LOG_INFO("Otro sistema detectado: %s en %s%s", candidate->name, device,
+             is_esp ? " (ESP)" : "");
+}
+
+static gboolean str_in_list(const gchar *value, const gchar **list)
+{
+    for (int i = 0; value && list[i]; i++) {
+        if (g_ascii_strcasecmp(value, list[i]) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* FAT no distingue mayúsculas: busca "name" dentro de dir sin tenerlas en cuenta */
+static gchar *find_child_nocase(const gchar *dir, const gchar *name)
+{
+    GDir *handle = g_dir_open(dir, 0, NULL);
+    if (!handle)
+        return NULL;
+
+    gchar *found = NULL;
+    const gchar *entry;
+    while (!found && (entry = g_dir_read_name(handle))) {
+        if (g_ascii_strcasecmp(entry, name) == 0)
+            found = g_build_filename(dir, entry, NULL);
+    }
+    g_dir_close(handle);
+    return found;
+}
+
+/* Cada directorio de EFI/ es un cargador instalado; Boot es el de reserva del
+ * firmware y no identifica a ningún sistema */
+static void inspect_esp(const gchar *mount_path, const gchar *device, const gchar *disk)
+{
+    gchar *efi_dir = find_child_nocase(mount_path, "EFI");
+    GDir *handle = efi_dir ? g_dir_open(efi_dir, 0, NULL) : NULL;
+    if (!handle) {
+        g_free(efi_dir);
+        return;
+    }
+
+    const gchar *entry;
+    while ((entry = g_dir_read_name(handle))) {
+        if (g_ascii_strcasecmp(entry, "Boot") == 0)
+            continue;
+        gchar *path = g_build_filename(efi_dir, entry, NULL);
+        if (g_file_test(path, G_FILE_TEST_IS_DIR)) {
+            add_candidate(device, disk,
+                          g_ascii_strcasecmp(entry, "Microsoft") == 0 ? "Windows" : entry,
+                          TRUE);
+        }
+        g_free(path);
+    }
+    g_dir_close(handle);
+    g_free(efi_dir);
+}
+
+static void apply_os_detect(GString *content, gpointer user_data)
+{
+    (void)user_data;
+    os_detect_update_variables(content);
+}
+
+static void scan_done(void)
+{
+    scan_finished = TRUE;
+    trace_span_end(&scan_span);
+    LOG_INFO("Detección de otros sistemas terminada: %u candidatos", os_candidates->len);
+    if (!vars_update(apply_os_detect, NULL))
+        LOG_WARNING("No se pudo guardar OS_PROBER_NEEDED en variables.sh");
+}
+
+static GVariant *readonly_mount_options(const gchar *mount_options)
+{
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+    if (mount_options)
+        g_variant_builder_add(&builder, "{sv}", "options", g_variant_new_string(mount_options));
+    g_variant_builder_add(&builder, "{sv}", "auth.no_user_interaction", g_variant_new_boolean(TRUE));
+    return g_variant_builder_end(&builder);
+}
+
+static void on_esp_unmounted(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+    EspMount *mount = user_data;
+    GError *error = NULL;
+
+    if (!udisks_filesystem_call_unmount_finish(UDISKS_FILESYSTEM(source), res, &error)) {
+        LOG_WARNING("No se pudo desmontar la ESP %s: %s", mount->device, error->message);
+        g_error_free(error);
+    }
+
+    esp_mount_free(mount);
+    if (--pending_mounts == 0)
+        scan_done();
+}
+
+static void on_esp_mounted(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+    EspMount *mount = user_data;
+    UDisksFilesystem *filesystem = UDISKS_FILESYSTEM(source);
+    GError *error = NULL;
+    gchar *mount_path = NULL;
+
+    if (!udisks_filesystem_call_mount_finish(filesystem, &mount_path, res, &error)) {
+        LOG_WARNING("No se pudo montar la ESP %s en solo lectura: %s", mount->device, error->message);
+        g_error_free(error);
+        esp_mount_free(mount);
+        if (--pending_mounts == 0)
+            scan_done();
+        return;
+    }
+
+    inspect_esp(mount_path, mount->device, mount->disk);
+    g_free(mount_path);
+
+    udisks_filesystem_call_unmount(filesystem, readonly_mount_options(NULL), NULL,
+                                   on_esp_unmounted, mount);
+}
+
+/* Clasifica una partición sin montarla; las ESP desmontadas se dejan en
+ * to_mount para leerlas después en paralelo */
+static void classify_partition(UDisksClient *client, UDisksObject *object, GPtrArray *to_mount)
+{
+    UDisksPartition *partition = udisks_object_peek_partition(object);
+    UDisksBlock *block = udisks_object_peek_block(object);
+    if (!partition || !block || udisks_block_get_hint_ignore(block))
+        return;
+
+    const gchar *device = udisks_block_get_device(block);
+    const gchar *type = udisks_partition_get_type_(partition);
+    const gchar *fs_type = udisks_block_get_id_type(block);
+    const gchar *label = udisks_block_get_id_label(block);
+    if (!device || !type)
+        return;
+
+    UDisksObject *table_object = udisks_client_peek_object(client, udisks_partition_get_table(partition));
+    UDisksBlock *table_block = table_object ? udisks_object_peek_block(table_object) : NULL;
+    const gchar *disk = table_block ? udisks_block_get_device(table_block) : "";
+
+    gboolean is_esp = g_ascii_strcasecmp(type, GUID_ESP) == 0 || g_ascii_strcasecmp(type, MBR_ESP) == 0;
+    if (is_esp && g_strcmp0(fs_type, "vfat") == 0) {
+        UDisksFilesystem *filesystem = udisks_object_peek_filesystem(object);
+        const gchar *const *mount_points = filesystem ? udisks_filesystem_get_mount_points(filesystem) : NULL;
+        if (mount_points && mount_points[0]) {
+            inspect_esp(mount_points[0], device, disk);
+        } else if (filesystem) {
+            EspMount *mount = g_new0(EspMount, 1);
+            mount->object = g_object_ref(object);
+            mount->device = g_strdup(device);
+            mount->disk = g_strdup(disk);
+            g_ptr_array_add(to_mount, mount);
+        }
+        return;
+    }
+
+    /* Windows: NTFS o BitLocker en una partición de datos básicos (la de
+     * recuperación tiene su propio tipo y no cuenta) */
+    if ((g_strcmp0(fs_type, "ntfs") == 0 || g_strcmp0(fs_type, "BitLocker") == 0) &&
+        (g_ascii_strcasecmp(type, GUID_MS_BASIC_DATA) == 0 || g_ascii_strcasecmp(type, MBR_NTFS) == 0)) {
+        add_candidate(device, disk, "Windows", FALSE);
+        return;
+    }
+
+    /* Linux: raíz descubrible o partición de datos Linux con un sistema de
+     * archivos de raíz; sin montarla no se distingue una raíz de un /home,
+     * así que cuenta como candidato y os-prober decide */
+    if (str_in_list(fs_type, linux_filesystems) &&
+        (str_in_list(type, linux_root_guids) || g_ascii_strcasecmp(type, GUID_LINUX_DATA) == 0 ||
+         g_ascii_strcasecmp(type, MBR_LINUX) == 0)) {
+        add_candidate(device, disk, label && *label ? label : "Linux", FALSE);
+    }
+}
+
+void os_detect_start(UDisksClient *client)
+{
+    if (!client || scan_started)
+        return;
+    scan_started = TRUE;
+    scan_span = trace_span_begin(TRACE_CAT_UDISKS, "os_detect");
+
+    os_candidates = g_ptr_array_new_with_free_func(os_candidate_free);
+    GPtrArray *to_mount = g_ptr_array_new();
+
+    GList *objects = g_dbus_object_manager_get_objects(udisks_client_get_object_manager(client));
+    for (GList *l = objects; l; l = l->next)
+        classify_partition(client, UDISKS_OBJECT(l->data), to_mount);
+    g_list_free_full(objects, g_object_unref);
+
+    if (to_mount->len == 0) {
+        g_ptr_array_free(to_mount, TRUE);
+        scan_done();
+        return;
+    }
+
+    /* Todas las ESP a la vez: cada montaje es una llamada D-Bus independiente */
+    pending_mounts = to_mount->len;
+    for (guint i = 0; i < to_mount->len; i++) {
+        EspMount *mount = g_ptr_array_index(to_mount, i);
+        udisks_filesystem_call_mount(udisks_object_peek_filesystem(mount->object),
+                                     readonly_mount_options("ro"), NULL,
+                                     on_esp_mounted, mount);
+    }
+    g_ptr_array_free(to_mount, TRUE);
+}
+
+gboolean os_detect_is_finished(void)
+{
+    return scan_finished;
+}
+
+void os_detect_update_variables(GString *content)
+{
+    g_return_if_fail(content != NULL);
+
+    if (!scan_finished)
+        return;
+
+    gchar *selected_disk = vars_get(content, "SELECTED_DISK");
+    gchar *mode = vars_get(content, "PARTITION_MODE");
+    /* Los modos automáticos borran el disco entero; en manual se conservan sus particiones */
+    gboolean wipes_disk = selected_disk && *selected_disk && g_strcmp0(mode, "manual") != 0;
+
+    GString *esps = g_string_new(NULL);
+    GString *found = g_string_new(NULL);
+    GHashTable *seen_esps = g_hash_table_new(g_str_hash, g_str_equal);
+
+    for (guint i = 0; i < os_candidates->len; i++) {
+        OsCandidate *candidate = g_ptr_array_index(os_candidates, i);
+        if (wipes_disk && g_strcmp0(candidate->disk, selected_disk) == 0)
+            continue;
+
+        g_string_append_printf(found, "%s%s (%s)", found->len ? ", " : "",
+                               candidate->name, candidate->device);
+        if (candidate->is_esp && g_hash_table_add(seen_esps, candidate->device))
+            g_string_append_printf(esps, "%s%s", esps->len ? " " : "", candidate->device);
+    }
+
+    vars_upsert(content, "OS_PROBER_NEEDED", found->len ? "true" : "false");
+    vars_upsert(content, "OTHER_OS_ESPS", esps->str);
+    vars_upsert(content, "OTHER_OS_FOUND", found->str);
+    LOG_INFO("Otros sistemas para el cargador de arranque: %s", found->len ? found->str : "ninguno");
+
+    g_hash_table_destroy(seen_esps);
+    g_string_free(found, TRUE);
+    g_string_free(esps, TRUE);
+    g_free(mode);
+    g_free(selected_disk);
+}
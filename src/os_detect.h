@@ -0,0 +1,28 @@
+#ifndef OS_DETECT_H
+#define OS_DETECT_H
+
+#include <glib.h>
+#include <udisks/udisks.h>
+
+/* Detección de otros sistemas operativos para el cargador de arranque.
+ *
+ * Recorre las particiones que UDisks ya conoce y reconoce Windows y otras
+ * distribuciones por el tipo de partición, el sistema de archivos y la
+ * etiqueta; las ESP se montan en solo lectura, todas a la vez, para mirar
+ * qué cargadores hay en EFI/. El resultado se escribe en variables.sh
+ * (OS_PROBER_NEEDED, OTHER_OS_ESPS, OTHER_OS_FOUND) y config_grub.sh solo
+ * instala y ejecuta os-prober cuando hay candidatos. */
+
+/* Inicia la detección en segundo plano (una sola vez por sesión) */
+void os_detect_start(UDisksClient *client);
+
+/* TRUE cuando la detección terminó y hay resultado */
+gboolean os_detect_is_finished(void);
+
+/* Escribe OS_PROBER_NEEDED, OTHER_OS_ESPS y OTHER_OS_FOUND descartando los
+ * sistemas del disco que el particionado automático va a borrar
+ * (SELECTED_DISK y PARTITION_MODE). No toca nada si la detección no terminó:
+ * config_grub.sh usa entonces su propia detección. */
+void os_detect_update_variables(GString *content);
+
+#endif /* OS_DETECT_H */
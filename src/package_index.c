@@ -0,0 +1,475 @@
+#include "package_index.h"
+#include "config.h"
+#include "trace.h"
+#include <libsoup/soup.h>
+#include <string.h>
+
+typedef struct {
+    const gchar *name;
+    const gchar *repo;
+    const gchar *provider;
+    guint64 download_size;
+    guint64 installed_size;
+    guint member_count;
+} PackageEntry;
+
+typedef struct {
+    GStringChunk *strings;         /* nombres y repositorios */
+    GHashTable *packages;          /* nombre → PackageEntry */
+    GHashTable *groups;
+    GHashTable *provides;
+    GPtrArray *sorted;             /* nombres de paquetes y grupos para completar */
+} PackageIndex;
+
+typedef struct {
+    PackageIndexCallback callback;
+    gpointer user_data;
+    gchar **names;
+    gchar **found;                 /* nombres que el AUR devolvió (NULL si falló) */
+} AurQuery;
+
+/* Estado global: solo se toca desde el hilo principal */
+static PackageIndex *g_index = NULL;
+static gboolean g_index_loading = FALSE;
+static PackageIndexCallback g_index_callback = NULL;
+static gpointer g_index_callback_data = NULL;
+static GHashTable *g_aur_results = NULL;   /* nombre → PackageStatus */
+
+static PackageEntry *index_entry(GHashTable *table, PackageIndex *index,
+                                 const gchar *repo, const gchar *name)
+{
+    PackageEntry *entry = g_hash_table_lookup(table, name);
+    if (entry) return entry;
+
+    entry = g_new0(PackageEntry, 1);
+    entry->name = g_string_chunk_insert_const(index->strings, name);
+    entry->repo = repo;
+    g_hash_table_insert(table, (gpointer)entry->name, entry);
+    return entry;
+}
+
+/* Salida de bsdtar: los archivos desc de cada paquete seguidos, con campos
+ * "%CAMPO%" y sus valores hasta la línea vacía. %NAME% abre cada
+ * paquete; %CSIZE% va después de %GROUPS%, así que los tamaños de los grupos
+ * se suman al cerrar el paquete */
+static void index_parse_desc(PackageIndex *index, const gchar *repo, gchar *text)
+{
+    PackageEntry *current = NULL;
+    GPtrArray *current_groups = g_ptr_array_new();
+    const gchar *field = NULL;
+    gchar *line = text;
+
+    while (line) {
+        gchar *next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+
+        if (line[0] == '\0') {
+            field = NULL;
+        } else if (line[0] == '%' && g_str_has_suffix(line, "%")) {
+            field = line;
+        } else if (g_strcmp0(field, "%NAME%") == 0) {
+            if (current) {
+                for (guint i = 0; i < current_groups->len; i++)
+                    ((PackageEntry *)current_groups->pdata[i])->download_size += current->download_size;
+            }
+            g_ptr_array_set_size(current_groups, 0);
+
+            /* El primer repositorio de pacman.conf gana, igual que en pacman -S */
+            current = g_hash_table_contains(index->packages, line) ? NULL
+                      : index_entry(index->packages, index, repo, line);
+        } else if (current && g_strcmp0(field, "%CSIZE%") == 0) {
+            current->download_size = g_ascii_strtoull(line, NULL, 10);
+        } else if (current && g_strcmp0(field, "%ISIZE%") == 0) {
+            current->installed_size = g_ascii_strtoull(line, NULL, 10);
+        } else if (current && g_strcmp0(field, "%GROUPS%") == 0) {
+            PackageEntry *group = index_entry(index->groups, index, repo, line);
+            group->member_count++;
+            g_ptr_array_add(current_groups, group);
+        } else if (current && g_strcmp0(field, "%PROVIDES%") == 0) {
+            gchar *version = strpbrk(line, "<>=");
+            if (version) *version = '\0';
+            PackageEntry *provided = index_entry(index->provides, index, repo, line);
+            if (!provided->provider) {
+                provided->provider = current->name;
+                provided->download_size = current->download_size;
+                provided->installed_size = current->installed_size;
+            }
+        }
+
+        line = next;
+    }
+
+    if (current) {
+        for (guint i = 0; i < current_groups->len; i++)
+            ((PackageEntry *)current_groups->pdata[i])->download_size += current->download_size;
+    }
+    g_ptr_array_free(current_groups, TRUE);
+}
+
+/* Repositorios en el orden de /etc/pacman.conf; sin él, los .db que haya */
+static GPtrArray *index_list_repos(void)
+{
+    GPtrArray *repos = g_ptr_array_new_with_free_func(g_free);
+    gchar *conf = NULL;
+
+    if (g_file_get_contents(PACKAGE_INDEX_PACMAN_CONF, &conf, NULL, NULL)) {
+        gchar **lines = g_strsplit(conf, "\n", -1);
+        for (int i = 0; lines[i]; i++) {
+            gchar *line = g_strstrip(lines[i]);
+            gsize len = strlen(line);
+            if (len > 2 && line[0] == '[' && line[len - 1] == ']') {
+                gchar *repo = g_strndup(line + 1, len - 2);
+                if (g_strcmp0(repo, "options") != 0)
+                    g_ptr_array_add(repos, repo);
+                else
+                    g_free(repo);
+            }
+        }
+        g_strfreev(lines);
+        g_free(conf);
+    }
+
+    if (repos->len == 0) {
+        GDir *dir = g_dir_open(PACKAGE_INDEX_SYNC_DIR, 0, NULL);
+        const gchar *entry;
+        while (dir && (entry = g_dir_read_name(dir))) {
+            if (g_str_has_suffix(entry, ".db"))
+                g_ptr_array_add(repos, g_strndup(entry, strlen(entry) - 3));
+        }
+        if (dir) g_dir_close(dir);
+    }
+    return repos;
+}
+
+static gint index_compare_names(gconstpointer a, gconstpointer b)
+{
+    return strcmp(*(const gchar * const *)a, *(const gchar * const *)b);
+}
+
+static gboolean index_build_done(gpointer user_data)
+{
+    g_index = user_data;
+    g_index_loading = FALSE;
+
+    LOG_INFO("Índice de paquetes listo: %u paquetes, %u grupos, %u nombres virtuales",
+             g_hash_table_size(g_index->packages), g_hash_table_size(g_index->groups),
+             g_hash_table_size(g_index->provides));
+    if (g_hash_table_size(g_index->packages) == 0)
+        LOG_WARNING("Sin bases de sincronización: los programas extra no se podrán comprobar");
+
+    if (g_index_callback)
+        g_index_callback(g_index_callback_data);
+    return G_SOURCE_REMOVE;
+}
+
+static gpointer index_build_thread(gpointer user_data)
+{
+    TraceSpan span = trace_span_begin(TRACE_CAT_SUBPROCESS, "índice de paquetes");
+    PackageIndex *index = g_new0(PackageIndex, 1);
+    index->strings = g_string_chunk_new(64 * 1024);
+    index->packages = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+    index->groups = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+    index->provides = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+    index->sorted = g_ptr_array_new();
+
+    GPtrArray *repos = index_list_repos();
+    for (guint i = 0; i < repos->len; i++) {
+        const gchar *repo = g_string_chunk_insert_const(index->strings, repos->pdata[i]);
+        gchar *db = g_strdup_printf("%s/%s.db", PACKAGE_INDEX_SYNC_DIR, repo);
+        gchar *argv[] = { "bsdtar", "-xOf", db, "*/desc", NULL };
+        gchar *desc = NULL;
+        GError *error = NULL;
+
+        if (!g_file_test(db, G_FILE_TEST_EXISTS)) {
+            LOG_WARNING("No existe la base de sincronización %s", db);
+        } else if (!g_spawn_sync(NULL, argv, NULL, G_SPAWN_SEARCH_PATH | G_SPAWN_STDERR_TO_DEV_NULL,
+                                 NULL, NULL, &desc, NULL, NULL, &error)) {
+            LOG_WARNING("No se pudo leer %s: %s", db, error ? error->message : "desconocido");
+            g_clear_error(&error);
+        } else {
+            index_parse_desc(index, repo, desc);
+        }
+        g_free(desc);
+        g_free(db);
+    }
+    g_ptr_array_free(repos, TRUE);
+
+    /* Un paquete real tapa al nombre virtual del mismo nombre */
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, index->packages);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        g_hash_table_remove(index->provides, key);
+        g_ptr_array_add(index->sorted, key);
+    }
+    g_hash_table_iter_init(&iter, index->groups);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        if (!g_hash_table_contains(index->packages, key))
+            g_ptr_array_add(index->sorted, key);
+    }
+    g_ptr_array_sort(index->sorted, index_compare_names);
+
+    trace_span_end(&span);
+
+    g_idle_add(index_build_done, index);
+    return NULL;
+}
+
+void package_index_load_async(PackageIndexCallback callback, gpointer user_data)
+{
+    g_index_callback = callback;
+    g_index_callback_data = user_data;
+
+    if (g_index) {
+        if (callback) callback(user_data);
+        return;
+    }
+    if (g_index_loading) return;
+
+    g_index_loading = TRUE;
+    LOG_INFO("Construyendo el índice de paquetes desde %s...", PACKAGE_INDEX_SYNC_DIR);
+    g_thread_unref(g_thread_new("package-index", index_build_thread, NULL));
+}
+
+gboolean package_index_is_ready(void)
+{
+    return g_index != NULL;
+}
+
+/* Caracteres que pacman admite en nombres de paquete: minúsculas, dígitos y
+ * @._+-, sin empezar por guion ni punto */
+static gboolean package_name_is_valid(const gchar *name)
+{
+    if (!name || !*name || name[0] == '-' || name[0] == '.') return FALSE;
+    for (const gchar *p = name; *p; p++) {
+        if (!g_ascii_islower(*p) && !g_ascii_isdigit(*p) && !strchr("@._+-", *p))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean aur_is_disabled(void)
+{
+    return g_strcmp0(g_getenv(PACKAGE_INDEX_AUR_ENV_VAR), "off") == 0;
+}
+
+static void lookup_fill(PackageLookup *lookup, PackageStatus status, const PackageEntry *entry)
+{
+    lookup->status = status;
+    lookup->repo = entry->repo;
+    lookup->provider = entry->provider;
+    lookup->download_size = entry->download_size;
+    lookup->installed_size = entry->installed_size;
+    lookup->member_count = entry->member_count;
+}
+
+void package_index_lookup(const gchar *name, PackageLookup *lookup)
+{
+    g_return_if_fail(lookup != NULL);
+    memset(lookup, 0, sizeof(*lookup));
+
+    if (!package_name_is_valid(name)) {
+        lookup->status = PACKAGE_STATUS_INVALID;
+        return;
+    }
+    if (!g_index) {
+        lookup->status = g_index_loading ? PACKAGE_STATUS_PENDING : PACKAGE_STATUS_UNCHECKED;
+        return;
+    }
+
+    const PackageEntry *entry;
+    if ((entry = g_hash_table_lookup(g_index->packages, name))) {
+        lookup_fill(lookup, PACKAGE_STATUS_REPO, entry);
+        return;
+    }
+    if ((entry = g_hash_table_lookup(g_index->groups, name))) {
+        lookup_fill(lookup, PACKAGE_STATUS_GROUP, entry);
+        return;
+    }
+    if ((entry = g_hash_table_lookup(g_index->provides, name))) {
+        lookup_fill(lookup, PACKAGE_STATUS_PROVIDED, entry);
+        return;
+    }
+
+    /* Sin índice de repositorios tampoco se puede afirmar que falte */
+    if (g_hash_table_size(g_index->packages) == 0 || aur_is_disabled()) {
+        lookup->status = PACKAGE_STATUS_UNCHECKED;
+        return;
+    }
+
+    gpointer status;
+    if (g_aur_results && g_hash_table_lookup_extended(g_aur_results, name, NULL, &status))
+        lookup->status = GPOINTER_TO_INT(status);
+    else
+        lookup->status = PACKAGE_STATUS_PENDING;
+}
+
+guint package_index_complete(const gchar *prefix, const gchar **out, guint max)
+{
+    if (!g_index || !prefix || !*prefix || !out || max == 0) return 0;
+
+    /* Búsqueda binaria del primer nombre >= prefix */
+    guint low = 0, high = g_index->sorted->len;
+    while (low < high) {
+        guint mid = low + (high - low) / 2;
+        if (strcmp(g_index->sorted->pdata[mid], prefix) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    guint count = 0;
+    for (guint i = low; i < g_index->sorted->len && count < max; i++) {
+        const gchar *name = g_index->sorted->pdata[i];
+        if (!g_str_has_prefix(name, prefix)) break;
+        out[count++] = name;
+    }
+    return count;
+}
+
+/* Respuesta de la API RPC: {"resultcount":N,"results":[{"Name":"...",...}]};
+ * solo hacen falta los nombres, así que basta con una expresión regular */
+static gchar **aur_parse_names(const gchar *json)
+{
+    if (!json || !strstr(json, "\"results\"") || strstr(json, "\"type\":\"error\""))
+        return NULL;
+
+    GPtrArray *names = g_ptr_array_new();
+    GRegex *regex = g_regex_new("\"Name\"\\s*:\\s*\"([^\"\\\\]+)\"", 0, 0, NULL);
+    GMatchInfo *match = NULL;
+
+    g_regex_match(regex, json, 0, &match);
+    while (g_match_info_matches(match)) {
+        g_ptr_array_add(names, g_match_info_fetch(match, 1));
+        g_match_info_next(match, NULL);
+    }
+    g_match_info_free(match);
+    g_regex_unref(regex);
+
+    g_ptr_array_add(names, NULL);
+    return (gchar **)g_ptr_array_free(names, FALSE);
+}
+
+static gchar *aur_fetch(const gchar *endpoint, gchar **names)
+{
+    /* Archivo JSON local en lugar del servidor */
+    if (g_str_has_prefix(endpoint, "/") || g_str_has_prefix(endpoint, "file://")) {
+        gchar *path = g_str_has_prefix(endpoint, "file://")
+                      ? g_filename_from_uri(endpoint, NULL, NULL) : g_strdup(endpoint);
+        gchar *json = NULL;
+        if (!path || !g_file_get_contents(path, &json, NULL, NULL))
+            LOG_WARNING("No se pudo leer la respuesta del AUR de %s", endpoint);
+        g_free(path);
+        return json;
+    }
+
+    GString *url = g_string_new(endpoint);
+    for (int i = 0; names[i]; i++) {
+        gchar *escaped = g_uri_escape_string(names[i], NULL, FALSE);
+        g_string_append_printf(url, "%sarg[]=%s", strchr(url->str, '?') ? "&" : "?", escaped);
+        g_free(escaped);
+    }
+
+    SoupSession *session = soup_session_new();
+    soup_session_set_timeout(session, 10);
+    SoupMessage *msg = soup_message_new("GET", url->str);
+    gchar *json = NULL;
+
+    if (msg) {
+        GError *error = NULL;
+        GBytes *body = soup_session_send_and_read(session, msg, NULL, &error);
+        if (body && soup_message_get_status(msg) == SOUP_STATUS_OK) {
+            gsize size;
+            const gchar *data = g_bytes_get_data(body, &size);
+            json = g_strndup(data, size);
+        } else {
+            LOG_WARNING("El AUR no respondió: %s",
+                        error ? error->message : soup_message_get_reason_phrase(msg));
+        }
+        g_clear_error(&error);
+        if (body) g_bytes_unref(body);
+        g_object_unref(msg);
+    }
+    g_object_unref(session);
+    g_string_free(url, TRUE);
+    return json;
+}
+
+static gboolean aur_query_done(gpointer user_data)
+{
+    AurQuery *query = user_data;
+
+    for (int i = 0; query->names[i]; i++) {
+        PackageStatus status = PACKAGE_STATUS_UNCHECKED;
+        if (query->found)
+            status = g_strv_contains((const gchar * const *)query->found, query->names[i])
+                     ? PACKAGE_STATUS_AUR : PACKAGE_STATUS_MISSING;
+        g_hash_table_insert(g_aur_results, g_strdup(query->names[i]), GINT_TO_POINTER(status));
+    }
+
+    if (query->callback)
+        query->callback(query->user_data);
+
+    g_strfreev(query->names);
+    g_strfreev(query->found);
+    g_free(query);
+    return G_SOURCE_REMOVE;
+}
+
+static gpointer aur_query_thread(gpointer user_data)
+{
+    AurQuery *query = user_data;
+    const gchar *endpoint = g_getenv(PACKAGE_INDEX_AUR_ENV_VAR);
+    if (!endpoint || !*endpoint) endpoint = PACKAGE_INDEX_AUR_URL;
+
+    TraceSpan span = trace_span_begin(TRACE_CAT_NETWORK, "AUR info (%u)", g_strv_length(query->names));
+    gchar *json = aur_fetch(endpoint, query->names);
+    query->found = aur_parse_names(json);
+    trace_span_end(&span);
+
+    if (json && !query->found)
+        LOG_WARNING("Respuesta del AUR no reconocida");
+    g_free(json);
+
+    g_idle_add(aur_query_done, query);
+    return NULL;
+}
+
+gboolean package_index_query_aur(const gchar * const *names,
+                                 PackageIndexCallback callback, gpointer user_data)
+{
+    if (!names || !g_index || g_hash_table_size(g_index->packages) == 0 || aur_is_disabled())
+        return FALSE;
+
+    if (!g_aur_results)
+        g_aur_results = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    GPtrArray *pending = g_ptr_array_new();
+    for (int i = 0; names[i]; i++) {
+        PackageLookup lookup;
+        package_index_lookup(names[i], &lookup);
+        if (lookup.status != PACKAGE_STATUS_PENDING ||
+            g_hash_table_contains(g_aur_results, names[i]))
+            continue;
+
+        /* En vuelo: no se vuelve a pedir mientras llega la respuesta */
+        g_hash_table_insert(g_aur_results, g_strdup(names[i]),
+                            GINT_TO_POINTER(PACKAGE_STATUS_PENDING));
+        g_ptr_array_add(pending, g_strdup(names[i]));
+    }
+
+    if (pending->len == 0) {
+        g_ptr_array_free(pending, TRUE);
+        return FALSE;
+    }
+    g_ptr_array_add(pending, NULL);
+
+    AurQuery *query = g_new0(AurQuery, 1);
+    query->callback = callback;
+    query->user_data = user_data;
+    query->names = (gchar **)g_ptr_array_free(pending, FALSE);
+
+    LOG_INFO("Consultando %u paquetes en el AUR", g_strv_length(query->names));
+    g_thread_unref(g_thread_new("aur-query", aur_query_thread, query));
+    return TRUE;
+}
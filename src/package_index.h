@@ -0,0 +1,62 @@
+#ifndef PACKAGE_INDEX_H
+#define PACKAGE_INDEX_H
+
+#include <glib.h>
+
+/* Índice de nombres de paquetes para la ventana de programas extra.
+ *
+ * Se construye en segundo plano a partir de las bases de sincronización del
+ * sistema en vivo (/var/lib/pacman/sync/<repo>.db, en el orden de
+ * /etc/pacman.conf): paquetes con su tamaño de descarga e instalado, grupos y
+ * nombres virtuales (%PROVIDES%). Los nombres que no están en los repositorios
+ * se consultan en lote a la API RPC del AUR; ARCRIS_AUR_RPC cambia el destino
+ * por otro servidor compatible o por un archivo JSON local con la misma
+ * respuesta, y "off" desactiva la consulta. */
+
+#define PACKAGE_INDEX_SYNC_DIR    "/var/lib/pacman/sync"
+#define PACKAGE_INDEX_PACMAN_CONF "/etc/pacman.conf"
+#define PACKAGE_INDEX_AUR_ENV_VAR "ARCRIS_AUR_RPC"
+#define PACKAGE_INDEX_AUR_URL     "https://aur.archlinux.org/rpc/v5/info"
+
+typedef enum {
+    PACKAGE_STATUS_PENDING = 0,    /* índice o consulta al AUR sin terminar */
+    PACKAGE_STATUS_REPO,
+    PACKAGE_STATUS_GROUP,
+    PACKAGE_STATUS_PROVIDED,       /* nombre virtual de otro paquete */
+    PACKAGE_STATUS_AUR,
+    PACKAGE_STATUS_MISSING,        /* ni en los repositorios ni en el AUR */
+    PACKAGE_STATUS_INVALID,        /* caracteres que pacman no admite */
+    PACKAGE_STATUS_UNCHECKED       /* sin bases de sincronización o el AUR no respondió */
+} PackageStatus;
+
+typedef struct {
+    PackageStatus status;
+    const gchar *repo;             /* core, extra... (NULL fuera de los repositorios) */
+    const gchar *provider;         /* paquete que provee el nombre (PACKAGE_STATUS_PROVIDED) */
+    guint64 download_size;         /* %CSIZE%; en grupos, la suma de sus paquetes */
+    guint64 installed_size;        /* %ISIZE% */
+    guint member_count;            /* paquetes del grupo */
+} PackageLookup;
+
+typedef void (*PackageIndexCallback)(gpointer user_data);
+
+/* Construye el índice en un hilo (una sola vez); callback se llama en el hilo
+ * principal cuando termina, también si no había bases de sincronización */
+void package_index_load_async(PackageIndexCallback callback, gpointer user_data);
+gboolean package_index_is_ready(void);
+
+/* Estado de un nombre según el índice y las consultas al AUR ya hechas */
+void package_index_lookup(const gchar *name, PackageLookup *lookup);
+
+/* Hasta max paquetes o grupos que empiezan por prefix, en orden alfabético;
+ * las cadenas pertenecen al índice. Devuelve cuántos se escribieron en out */
+guint package_index_complete(const gchar *prefix, const gchar **out, guint max);
+
+/* Consulta al AUR, en una sola petición, los nombres que siguen pendientes
+ * (no están en el índice ni se consultaron antes). Devuelve FALSE si no había
+ * nada que consultar; si no, callback se llama en el hilo principal al
+ * recibir la respuesta */
+gboolean package_index_query_aur(const gchar * const *names,
+                                 PackageIndexCallback callback, gpointer user_data);
+
+#endif /* PACKAGE_INDEX_H */
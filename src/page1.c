@@ -1,6 +1,8 @@
 #include "page1.h"
 #include "page2.h"
 #include "i18n.h"
+#include "keyring_prep.h"
+#include "trace.h"
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -13,6 +15,8 @@ static Page1Data *g_page1_data = NULL;
 // Función para verificar conectividad a internet
 static gboolean check_internet_connectivity(void)
 {
+    TRACE_SCOPE(TRACE_CAT_NETWORK, "check_internet_connectivity");
+
     // Método 1: ping a 1.1.1.1 (Cloudflare DNS)
     int result = system("ping -c 1 -W 2 1.1.1.1 > /dev/null 2>&1");
     if (result == 0) {
@@ -211,6 +215,9 @@ static void page1_start_button_clicked(GtkButton *button, gpointer user_data)
 
     // Detener monitoreo de internet ya que vamos a la siguiente página
     page1_stop_internet_monitoring();
+
+    // Las claves de pacman se preparan mientras se configura la instalación
+    keyring_prep_start();
     
     AdwCarousel *carousel = g_page1_data->carousel;
     GtkRevealer *revealer = g_page1_data->revealer;
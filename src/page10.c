@@ -1,9 +1,23 @@
 #include "page10.h"
 #include "config.h"
 #include "i18n.h"
+#include "install_log.h"
+#include <glib/gstdio.h>
+#include <string.h>
 
 static Page10Data *g_page10_data = NULL;
 
+// Líneas que se cargan de una vez y máximo en el buffer
+#define LOG_VIEW_CHUNK_LINES 2000
+#define LOG_VIEW_MAX_LINES   10000
+
+typedef struct {
+    Page10Data *data;
+    gchar *path;
+    LogIndex *index;
+    gchar *error_message;
+} LogLoadTask;
+
 void page10_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *revealer)
 {
     (void)builder;
@@ -36,6 +50,14 @@ void page10_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveal
     g_page10_data->view_log_button = GTK_TOGGLE_BUTTON(gtk_builder_get_object(page_builder, "view_log_button"));
     g_page10_data->log_revealer   = GTK_REVEALER(gtk_builder_get_object(page_builder, "log_revealer"));
     g_page10_data->log_text_view  = GTK_TEXT_VIEW(gtk_builder_get_object(page_builder, "log_text_view"));
+    g_page10_data->log_scrolled_window = GTK_SCROLLED_WINDOW(gtk_builder_get_object(page_builder, "log_scrolled_window"));
+    g_page10_data->log_search_entry = GTK_SEARCH_ENTRY(gtk_builder_get_object(page_builder, "log_search_entry"));
+    g_page10_data->log_error_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "log_error_button"));
+    g_page10_data->log_retry_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "log_retry_button"));
+    g_page10_data->log_status_label = GTK_LABEL(gtk_builder_get_object(page_builder, "log_status_label"));
+    g_page10_data->log_error_line = G_MAXUINT;
+    g_page10_data->log_retry_line = G_MAXUINT;
+    g_page10_data->log_search_line = 0;
 
     adw_carousel_append(carousel, g_page10_data->main_content);
 
@@ -43,30 +65,289 @@ void page10_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveal
         g_signal_connect(g_page10_data->view_log_button, "toggled",
                          G_CALLBACK(on_view_log_button_toggled), g_page10_data);
     }
+    if (g_page10_data->log_scrolled_window) {
+        g_signal_connect(g_page10_data->log_scrolled_window, "edge-reached",
+                         G_CALLBACK(on_log_edge_reached), g_page10_data);
+    }
+    if (g_page10_data->log_search_entry) {
+        g_signal_connect(g_page10_data->log_search_entry, "search-changed",
+                         G_CALLBACK(on_log_search_changed), g_page10_data);
+        g_signal_connect(g_page10_data->log_search_entry, "activate",
+                         G_CALLBACK(on_log_search_next), g_page10_data);
+        g_signal_connect(g_page10_data->log_search_entry, "next-match",
+                         G_CALLBACK(on_log_search_next), g_page10_data);
+    }
+    if (g_page10_data->log_error_button) {
+        g_signal_connect(g_page10_data->log_error_button, "clicked",
+                         G_CALLBACK(on_log_error_button_clicked), g_page10_data);
+    }
+    if (g_page10_data->log_retry_button) {
+        g_signal_connect(g_page10_data->log_retry_button, "clicked",
+                         G_CALLBACK(on_log_retry_button_clicked), g_page10_data);
+    }
 
     g_object_unref(page_builder);
     LOG_INFO("Página 10 (error) inicializada correctamente");
 }
 
-void page10_load_log(Page10Data *data)
+// Muestra en el buffer las líneas [first, end) del registro
+static void page10_log_show_range(Page10Data *data, guint first, guint end)
+{
+    gsize length = 0;
+    const gchar *text = log_index_get_lines(data->log_index, first, end, &length);
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(data->log_text_view);
+
+    gtk_text_buffer_set_text(buffer, text, length);
+    data->log_first_line = MIN(first, end);
+    data->log_end_line = MIN(end, log_index_get_line_count(data->log_index));
+}
+
+static void page10_log_scroll_to(Page10Data *data, GtkTextIter *iter, gdouble yalign)
+{
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(data->log_text_view);
+    GtkTextMark *mark = gtk_text_buffer_get_mark(buffer, "log-scroll");
+
+    if (mark)
+        gtk_text_buffer_move_mark(buffer, mark, iter);
+    else
+        mark = gtk_text_buffer_create_mark(buffer, "log-scroll", iter, TRUE);
+    gtk_text_view_scroll_to_mark(data->log_text_view, mark, 0.0, TRUE, 0.0, yalign);
+}
+
+// Lleva la vista a la línea del registro y selecciona [line_byte, line_byte + length)
+// o la línea entera si length es 0; carga antes el tramo si no está en el buffer
+static void page10_log_jump_to(Page10Data *data, guint line, gsize line_byte, gsize length)
+{
+    if (line < data->log_first_line || line >= data->log_end_line) {
+        guint first = line > LOG_VIEW_CHUNK_LINES / 2 ? line - LOG_VIEW_CHUNK_LINES / 2 : 0;
+        page10_log_show_range(data, first, first + LOG_VIEW_CHUNK_LINES);
+    }
+
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(data->log_text_view);
+    GtkTextIter start, end;
+    gtk_text_buffer_get_iter_at_line_index(buffer, &start, line - data->log_first_line, line_byte);
+    end = start;
+    if (length > 0) {
+        gtk_text_buffer_get_iter_at_line_index(buffer, &end, line - data->log_first_line,
+                                               line_byte + length);
+    } else if (!gtk_text_iter_ends_line(&end)) {
+        gtk_text_iter_forward_to_line_end(&end);
+    }
+
+    gtk_text_buffer_select_range(buffer, &start, &end);
+    page10_log_scroll_to(data, &start, 0.3);
+}
+
+static void page10_log_update_status(Page10Data *data)
+{
+    guint errors = log_index_get_marker_count(data->log_index, LOG_MARKER_ERROR);
+    guint retries = log_index_get_marker_count(data->log_index, LOG_MARKER_RETRY);
+
+    if (data->log_error_button)
+        gtk_widget_set_sensitive(GTK_WIDGET(data->log_error_button), errors > 0);
+    if (data->log_retry_button)
+        gtk_widget_set_sensitive(GTK_WIDGET(data->log_retry_button), retries > 0);
+
+    if (data->log_status_label) {
+        gchar *status = g_strdup_printf("%u %s · %u %s · %u %s",
+                                        log_index_get_line_count(data->log_index), i18n_t("líneas"),
+                                        errors, i18n_t("errores"),
+                                        retries, i18n_t("reintentos"));
+        gtk_label_set_text(data->log_status_label, status);
+        g_free(status);
+    }
+}
+
+// Muestra el final del registro, que es donde suele estar el fallo
+static void page10_log_show_tail(Page10Data *data)
+{
+    guint total = log_index_get_line_count(data->log_index);
+    page10_log_show_range(data, total > LOG_VIEW_CHUNK_LINES ? total - LOG_VIEW_CHUNK_LINES : 0, total);
+
+    GtkTextIter end;
+    gtk_text_buffer_get_end_iter(gtk_text_view_get_buffer(data->log_text_view), &end);
+    page10_log_scroll_to(data, &end, 1.0);
+    page10_log_update_status(data);
+}
+
+static gboolean page10_log_load_done(gpointer user_data)
 {
-    if (!data || !data->log_text_view) return;
+    LogLoadTask *task = user_data;
+    Page10Data *data = task->data;
 
-    gchar *log_path = g_build_filename(g_get_home_dir(), "install.log", NULL);
-    gchar *log_content = NULL;
+    data->log_loading = FALSE;
+    if (task->index) {
+        log_index_free(data->log_index);
+        data->log_index = task->index;
+        data->log_error_line = G_MAXUINT;
+        data->log_retry_line = G_MAXUINT;
+        data->log_search_line = 0;
+        page10_log_show_tail(data);
+    } else {
+        LOG_WARNING("No se pudo leer %s: %s", task->path, task->error_message);
+        gtk_text_buffer_set_text(gtk_text_view_get_buffer(data->log_text_view),
+                                 "(No se pudo leer el archivo de registro.)", -1);
+    }
+
+    g_free(task->error_message);
+    g_free(task->path);
+    g_free(task);
+    return G_SOURCE_REMOVE;
+}
+
+static gpointer page10_log_load_thread(gpointer user_data)
+{
+    LogLoadTask *task = user_data;
     GError *error = NULL;
 
+    task->index = log_index_new(task->path, &error);
+    if (!task->index)
+        task->error_message = g_strdup(error ? error->message : "desconocido");
+    g_clear_error(&error);
+
+    g_idle_add(page10_log_load_done, task);
+    return NULL;
+}
+
+void page10_load_log(Page10Data *data)
+{
+    if (!data || !data->log_text_view || data->log_loading) return;
+
+    // ~/install.log.gz de arcris-log, o el typescript ~/install.log sin él
+    gchar *log_path = install_log_find_latest();
+    if (!log_path) {
+        gtk_text_buffer_set_text(gtk_text_view_get_buffer(data->log_text_view),
+                                 "(No se pudo leer el archivo de registro.)", -1);
+        return;
+    }
+
+    // El índice se rehace solo si el archivo cambió desde la última vez
+    GStatBuf st;
+    if (data->log_index && g_stat(log_path, &st) == 0 &&
+        st.st_size == log_index_get_source_size(data->log_index)) {
+        page10_log_show_tail(data);
+        g_free(log_path);
+        return;
+    }
+
+    // Mapear, limpiar e indexar un registro de varios MB no bloquea la ventana
+    LogLoadTask *task = g_new0(LogLoadTask, 1);
+    task->data = data;
+    task->path = log_path;
+    data->log_loading = TRUE;
+
+    gtk_text_buffer_set_text(gtk_text_view_get_buffer(data->log_text_view),
+                             i18n_t("Cargando registro..."), -1);
+    g_thread_unref(g_thread_new("log-index", page10_log_load_thread, task));
+}
+
+// Carga perezosa al llegar a un extremo: las líneas anteriores o las siguientes,
+// descartando las del otro extremo para no pasar de LOG_VIEW_MAX_LINES
+void on_log_edge_reached(GtkScrolledWindow *scrolled, GtkPositionType pos, gpointer user_data)
+{
+    Page10Data *data = (Page10Data*)user_data;
+    if (!data || !data->log_index || data->log_loading) return;
+
     GtkTextBuffer *buffer = gtk_text_view_get_buffer(data->log_text_view);
+    GtkTextIter iter, trim;
+    gsize length = 0;
+
+    if (pos == GTK_POS_TOP && data->log_first_line > 0) {
+        guint first = data->log_first_line > LOG_VIEW_CHUNK_LINES
+                      ? data->log_first_line - LOG_VIEW_CHUNK_LINES : 0;
+        const gchar *text = log_index_get_lines(data->log_index, first, data->log_first_line, &length);
+
+        gtk_text_buffer_get_start_iter(buffer, &iter);
+        GtkTextMark *anchor = gtk_text_buffer_create_mark(buffer, NULL, &iter, FALSE);
+        gtk_text_buffer_insert(buffer, &iter, text, length);
+        data->log_first_line = first;
+
+        if (data->log_end_line - data->log_first_line > LOG_VIEW_MAX_LINES) {
+            gtk_text_buffer_get_iter_at_line(buffer, &trim, LOG_VIEW_MAX_LINES);
+            gtk_text_buffer_get_end_iter(buffer, &iter);
+            gtk_text_buffer_delete(buffer, &trim, &iter);
+            data->log_end_line = data->log_first_line + LOG_VIEW_MAX_LINES;
+        }
+
+        // Mantener a la vista la línea que se estaba leyendo
+        gtk_text_buffer_get_iter_at_mark(buffer, &iter, anchor);
+        gtk_text_buffer_delete_mark(buffer, anchor);
+        page10_log_scroll_to(data, &iter, 0.0);
+    } else if (pos == GTK_POS_BOTTOM &&
+               data->log_end_line < log_index_get_line_count(data->log_index)) {
+        guint end = data->log_end_line + LOG_VIEW_CHUNK_LINES;
+        const gchar *text = log_index_get_lines(data->log_index, data->log_end_line, end, &length);
+
+        gtk_text_buffer_get_end_iter(buffer, &iter);
+        GtkTextMark *anchor = gtk_text_buffer_create_mark(buffer, NULL, &iter, TRUE);
+        gtk_text_buffer_insert(buffer, &iter, text, length);
+        data->log_end_line = MIN(end, log_index_get_line_count(data->log_index));
 
-    if (g_file_get_contents(log_path, &log_content, NULL, &error)) {
-        gtk_text_buffer_set_text(buffer, log_content, -1);
-        g_free(log_content);
+        if (data->log_end_line - data->log_first_line > LOG_VIEW_MAX_LINES) {
+            guint excess = data->log_end_line - data->log_first_line - LOG_VIEW_MAX_LINES;
+            gtk_text_buffer_get_start_iter(buffer, &trim);
+            gtk_text_buffer_get_iter_at_line(buffer, &iter, excess);
+            gtk_text_buffer_delete(buffer, &trim, &iter);
+            data->log_first_line += excess;
+        }
+
+        gtk_text_buffer_get_iter_at_mark(buffer, &iter, anchor);
+        gtk_text_buffer_delete_mark(buffer, anchor);
+        page10_log_scroll_to(data, &iter, 1.0);
+    }
+}
+
+static void page10_log_search(Page10Data *data, guint from_line)
+{
+    const gchar *needle = gtk_editable_get_text(GTK_EDITABLE(data->log_search_entry));
+    guint line;
+    gsize line_byte;
+
+    gtk_widget_remove_css_class(GTK_WIDGET(data->log_search_entry), "error");
+    if (!data->log_index || !needle || !*needle) return;
+
+    if (log_index_find(data->log_index, needle, from_line, &line, &line_byte)) {
+        data->log_search_line = line;
+        page10_log_jump_to(data, line, line_byte, strlen(needle));
     } else {
-        gtk_text_buffer_set_text(buffer, "(No se pudo leer el archivo de registro.)", -1);
-        if (error) g_error_free(error);
+        gtk_widget_add_css_class(GTK_WIDGET(data->log_search_entry), "error");
+    }
+}
+
+void on_log_search_changed(GtkSearchEntry *entry, gpointer user_data)
+{
+    Page10Data *data = (Page10Data*)user_data;
+    if (!data) return;
+    page10_log_search(data, 0);
+}
+
+void on_log_search_next(GtkSearchEntry *entry, gpointer user_data)
+{
+    Page10Data *data = (Page10Data*)user_data;
+    if (!data) return;
+    page10_log_search(data, data->log_search_line + 1);
+}
+
+void on_log_error_button_clicked(GtkButton *button, gpointer user_data)
+{
+    Page10Data *data = (Page10Data*)user_data;
+    guint line;
+
+    if (data && log_index_next_marker(data->log_index, LOG_MARKER_ERROR, data->log_error_line, &line)) {
+        data->log_error_line = line;
+        page10_log_jump_to(data, line, 0, 0);
     }
+}
 
-    g_free(log_path);
+void on_log_retry_button_clicked(GtkButton *button, gpointer user_data)
+{
+    Page10Data *data = (Page10Data*)user_data;
+    guint line;
+
+    if (data && log_index_next_marker(data->log_index, LOG_MARKER_RETRY, data->log_retry_line, &line)) {
+        data->log_retry_line = line;
+        page10_log_jump_to(data, line, 0, 0);
+    }
 }
 
 void on_view_log_button_toggled(GtkToggleButton *button, gpointer user_data)
@@ -119,4 +400,15 @@ void page10_update_language(void)
     if (g_page10_data->view_log_button)
         gtk_button_set_label(GTK_BUTTON(g_page10_data->view_log_button),
             i18n_t("Ver registro log"));
+    if (g_page10_data->log_search_entry)
+        gtk_search_entry_set_placeholder_text(g_page10_data->log_search_entry,
+            i18n_t("Buscar en el registro"));
+    if (g_page10_data->log_error_button)
+        gtk_button_set_label(g_page10_data->log_error_button,
+            i18n_t("Siguiente error"));
+    if (g_page10_data->log_retry_button)
+        gtk_button_set_label(g_page10_data->log_retry_button,
+            i18n_t("Siguiente reintento"));
+    if (g_page10_data->log_index)
+        page10_log_update_status(g_page10_data);
 }
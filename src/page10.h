@@ -3,6 +3,7 @@
 
 #include <gtk/gtk.h>
 #include <adwaita.h>
+#include "log_index.h"
 
 typedef struct _Page10Data {
     AdwCarousel *carousel;
@@ -13,6 +14,20 @@ typedef struct _Page10Data {
     GtkToggleButton *view_log_button;
     GtkRevealer *log_revealer;
     GtkTextView *log_text_view;
+    GtkScrolledWindow *log_scrolled_window;
+    GtkSearchEntry *log_search_entry;
+    GtkButton *log_error_button;
+    GtkButton *log_retry_button;
+    GtkLabel *log_status_label;
+
+    // Registro indexado; el buffer solo tiene el tramo [log_first_line, log_end_line)
+    LogIndex *log_index;
+    gboolean log_loading;
+    guint log_first_line;
+    guint log_end_line;
+    guint log_error_line;      // última posición de cada salto (G_MAXUINT: ninguna)
+    guint log_retry_line;
+    guint log_search_line;
 } Page10Data;
 
 void page10_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *revealer);
@@ -21,6 +36,11 @@ GtkWidget* page10_get_widget(void);
 Page10Data* page10_get_data(void);
 
 void on_view_log_button_toggled(GtkToggleButton *button, gpointer user_data);
+void on_log_edge_reached(GtkScrolledWindow *scrolled, GtkPositionType pos, gpointer user_data);
+void on_log_search_changed(GtkSearchEntry *entry, gpointer user_data);
+void on_log_search_next(GtkSearchEntry *entry, gpointer user_data);
+void on_log_error_button_clicked(GtkButton *button, gpointer user_data);
+void on_log_retry_button_clicked(GtkButton *button, gpointer user_data);
 
 void page10_on_page_shown(void);
 void page10_on_page_hidden(void);
@@ -3,6 +3,7 @@
 #include "config.h"
 #include "internet.h"
 #include "i18n.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -447,6 +448,8 @@ void auto_configure_combo_rows(void)
 // Función helper para ejecutar comandos del sistema y llenar listas
 gboolean execute_system_command_to_list(const char *command, GtkStringList *list)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "%s", command);
+
     FILE *fp = popen(command, "r");
     if (fp == NULL) {
         g_warning("Failed to execute command: %s", command);
@@ -5,6 +5,9 @@
 #include "disk_manager.h"
 #include "partition_manager.h"
 #include "config.h"
+#include "trace.h"
+#include "partition_plan.h"
+#include "os_detect.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <udisks/udisks.h>
@@ -92,6 +95,8 @@ void page3_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
         if (error) g_error_free(error);
     } else {
         LOG_INFO("Cliente UDisks2 inicializado para page3");
+        /* Otros sistemas operativos para el cargador de arranque, en segundo plano */
+        os_detect_start(g_page3_data->udisks_client);
     }
 
     // Inicializar listas de particiones
@@ -843,6 +848,8 @@ void on_page3_return_disks_clicked(GtkButton *button, gpointer user_data)
 // Función para obtener el tamaño del disco
 gchar* page3_get_disk_size(const gchar *disk_path)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "lsblk size %s", disk_path ? disk_path : "(null)");
+
     if (!disk_path) return NULL;
 
     // Usar udisks2 para obtener información del disco
@@ -995,6 +1002,8 @@ void page3_clear_partitions(Page3Data *data)
 // Función para poblar particiones
 void page3_populate_partitions(Page3Data *data, const gchar *disk_path)
 {
+    TRACE_SCOPE(TRACE_CAT_UDISKS, "page3_populate_partitions");
+
     if (!data) {
         LOG_WARNING("page3_populate_partitions: data es NULL");
         return;
@@ -1565,6 +1574,9 @@ void on_partition_config_saved(PartitionConfig *config, gpointer user_data)
 static void apply_partition_mode(GString *content, gpointer user_data)
 {
     vars_upsert(content, "PARTITION_MODE", (const gchar *)user_data);
+    /* El modo manual usa particiones existentes y no lleva plan */
+    partition_plan_update_variables(content);
+    os_detect_update_variables(content);
 }
 
 void page3_save_partition_mode(const gchar *partition_mode)
@@ -1830,6 +1842,8 @@ void on_page3_configure_disk_clicked(GtkButton *button, gpointer user_data)
 // Función para obtener el tipo de tabla de particiones (GPT/MBR)
 gchar* page3_get_partition_table_type(const gchar *disk_path)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "lsblk pttype %s", disk_path ? disk_path : "(null)");
+
     if (!disk_path) return g_strdup("Desconocido");
 
     // Usar lsblk para obtener tipo de tabla de particiones
@@ -1935,6 +1949,8 @@ gchar* page3_get_partition_table_type(const gchar *disk_path)
 // Función para obtener el tipo de firmware (UEFI/BIOS Legacy)
 gchar* page3_get_firmware_type(void)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "page3_get_firmware_type");
+
     // Verificar si existe el directorio /sys/firmware/efi
     if (g_file_test("/sys/firmware/efi", G_FILE_TEST_IS_DIR)) {
         return g_strdup("UEFI");
@@ -12,6 +12,9 @@
 // Variable global para datos de la página 4
 static Page4Data *g_page4_data = NULL;
 
+// Transacción de variables.sh abierta mientras se está en la página
+static gboolean g_page4_vars_staging = FALSE;
+
 // Funciones privadas
 static void page4_connect_signals(Page4Data *data);
 
@@ -116,6 +119,8 @@ gboolean page4_initial_validation(Page4Data *data)
 // Función de limpieza
 void page4_cleanup(Page4Data *data)
 {
+    page4_on_leave();
+
     if (g_page4_data) {
         // Liberar lista de nombres reservados
         if (g_page4_data->reserved_usernames) {
@@ -607,10 +612,29 @@ void page4_on_enter(void)
         }
     }
 
+    // Lo que se escribe en los campos se guarda en una transacción que se
+    // confirma al salir de la página: una escritura en lugar de una por tecla
+    if (!g_page4_vars_staging) {
+        vars_begin();
+        g_page4_vars_staging = TRUE;
+    }
+
     // Ejecutar validación para determinar si activar el botón
     g_timeout_add(20, (GSourceFunc)page4_delayed_validation, g_page4_data);
 }
 
+void page4_on_leave(void)
+{
+    if (!g_page4_vars_staging) return;
+
+    if (g_page4_data && page4_is_form_valid(g_page4_data))
+        page4_save_user_data(g_page4_data);
+
+    g_page4_vars_staging = FALSE;
+    if (!vars_commit())
+        LOG_WARNING("No se pudieron guardar los datos del usuario en variables.sh");
+}
+
 // Función auxiliar para validación con delay
 gboolean page4_delayed_validation(Page4Data *data)
 {
@@ -631,33 +655,21 @@ gboolean page4_delayed_validation(Page4Data *data)
     return FALSE;
 }
 
-gboolean page4_save_user_data(Page4Data *data)
-{
-    if (!data) return FALSE;
-
-    const gchar *username = page4_get_username(data);
-    const gchar *password = page4_get_password(data);
-    const gchar *hostname = page4_get_hostname(data);
-
-    if (!username || !password) {
-        LOG_ERROR("Datos de usuario incompletos");
-        return FALSE;
-    }
-
-    // Leer el archivo existente
-    gchar *file_content = NULL;
-    gsize file_size = 0;
-    GError *error = NULL;
+typedef struct {
+    const gchar *username;
+    const gchar *password;
+    const gchar *hostname;
+} Page4UserVars;
 
-    if (!g_file_get_contents("data/bash/variables.sh", &file_content, &file_size, &error)) {
-        LOG_WARNING("No se pudo leer variables.sh existente: %s", error ? error->message : "Error desconocido");
-        g_clear_error(&error);
-        file_content = g_strdup("#!/bin/bash\n# Variables de configuración generadas por Arcris\n# Archivo generado automáticamente - No editar manualmente\n\n");
-    }
+static void apply_user_data(GString *content, gpointer user_data)
+{
+    const Page4UserVars *vars = user_data;
+    const gchar *username = vars->username;
+    const gchar *password = vars->password;
+    const gchar *hostname = vars->hostname;
 
     // Dividir el contenido en líneas
-    gchar **lines = g_strsplit(file_content, "\n", -1);
-    g_free(file_content);
+    gchar **lines = g_strsplit(content->str, "\n", -1);
 
     // Variables para rastrear si ya existen
     gboolean user_found = FALSE;
@@ -665,12 +677,6 @@ gboolean page4_save_user_data(Page4Data *data)
     gboolean password_root_found = FALSE;
     gboolean hostname_found = FALSE;
 
-    // Variables para preservar drivers de hardware
-    gchar *driver_video_value = NULL;
-    gchar *driver_audio_value = NULL;
-    gchar *driver_wifi_value = NULL;
-    gchar *driver_bluetooth_value = NULL;
-
     // Crear nuevo contenido
     GString *new_content = g_string_new("");
 
@@ -745,48 +751,35 @@ gboolean page4_save_user_data(Page4Data *data)
         }
     }
 
-    // Añadir variables de drivers preservadas si existen
-    if (driver_video_value || driver_audio_value || driver_wifi_value || driver_bluetooth_value) {
-        // Si tenemos variables de drivers preservadas, agregarlas
-        if (!last_line_empty) {
-            g_string_append_c(new_content, '\n');
-        }
+    g_string_assign(content, new_content->str);
+    g_string_free(new_content, TRUE);
+    g_strfreev(lines);
+}
 
-        if (driver_video_value) {
-            g_string_append_printf(new_content, "%s\n", driver_video_value);
-        }
-        if (driver_audio_value) {
-            g_string_append_printf(new_content, "%s\n", driver_audio_value);
-        }
-        if (driver_wifi_value) {
-            g_string_append_printf(new_content, "%s\n", driver_wifi_value);
-        }
-        if (driver_bluetooth_value) {
-            g_string_append_printf(new_content, "%s\n", driver_bluetooth_value);
-        }
+gboolean page4_save_user_data(Page4Data *data)
+{
+    if (!data) return FALSE;
+
+    Page4UserVars vars = {
+        page4_get_username(data),
+        page4_get_password(data),
+        page4_get_hostname(data),
+    };
+
+    if (!vars.username || !vars.password) {
+        LOG_ERROR("Datos de usuario incompletos");
+        return FALSE;
     }
 
-    // Escribir el archivo actualizado
-    vars_trim_trailing_newlines(new_content);
-    if (!g_file_set_contents("data/bash/variables.sh", new_content->str, -1, &error)) {
-        LOG_ERROR("Error al escribir variables.sh: %s", error ? error->message : "Error desconocido");
-        g_clear_error(&error);
-        g_strfreev(lines);
-        g_string_free(new_content, TRUE);
+    // Mientras se está en la página solo se prepara el cambio; se escribe al salir
+    if (!vars_update(apply_user_data, &vars)) {
+        LOG_ERROR("Error al guardar los datos del usuario en variables.sh");
         return FALSE;
     }
 
-    // Limpiar memoria
-    g_strfreev(lines);
-    g_string_free(new_content, TRUE);
-    g_free(driver_video_value);
-    g_free(driver_audio_value);
-    g_free(driver_wifi_value);
-    g_free(driver_bluetooth_value);
-
-    LOG_INFO("Datos del usuario guardados correctamente en data/bash/variables.sh");
-    LOG_INFO("Usuario: %s", username);
-    LOG_INFO("Hostname: %s", hostname ? hostname : "arcris");
+    LOG_INFO("Datos del usuario guardados en variables.sh");
+    LOG_INFO("Usuario: %s", vars.username);
+    LOG_INFO("Hostname: %s", vars.hostname ? vars.hostname : "arcris");
 
     return TRUE;
 }
@@ -52,6 +52,7 @@ gboolean page4_go_to_next_page(Page4Data *data);
 gboolean page4_go_to_previous_page(Page4Data *data);
 gboolean page4_is_installation_complete(void);
 void page4_on_enter(void);
+void page4_on_leave(void);
 gboolean page4_delayed_validation(Page4Data *data);
 
 
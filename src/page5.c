@@ -78,6 +78,7 @@ static const char* WM_IMAGE_RESOURCES[] = {
 // Declaración forward de funciones
 static gboolean page5_save_installation_type_variable(InstallationType type);
 static gboolean page5_remove_variable_from_config(const char* variable_name);
+static void page5_save_installation_type(InstallationType type);
 
 // Función de debugging para verificar que las imágenes se carguen correctamente
 static void page5_debug_check_image_resources(void)
@@ -295,12 +296,9 @@ void page5_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
     // Programar prueba de imágenes para después de que la UI esté completamente cargada
     g_timeout_add(500, page5_test_images_loaded, g_page5_data);
 
-    // Guardar el tipo de instalación por defecto (TERMINAL) al iniciar
-    page5_save_installation_type_variable(INSTALL_TYPE_TERMINAL);
-
-    // Limpiar variables DE y WM al iniciar en modo TERMINAL (son mutuamente excluyentes)
-    page5_remove_variable_from_config("DESKTOP_ENVIRONMENT");
-    page5_remove_variable_from_config("WINDOW_MANAGER");
+    // Guardar el tipo de instalación por defecto (TERMINAL) al iniciar,
+    // sin variables DE y WM (son mutuamente excluyentes)
+    page5_save_installation_type(INSTALL_TYPE_TERMINAL);
 
     // Liberar el builder de la página
     g_object_unref(page_builder);
@@ -468,199 +466,134 @@ static GtkWidget* page5_get_next_button(Page5Data *data)
     return GTK_WIDGET(data->next_button);
 }
 
+typedef struct {
+    const gchar *name;
+    const gchar *value;
+    const gchar *after_name;
+} Page5Var;
+
+static void apply_page5_var(GString *content, gpointer user_data)
+{
+    const Page5Var *var = user_data;
+    if (var->after_name)
+        vars_upsert_after(content, var->name, var->value, var->after_name);
+    else
+        vars_upsert(content, var->name, var->value);
+}
+
 // Función auxiliar para guardar variable DE en el archivo de configuración
 static gboolean page5_save_de_variable(DesktopEnvironmentType de)
 {
-    GError *error = NULL;
-    gchar *config_content = NULL;
-    const gchar *config_path = "data/bash/variables.sh";
-
-    if (!g_file_get_contents(config_path, &config_content, NULL, &error)) {
-        LOG_ERROR("Error al leer archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-
     /* Orden exacto del enum DesktopEnvironmentType en page5.h */
     static const char *de_names[] = {
         "GNOME", "KDE", "XFCE4", "BUDGIE", "CINNAMON", "LXDE", "LXQT",
         "COSMIC", "MATE", "CUTEFISH", "UKUI", "PANTHEON", "ENLIGHTENMENT"
     };
-    gchar *de_name = g_strdup(de < (int)(sizeof(de_names)/sizeof(de_names[0])) ? de_names[de] : "GNOME");
-
-    GString *content = g_string_new(config_content);
-    g_free(config_content);
-
-    vars_upsert_after(content, "DESKTOP_ENVIRONMENT", de_name, "INSTALLATION_TYPE");
-    vars_trim_trailing_newlines(content);
-    gboolean success = g_file_set_contents(config_path, content->str, -1, &error);
-    if (error) {
-        LOG_ERROR("Error al guardar variable DE: %s", error->message);
-        g_error_free(error);
-        success = FALSE;
-    } else {
-        LOG_INFO("Variable DE guardada: %s", de_name);
-    }
+    const gchar *de_name = de < (int)(sizeof(de_names)/sizeof(de_names[0])) ? de_names[de] : "GNOME";
 
-    g_string_free(content, TRUE);
-    g_free(de_name);
+    Page5Var var = { "DESKTOP_ENVIRONMENT", de_name, "INSTALLATION_TYPE" };
+    gboolean success = vars_update(apply_page5_var, &var);
+    if (success)
+        LOG_INFO("Variable DE guardada: %s", de_name);
+    else
+        LOG_ERROR("Error al guardar variable DE");
     return success;
 }
 
 static gboolean page5_save_wm_variable(WindowManagerType wm)
 {
-    GError *error = NULL;
-    gchar *config_content = NULL;
-    const gchar *config_path = "data/bash/variables.sh";
-
-    if (!g_file_get_contents(config_path, &config_content, NULL, &error)) {
-        LOG_ERROR("Error al leer archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-
     /* Orden exacto del enum WindowManagerType en page5.h */
     static const char *wm_names[] = {
         "HYPRLAND", "NIRI", "SWAY", "MANGO", "DWL", "DWM", "I3WM",
         "BSPWM", "QTITLE", "AWESOME", "XMONAD", "OPENBOX"
     };
-    gchar *wm_name = g_strdup(wm < (int)(sizeof(wm_names)/sizeof(wm_names[0])) ? wm_names[wm] : "HYPRLAND");
-
-    GString *content = g_string_new(config_content);
-    g_free(config_content);
-
-    vars_upsert_after(content, "WINDOW_MANAGER", wm_name, "INSTALLATION_TYPE");
-    vars_trim_trailing_newlines(content);
-    gboolean success = g_file_set_contents(config_path, content->str, -1, &error);
-    if (error) {
-        LOG_ERROR("Error al guardar variable WM: %s", error->message);
-        g_error_free(error);
-        success = FALSE;
-    } else {
-        LOG_INFO("Variable WM guardada: %s", wm_name);
-    }
+    const gchar *wm_name = wm < (int)(sizeof(wm_names)/sizeof(wm_names[0])) ? wm_names[wm] : "HYPRLAND";
 
-    g_string_free(content, TRUE);
-    g_free(wm_name);
+    Page5Var var = { "WINDOW_MANAGER", wm_name, "INSTALLATION_TYPE" };
+    gboolean success = vars_update(apply_page5_var, &var);
+    if (success)
+        LOG_INFO("Variable WM guardada: %s", wm_name);
+    else
+        LOG_ERROR("Error al guardar variable WM");
     return success;
 }
 
 static gboolean page5_save_installation_type_variable(InstallationType type)
 {
-    GError *error = NULL;
-    gchar *config_content = NULL;
-    const gchar *config_path = "data/bash/variables.sh";
-
-    if (!g_file_get_contents(config_path, &config_content, NULL, &error)) {
-        LOG_ERROR("Error al leer archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-
     static const char *type_names[] = { "TERMINAL", "DESKTOP", "WINDOW_MANAGER" };
-    gchar *type_name = g_strdup(type < (int)(sizeof(type_names)/sizeof(type_names[0])) ? type_names[type] : "TERMINAL");
-
-    GString *content = g_string_new(config_content);
-    g_free(config_content);
-
-    vars_upsert(content, "INSTALLATION_TYPE", type_name);
-    vars_trim_trailing_newlines(content);
-    gboolean success = g_file_set_contents(config_path, content->str, -1, &error);
-    if (error) {
-        LOG_ERROR("Error al guardar tipo de instalación: %s", error->message);
-        g_error_free(error);
-        success = FALSE;
-    } else {
-        LOG_INFO("Tipo de instalación guardado: %s", type_name);
-    }
+    const gchar *type_name = type < (int)(sizeof(type_names)/sizeof(type_names[0])) ? type_names[type] : "TERMINAL";
 
-    g_string_free(content, TRUE);
-    g_free(type_name);
+    Page5Var var = { "INSTALLATION_TYPE", type_name, NULL };
+    gboolean success = vars_update(apply_page5_var, &var);
+    if (success)
+        LOG_INFO("Tipo de instalación guardado: %s", type_name);
+    else
+        LOG_ERROR("Error al guardar tipo de instalación");
     return success;
 }
 
-static gboolean page5_remove_variable_from_config(const char* variable_name)
+// Quita NAME= y su comentario "# Variable DE/WM seleccionada"
+static void apply_page5_remove(GString *content, gpointer user_data)
 {
-    GError *error = NULL;
-    gchar *config_content = NULL;
-    const gchar *config_path = "data/bash/variables.sh";
-
-    LOG_INFO("=== Iniciando eliminación de variable: %s ===", variable_name);
-
-    // Leer el archivo actual
-    if (!g_file_get_contents(config_path, &config_content, NULL, &error)) {
-        LOG_ERROR("Error al leer archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-
-    LOG_INFO("Archivo leído exitosamente, tamaño: %lu caracteres", strlen(config_content));
-
-    // Buscar y eliminar la variable especificada
-    gchar **lines = g_strsplit(config_content, "\n", -1);
+    const gchar *variable_name = user_data;
+    gchar **lines = g_strsplit(content->str, "\n", -1);
     GString *new_content = g_string_new("");
     gboolean found = FALSE;
-    int total_lines = 0;
-
-    // Contar líneas totales
-    while (lines[total_lines] != NULL) total_lines++;
 
-    // Crear el patrón a buscar
     gchar *variable_pattern = g_strdup_printf("%s=", variable_name);
     gchar *comment_pattern = g_strdup_printf("# Variable %s seleccionada",
                                             g_str_has_prefix(variable_name, "DESKTOP") ? "DE" :
                                             g_str_has_prefix(variable_name, "WINDOW") ? "WM" : "");
 
-    LOG_INFO("Buscando patrón: '%s'", variable_pattern);
-    LOG_INFO("Buscando comentario: '%s'", comment_pattern);
-
     for (int i = 0; lines[i] != NULL; i++) {
         if (g_str_has_prefix(lines[i], variable_pattern)) {
             // Omitir la línea de la variable
             found = TRUE;
-            LOG_INFO("¡Variable %s encontrada en línea %d y eliminada! Contenido: '%s'", variable_name, i, lines[i]);
+            LOG_INFO("Variable %s eliminada (línea %d): '%s'", variable_name, i, lines[i]);
             continue;
         } else if (strlen(comment_pattern) > 0 && g_str_has_prefix(lines[i], comment_pattern)) {
             // Omitir el comentario asociado
-            LOG_INFO("Comentario asociado eliminado en línea %d: '%s'", i, lines[i]);
             continue;
-        } else {
-            // Mantener la línea original
-            g_string_append(new_content, lines[i]);
-            if (lines[i + 1] != NULL) {
-                g_string_append_c(new_content, '\n');
-            }
         }
+        g_string_append(new_content, lines[i]);
+        if (lines[i + 1] != NULL)
+            g_string_append_c(new_content, '\n');
     }
 
-    // Escribir el nuevo contenido solo si se encontró la variable
-    gboolean success = TRUE;
-    if (found) {
-        LOG_INFO("Escribiendo archivo actualizado sin la variable %s", variable_name);
-        vars_trim_trailing_newlines(new_content);
-        success = g_file_set_contents(config_path, new_content->str, -1, &error);
-
-        if (error) {
-            LOG_ERROR("Error al eliminar variable %s: %s", variable_name, error->message);
-            g_error_free(error);
-            success = FALSE;
-        } else {
-            LOG_INFO("✅ Variable %s eliminada exitosamente del archivo", variable_name);
-        }
-    } else {
-        LOG_INFO("⚠️ Variable %s no encontrada en el archivo (puede que ya no exista)", variable_name);
-    }
+    // Sin la variable el contenido queda igual y no hay nada que escribir
+    if (found)
+        g_string_assign(content, new_content->str);
 
     g_strfreev(lines);
     g_string_free(new_content, TRUE);
-    g_free(config_content);
     g_free(variable_pattern);
     g_free(comment_pattern);
+}
 
-    LOG_INFO("=== Finalizada eliminación de variable: %s (éxito: %s) ===", variable_name, success ? "SÍ" : "NO");
+static gboolean page5_remove_variable_from_config(const char* variable_name)
+{
+    gboolean success = vars_update(apply_page5_remove, (gpointer)variable_name);
+    if (!success)
+        LOG_ERROR("Error al eliminar variable %s", variable_name);
     return success;
 }
 
+// Tipo de instalación más la limpieza de DE/WM en una sola escritura
+static void page5_save_installation_type(InstallationType type)
+{
+    vars_begin();
+    page5_save_installation_type_variable(type);
+
+    // DE y WM son mutuamente excluyentes
+    if (type != INSTALL_TYPE_DESKTOP)
+        page5_remove_variable_from_config("DESKTOP_ENVIRONMENT");
+    if (type != INSTALL_TYPE_WINDOW_MANAGER)
+        page5_remove_variable_from_config("WINDOW_MANAGER");
+
+    if (!vars_commit())
+        LOG_WARNING("No se pudo guardar el tipo de instalación en variables.sh");
+}
+
 // Función para actualizar el estado de los botones go-next-symbolic
 void page5_update_next_buttons_state(Page5Data *data)
 {
@@ -808,12 +741,8 @@ void on_page5_terminal_check_toggled(GtkCheckButton *check, gpointer user_data)
     if (gtk_check_button_get_active(check)) {
         page5_set_installation_type(data, INSTALL_TYPE_TERMINAL);
 
-        // Guardar el tipo de instalación en variables.sh
-        page5_save_installation_type_variable(INSTALL_TYPE_TERMINAL);
-
-        // Limpiar variables DE y WM en modo TERMINAL (son mutuamente excluyentes)
-        page5_remove_variable_from_config("DESKTOP_ENVIRONMENT");
-        page5_remove_variable_from_config("WINDOW_MANAGER");
+        // Guardar el tipo de instalación y limpiar DE y WM en variables.sh
+        page5_save_installation_type(INSTALL_TYPE_TERMINAL);
 
         // Activar el botón siguiente del GtkRevealer
         GtkWidget *next_button = page5_get_next_button(data);
@@ -834,11 +763,8 @@ void on_page5_desktop_check_toggled(GtkCheckButton *check, gpointer user_data)
     if (gtk_check_button_get_active(check)) {
         page5_set_installation_type(data, INSTALL_TYPE_DESKTOP);
 
-        // Guardar el tipo de instalación en variables.sh
-        page5_save_installation_type_variable(INSTALL_TYPE_DESKTOP);
-
-        // Eliminar variable WINDOW_MANAGER si existe (son mutuamente excluyentes)
-        page5_remove_variable_from_config("WINDOW_MANAGER");
+        // Guardar el tipo de instalación y eliminar WINDOW_MANAGER en variables.sh
+        page5_save_installation_type(INSTALL_TYPE_DESKTOP);
 
         // Desactivar el botón siguiente del GtkRevealer
         GtkWidget *next_button = page5_get_next_button(data);
@@ -859,11 +785,8 @@ void on_page5_wm_check_toggled(GtkCheckButton *check, gpointer user_data)
     if (gtk_check_button_get_active(check)) {
         page5_set_installation_type(data, INSTALL_TYPE_WINDOW_MANAGER);
 
-        // Guardar el tipo de instalación en variables.sh
-        page5_save_installation_type_variable(INSTALL_TYPE_WINDOW_MANAGER);
-
-        // Eliminar variable DESKTOP_ENVIRONMENT si existe (son mutuamente excluyentes)
-        page5_remove_variable_from_config("DESKTOP_ENVIRONMENT");
+        // Guardar el tipo de instalación y eliminar DESKTOP_ENVIRONMENT en variables.sh
+        page5_save_installation_type(INSTALL_TYPE_WINDOW_MANAGER);
 
         // Desactivar el botón siguiente del GtkRevealer
         GtkWidget *next_button = page5_get_next_button(data);
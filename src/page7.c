@@ -2,6 +2,8 @@
 #include "page8.h"
 #include "config.h"
 #include "i18n.h"
+#include "trace.h"
+#include "performance_profile.h"
 #include <stdio.h>
 
 #include <string.h>
@@ -65,6 +67,7 @@ void page7_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
     g_page7_data->driver_bluetooth_row = ADW_ACTION_ROW(gtk_builder_get_object(page_builder, "driver_bluetooth_row"));
     
     g_page7_data->aplicaciones_base_row = ADW_ACTION_ROW(gtk_builder_get_object(page_builder, "aplicaciones_base_row"));
+    g_page7_data->rendimiento_row = ADW_ACTION_ROW(gtk_builder_get_object(page_builder, "rendimiento_row"));
     g_page7_data->utilidades_row = ADW_ACTION_ROW(gtk_builder_get_object(page_builder, "utilidades_row"));
     g_page7_data->programas_extras_row = ADW_ACTION_ROW(gtk_builder_get_object(page_builder, "programas_extras_row"));
     
@@ -89,6 +92,7 @@ void page7_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
     g_page7_data->edit_kernel_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_kernel_button"));
     g_page7_data->edit_drivers_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_drivers_button"));
     g_page7_data->edit_aplicaciones_base_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_aplicaciones_base_button"));
+    g_page7_data->edit_rendimiento_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_rendimiento_button"));
     g_page7_data->edit_utilidades_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_utilidades_button"));
     g_page7_data->edit_programas_extras_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "edit_programas_extras_button"));
     
@@ -177,6 +181,10 @@ void page7_setup_widgets(Page7Data *data)
                      G_CALLBACK(on_edit_drivers_button_clicked), data);
     g_signal_connect(data->edit_aplicaciones_base_button, "clicked", 
                      G_CALLBACK(on_edit_aplicaciones_base_button_clicked), data);
+    /* El perfil de rendimiento se edita en la ventana de aplicaciones base (página 6) */
+    if (data->edit_rendimiento_button)
+        g_signal_connect(data->edit_rendimiento_button, "clicked",
+                         G_CALLBACK(on_edit_aplicaciones_base_button_clicked), data);
     g_signal_connect(data->edit_utilidades_button, "clicked", 
                      G_CALLBACK(on_edit_utilidades_button_clicked), data);
     g_signal_connect(data->edit_programas_extras_button, "clicked", 
@@ -369,8 +377,29 @@ void page7_load_sistema_data(Page7Data *data)
     
     // Cargar kernel
     gchar *kernel = page7_read_variable_from_file("SELECTED_KERNEL");
-    const gchar *kernel_info = kernel ? kernel : "linux (por defecto)";
+    gchar *bootloader = page7_read_variable_from_file("BOOTLOADER");
+    gchar *kernel_info = g_strcmp0(bootloader, "systemd-boot") == 0
+        ? g_strdup_printf("%s • systemd-boot + UKI", kernel ? kernel : "linux")
+        : g_strdup(kernel ? kernel : "linux (por defecto)");
+
+    // Perfil de initramfs solo si no es el de Arch
+    gchar *initramfs_profile = page7_read_variable_from_file("INITRAMFS_PROFILE");
+    gchar *initramfs_fallback = page7_read_variable_from_file("INITRAMFS_FALLBACK");
+    if (initramfs_profile && g_strcmp0(initramfs_profile, "default") != 0) {
+        gchar *with_profile = g_strdup_printf("%s • initramfs %s", kernel_info, initramfs_profile);
+        g_free(kernel_info);
+        kernel_info = with_profile;
+    }
+    if (g_strcmp0(initramfs_fallback, "false") == 0) {
+        gchar *without_fallback = g_strdup_printf("%s • %s", kernel_info, i18n_t("sin fallback"));
+        g_free(kernel_info);
+        kernel_info = without_fallback;
+    }
     adw_action_row_set_subtitle(data->kernel_row, kernel_info);
+    g_free(kernel_info);
+    g_free(bootloader);
+    g_free(initramfs_profile);
+    g_free(initramfs_fallback);
     
     // Cargar información de drivers (subtitle simplificado)
     adw_expander_row_set_subtitle(data->drivers_expander, "Video | Audio | WiFi | Bluetooth");
@@ -385,6 +414,14 @@ void page7_load_sistema_data(Page7Data *data)
         essential_apps ? i18n_t("Habilitadas")
                        : i18n_t("Deshabilitadas"));
 
+    // Cargar perfil de rendimiento
+    if (data->rendimiento_row) {
+        gchar *performance = page7_read_variable_from_file("PERFORMANCE_PROFILE");
+        adw_action_row_set_subtitle(data->rendimiento_row,
+            perf_profile_label(perf_profile_from_id(performance)));
+        g_free(performance);
+    }
+
     // Cargar utilidades
     gchar *utilities_str = page7_read_variable_from_file("UTILITIES_ENABLED");
     gboolean utilities = utilities_str && g_strcmp0(utilities_str, "true") == 0;
@@ -814,6 +851,8 @@ gchar* page7_read_variable_from_file(const gchar* variable_name)
 // Función para obtener el tamaño del disco
 gchar* page7_get_disk_size(const gchar* disk_path)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "lsblk size %s", disk_path ? disk_path : "(null)");
+
     if (!disk_path) return NULL;
     
     // Comando para obtener el tamaño del disco
@@ -1275,6 +1314,9 @@ void page7_update_language(void)
     if (g_page7_data->aplicaciones_base_row)
         adw_preferences_row_set_title(ADW_PREFERENCES_ROW(g_page7_data->aplicaciones_base_row),
             i18n_t("Aplicaciones Base"));
+    if (g_page7_data->rendimiento_row)
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(g_page7_data->rendimiento_row),
+            i18n_t("Perfil de rendimiento"));
     if (g_page7_data->utilidades_row)
         adw_preferences_row_set_title(ADW_PREFERENCES_ROW(g_page7_data->utilidades_row),
             i18n_t("Programas de Utilidades"));
@@ -1325,6 +1367,9 @@ void page7_update_language(void)
     if (g_page7_data->edit_aplicaciones_base_button)
         gtk_widget_set_tooltip_text(GTK_WIDGET(g_page7_data->edit_aplicaciones_base_button),
             i18n_t("Configurar aplicaciones base"));
+    if (g_page7_data->edit_rendimiento_button)
+        gtk_widget_set_tooltip_text(GTK_WIDGET(g_page7_data->edit_rendimiento_button),
+            i18n_t("Cambiar perfil de rendimiento"));
     if (g_page7_data->edit_utilidades_button)
         gtk_widget_set_tooltip_text(GTK_WIDGET(g_page7_data->edit_utilidades_button),
             i18n_t("Configurar programas de utilidades"));
@@ -48,6 +48,7 @@ typedef struct _Page7Data {
     AdwActionRow *driver_bluetooth_row;
     
     AdwActionRow *aplicaciones_base_row;
+    AdwActionRow *rendimiento_row;
     AdwActionRow *utilidades_row;
     AdwActionRow *programas_extras_row;
     
@@ -72,6 +73,7 @@ typedef struct _Page7Data {
     GtkButton *edit_kernel_button;
     GtkButton *edit_drivers_button;
     GtkButton *edit_aplicaciones_base_button;
+    GtkButton *edit_rendimiento_button;
     GtkButton *edit_utilidades_button;
     GtkButton *edit_programas_extras_button;
     
@@ -3,6 +3,11 @@
 #include "page10.h"
 #include "config.h"
 #include "i18n.h"
+#include "wipe_strategy.h"
+#include "install_log.h"
+#include "install_targets.h"
+#include "install_timing.h"
+#include "variables_utils.h"
 #include <glib/gstdio.h>
 #include <vte/vte.h>
 
@@ -11,9 +16,17 @@ static Page8Data *g_page8_data = NULL;
 
 // Constantes
 #define CAROUSEL_ADVANCE_INTERVAL 4000 // 4 segundos en milisegundos
+// Historial de la terminal; el registro completo lo guarda arcris-log en disco
+#define PAGE8_SCROLLBACK_LINES 1000
+// Escala mínima de las gráficas de red y disco, para que el reposo se vea plano
+#define PAGE8_SPARKLINE_MIN_RATE (64.0 * 1024)
 
 // Forward declarations
 static gboolean page8_navigate_to_completion(Page8Data *data);
+static void page8_stop_wipe_progress(Page8Data *data);
+static void page8_stop_proc_monitor(Page8Data *data);
+static void page8_stop_targets(Page8Data *data);
+static void page8_draw_sparkline(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data);
 #define TOTAL_CAROUSEL_IMAGES 4
 
 Page8Data* page8_new(void)
@@ -27,6 +40,8 @@ Page8Data* page8_new(void)
     data->current_image_index = 0;
     data->total_images = TOTAL_CAROUSEL_IMAGES;
     data->progress_bar_timeout_id = 0;
+    data->wipe_progress_timeout_id = 0;
+    data->wipe_progress_active = FALSE;
     data->is_installing = FALSE;
     data->carousel_auto_advance = FALSE;
     data->terminal_visible = FALSE;
@@ -135,6 +150,26 @@ void page8_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
     g_page8_data->install_title = GTK_LABEL(gtk_builder_get_object(page_builder, "install_title"));
     g_page8_data->carousel_info = GTK_LABEL(gtk_builder_get_object(page_builder, "carousel_info"));
     g_page8_data->progress_bar = GTK_PROGRESS_BAR(gtk_builder_get_object(page_builder, "progress_bar"));
+    g_page8_data->targets_list = GTK_LIST_BOX(gtk_builder_get_object(page_builder, "targets_list"));
+
+    // Gráficas de consumo junto a la barra de progreso
+    static const gchar *const resource_ids[PROC_METRIC_COUNT] = {
+        [PROC_METRIC_CPU] = "cpu", [PROC_METRIC_DISK] = "disk", [PROC_METRIC_NET] = "net"
+    };
+    g_page8_data->resource_box = GTK_WIDGET(gtk_builder_get_object(page_builder, "resource_box"));
+    for (int m = 0; m < PROC_METRIC_COUNT; m++) {
+        gchar *sparkline_id = g_strdup_printf("%s_sparkline", resource_ids[m]);
+        gchar *label_id = g_strdup_printf("%s_label", resource_ids[m]);
+        g_page8_data->sparklines[m] = GTK_DRAWING_AREA(gtk_builder_get_object(page_builder, sparkline_id));
+        g_page8_data->resource_labels[m] = GTK_LABEL(gtk_builder_get_object(page_builder, label_id));
+        if (g_page8_data->sparklines[m]) {
+            g_object_set_data(G_OBJECT(g_page8_data->sparklines[m]), "metric", GINT_TO_POINTER(m));
+            gtk_drawing_area_set_draw_func(g_page8_data->sparklines[m], page8_draw_sparkline,
+                                           g_page8_data, NULL);
+        }
+        g_free(sparkline_id);
+        g_free(label_id);
+    }
 
     // Obtener widgets de terminal
     g_page8_data->vte_terminal = VTE_TERMINAL(gtk_builder_get_object(page_builder, "vte_terminal"));
@@ -191,9 +226,12 @@ void page8_cleanup(Page8Data *data)
 
     // Detener el timer del progress bar
     page8_stop_progress_bar_pulse(data);
+    page8_stop_wipe_progress(data);
 
     // Detener instalación si está en progreso
     page8_stop_installation(data);
+    page8_stop_proc_monitor(data);
+    page8_stop_targets(data);
 
     // Liberar memoria
     g_free(data);
@@ -274,10 +312,176 @@ static gboolean page8_progress_bar_pulse_callback(gpointer user_data)
     Page8Data *data = (Page8Data*)user_data;
     if (!data || !data->progress_bar) return G_SOURCE_REMOVE;
 
-    gtk_progress_bar_pulse(data->progress_bar);
+    // Durante el borrado completo la barra muestra el porcentaje real
+    if (!data->wipe_progress_active)
+        gtk_progress_bar_pulse(data->progress_bar);
+    return G_SOURCE_CONTINUE;
+}
+
+// Progreso del borrado completo del disco: config_disk.sh escribe el
+// porcentaje en WIPE_PROGRESS_PATH y lo borra al terminar
+static gboolean page8_wipe_progress_callback(gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    if (!data || !data->progress_bar) {
+        if (data) data->wipe_progress_timeout_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    gdouble fraction = 0.0;
+    gboolean active = wipe_progress_read(&fraction);
+
+    if (active) {
+        gchar *text = g_strdup_printf("%s: %d %%", i18n_t("Borrando el disco"), (int)(fraction * 100));
+        gtk_progress_bar_set_fraction(data->progress_bar, fraction);
+        gtk_progress_bar_set_text(data->progress_bar, text);
+        gtk_progress_bar_set_show_text(data->progress_bar, TRUE);
+        g_free(text);
+    } else if (data->wipe_progress_active) {
+        // Borrado terminado: la barra vuelve a la animación indeterminada
+        LOG_INFO("Borrado completo del disco terminado");
+        gtk_progress_bar_set_show_text(data->progress_bar, FALSE);
+        data->wipe_progress_active = FALSE;
+        data->wipe_progress_timeout_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    data->wipe_progress_active = active;
+    return G_SOURCE_CONTINUE;
+}
+
+static void page8_stop_wipe_progress(Page8Data *data)
+{
+    if (!data || data->wipe_progress_timeout_id == 0) return;
+
+    g_source_remove(data->wipe_progress_timeout_id);
+    data->wipe_progress_timeout_id = 0;
+    data->wipe_progress_active = FALSE;
+}
+
+// Texto bajo cada gráfica ("Red 2,4 MB/s", "CPU 35 %") y detalle en el tooltip
+static void page8_update_resource_labels(Page8Data *data)
+{
+    static const gchar *const names[PROC_METRIC_COUNT] = {
+        [PROC_METRIC_CPU] = "CPU", [PROC_METRIC_DISK] = "Disco", [PROC_METRIC_NET] = "Red"
+    };
+
+    for (int m = 0; m < PROC_METRIC_COUNT; m++) {
+        if (!data->resource_labels[m]) continue;
+
+        gdouble value = proc_monitor_get_current(data->proc_monitor, m);
+        gchar *text;
+        if (m == PROC_METRIC_CPU) {
+            text = g_strdup_printf("%s %.0f %%", i18n_t(names[m]), value);
+        } else {
+            gchar *rate = g_format_size((guint64)value);
+            text = g_strdup_printf("%s %s/s", i18n_t(names[m]), rate);
+            g_free(rate);
+        }
+        gtk_label_set_text(data->resource_labels[m], text);
+        g_free(text);
+    }
+
+    if (data->resource_box) {
+        gchar *rss = g_format_size(proc_monitor_get_rss(data->proc_monitor));
+        gchar *tooltip = g_strdup_printf("%s\n%s: %s", i18n_t("Consumo de la instalación (últimos 60 s)"),
+                                         i18n_t("Memoria"), rss);
+        gtk_widget_set_tooltip_text(data->resource_box, tooltip);
+        g_free(tooltip);
+        g_free(rss);
+    }
+}
+
+// Gráfica de las últimas muestras, la más reciente a la derecha
+static void page8_draw_sparkline(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    ProcMetric metric = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(area), "metric"));
+    guint count = 0;
+    const gdouble *values = proc_monitor_get_history(data ? data->proc_monitor : NULL, metric, &count);
+    if (count < 2) return;
+
+    // CPU en escala fija; red y disco relativos al máximo visible
+    gdouble top = metric == PROC_METRIC_CPU ? 100.0 : PAGE8_SPARKLINE_MIN_RATE;
+    if (metric != PROC_METRIC_CPU) {
+        for (guint i = 0; i < count; i++)
+            top = MAX(top, values[i]);
+    }
+
+    GdkRGBA color;
+    gtk_widget_get_color(GTK_WIDGET(area), &color);
+
+    gdouble step = (gdouble)width / (PROC_MONITOR_HISTORY - 1);
+    gdouble x0 = width - (count - 1) * step;
+    for (guint i = 0; i < count; i++) {
+        gdouble y = height - 1 - MIN(values[i] / top, 1.0) * (height - 2);
+        if (i == 0)
+            cairo_move_to(cr, x0, y);
+        else
+            cairo_line_to(cr, x0 + i * step, y);
+    }
+
+    cairo_set_line_width(cr, 1.5);
+    cairo_set_source_rgba(cr, color.red, color.green, color.blue, color.alpha);
+    cairo_stroke_preserve(cr);
+
+    cairo_line_to(cr, width, height);
+    cairo_line_to(cr, x0, height);
+    cairo_close_path(cr);
+    cairo_set_source_rgba(cr, color.red, color.green, color.blue, color.alpha * 0.2);
+    cairo_fill(cr);
+}
+
+static gboolean page8_proc_monitor_callback(gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    if (!data || !data->proc_monitor) {
+        if (data) data->proc_monitor_timeout_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    // Las gráficas se quedan con las últimas muestras al terminar el script
+    if (!proc_monitor_sample(data->proc_monitor)) {
+        LOG_INFO("El proceso de instalación terminó, fin del muestreo de recursos");
+        data->proc_monitor_timeout_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    page8_update_resource_labels(data);
+    for (int m = 0; m < PROC_METRIC_COUNT; m++) {
+        if (data->sparklines[m])
+            gtk_widget_queue_draw(GTK_WIDGET(data->sparklines[m]));
+    }
     return G_SOURCE_CONTINUE;
 }
 
+// Empieza a medir el árbol de procesos que cuelga de pid (script → install.sh)
+static void page8_start_proc_monitor(Page8Data *data, GPid pid)
+{
+    page8_stop_proc_monitor(data);
+
+    LOG_INFO("Midiendo recursos del árbol de procesos de la instalación (PID %d)", pid);
+    GString *content = vars_read();
+    gchar *disk = content ? vars_get(content, "SELECTED_DISK") : NULL;
+    data->proc_monitor = proc_monitor_new(pid, disk, PROC_MONITOR_JOURNAL_PATH);
+    g_free(disk);
+    if (content) g_string_free(content, TRUE);
+    data->proc_monitor_timeout_id = g_timeout_add_seconds(1, page8_proc_monitor_callback, data);
+    if (data->resource_box)
+        gtk_widget_set_visible(data->resource_box, TRUE);
+}
+
+static void page8_stop_proc_monitor(Page8Data *data)
+{
+    if (!data) return;
+
+    if (data->proc_monitor_timeout_id != 0) {
+        g_source_remove(data->proc_monitor_timeout_id);
+        data->proc_monitor_timeout_id = 0;
+    }
+    g_clear_pointer(&data->proc_monitor, proc_monitor_free);
+}
+
 void page8_start_progress_bar_pulse(Page8Data *data)
 {
     if (!data || !data->progress_bar) return;
@@ -351,6 +555,16 @@ void page8_start_installation(Page8Data *data)
     // Iniciar animación de la barra de progreso
     page8_start_progress_bar_pulse(data);
 
+    // Seguir el borrado completo del disco, si se eligió (se consulta cada
+    // segundo). config_disk.sh vacía el archivo de progreso antes de borrar
+    page8_stop_wipe_progress(data);
+    GString *content = vars_read();
+    gchar *wipe_full = content ? vars_get(content, "WIPE_FULL") : NULL;
+    if (g_strcmp0(wipe_full, "true") == 0)
+        data->wipe_progress_timeout_id = g_timeout_add_seconds(1, page8_wipe_progress_callback, data);
+    g_free(wipe_full);
+    if (content) g_string_free(content, TRUE);
+
     // Iniciar instalación automáticamente
 
     // Ejecutar script de instalación en la terminal VTE
@@ -373,6 +587,7 @@ void page8_stop_installation(Page8Data *data)
 
     // Detener la animación del progress bar
     page8_stop_progress_bar_pulse(data);
+    page8_stop_wipe_progress(data);
 
     // Instalación completada
 
@@ -388,7 +603,7 @@ void page8_setup_terminal(Page8Data *data)
     LOG_INFO("Configurando terminal VTE");
 
     // Configurar el terminal VTE
-    vte_terminal_set_scrollback_lines(data->vte_terminal, 1000);
+    vte_terminal_set_scrollback_lines(data->vte_terminal, PAGE8_SCROLLBACK_LINES);
     vte_terminal_set_scroll_on_output(data->vte_terminal, TRUE);
     vte_terminal_set_scroll_on_keystroke(data->vte_terminal, TRUE);
     vte_terminal_set_audible_bell(data->vte_terminal, FALSE);
@@ -540,6 +755,242 @@ static gboolean page8_navigate_to_completion(Page8Data *data)
     return FALSE; // No repetir el timeout
 }
 
+// Callback de vte_terminal_spawn_async: el PID del script ya existe
+static void on_install_script_spawned(VteTerminal *terminal, GPid pid, GError *error, gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    if (!data) return;
+
+    if (error) {
+        LOG_ERROR("Error ejecutando script de instalación: %s", error->message);
+        page8_terminal_output(data, "ERROR: No se pudo ejecutar el script de instalación\n");
+        return;
+    }
+
+    page8_start_proc_monitor(data, pid);
+}
+
+// Instalación en varios discos (--targets): cada destino tiene su fila con una
+// barra de progreso que se calcula con las fases cerradas de su diario de tiempos
+typedef struct {
+    InstallTarget *target;
+    AdwActionRow *row;
+    GtkProgressBar *bar;
+    gchar *phase;
+} Page8Target;
+
+static void page8_target_free(Page8Target *item)
+{
+    if (!item) return;
+    install_target_free(item->target);
+    g_free(item->phase);
+    g_free(item);
+}
+
+static gboolean page8_targets_progress_callback(gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    if (!data || !data->targets) {
+        if (data) data->targets_timeout_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    gdouble total = 0.0;
+    for (guint i = 0; i < data->targets->len; i++) {
+        Page8Target *item = g_ptr_array_index(data->targets, i);
+        const gchar *phase = NULL;
+        gdouble fraction = install_timing_progress(item->target->journal_path, &phase);
+        total += item->target->exit_code == 0 ? 1.0 : fraction;
+
+        // Las filas de los destinos que ya terminaron conservan su resultado
+        if (item->target->exit_code != -1)
+            continue;
+        gtk_progress_bar_set_fraction(item->bar, fraction);
+        if (!phase || g_strcmp0(phase, item->phase) == 0)
+            continue;
+
+        g_free(item->phase);
+        item->phase = g_strdup(phase);
+        gchar *label = g_strdelimit(g_strdup(phase), "_", ' ');
+        adw_action_row_set_subtitle(item->row, label);
+        gchar *line = g_strdup_printf("[%s] %s\r\n", item->target->name, label);
+        page8_terminal_output(data, line);
+        g_free(line);
+        g_free(label);
+    }
+
+    gtk_progress_bar_set_fraction(data->progress_bar, total / data->targets->len);
+    return G_SOURCE_CONTINUE;
+}
+
+static void page8_stop_targets(Page8Data *data)
+{
+    if (!data) return;
+
+    if (data->targets_timeout_id != 0) {
+        g_source_remove(data->targets_timeout_id);
+        data->targets_timeout_id = 0;
+    }
+    if (data->targets) {
+        for (guint i = 0; i < data->targets->len; i++) {
+            Page8Target *item = g_ptr_array_index(data->targets, i);
+            if (item->target->pid)
+                g_spawn_close_pid(item->target->pid);
+            item->target->pid = 0;
+        }
+        g_ptr_array_unref(data->targets);
+        data->targets = NULL;
+    }
+}
+
+static void on_target_exited(GPid pid, gint status, gpointer user_data)
+{
+    Page8Data *data = (Page8Data*)user_data;
+    if (!data || !data->targets) {
+        g_spawn_close_pid(pid);
+        return;
+    }
+
+    for (guint i = 0; i < data->targets->len; i++) {
+        Page8Target *item = g_ptr_array_index(data->targets, i);
+        if (item->target->pid != pid)
+            continue;
+
+        GError *error = NULL;
+        item->target->exit_code = g_spawn_check_wait_status(status, &error) ? 0 : 1;
+        if (error) {
+            LOG_ERROR("La instalación en %s falló: %s", item->target->disk, error->message);
+            g_error_free(error);
+        } else {
+            LOG_INFO("Instalación en %s completada", item->target->disk);
+        }
+
+        gtk_progress_bar_set_fraction(item->bar, item->target->exit_code == 0 ? 1.0 : 0.0);
+        adw_action_row_set_subtitle(item->row, i18n_t(item->target->exit_code == 0
+                                                      ? "Instalación completada"
+                                                      : "La instalación falló"));
+        item->target->pid = 0;
+        data->targets_pending--;
+    }
+    g_spawn_close_pid(pid);
+
+    if (data->targets_pending > 0)
+        return;
+
+    // Todos terminaron: página 9 solo si se instalaron todos los discos
+    gboolean all_ok = TRUE;
+    for (guint i = 0; i < data->targets->len; i++) {
+        Page8Target *item = g_ptr_array_index(data->targets, i);
+        if (item->target->exit_code != 0)
+            all_ok = FALSE;
+    }
+
+    page8_targets_progress_callback(data);
+    if (data->targets_timeout_id != 0) {
+        g_source_remove(data->targets_timeout_id);
+        data->targets_timeout_id = 0;
+    }
+    page8_stop_carousel_timer(data);
+
+    if (all_ok) {
+        LOG_INFO("Todos los discos instalados - navegando a página 9");
+        g_timeout_add(1000, (GSourceFunc)page8_navigate_to_completion, data);
+    } else {
+        LOG_ERROR("La instalación falló en al menos un disco");
+        GtkWidget *page10_widget = page10_get_widget();
+        if (page10_widget && data->carousel)
+            adw_carousel_scroll_to(data->carousel, page10_widget, TRUE);
+    }
+}
+
+// Lanza install.sh para cada disco de --targets con las respuestas de las
+// páginas anteriores. FALSE si no se pudo: se sigue con la instalación normal
+static gboolean page8_execute_targets(Page8Data *data, const gchar *script_path)
+{
+    GString *answers = vars_read();
+    if (!answers) {
+        LOG_ERROR("No se pudo leer variables.sh para instalar en varios discos");
+        return FALSE;
+    }
+
+    // PARTITIONS apunta a particiones de un disco concreto: no se puede replicar
+    gchar *mode = vars_get(answers, "PARTITION_MODE");
+    gboolean manual = g_strcmp0(mode, "manual") == 0;
+    g_free(mode);
+    if (manual) {
+        LOG_WARNING("%s requiere particionado automático; se instala solo en SELECTED_DISK",
+                    INSTALL_TARGETS_OPTION);
+        g_string_free(answers, TRUE);
+        return FALSE;
+    }
+
+    GPtrArray *targets = install_targets_parse(install_targets_requested());
+    if (!targets) {
+        g_string_free(answers, TRUE);
+        return FALSE;
+    }
+
+    page8_stop_targets(data);
+    data->targets = g_ptr_array_new_with_free_func((GDestroyNotify)page8_target_free);
+    data->targets_pending = 0;
+
+    // install_targets_parse es dueño de cada destino: se pasan a Page8Target
+    g_ptr_array_set_free_func(targets, NULL);
+    for (guint i = 0; i < targets->len; i++) {
+        Page8Target *item = g_new0(Page8Target, 1);
+        GError *error = NULL;
+        item->target = g_ptr_array_index(targets, i);
+        g_ptr_array_add(data->targets, item);
+
+        item->row = ADW_ACTION_ROW(adw_action_row_new());
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(item->row), item->target->disk);
+        adw_action_row_set_subtitle(item->row, i18n_t("En espera"));
+        item->bar = GTK_PROGRESS_BAR(gtk_progress_bar_new());
+        gtk_widget_set_valign(GTK_WIDGET(item->bar), GTK_ALIGN_CENTER);
+        gtk_widget_set_size_request(GTK_WIDGET(item->bar), 200, -1);
+        adw_action_row_add_suffix(item->row, GTK_WIDGET(item->bar));
+        if (data->targets_list)
+            gtk_list_box_append(data->targets_list, GTK_WIDGET(item->row));
+
+        gchar *envp[] = {
+            "TERM=xterm-256color",
+            "PATH=/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:/sbin:/bin",
+            NULL
+        };
+        if (!install_target_write_variables(item->target, answers->str, &error) ||
+            !install_target_spawn(item->target, script_path, g_strdupv(envp), &error)) {
+            LOG_ERROR("No se pudo iniciar la instalación en %s: %s", item->target->disk, error->message);
+            g_error_free(error);
+            item->target->exit_code = 1;
+            adw_action_row_set_subtitle(item->row, i18n_t("La instalación falló"));
+            continue;
+        }
+
+        g_child_watch_add(item->target->pid, on_target_exited, data);
+        data->targets_pending++;
+        gchar *line = g_strdup_printf("[%s] install.sh: %s\r\n", item->target->name, item->target->log_path);
+        page8_terminal_output(data, line);
+        g_free(line);
+    }
+    g_ptr_array_unref(targets);
+    g_string_free(answers, TRUE);
+
+    if (data->targets_pending == 0) {
+        page8_stop_targets(data);
+        return FALSE;
+    }
+
+    // El borrado de cada disco escribe en su propio ARCRIS_TMP_DIR: aquí la
+    // barra general es el promedio de los destinos
+    page8_stop_wipe_progress(data);
+    page8_stop_progress_bar_pulse(data);
+    gtk_progress_bar_set_fraction(data->progress_bar, 0.0);
+    if (data->targets_list)
+        gtk_widget_set_visible(GTK_WIDGET(data->targets_list), TRUE);
+    data->targets_timeout_id = g_timeout_add_seconds(1, page8_targets_progress_callback, data);
+    return TRUE;
+}
+
 void page8_execute_install_script(Page8Data *data)
 {
     if (!data || !data->vte_terminal) return;
@@ -566,22 +1017,25 @@ void page8_execute_install_script(Page8Data *data)
     }
     g_free(chmod_command);
 
-    // Preparar argumentos para ejecutar el script
-    // --return: propagar el exit code del comando interno
-    gchar *argv[] = {
-        "/usr/bin/script",
-        "--return",
-        "-q",
-        "-c",
-        g_strdup_printf("bash %s", script_path),
-        g_strdup_printf("%s/install.log", g_get_home_dir()),
-        NULL
-    };
+    // Con --targets cada disco corre su propio install.sh fuera de la terminal
+    if (install_targets_requested() && page8_execute_targets(data, script_path)) {
+        page8_terminal_output(data, "Instalación en varios discos: ver el registro de cada destino\r\n");
+        g_free(script_path);
+        return;
+    }
+
+    // Preparar argumentos para ejecutar el script: script(1) con el registro
+    // comprimido de arcris-log (ver install_log.h)
+    gchar *log_path = install_log_path(NULL);
+    gchar **argv = install_log_build_argv(NULL, script_path, log_path);
+    LOG_INFO("Registro de instalación: %s", log_path);
 
-    // Variables de entorno
+    // Variables de entorno; install_timing.sh solo lee la serie de recursos
+    // de esta instalación, la que escribe page8_start_proc_monitor()
     gchar *envp[] = {
         "TERM=xterm-256color",
         "PATH=/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:/sbin:/bin",
+        "ARCRIS_RESOURCE_JOURNAL=" PROC_MONITOR_JOURNAL_PATH,
         NULL
     };
 
@@ -607,8 +1061,8 @@ void page8_execute_install_script(Page8Data *data)
         NULL,                    // child setup data destroy
         -1,                      // timeout
         NULL,                    // cancellable
-        NULL,                    // callback
-        NULL                     // user data
+        on_install_script_spawned, // callback (errores y PID para medir recursos)
+        data                     // user data
     );
 
     if (error) {
@@ -622,6 +1076,8 @@ void page8_execute_install_script(Page8Data *data)
         page8_terminal_output(data, "DEBUG: Script iniciado - se detectará automáticamente cuando termine\n");
     }
 
+    g_strfreev(argv);
+    g_free(log_path);
     g_free(script_path);
 }
 
@@ -4,6 +4,7 @@
 #include <gtk/gtk.h>
 #include <adwaita.h>
 #include <vte/vte.h>
+#include "proc_monitor.h"
 
 // Estructura para datos de la página 8
 typedef struct _Page8Data {
@@ -44,6 +45,23 @@ typedef struct _Page8Data {
     
     // Timer para animación del progress bar
     guint progress_bar_timeout_id;
+
+    // Progreso del borrado completo del disco (porcentaje real en la barra)
+    guint wipe_progress_timeout_id;
+    gboolean wipe_progress_active;
+
+    // Consumo del árbol de procesos de la instalación (red, disco, CPU)
+    GtkWidget *resource_box;
+    GtkDrawingArea *sparklines[PROC_METRIC_COUNT];
+    GtkLabel *resource_labels[PROC_METRIC_COUNT];
+    ProcMonitor *proc_monitor;
+    guint proc_monitor_timeout_id;
+
+    // Instalación en varios discos (--targets): una fila con el avance de cada uno
+    GtkListBox *targets_list;
+    GPtrArray *targets;
+    guint targets_timeout_id;
+    guint targets_pending;
     
     // Estado de la página
     gboolean is_installing;
@@ -1,6 +1,8 @@
 #include "page9.h"
 #include "config.h"
 #include "i18n.h"
+#include "install_timing.h"
+#include "proc_monitor.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,6 +59,8 @@ void page9_init(GtkBuilder *builder, AdwCarousel *carousel, GtkRevealer *reveale
     g_page9_data->completion_message = GTK_LABEL(gtk_builder_get_object(page_builder, "completion_message"));
     g_page9_data->secondary_message = GTK_LABEL(gtk_builder_get_object(page_builder, "secondary_message"));
     g_page9_data->info_label = GTK_LABEL(gtk_builder_get_object(page_builder, "info_label"));
+    g_page9_data->timing_expander = GTK_EXPANDER(gtk_builder_get_object(page_builder, "timing_expander"));
+    g_page9_data->timing_label = GTK_LABEL(gtk_builder_get_object(page_builder, "timing_label"));
     
     // Obtener botones
     g_page9_data->shutdown_button = GTK_BUTTON(gtk_builder_get_object(page_builder, "shutdown_button"));
@@ -242,8 +246,17 @@ void page9_load_data(Page9Data *data)
     
     LOG_INFO("Cargando datos para página 9");
     
-    // Aquí se pueden cargar datos específicos si es necesario
-    // Por ahora, los textos están definidos en el UI
+    // Desglose de tiempos; el expander queda oculto si no hay diario
+    if (data->timing_expander && data->timing_label) {
+        InstallTimingReport *report = install_timing_load(INSTALL_TIMING_JOURNAL_PATH);
+        if (report) {
+            gchar *text = install_timing_format(report);
+            gtk_label_set_text(data->timing_label, text);
+            g_free(text);
+            install_timing_free(report);
+        }
+        gtk_widget_set_visible(GTK_WIDGET(data->timing_expander), report != NULL);
+    }
     
     LOG_INFO("Datos cargados para página 9");
 }
@@ -660,14 +673,11 @@ gboolean page9_check_critical_processes(void)
         NULL
     };
     
-    for (int i = 0; critical_processes[i] != NULL; i++) {
-        char command[256];
-        snprintf(command, sizeof(command), "pgrep %s > /dev/null 2>&1", critical_processes[i]);
-        
-        if (system(command) == 0) {
-            LOG_WARNING("Proceso crítico encontrado: %s", critical_processes[i]);
-            return TRUE; // Hay procesos críticos
-        }
+    // Una sola pasada por /proc comparando el nombre de cada proceso (como pgrep)
+    const gchar *found = proc_find_running(critical_processes, FALSE);
+    if (found) {
+        LOG_WARNING("Proceso crítico encontrado: %s", found);
+        return TRUE; // Hay procesos críticos
     }
     
     LOG_INFO("No se encontraron procesos críticos");
@@ -767,14 +777,11 @@ gboolean page9_check_installer_processes(void)
         NULL
     };
     
-    for (int i = 0; installer_processes[i] != NULL; i++) {
-        char command[256];
-        snprintf(command, sizeof(command), "pgrep -f %s > /dev/null 2>&1", installer_processes[i]);
-        
-        if (system(command) == 0) {
-            LOG_WARNING("Proceso del instalador encontrado: %s", installer_processes[i]);
-            return TRUE; // Hay procesos del instalador
-        }
+    // Se busca en la línea de órdenes completa (como pgrep -f)
+    const gchar *found = proc_find_running(installer_processes, TRUE);
+    if (found) {
+        LOG_WARNING("Proceso del instalador encontrado: %s", found);
+        return TRUE; // Hay procesos del instalador
     }
     
     LOG_INFO("No se encontraron procesos críticos del instalador");
@@ -866,4 +873,12 @@ void page9_update_language(void)
     if (g_page9_data->info_label)
         gtk_label_set_text(g_page9_data->info_label,
             i18n_t("Apagar: Cierra el sistema completamente • Reiniciar: Reinicia el sistema • Salir: Cierra el instalador"));
+    if (g_page9_data->timing_expander)
+        gtk_expander_set_label(g_page9_data->timing_expander,
+            i18n_t("Tiempos de instalación"));
+
+    // El desglose también lleva textos traducidos
+    if (g_page9_data->timing_expander &&
+        gtk_widget_get_visible(GTK_WIDGET(g_page9_data->timing_expander)))
+        page9_load_data(g_page9_data);
 }
\ No newline at end of file
@@ -20,6 +20,10 @@ typedef struct _Page9Data {
     GtkLabel *secondary_message;
     GtkLabel *info_label;
     
+    // Desglose de tiempos (diario de install_timing.sh)
+    GtkExpander *timing_expander;
+    GtkLabel *timing_label;
+    
     // Botones de acción
     GtkButton *shutdown_button;
     GtkButton *restart_button;
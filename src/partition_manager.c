@@ -287,48 +287,11 @@ partition_manager_copy_config(PartitionConfig *config)
                                           config->is_swap);
 }
 
-// Guardar configuraciones en variables.sh
-gboolean
-partition_manager_save_to_variables(PartitionManager *manager)
+// Elimina el bloque PARTITIONS existente e inserta el nuevo tras PARTITION_MODE
+static void apply_partitions_block(GString *content, gpointer user_data)
 {
-    if (!manager) return FALSE;
-
-    // Construir el bloque PARTITIONS
-    GString *partitions_block = g_string_new("");
-    if (manager->partition_configs) {
-        g_string_append(partitions_block, "PARTITIONS=(\n");
-        for (GList *l = manager->partition_configs; l != NULL; l = l->next) {
-            PartitionConfig *config = (PartitionConfig*)l->data;
-            if (config) {
-                if (config->is_swap)
-                    g_string_append_printf(partitions_block, "    \"%s %s swap\"\n",
-                                           config->device_path, config->filesystem);
-                else
-                    g_string_append_printf(partitions_block, "    \"%s %s %s\"\n",
-                                           config->device_path, config->filesystem, config->mount_point);
-            }
-        }
-        g_string_append(partitions_block, ")");
-    } else {
-        g_string_append(partitions_block, "PARTITIONS=()");
-    }
-
-    // Leer archivo existente
-    gchar *bash_file_path = g_build_filename(".", "data", "bash", "variables.sh", NULL);
-    GError *error = NULL;
-    gchar *file_content = NULL;
-
-    if (!g_file_get_contents(bash_file_path, &file_content, NULL, &error)) {
-        LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        g_string_free(partitions_block, TRUE);
-        g_free(bash_file_path);
-        return FALSE;
-    }
-
-    // Procesar líneas: eliminar bloque PARTITIONS existente e insertar tras PARTITION_MODE
-    gchar **lines = g_strsplit(file_content, "\n", -1);
-    g_free(file_content);
+    const gchar *partitions_block = user_data;
+    gchar **lines = g_strsplit(content->str, "\n", -1);
     GString *result = g_string_new("");
     gboolean in_partitions = FALSE;
     gboolean inserted = FALSE;
@@ -353,7 +316,7 @@ partition_manager_save_to_variables(PartitionManager *manager)
 
         // Insertar PARTITIONS justo después de PARTITION_MODE=
         if (!inserted && g_str_has_prefix(stripped, "PARTITION_MODE=")) {
-            g_string_append_printf(result, "%s\n", partitions_block->str);
+            g_string_append_printf(result, "%s\n", partitions_block);
             inserted = TRUE;
         }
 
@@ -362,21 +325,46 @@ partition_manager_save_to_variables(PartitionManager *manager)
 
     // Si PARTITION_MODE no existe todavía, agregar al final
     if (!inserted)
-        g_string_append_printf(result, "%s\n", partitions_block->str);
+        g_string_append_printf(result, "%s\n", partitions_block);
 
-    vars_trim_trailing_newlines(result);
-    gboolean ok = g_file_set_contents(bash_file_path, result->str, -1, &error);
-    if (!ok) {
-        LOG_ERROR("Error guardando variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
+    g_string_assign(content, result->str);
+    g_string_free(result, TRUE);
+    g_strfreev(lines);
+}
+
+// Guardar configuraciones en variables.sh
+gboolean
+partition_manager_save_to_variables(PartitionManager *manager)
+{
+    if (!manager) return FALSE;
+
+    // Construir el bloque PARTITIONS
+    GString *partitions_block = g_string_new("");
+    if (manager->partition_configs) {
+        g_string_append(partitions_block, "PARTITIONS=(\n");
+        for (GList *l = manager->partition_configs; l != NULL; l = l->next) {
+            PartitionConfig *config = (PartitionConfig*)l->data;
+            if (config) {
+                if (config->is_swap)
+                    g_string_append_printf(partitions_block, "    \"%s %s swap\"\n",
+                                           config->device_path, config->filesystem);
+                else
+                    g_string_append_printf(partitions_block, "    \"%s %s %s\"\n",
+                                           config->device_path, config->filesystem, config->mount_point);
+            }
+        }
+        g_string_append(partitions_block, ")");
     } else {
-        LOG_INFO("Configuraciones de partición guardadas en: %s", bash_file_path);
+        g_string_append(partitions_block, "PARTITIONS=()");
     }
 
-    g_strfreev(lines);
-    g_string_free(result, TRUE);
+    gboolean ok = vars_update(apply_partitions_block, partitions_block->str);
+    if (!ok)
+        LOG_ERROR("Error guardando configuraciones de partición en variables.sh");
+    else
+        LOG_INFO("Configuraciones de partición guardadas en variables.sh");
+
     g_string_free(partitions_block, TRUE);
-    g_free(bash_file_path);
     return ok;
 }
 
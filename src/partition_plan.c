@@ -0,0 +1,219 @@
+#include "partition_plan.h"
+#include "variables_utils.h"
+#include "config.h"
+#include <string.h>
+
+#define MIB (1024ULL * 1024)
+
+static gboolean plan_read_sysfs(const gchar *name, const gchar *attr, guint64 *value)
+{
+    gchar *path = g_strdup_printf("/sys/block/%s/%s", name, attr);
+    gchar *content = NULL;
+    gboolean ok = g_file_get_contents(path, &content, NULL, NULL);
+    if (ok) {
+        *value = g_ascii_strtoull(g_strstrip(content), NULL, 10);
+        g_free(content);
+    }
+    g_free(path);
+    return ok;
+}
+
+/* Único cálculo del tamaño de la swap: config_disk.sh lo recibe en SWAP_SIZE_MIB */
+static guint64 plan_swap_mib(const gchar *swap_type, const gchar *swap_custom)
+{
+    if (g_strcmp0(swap_type, "custom") == 0)
+        return (swap_custom ? g_ascii_strtoull(swap_custom, NULL, 10) : 1) * 1024;
+    if (g_strcmp0(swap_type, "half") != 0 && g_strcmp0(swap_type, "equal") != 0)
+        return 0;
+
+    guint64 ram_mib = 0;
+    gchar *meminfo = NULL;
+    if (g_file_get_contents("/proc/meminfo", &meminfo, NULL, NULL)) {
+        const gchar *line = strstr(meminfo, "MemTotal:");
+        if (line)
+            ram_mib = g_ascii_strtoull(line + strlen("MemTotal:"), NULL, 10) / 1024;
+        g_free(meminfo);
+    }
+
+    /* Redondear al GiB superior si sobra medio GiB o más (RAM >= 3.5 GiB) */
+    if (ram_mib >= 3584 && ram_mib % 1024 >= 512)
+        ram_mib = (ram_mib / 1024 + 1) * 1024;
+
+    return g_strcmp0(swap_type, "half") == 0 ? ram_mib / 2 : ram_mib;
+}
+
+static void plan_add(PartitionPlan *plan, guint64 *next, const gchar *role,
+                     guint64 size_bytes, const gchar *type, gboolean bootable)
+{
+    PartitionPlanEntry entry = {
+        .role = role,
+        .start = *next,
+        .size = size_bytes / plan->sector_size,
+        .type = type,
+        .bootable = bootable,
+    };
+    g_array_append_val(plan->entries, entry);
+    *next += entry.size;
+}
+
+void partition_plan_free(PartitionPlan *plan)
+{
+    if (!plan) return;
+    g_array_unref(plan->entries);
+    g_free(plan);
+}
+
+static PartitionPlan *plan_compute(const gchar *disk, gboolean encrypted, gboolean home_partition,
+                                   guint64 root_mib, guint64 swap_mib, GError **error)
+{
+    gchar *name = g_path_get_basename(disk);
+    guint64 size_512 = 0, logical = 512;
+    gboolean found = plan_read_sysfs(name, "size", &size_512);
+    plan_read_sysfs(name, "queue/logical_block_size", &logical);
+    g_free(name);
+
+    if (!found || size_512 == 0) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOENT,
+                    "No se encontró el disco '%s' en /sys/block", disk);
+        return NULL;
+    }
+    if (logical == 0) logical = 512;
+
+    PartitionPlan *plan = g_new0(PartitionPlan, 1);
+    plan->label = g_file_test("/sys/firmware/efi", G_FILE_TEST_IS_DIR) ? "gpt" : "dos";
+    plan->sector_size = (guint)logical;
+    plan->disk_sectors = size_512 * 512 / logical;
+    plan->swap_mib = swap_mib;
+    plan->entries = g_array_new(FALSE, FALSE, sizeof(PartitionPlanEntry));
+
+    gboolean uefi = g_strcmp0(plan->label, "gpt") == 0;
+    guint64 next = PARTITION_PLAN_ALIGN_BYTES / logical;
+
+    /* Con cifrado swap, raíz y /home son volúmenes LVM dentro de la partición LUKS */
+    if (encrypted) {
+        plan_add(plan, &next, uefi ? "efi" : "boot", PARTITION_PLAN_BOOT_MIB * MIB,
+                 uefi ? "U" : "L", !uefi);
+        plan_add(plan, &next, "luks", 0, "L", FALSE);
+    } else {
+        if (uefi)
+            plan_add(plan, &next, "efi", PARTITION_PLAN_BOOT_MIB * MIB, "U", FALSE);
+        if (swap_mib > 0)
+            plan_add(plan, &next, "swap", swap_mib * MIB, "S", FALSE);
+        if (home_partition) {
+            plan_add(plan, &next, "root", root_mib * MIB, "L", !uefi);
+            plan_add(plan, &next, "home", 0, "L", FALSE);
+        } else {
+            plan_add(plan, &next, "root", 0, "L", !uefi);
+        }
+    }
+
+    /* La última partición ocupa el resto: comprobar que queda sitio suficiente
+     * (más 1 MiB al final para la cabecera GPT de respaldo) */
+    guint64 disk_bytes = plan->disk_sectors * logical;
+    guint64 required = next * logical + PARTITION_PLAN_MIN_REST_MIB * MIB + PARTITION_PLAN_ALIGN_BYTES;
+    if (required > disk_bytes) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOSPC,
+                    "El plan de particiones necesita %" G_GUINT64_FORMAT " MiB y %s tiene %" G_GUINT64_FORMAT " MiB",
+                    required / MIB, disk, disk_bytes / MIB);
+        partition_plan_free(plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
+PartitionPlan *partition_plan_new(const gchar *disk, const gchar *encryption,
+                                  const gchar *home_partition, const gchar *root_size,
+                                  const gchar *swap_type, const gchar *swap_custom,
+                                  GError **error)
+{
+    if (!disk || disk[0] == '\0') {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOENT, "SELECTED_DISK está vacío");
+        return NULL;
+    }
+
+    guint64 root_mib = (root_size ? g_ascii_strtoull(root_size, NULL, 10) : 15) * 1024;
+    return plan_compute(disk,
+                        g_strcmp0(encryption, "true") == 0,
+                        g_strcmp0(home_partition, "partition") == 0,
+                        root_mib,
+                        plan_swap_mib(swap_type, swap_custom),
+                        error);
+}
+
+PartitionPlan *partition_plan_build(const GString *content, GError **error)
+{
+    g_return_val_if_fail(content != NULL, NULL);
+
+    gchar *disk = vars_get(content, "SELECTED_DISK");
+    gchar *encryption = vars_get(content, "ENCRYPTION");
+    gchar *home = vars_get(content, "HOME_PARTITION");
+    gchar *root_size = vars_get(content, "ROOT_SIZE");
+    gchar *swap_type = vars_get(content, "SWAP_TYPE");
+    gchar *swap_custom = vars_get(content, "SWAP_CUSTOM_SIZE");
+
+    PartitionPlan *plan = partition_plan_new(disk, encryption, home, root_size,
+                                             swap_type, swap_custom, error);
+
+    g_free(swap_custom);
+    g_free(swap_type);
+    g_free(root_size);
+    g_free(home);
+    g_free(encryption);
+    g_free(disk);
+    return plan;
+}
+
+void partition_plan_write_variables(GString *content, const PartitionPlan *plan)
+{
+    g_return_if_fail(content != NULL && plan != NULL);
+
+    GPtrArray *items = g_ptr_array_new_with_free_func(g_free);
+    for (guint i = 0; i < plan->entries->len; i++) {
+        const PartitionPlanEntry *entry = &g_array_index(plan->entries, PartitionPlanEntry, i);
+        g_ptr_array_add(items, g_strdup_printf("%s %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT " %s%s",
+                                               entry->role, entry->start, entry->size, entry->type,
+                                               entry->bootable ? " bootable" : ""));
+    }
+    g_ptr_array_add(items, NULL);
+
+    gchar *swap_mib = g_strdup_printf("%" G_GUINT64_FORMAT, plan->swap_mib);
+    vars_upsert(content, "PARTITION_TABLE", plan->label);
+    vars_upsert(content, "SWAP_SIZE_MIB", swap_mib);
+    g_free(swap_mib);
+    vars_upsert_array(content, "PARTITION_PLAN", (const gchar *const *)items->pdata);
+    g_ptr_array_unref(items);
+}
+
+gboolean partition_plan_update_variables(GString *content)
+{
+    g_return_val_if_fail(content != NULL, FALSE);
+
+    gchar *mode = vars_get(content, "PARTITION_MODE");
+    gboolean manual = g_strcmp0(mode, "manual") == 0;
+    g_free(mode);
+
+    /* En modo manual se usan las particiones existentes: no hay tabla nueva */
+    if (manual) {
+        vars_remove(content, "PARTITION_TABLE");
+        vars_remove(content, "SWAP_SIZE_MIB");
+        vars_upsert_array(content, "PARTITION_PLAN", NULL);
+        return TRUE;
+    }
+
+    GError *error = NULL;
+    PartitionPlan *plan = partition_plan_build(content, &error);
+    if (!plan) {
+        LOG_WARNING("Plan de particiones no válido: %s", error ? error->message : "desconocido");
+        g_clear_error(&error);
+        vars_remove(content, "PARTITION_TABLE");
+        vars_remove(content, "SWAP_SIZE_MIB");
+        vars_upsert_array(content, "PARTITION_PLAN", NULL);
+        return FALSE;
+    }
+
+    partition_plan_write_variables(content, plan);
+    LOG_INFO("Plan de particiones (%s, %u particiones) guardado", plan->label, plan->entries->len);
+    partition_plan_free(plan);
+    return TRUE;
+}
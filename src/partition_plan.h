@@ -0,0 +1,53 @@
+#ifndef PARTITION_PLAN_H
+#define PARTITION_PLAN_H
+
+#include <glib.h>
+
+/* Alineación de todas las particiones (1 MiB: válida para cualquier
+ * tamaño de sector, página de SSD o franja de RAID habitual) */
+#define PARTITION_PLAN_ALIGN_BYTES (1024 * 1024)
+
+/* Tamaño de la partición EFI / /boot del particionado automático */
+#define PARTITION_PLAN_BOOT_MIB 512
+
+/* Espacio mínimo para la raíz o /home cuando ocupan "el resto del disco" */
+#define PARTITION_PLAN_MIN_REST_MIB 1024
+
+typedef struct {
+    const gchar *role;    /* efi, boot, swap, root, home, luks */
+    guint64      start;   /* en sectores lógicos */
+    guint64      size;    /* en sectores lógicos; 0 = hasta el final del disco */
+    const gchar *type;    /* alias de tipo de sfdisk (U, L, S) */
+    gboolean     bootable;
+} PartitionPlanEntry;
+
+typedef struct {
+    const gchar *label;        /* "gpt" (UEFI) o "dos" (BIOS) */
+    guint        sector_size;  /* tamaño de sector lógico del disco */
+    guint64      disk_sectors;
+    guint64      swap_mib;     /* swap en disco (partición o LV); 0 con zram o sin swap */
+    GArray      *entries;      /* PartitionPlanEntry, en orden de número de partición */
+} PartitionPlan;
+
+/* Calcula el plan del particionado automático con los valores tal como
+ * aparecen en variables.sh. Devuelve NULL con error si el disco no existe o
+ * el plan no cabe en él. */
+PartitionPlan *partition_plan_new(const gchar *disk, const gchar *encryption,
+                                  const gchar *home_partition, const gchar *root_size,
+                                  const gchar *swap_type, const gchar *swap_custom,
+                                  GError **error);
+
+/* Igual que partition_plan_new leyendo los valores del contenido de
+ * variables.sh (SELECTED_DISK, ENCRYPTION, SWAP_TYPE, HOME_PARTITION, ROOT_SIZE...) */
+PartitionPlan *partition_plan_build(const GString *content, GError **error);
+void partition_plan_free(PartitionPlan *plan);
+
+/* Escribe PARTITION_TABLE, SWAP_SIZE_MIB y el array PARTITION_PLAN ("rol inicio
+ * tamaño tipo [bootable]") que config_disk.sh aplica con una sola llamada a sfdisk. */
+void partition_plan_write_variables(GString *content, const PartitionPlan *plan);
+
+/* Recalcula el plan y lo guarda; con particionado manual o un plan inválido
+ * elimina el anterior. Devuelve FALSE si el plan no es válido. */
+gboolean partition_plan_update_variables(GString *content);
+
+#endif /* PARTITION_PLAN_H */
@@ -0,0 +1,306 @@
+#include "performance_profile.h"
+#include "variables_utils.h"
+#include "config.h"
+#include "i18n.h"
+#include <string.h>
+#include <unistd.h>
+
+#define MIB ((guint64)1024 * 1024)
+#define GIB (MIB * 1024)
+
+#define CPUFREQ_DIR "/sys/devices/system/cpu/cpu0/cpufreq"
+
+static const gchar *profile_ids[] = { "balanced", "throughput", "desktop", "server" };
+
+static gchar *read_sys_string(const gchar *path)
+{
+    gchar *content = NULL;
+    if (!g_file_get_contents(path, &content, NULL, NULL))
+        return NULL;
+    g_strstrip(content);
+    return content;
+}
+
+static gboolean has_battery(void)
+{
+    GDir *dir = g_dir_open("/sys/class/power_supply", 0, NULL);
+    if (!dir)
+        return FALSE;
+
+    gboolean found = FALSE;
+    const gchar *name;
+    while (!found && (name = g_dir_read_name(dir)) != NULL) {
+        gchar *path = g_build_filename("/sys/class/power_supply", name, "type", NULL);
+        gchar *type = read_sys_string(path);
+        found = g_strcmp0(type, "Battery") == 0;
+        g_free(type);
+        g_free(path);
+    }
+    g_dir_close(dir);
+    return found;
+}
+
+/* Velocidad de la interfaz cableada más rápida con enlace; las virtuales
+ * (sin "device") y las wifi no cuentan */
+static guint wired_link_speed(void)
+{
+    GDir *dir = g_dir_open("/sys/class/net", 0, NULL);
+    if (!dir)
+        return 0;
+
+    guint best = 0;
+    const gchar *name;
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        gchar *base = g_build_filename("/sys/class/net", name, NULL);
+        gchar *device = g_build_filename(base, "device", NULL);
+        gchar *wireless = g_build_filename(base, "wireless", NULL);
+        gchar *speed_path = g_build_filename(base, "speed", NULL);
+
+        if (g_file_test(device, G_FILE_TEST_EXISTS) && !g_file_test(wireless, G_FILE_TEST_EXISTS)) {
+            /* Sin enlace el kernel devuelve EINVAL o -1 */
+            gchar *speed = read_sys_string(speed_path);
+            gint64 mbps = speed ? g_ascii_strtoll(speed, NULL, 10) : 0;
+            if (mbps > 0 && (guint64)mbps > best)
+                best = (guint)mbps;
+            g_free(speed);
+        }
+
+        g_free(speed_path);
+        g_free(wireless);
+        g_free(device);
+        g_free(base);
+    }
+    g_dir_close(dir);
+    return best;
+}
+
+void perf_hardware_detect(const gchar *driver_video, PerfHardware *hw)
+{
+    g_return_if_fail(hw != NULL);
+
+    memset(hw, 0, sizeof(*hw));
+
+    gchar *driver = read_sys_string(CPUFREQ_DIR "/scaling_driver");
+    if (driver)
+        g_strlcpy(hw->cpufreq_driver, driver, sizeof(hw->cpufreq_driver));
+    g_free(driver);
+    hw->has_epp = g_file_test(CPUFREQ_DIR "/energy_performance_preference", G_FILE_TEST_EXISTS);
+
+    hw->is_laptop = has_battery();
+    hw->is_virtual_machine = g_strcmp0(driver_video, "Máquina Virtual") == 0;
+
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page_size > 0)
+        hw->ram_bytes = (guint64)pages * (guint64)page_size;
+
+    hw->link_speed_mbps = wired_link_speed();
+
+    LOG_INFO("Hardware para el perfil de rendimiento: cpufreq=%s, EPP=%s, portátil=%s, VM=%s, RAM=%" G_GUINT64_FORMAT " MiB, red=%u Mb/s",
+             hw->cpufreq_driver[0] ? hw->cpufreq_driver : "(ninguno)",
+             hw->has_epp ? "sí" : "no", hw->is_laptop ? "sí" : "no",
+             hw->is_virtual_machine ? "sí" : "no", hw->ram_bytes / MIB, hw->link_speed_mbps);
+}
+
+static guint64 clamp_bytes(guint64 value, guint64 low, guint64 high)
+{
+    return CLAMP(value, low, high);
+}
+
+static void compute_cpufreq(PerfProfile profile, const PerfHardware *hw, PerfSettings *s)
+{
+    s->governor = NULL;
+    s->epp = NULL;
+
+    /* En una máquina virtual la frecuencia la gestiona el anfitrión */
+    if (hw->is_virtual_machine || hw->cpufreq_driver[0] == '\0')
+        return;
+
+    /* Con EPP (intel_pstate / amd-pstate en modo activo) solo existen los
+     * gobernadores performance y powersave; la preferencia afina el segundo.
+     * Con performance el propio driver fija EPP en "performance". */
+    gboolean pstate = hw->has_epp;
+
+    switch (profile) {
+        case PERF_PROFILE_THROUGHPUT:
+            s->governor = "performance";
+            break;
+        case PERF_PROFILE_DESKTOP:
+            if (!hw->is_laptop) {
+                s->governor = "performance";
+            } else if (pstate) {
+                s->governor = "powersave";
+                s->epp = "performance";
+            } else {
+                s->governor = "schedutil";
+            }
+            break;
+        case PERF_PROFILE_SERVER:
+            if (!hw->is_laptop) {
+                s->governor = "performance";
+            } else if (pstate) {
+                s->governor = "powersave";
+                s->epp = "balance_performance";
+            } else {
+                s->governor = "schedutil";
+            }
+            break;
+        default:
+            if (pstate) {
+                s->governor = "powersave";
+                s->epp = hw->is_laptop ? "balance_power" : "balance_performance";
+            } else {
+                s->governor = "schedutil";
+            }
+            break;
+    }
+}
+
+void perf_profile_compute(PerfProfile profile, const PerfHardware *hw,
+                          const gchar *storage_class, PerfSettings *settings)
+{
+    g_return_if_fail(hw != NULL && settings != NULL);
+
+    PerfSettings *s = settings;
+    guint64 ram = hw->ram_bytes ? hw->ram_bytes : 4 * GIB;
+    gboolean hdd = g_strcmp0(storage_class, "hdd") == 0;
+    /* Producto ancho de banda × retardo para un RTT de 20 ms */
+    guint64 bdp = (guint64)hw->link_speed_mbps * 2500;
+
+    /* Planificador de E/S: NVMe siempre sin planificador; bfq da prioridad a
+     * las tareas interactivas y mq-deadline reparte mejor el rendimiento */
+    s->sched_nvme = "none";
+    switch (profile) {
+        case PERF_PROFILE_THROUGHPUT:
+            s->sched_ssd = "none";
+            s->sched_hdd = "mq-deadline";
+            break;
+        case PERF_PROFILE_DESKTOP:
+            s->sched_ssd = "bfq";
+            s->sched_hdd = "bfq";
+            break;
+        case PERF_PROFILE_SERVER:
+            s->sched_ssd = "mq-deadline";
+            s->sched_hdd = "mq-deadline";
+            break;
+        default:
+            s->sched_ssd = "mq-deadline";
+            s->sched_hdd = "bfq";
+            break;
+    }
+    /* Los discos virtuales ya los planifica el anfitrión */
+    if (hw->is_virtual_machine) {
+        s->sched_ssd = "none";
+        s->sched_hdd = "none";
+    }
+
+    compute_cpufreq(profile, hw, s);
+
+    /* Escritura diferida: pocos datos sucios en escritorio (sin pausas largas
+     * al vaciar), mucho margen en rendimiento, acotado en servidor */
+    switch (profile) {
+        case PERF_PROFILE_THROUGHPUT:
+            s->dirty_background_bytes = clamp_bytes(ram / 20, 256 * MIB, 2 * GIB);
+            s->dirty_bytes = clamp_bytes(ram / 5, GIB, 8 * GIB);
+            s->dirty_expire_centisecs = 6000;
+            s->net_buffer_max = (guint)clamp_bytes(bdp, 16 * MIB, 64 * MIB);
+            s->net_bbr = TRUE;
+            break;
+        case PERF_PROFILE_DESKTOP:
+            s->dirty_background_bytes = 64 * MIB;
+            s->dirty_bytes = 256 * MIB;
+            s->dirty_expire_centisecs = 1500;
+            s->net_buffer_max = 4 * MIB;
+            s->net_bbr = FALSE;
+            break;
+        case PERF_PROFILE_SERVER:
+            s->dirty_background_bytes = clamp_bytes(ram / 50, 128 * MIB, GIB);
+            s->dirty_bytes = clamp_bytes(ram / 12, 512 * MIB, 4 * GIB);
+            s->dirty_expire_centisecs = 1500;
+            s->net_buffer_max = (guint)clamp_bytes(bdp, 16 * MIB, 64 * MIB);
+            s->net_bbr = TRUE;
+            break;
+        default:
+            s->dirty_background_bytes = clamp_bytes(ram / 100, 64 * MIB, 256 * MIB);
+            s->dirty_bytes = s->dirty_background_bytes * 4;
+            s->dirty_expire_centisecs = 3000;
+            s->net_buffer_max = (guint)clamp_bytes(bdp, 4 * MIB, 16 * MIB);
+            s->net_bbr = FALSE;
+            break;
+    }
+
+    /* Un disco mecánico vacía despacio: la mitad para no bloquear escrituras */
+    if (hdd && (profile == PERF_PROFILE_DESKTOP || profile == PERF_PROFILE_BALANCED)) {
+        s->dirty_background_bytes /= 2;
+        s->dirty_bytes /= 2;
+    }
+}
+
+const gchar *perf_profile_id(PerfProfile profile)
+{
+    if (profile >= PERF_PROFILE_BALANCED && profile <= PERF_PROFILE_SERVER)
+        return profile_ids[profile];
+    return profile_ids[PERF_PROFILE_BALANCED];
+}
+
+PerfProfile perf_profile_from_id(const gchar *id)
+{
+    for (guint i = 0; i < G_N_ELEMENTS(profile_ids); i++) {
+        if (g_strcmp0(id, profile_ids[i]) == 0)
+            return (PerfProfile)i;
+    }
+    return PERF_PROFILE_BALANCED;
+}
+
+const gchar *perf_profile_label(PerfProfile profile)
+{
+    switch (profile) {
+        case PERF_PROFILE_THROUGHPUT: return i18n_t("Máximo rendimiento");
+        case PERF_PROFILE_DESKTOP:    return i18n_t("Escritorio de baja latencia");
+        case PERF_PROFILE_SERVER:     return i18n_t("Servidor");
+        default:                      return i18n_t("Equilibrado");
+    }
+}
+
+static void upsert_uint64(GString *content, const gchar *name, guint64 value)
+{
+    gchar buf[32];
+    g_snprintf(buf, sizeof(buf), "%" G_GUINT64_FORMAT, value);
+    vars_upsert(content, name, buf);
+}
+
+void perf_profile_update_variables(GString *content)
+{
+    g_return_if_fail(content != NULL);
+
+    gchar *profile_id = vars_get(content, "PERFORMANCE_PROFILE");
+    gchar *driver_video = vars_get(content, "DRIVER_VIDEO");
+    gchar *storage_class = vars_get(content, "STORAGE_CLASS");
+    PerfProfile profile = perf_profile_from_id(profile_id);
+
+    PerfHardware hw;
+    PerfSettings settings;
+    perf_hardware_detect(driver_video, &hw);
+    perf_profile_compute(profile, &hw, storage_class, &settings);
+
+    vars_upsert(content, "PERFORMANCE_PROFILE", perf_profile_id(profile));
+    vars_upsert(content, "PERF_SCHED_NVME", settings.sched_nvme);
+    vars_upsert(content, "PERF_SCHED_SSD", settings.sched_ssd);
+    vars_upsert(content, "PERF_SCHED_HDD", settings.sched_hdd);
+    vars_upsert(content, "PERF_GOVERNOR", settings.governor ? settings.governor : "");
+    vars_upsert(content, "PERF_EPP", settings.epp ? settings.epp : "");
+    upsert_uint64(content, "PERF_DIRTY_BYTES", settings.dirty_bytes);
+    upsert_uint64(content, "PERF_DIRTY_BACKGROUND_BYTES", settings.dirty_background_bytes);
+    upsert_uint64(content, "PERF_DIRTY_EXPIRE_CENTISECS", settings.dirty_expire_centisecs);
+    upsert_uint64(content, "PERF_NET_BUFFER_MAX", settings.net_buffer_max);
+    vars_upsert(content, "PERF_NET_BBR", settings.net_bbr ? "true" : "false");
+
+    LOG_INFO("Perfil de rendimiento %s: E/S %s/%s/%s, gobernador %s, EPP %s, dirty %" G_GUINT64_FORMAT "/%" G_GUINT64_FORMAT " MiB",
+             perf_profile_id(profile), settings.sched_nvme, settings.sched_ssd, settings.sched_hdd,
+             settings.governor ? settings.governor : "-", settings.epp ? settings.epp : "-",
+             settings.dirty_background_bytes / MIB, settings.dirty_bytes / MIB);
+
+    g_free(storage_class);
+    g_free(driver_video);
+    g_free(profile_id);
+}
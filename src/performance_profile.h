@@ -0,0 +1,56 @@
+#ifndef PERFORMANCE_PROFILE_H
+#define PERFORMANCE_PROFILE_H
+
+#include <glib.h>
+
+/* Perfil de rendimiento del sistema instalado (PERFORMANCE_PROFILE en variables.sh) */
+typedef enum {
+    PERF_PROFILE_BALANCED = 0,
+    PERF_PROFILE_THROUGHPUT,
+    PERF_PROFILE_DESKTOP,
+    PERF_PROFILE_SERVER
+} PerfProfile;
+
+/* Hardware del equipo que influye en el ajuste */
+typedef struct {
+    gchar    cpufreq_driver[32];   /* intel_pstate, amd-pstate-epp, acpi-cpufreq... ("" sin cpufreq) */
+    gboolean has_epp;              /* energy_performance_preference disponible */
+    gboolean is_laptop;            /* hay batería en /sys/class/power_supply */
+    gboolean is_virtual_machine;   /* driver de video "Máquina Virtual" elegido en la ventana de hardware */
+    guint64  ram_bytes;
+    guint    link_speed_mbps;      /* interfaz cableada más rápida (0 si no hay) */
+} PerfHardware;
+
+/* Valores que config_performance.sh aplica en el sistema instalado */
+typedef struct {
+    const gchar *sched_nvme;       /* planificador de E/S por clase de dispositivo */
+    const gchar *sched_ssd;
+    const gchar *sched_hdd;
+    const gchar *governor;         /* NULL si no hay cpufreq */
+    const gchar *epp;              /* NULL si no hay EPP o el gobernador lo fija */
+    guint64 dirty_bytes;
+    guint64 dirty_background_bytes;
+    guint   dirty_expire_centisecs;
+    guint   net_buffer_max;        /* net.core.{r,w}mem_max y máximo de tcp_{r,w}mem */
+    gboolean net_bbr;              /* fq + BBR para enlaces rápidos */
+} PerfSettings;
+
+/* Detecta CPU/cpufreq, batería, RAM y red del equipo; driver_video es DRIVER_VIDEO */
+void perf_hardware_detect(const gchar *driver_video, PerfHardware *hw);
+
+/* Calcula los ajustes del perfil para ese hardware; storage_class es STORAGE_CLASS
+ * del disco de destino ("nvme", "ssd", "hdd" o NULL) */
+void perf_profile_compute(PerfProfile profile, const PerfHardware *hw,
+                          const gchar *storage_class, PerfSettings *settings);
+
+/* Nombre estable del perfil ("balanced", "throughput", "desktop", "server") */
+const gchar *perf_profile_id(PerfProfile profile);
+PerfProfile perf_profile_from_id(const gchar *id);
+
+/* Nombre traducido para la ventana del sistema y el resumen de la página 7 */
+const gchar *perf_profile_label(PerfProfile profile);
+
+/* Recalcula PERF_* a partir de PERFORMANCE_PROFILE, DRIVER_VIDEO y STORAGE_CLASS */
+void perf_profile_update_variables(GString *content);
+
+#endif /* PERFORMANCE_PROFILE_H */
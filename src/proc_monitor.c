@@ -0,0 +1,330 @@
+#include "proc_monitor.h"
+#include "config.h"
+#include "trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    GPid    pid;
+    GPid    ppid;
+    gchar   state;
+    guint64 cpu_ticks;
+    guint64 rss_pages;
+} ProcEntry;
+
+struct _ProcMonitor {
+    GPid root;
+    gchar *disk;
+    ProcSnapshot first;
+    ProcSnapshot last;
+    ProcSnapshot last_journal;
+    gdouble history[PROC_METRIC_COUNT][PROC_MONITOR_HISTORY];
+    guint history_len;
+    FILE *journal;
+    guint samples;
+};
+
+/* Lee un archivo pequeño de /proc en buffer (terminado en NUL); -1 si falla */
+static gssize proc_read(const gchar *path, gchar *buffer, gsize size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    gsize total = 0;
+    while (total < size - 1) {
+        gssize n = read(fd, buffer + total, size - 1 - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        total += n;
+    }
+    close(fd);
+    buffer[total] = '\0';
+    return total;
+}
+
+static gboolean proc_is_pid(const gchar *name)
+{
+    if (!g_ascii_isdigit(name[0])) return FALSE;
+    for (const gchar *p = name; *p; p++)
+        if (!g_ascii_isdigit(*p)) return FALSE;
+    return TRUE;
+}
+
+/* /proc/PID/stat: el nombre va entre paréntesis y puede contener espacios,
+ * así que los campos se cuentan desde el último ')' */
+static gboolean proc_read_stat(GPid pid, ProcEntry *entry)
+{
+    gchar path[64], buffer[1024];
+    g_snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    if (proc_read(path, buffer, sizeof(buffer)) <= 0) return FALSE;
+
+    gchar *fields = strrchr(buffer, ')');
+    if (!fields) return FALSE;
+
+    /* Campo 3 (estado) en adelante: 4 ppid, 14-17 utime stime cutime cstime, 24 rss */
+    gchar **tokens = g_strsplit(g_strchug(fields + 1), " ", 24);
+    gboolean ok = g_strv_length(tokens) >= 23;
+    if (ok) {
+        entry->pid = pid;
+        entry->state = tokens[0][0];
+        entry->ppid = atoi(tokens[1]);
+        entry->cpu_ticks = 0;
+        for (int i = 11; i <= 14; i++)
+            entry->cpu_ticks += g_ascii_strtoull(tokens[i], NULL, 10);
+        entry->rss_pages = g_ascii_strtoull(tokens[21], NULL, 10);
+    }
+    g_strfreev(tokens);
+    return ok;
+}
+
+/* Sectores leídos y escritos del disco en /proc/diskstats (legible por
+ * cualquier usuario). Los sectores son siempre de 512 bytes, sea cual sea el
+ * tamaño lógico del disco */
+static void proc_read_diskstats(const gchar *disk, ProcSnapshot *snapshot)
+{
+    gchar buffer[32768];
+    if (!disk || proc_read("/proc/diskstats", buffer, sizeof(buffer)) <= 0) return;
+
+    /* "major minor nombre lecturas fusionadas sectores_leídos ms escrituras fusionadas sectores_escritos ..." */
+    gchar **lines = g_strsplit(buffer, "\n", -1);
+    for (guint i = 0; lines[i]; i++) {
+        gchar name[64];
+        guint64 sectors_read, sectors_written;
+        if (sscanf(lines[i], "%*u %*u %63s %*u %*u %" G_GUINT64_FORMAT " %*u %*u %*u %" G_GUINT64_FORMAT,
+                   name, &sectors_read, &sectors_written) != 3)
+            continue;
+        if (g_strcmp0(name, disk) != 0) continue;
+
+        snapshot->read_bytes = sectors_read * 512;
+        snapshot->write_bytes = sectors_written * 512;
+        break;
+    }
+    g_strfreev(lines);
+}
+
+static void proc_read_net(ProcSnapshot *snapshot)
+{
+    gchar buffer[16384];
+    if (proc_read("/proc/net/dev", buffer, sizeof(buffer)) <= 0) return;
+
+    /* Dos líneas de cabecera; luego "iface: rx_bytes ... (8 campos) tx_bytes ..." */
+    gchar **lines = g_strsplit(buffer, "\n", -1);
+    for (guint i = 2; lines[i]; i++) {
+        gchar *colon = strchr(lines[i], ':');
+        if (!colon) continue;
+        *colon = '\0';
+        if (g_strcmp0(g_strstrip(lines[i]), "lo") == 0) continue;
+
+        guint64 values[9] = { 0 };
+        gchar *cursor = colon + 1;
+        for (int k = 0; k < 9; k++)
+            values[k] = g_ascii_strtoull(cursor, &cursor, 10);
+        snapshot->net_rx_bytes += values[0];
+        snapshot->net_tx_bytes += values[8];
+    }
+    g_strfreev(lines);
+}
+
+gboolean proc_snapshot_take(GPid root, const gchar *disk, ProcSnapshot *snapshot)
+{
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "proc_snapshot_take");
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->time_us = g_get_monotonic_time();
+    proc_read_net(snapshot);
+    proc_read_diskstats(disk, snapshot);
+
+    GDir *dir = g_dir_open("/proc", 0, NULL);
+    if (!dir) return FALSE;
+
+    GArray *entries = g_array_new(FALSE, FALSE, sizeof(ProcEntry));
+    const gchar *name;
+    while ((name = g_dir_read_name(dir))) {
+        ProcEntry entry;
+        if (proc_is_pid(name) && proc_read_stat(atoi(name), &entry))
+            g_array_append_val(entries, entry);
+    }
+    g_dir_close(dir);
+
+    /* Descendientes de root: se agregan los hijos de los ya incluidos hasta
+     * que una pasada no encuentra ninguno nuevo */
+    GHashTable *tree = g_hash_table_new(g_direct_hash, g_direct_equal);
+    for (guint i = 0; i < entries->len; i++) {
+        ProcEntry *entry = &g_array_index(entries, ProcEntry, i);
+        if (entry->pid == root) {
+            /* Un zombi ya terminó aunque su padre no lo haya recogido */
+            if (entry->state != 'Z')
+                g_hash_table_add(tree, GINT_TO_POINTER(root));
+            break;
+        }
+    }
+    gboolean found = g_hash_table_size(tree) > 0;
+    gboolean grew = found;
+    while (grew) {
+        grew = FALSE;
+        for (guint i = 0; i < entries->len; i++) {
+            ProcEntry *entry = &g_array_index(entries, ProcEntry, i);
+            if (!g_hash_table_contains(tree, GINT_TO_POINTER(entry->pid)) &&
+                g_hash_table_contains(tree, GINT_TO_POINTER(entry->ppid))) {
+                g_hash_table_add(tree, GINT_TO_POINTER(entry->pid));
+                grew = TRUE;
+            }
+        }
+    }
+
+    static glong page_size = 0;
+    if (page_size == 0) page_size = sysconf(_SC_PAGESIZE);
+
+    for (guint i = 0; i < entries->len; i++) {
+        ProcEntry *entry = &g_array_index(entries, ProcEntry, i);
+        if (!g_hash_table_contains(tree, GINT_TO_POINTER(entry->pid))) continue;
+
+        snapshot->processes++;
+        snapshot->cpu_ticks += entry->cpu_ticks;
+        snapshot->rss_bytes += entry->rss_pages * page_size;
+    }
+
+    g_hash_table_destroy(tree);
+    g_array_free(entries, TRUE);
+    return found;
+}
+
+const gchar *proc_find_running(const gchar *const *names, gboolean full_cmdline)
+{
+    GDir *dir = g_dir_open("/proc", 0, NULL);
+    if (!dir) return NULL;
+
+    GPid self = getpid();
+    const gchar *match = NULL;
+    const gchar *name;
+    while (!match && (name = g_dir_read_name(dir))) {
+        if (!proc_is_pid(name) || atoi(name) == self) continue;
+
+        gchar path[64], buffer[4096];
+        g_snprintf(path, sizeof(path), "/proc/%s/%s", name, full_cmdline ? "cmdline" : "comm");
+        gssize length = proc_read(path, buffer, sizeof(buffer));
+        if (length <= 0) continue;
+
+        /* cmdline separa los argumentos con NUL; pgrep -f los une con espacios */
+        for (gssize i = 0; i < length; i++)
+            if (buffer[i] == '\0') buffer[i] = ' ';
+
+        for (int i = 0; names[i]; i++) {
+            if (strstr(buffer, names[i])) {
+                match = names[i];
+                break;
+            }
+        }
+    }
+    g_dir_close(dir);
+    return match;
+}
+
+/* Valores por segundo entre dos muestras */
+static void proc_rates(const ProcSnapshot *from, const ProcSnapshot *to, gdouble rates[PROC_METRIC_COUNT],
+                       gdouble *read_rate, gdouble *write_rate, gdouble *rx_rate, gdouble *tx_rate)
+{
+    static glong ticks_per_second = 0, cpus = 0;
+    if (ticks_per_second == 0) {
+        ticks_per_second = sysconf(_SC_CLK_TCK);
+        cpus = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+    }
+
+    gdouble seconds = (to->time_us - from->time_us) / (gdouble)G_USEC_PER_SEC;
+    if (seconds <= 0) seconds = 1;
+
+    /* Un proceso que queda huérfano se lleva sus contadores: nunca negativo */
+#define PROC_DELTA(field) (to->field > from->field ? (gdouble)(to->field - from->field) : 0.0)
+    *read_rate = PROC_DELTA(read_bytes) / seconds;
+    *write_rate = PROC_DELTA(write_bytes) / seconds;
+    *rx_rate = PROC_DELTA(net_rx_bytes) / seconds;
+    *tx_rate = PROC_DELTA(net_tx_bytes) / seconds;
+    rates[PROC_METRIC_CPU] = MIN(100.0, PROC_DELTA(cpu_ticks) / ticks_per_second / seconds / cpus * 100.0);
+#undef PROC_DELTA
+    rates[PROC_METRIC_DISK] = *read_rate + *write_rate;
+    rates[PROC_METRIC_NET] = *rx_rate + *tx_rate;
+}
+
+ProcMonitor *proc_monitor_new(GPid root, const gchar *disk_path, const gchar *journal_path)
+{
+    ProcMonitor *monitor = g_new0(ProcMonitor, 1);
+    monitor->root = root;
+
+    /* /proc/diskstats usa el nombre del kernel: /dev/disk/by-id/... -> sda */
+    if (disk_path && disk_path[0]) {
+        char *resolved = realpath(disk_path, NULL);
+        monitor->disk = g_path_get_basename(resolved ? resolved : disk_path);
+        free(resolved);
+    }
+    proc_snapshot_take(root, monitor->disk, &monitor->first);
+    monitor->last = monitor->first;
+    monitor->last_journal = monitor->first;
+
+    if (journal_path) {
+        monitor->journal = fopen(journal_path, "w");
+        if (!monitor->journal)
+            LOG_WARNING("No se pudo crear %s: %s", journal_path, g_strerror(errno));
+    }
+    return monitor;
+}
+
+void proc_monitor_free(ProcMonitor *monitor)
+{
+    if (!monitor) return;
+    if (monitor->journal)
+        fclose(monitor->journal);
+    g_free(monitor->disk);
+    g_free(monitor);
+}
+
+gboolean proc_monitor_sample(ProcMonitor *monitor)
+{
+    ProcSnapshot now;
+    gboolean alive = proc_snapshot_take(monitor->root, monitor->disk, &now);
+    if (!alive) return FALSE;
+
+    gdouble rates[PROC_METRIC_COUNT], read_rate, write_rate, rx_rate, tx_rate;
+    proc_rates(&monitor->last, &now, rates, &read_rate, &write_rate, &rx_rate, &tx_rate);
+
+    if (monitor->history_len == PROC_MONITOR_HISTORY) {
+        for (int m = 0; m < PROC_METRIC_COUNT; m++)
+            memmove(monitor->history[m], monitor->history[m] + 1,
+                    (PROC_MONITOR_HISTORY - 1) * sizeof(gdouble));
+        monitor->history_len--;
+    }
+    for (int m = 0; m < PROC_METRIC_COUNT; m++)
+        monitor->history[m][monitor->history_len] = rates[m];
+    monitor->history_len++;
+    monitor->last = now;
+
+    /* El diario guarda la media de cada intervalo, no la muestra suelta */
+    if (monitor->journal && ++monitor->samples % PROC_MONITOR_JOURNAL_INTERVAL == 0) {
+        proc_rates(&monitor->last_journal, &now, rates, &read_rate, &write_rate, &rx_rate, &tx_rate);
+        fprintf(monitor->journal, "%" G_GINT64_FORMAT "\t%.1f\t%" G_GUINT64_FORMAT "\t%.0f\t%.0f\t%.0f\t%.0f\t%u\n",
+                (now.time_us - monitor->first.time_us) / 1000, rates[PROC_METRIC_CPU], now.rss_bytes,
+                read_rate, write_rate, rx_rate, tx_rate, now.processes);
+        fflush(monitor->journal);
+        monitor->last_journal = now;
+    }
+    return TRUE;
+}
+
+const gdouble *proc_monitor_get_history(const ProcMonitor *monitor, ProcMetric metric, guint *count)
+{
+    *count = monitor ? monitor->history_len : 0;
+    return monitor ? monitor->history[metric] : NULL;
+}
+
+gdouble proc_monitor_get_current(const ProcMonitor *monitor, ProcMetric metric)
+{
+    if (!monitor || monitor->history_len == 0) return 0;
+    return monitor->history[metric][monitor->history_len - 1];
+}
+
+guint64 proc_monitor_get_rss(const ProcMonitor *monitor)
+{
+    return monitor ? monitor->last.rss_bytes : 0;
+}
@@ -0,0 +1,77 @@
+#ifndef PROC_MONITOR_H
+#define PROC_MONITOR_H
+
+#include <glib.h>
+
+/* Consumo de recursos de la instalación leído de /proc.
+ *
+ * El árbol de procesos que cuelga del script (script, install.sh, pacman,
+ * makepkg, mkinitcpio, el agente del chroot...) se recorre en cada muestra
+ * y se suman su CPU y memoria, junto con los contadores de red de
+ * /proc/net/dev. La CPU de cada proceso incluye la de sus hijos ya terminados
+ * (cutime/cstime), así que el total no retrocede cuando un paquete acaba de
+ * instalarse.
+ *
+ * Los bytes leídos y escritos son los del disco de destino en /proc/diskstats:
+ * la interfaz corre como usuario normal y no puede leer /proc/PID/io de los
+ * procesos de root de la instalación. La fila del disco entero suma sus
+ * particiones y lo que pasa por LUKS o LVM. */
+
+/* Serie temporal que la página 8 escribe durante la instalación; timing_finish
+ * (install_timing.sh) la incluye en el informe JSON.
+ * Columnas: ms_desde_inicio  cpu_%  rss_bytes  lectura_B/s  escritura_B/s  rx_B/s  tx_B/s  procesos */
+#define PROC_MONITOR_JOURNAL_PATH "/tmp/arcris-resources.tsv"
+
+typedef struct {
+    gint64  time_us;        /* g_get_monotonic_time() al tomarla */
+    guint   processes;
+    guint64 cpu_ticks;      /* utime+stime+cutime+cstime, en ticks de reloj */
+    guint64 rss_bytes;
+    guint64 read_bytes;     /* del disco de destino, no la de la caché */
+    guint64 write_bytes;
+    guint64 net_rx_bytes;   /* todas las interfaces salvo lo */
+    guint64 net_tx_bytes;
+} ProcSnapshot;
+
+/* Suma los recursos de root y todos sus descendientes, y la E/S del disco
+ * disk (nombre del kernel: "sda", "nvme0n1"; NULL para no medirla). FALSE si
+ * root ya no existe (los contadores de red y disco se rellenan igualmente) */
+gboolean proc_snapshot_take(GPid root, const gchar *disk, ProcSnapshot *snapshot);
+
+/* Primer proceso cuyo nombre (o línea de órdenes completa con full_cmdline)
+ * contiene alguno de names, como pgrep [-f]. Devuelve el nombre buscado que
+ * coincidió, o NULL si no hay ninguno. No cuenta el proceso actual */
+const gchar *proc_find_running(const gchar *const *names, gboolean full_cmdline);
+
+typedef enum {
+    PROC_METRIC_CPU = 0,    /* % del total de CPUs */
+    PROC_METRIC_DISK,       /* lectura + escritura, bytes/s */
+    PROC_METRIC_NET,        /* recepción + envío, bytes/s */
+    PROC_METRIC_COUNT
+} ProcMetric;
+
+/* Muestras recientes que se conservan para las gráficas */
+#define PROC_MONITOR_HISTORY 60
+
+typedef struct _ProcMonitor ProcMonitor;
+
+/* Empieza a seguir el árbol de root y la E/S de disk_path (SELECTED_DISK, se
+ * resuelven los enlaces de /dev/disk/by-*; NULL para no medirla); con
+ * journal_path se vacía el archivo y se agrega una línea cada
+ * PROC_MONITOR_JOURNAL_INTERVAL muestras */
+ProcMonitor *proc_monitor_new(GPid root, const gchar *disk_path, const gchar *journal_path);
+void proc_monitor_free(ProcMonitor *monitor);
+
+#define PROC_MONITOR_JOURNAL_INTERVAL 5
+
+/* Toma una muestra. FALSE cuando root ya terminó */
+gboolean proc_monitor_sample(ProcMonitor *monitor);
+
+/* Historial de metric, el valor más antiguo primero */
+const gdouble *proc_monitor_get_history(const ProcMonitor *monitor, ProcMetric metric, guint *count);
+
+/* Último valor de metric y memoria residente actual del árbol */
+gdouble proc_monitor_get_current(const ProcMonitor *monitor, ProcMetric metric);
+guint64 proc_monitor_get_rss(const ProcMonitor *monitor);
+
+#endif /* PROC_MONITOR_H */
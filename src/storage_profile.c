@@ -0,0 +1,230 @@
+#include "storage_profile.h"
+#include "variables_utils.h"
+#include "config.h"
+#include "i18n.h"
+#include "trace.h"
+#include <string.h>
+
+static const gchar *profile_filesystems[] = { "ext4", "btrfs", "xfs", NULL };
+
+/* Lee un entero de /sys/block/<name>/<attr>; devuelve fallback si no existe */
+static guint64 read_block_attr(const gchar *name, const gchar *attr, guint64 fallback)
+{
+    gchar *path = g_strdup_printf("/sys/block/%s/%s", name, attr);
+    gchar *content = NULL;
+    guint64 value = fallback;
+
+    if (g_file_get_contents(path, &content, NULL, NULL)) {
+        g_strstrip(content);
+        if (content[0] != '\0')
+            value = g_ascii_strtoull(content, NULL, 10);
+        g_free(content);
+    }
+
+    g_free(path);
+    return value;
+}
+
+static guint64 read_queue_attr(const gchar *name, const gchar *attr, guint64 fallback)
+{
+    gchar *queue_attr = g_strconcat("queue/", attr, NULL);
+    guint64 value = read_block_attr(name, queue_attr, fallback);
+    g_free(queue_attr);
+    return value;
+}
+
+gboolean storage_profile_detect(const gchar *disk_path, StorageProfile *profile)
+{
+    g_return_val_if_fail(profile != NULL, FALSE);
+
+    profile->storage_class = STORAGE_CLASS_UNKNOWN;
+    profile->logical_block_size = 512;
+    profile->physical_block_size = 512;
+    profile->discard = FALSE;
+    profile->secure_discard = FALSE;
+    profile->write_zeroes = FALSE;
+    profile->size_bytes = 0;
+
+    if (!disk_path || disk_path[0] == '\0')
+        return FALSE;
+
+    TRACE_SCOPE(TRACE_CAT_UDISKS, "storage profile %s", disk_path);
+
+    gchar *name = g_path_get_basename(disk_path);
+    gchar *queue = g_strdup_printf("/sys/block/%s/queue", name);
+    gboolean present = g_file_test(queue, G_FILE_TEST_IS_DIR);
+    g_free(queue);
+
+    if (!present) {
+        LOG_WARNING("Perfil de almacenamiento: /sys/block/%s no existe, se usan opciones genéricas", name);
+        g_free(name);
+        return FALSE;
+    }
+
+    gboolean rotational = read_queue_attr(name, "rotational", 1) != 0;
+    profile->logical_block_size = (guint)read_queue_attr(name, "logical_block_size", 512);
+    profile->physical_block_size = (guint)read_queue_attr(name, "physical_block_size",
+                                                          profile->logical_block_size);
+    profile->discard = read_queue_attr(name, "discard_max_bytes", 0) > 0;
+    /* Solo las tarjetas eMMC/SD implementan el discard seguro (secure trim) */
+    profile->secure_discard = profile->discard && g_str_has_prefix(name, "mmcblk");
+    profile->write_zeroes = read_queue_attr(name, "write_zeroes_max_bytes", 0) > 0;
+    /* /sys/block/<n>/size cuenta siempre sectores de 512 bytes */
+    profile->size_bytes = read_block_attr(name, "size", 0) * 512;
+
+    if (g_str_has_prefix(name, "nvme"))
+        profile->storage_class = STORAGE_CLASS_NVME;
+    else if (rotational)
+        profile->storage_class = STORAGE_CLASS_HDD;
+    else
+        profile->storage_class = STORAGE_CLASS_SSD;
+
+    LOG_INFO("Perfil de almacenamiento de %s: %s, bloques %u/%u B, discard=%s",
+             disk_path, storage_profile_class_id(profile->storage_class),
+             profile->logical_block_size, profile->physical_block_size,
+             profile->discard ? "sí" : "no");
+
+    g_free(name);
+    return TRUE;
+}
+
+const gchar *storage_profile_class_id(StorageClass storage_class)
+{
+    switch (storage_class) {
+        case STORAGE_CLASS_NVME: return "nvme";
+        case STORAGE_CLASS_SSD:  return "ssd";
+        case STORAGE_CLASS_HDD:  return "hdd";
+        default:                 return "unknown";
+    }
+}
+
+gchar *storage_profile_mkfs_options(const StorageProfile *profile, const gchar *filesystem)
+{
+    g_return_val_if_fail(profile != NULL, NULL);
+
+    GPtrArray *options = g_ptr_array_new();
+
+    if (g_strcmp0(filesystem, "ext4") == 0) {
+        /* Bloques de 4 KiB alineados con el sector físico de los discos Advanced Format */
+        g_ptr_array_add(options, "-b 4096");
+        /* Con discard, mke2fs ya omite la inicialización de las tablas de
+         * inodos cuando el dispositivo garantiza leer ceros tras el discard;
+         * forzar lazy_itable_init=0 en los demás las escribiría enteras */
+        if (!profile->discard)
+            g_ptr_array_add(options, "-E nodiscard");
+    } else if (g_strcmp0(filesystem, "btrfs") == 0) {
+        if (!profile->discard)
+            g_ptr_array_add(options, "--nodiscard");
+        /* En discos mecánicos los metadatos duplicados protegen de sectores dañados */
+        if (profile->storage_class == STORAGE_CLASS_HDD)
+            g_ptr_array_add(options, "-m dup");
+    } else if (g_strcmp0(filesystem, "xfs") == 0) {
+        if (!profile->discard)
+            g_ptr_array_add(options, "-K");
+        if (profile->physical_block_size >= 4096 && profile->logical_block_size <= 4096)
+            g_ptr_array_add(options, "-s size=4096");
+    }
+
+    g_ptr_array_add(options, NULL);
+    gchar *result = g_strjoinv(" ", (gchar **)options->pdata);
+    g_ptr_array_free(options, TRUE);
+    return result;
+}
+
+gchar *storage_profile_mount_options(const StorageProfile *profile, const gchar *filesystem)
+{
+    g_return_val_if_fail(profile != NULL, NULL);
+
+    gboolean flash = profile->storage_class == STORAGE_CLASS_NVME ||
+                     profile->storage_class == STORAGE_CLASS_SSD;
+
+    if (g_strcmp0(filesystem, "btrfs") == 0) {
+        switch (profile->storage_class) {
+            case STORAGE_CLASS_NVME:
+                /* En NVMe la CPU es el cuello de botella: compresión ligera y sin autodefrag */
+                return g_strdup(profile->discard
+                    ? "noatime,compress=zstd:1,space_cache=v2,discard=async"
+                    : "noatime,compress=zstd:1,space_cache=v2");
+            case STORAGE_CLASS_SSD:
+                return g_strdup(profile->discard
+                    ? "noatime,compress=zstd:3,space_cache=v2,discard=async"
+                    : "noatime,compress=zstd:3,space_cache=v2");
+            case STORAGE_CLASS_HDD:
+                /* En discos mecánicos compensa comprimir más y desfragmentar */
+                return g_strdup("noatime,compress=zstd:3,space_cache=v2,autodefrag");
+            default:
+                return g_strdup("noatime,compress=zstd:3,space_cache=v2");
+        }
+    }
+
+    /* ext4 y xfs: lazytime agrupa las escrituras de marcas de tiempo en memoria flash */
+    return g_strdup(flash ? "noatime,lazytime" : "noatime");
+}
+
+guint storage_profile_luks_sector_size(const StorageProfile *profile)
+{
+    g_return_val_if_fail(profile != NULL, 512);
+
+    if (profile->logical_block_size > 4096)
+        return profile->logical_block_size;
+    if (profile->storage_class == STORAGE_CLASS_NVME ||
+        profile->storage_class == STORAGE_CLASS_SSD ||
+        profile->physical_block_size >= 4096)
+        return 4096;
+    return 512;
+}
+
+gboolean storage_profile_luks_no_workqueue(const StorageProfile *profile)
+{
+    g_return_val_if_fail(profile != NULL, FALSE);
+
+    return profile->storage_class == STORAGE_CLASS_NVME ||
+           profile->storage_class == STORAGE_CLASS_SSD;
+}
+
+gchar *storage_profile_describe(const StorageProfile *profile)
+{
+    g_return_val_if_fail(profile != NULL, NULL);
+
+    const gchar *class_name;
+    switch (profile->storage_class) {
+        case STORAGE_CLASS_NVME: class_name = "NVMe"; break;
+        case STORAGE_CLASS_SSD:  class_name = "SSD"; break;
+        case STORAGE_CLASS_HDD:  class_name = i18n_t("Disco mecánico"); break;
+        default:                 return g_strdup(i18n_t("Dispositivo no identificado, opciones genéricas"));
+    }
+
+    return g_strdup_printf("%s • %u/%u B%s", class_name,
+                           profile->logical_block_size, profile->physical_block_size,
+                           profile->discard ? " • TRIM" : "");
+}
+
+void storage_profile_write_variables(GString *content, const StorageProfile *profile)
+{
+    g_return_if_fail(content != NULL && profile != NULL);
+
+    vars_upsert(content, "STORAGE_CLASS", storage_profile_class_id(profile->storage_class));
+
+    for (int i = 0; profile_filesystems[i]; i++) {
+        gchar *upper = g_ascii_strup(profile_filesystems[i], -1);
+        gchar *mkfs_name = g_strdup_printf("STORAGE_MKFS_%s", upper);
+        gchar *mount_name = g_strdup_printf("STORAGE_MOUNT_%s", upper);
+        gchar *mkfs = storage_profile_mkfs_options(profile, profile_filesystems[i]);
+        gchar *mount = storage_profile_mount_options(profile, profile_filesystems[i]);
+
+        vars_upsert(content, mkfs_name, mkfs);
+        vars_upsert(content, mount_name, mount);
+
+        g_free(mount);
+        g_free(mkfs);
+        g_free(mount_name);
+        g_free(mkfs_name);
+        g_free(upper);
+    }
+
+    gchar sector_size[16];
+    g_snprintf(sector_size, sizeof(sector_size), "%u", storage_profile_luks_sector_size(profile));
+    vars_upsert(content, "STORAGE_LUKS_SECTOR_SIZE", sector_size);
+    vars_upsert(content, "STORAGE_LUKS_NO_WORKQUEUE",
+                storage_profile_luks_no_workqueue(profile) ? "true" : "false");
+}
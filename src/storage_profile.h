@@ -0,0 +1,48 @@
+#ifndef STORAGE_PROFILE_H
+#define STORAGE_PROFILE_H
+
+#include <glib.h>
+
+/* Clase del dispositivo según /sys/block/<disco>/queue */
+typedef enum {
+    STORAGE_CLASS_UNKNOWN = 0,
+    STORAGE_CLASS_NVME,
+    STORAGE_CLASS_SSD,
+    STORAGE_CLASS_HDD
+} StorageClass;
+
+typedef struct {
+    StorageClass storage_class;
+    guint    logical_block_size;   /* bytes */
+    guint    physical_block_size;  /* bytes */
+    gboolean discard;              /* el dispositivo acepta TRIM/discard */
+    gboolean secure_discard;       /* discard seguro (eMMC/SD) */
+    gboolean write_zeroes;         /* escritura de ceros delegada al dispositivo */
+    guint64  size_bytes;
+} StorageProfile;
+
+/* Clasifica el disco (p. ej. "/dev/nvme0n1"). Si sysfs no está disponible el
+ * perfil queda en STORAGE_CLASS_UNKNOWN con opciones conservadoras y se
+ * devuelve FALSE. */
+gboolean storage_profile_detect(const gchar *disk_path, StorageProfile *profile);
+
+/* Nombre estable de la clase tal como se escribe en STORAGE_CLASS ("nvme", "ssd", "hdd", "unknown") */
+const gchar *storage_profile_class_id(StorageClass storage_class);
+
+/* Opciones de mkfs y de montaje para "ext4", "btrfs" o "xfs" (cadenas recién allocadas) */
+gchar *storage_profile_mkfs_options(const StorageProfile *profile, const gchar *filesystem);
+gchar *storage_profile_mount_options(const StorageProfile *profile, const gchar *filesystem);
+
+/* Tamaño de sector de dm-crypt: 4096 en memoria flash y discos Advanced Format */
+guint storage_profile_luks_sector_size(const StorageProfile *profile);
+
+/* En NVMe/SSD dm-crypt rinde más cifrando en línea, sin sus colas de trabajo */
+gboolean storage_profile_luks_no_workqueue(const StorageProfile *profile);
+
+/* Resumen legible para la ventana de disco (p. ej. "NVMe • 512/4096 B • TRIM") */
+gchar *storage_profile_describe(const StorageProfile *profile);
+
+/* Escribe STORAGE_CLASS, STORAGE_MKFS_* / STORAGE_MOUNT_* y STORAGE_LUKS_* en el contenido de variables.sh */
+void storage_profile_write_variables(GString *content, const StorageProfile *profile);
+
+#endif /* STORAGE_PROFILE_H */
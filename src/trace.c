@@ -0,0 +1,169 @@
+#include "trace.h"
+#include "config.h"
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Evento completo ("ph":"X") o puntual ("ph":"i") del formato Chrome trace */
+typedef struct {
+    gchar   *name;
+    const gchar *category;
+    gchar    phase;
+    gint64   ts;
+    gint64   dur;
+    guint    tid;
+} TraceEvent;
+
+static gboolean g_trace_enabled = FALSE;
+static gchar *g_trace_path = NULL;
+static gint64 g_trace_origin = 0;
+static GArray *g_trace_events = NULL;
+static GMutex g_trace_mutex;
+
+/* Los hilos se numeran en orden de aparición para que el visor los agrupe */
+static GPrivate g_trace_thread_id;
+static guint g_trace_next_tid = 0;
+
+static guint trace_current_tid(void)
+{
+    guint tid = GPOINTER_TO_UINT(g_private_get(&g_trace_thread_id));
+    if (tid == 0) {
+        tid = g_atomic_int_add(&g_trace_next_tid, 1) + 1;
+        g_private_set(&g_trace_thread_id, GUINT_TO_POINTER(tid));
+    }
+    return tid;
+}
+
+void trace_init(void)
+{
+    const gchar *value = g_getenv(TRACE_ENV_VAR);
+    if (!value || value[0] == '\0' || g_strcmp0(value, "0") == 0)
+        return;
+
+    g_trace_path = g_strdup(g_strcmp0(value, "1") == 0 ? TRACE_DEFAULT_PATH : value);
+    g_trace_origin = g_get_monotonic_time();
+    g_trace_events = g_array_new(FALSE, FALSE, sizeof(TraceEvent));
+    g_trace_enabled = TRUE;
+
+    LOG_INFO("Trazado activado, se escribirá en %s", g_trace_path);
+}
+
+gboolean trace_is_enabled(void)
+{
+    return g_trace_enabled;
+}
+
+static void trace_record(const gchar *category, gchar *name, gchar phase, gint64 start, gint64 end)
+{
+    TraceEvent event = {
+        .name = name,
+        .category = category,
+        .phase = phase,
+        .ts = start - g_trace_origin,
+        .dur = end - start,
+        .tid = trace_current_tid(),
+    };
+
+    g_mutex_lock(&g_trace_mutex);
+    g_array_append_val(g_trace_events, event);
+    g_mutex_unlock(&g_trace_mutex);
+}
+
+TraceSpan trace_span_begin(const gchar *category, const gchar *format, ...)
+{
+    TraceSpan span = { category, NULL, 0 };
+    if (!g_trace_enabled)
+        return span;
+
+    va_list args;
+    va_start(args, format);
+    span.name = g_strdup_vprintf(format, args);
+    va_end(args);
+
+    span.start = g_get_monotonic_time();
+    return span;
+}
+
+void trace_span_end(TraceSpan *span)
+{
+    if (!span || !span->name)
+        return;
+
+    /* El evento toma posesión del nombre */
+    trace_record(span->category, span->name, 'X', span->start, g_get_monotonic_time());
+    span->name = NULL;
+}
+
+void trace_instant(const gchar *category, const gchar *format, ...)
+{
+    if (!g_trace_enabled)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    gchar *name = g_strdup_vprintf(format, args);
+    va_end(args);
+
+    gint64 now = g_get_monotonic_time();
+    trace_record(category, name, 'i', now, now);
+}
+
+static void append_json_string(GString *json, const gchar *value)
+{
+    g_string_append_c(json, '"');
+    for (const gchar *p = value; *p; p++) {
+        switch (*p) {
+            case '"':  g_string_append(json, "\\\""); break;
+            case '\\': g_string_append(json, "\\\\"); break;
+            case '\n': g_string_append(json, "\\n"); break;
+            case '\t': g_string_append(json, "\\t"); break;
+            default:
+                if ((guchar)*p < 0x20)
+                    g_string_append_printf(json, "\\u%04x", *p);
+                else
+                    g_string_append_c(json, *p);
+        }
+    }
+    g_string_append_c(json, '"');
+}
+
+gboolean trace_write(void)
+{
+    if (!g_trace_enabled)
+        return TRUE;
+
+    GString *json = g_string_new("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    gint pid = (gint)getpid();
+
+    g_mutex_lock(&g_trace_mutex);
+    for (guint i = 0; i < g_trace_events->len; i++) {
+        TraceEvent *event = &g_array_index(g_trace_events, TraceEvent, i);
+
+        g_string_append(json, "{\"name\":");
+        append_json_string(json, event->name);
+        g_string_append_printf(json, ",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" G_GINT64_FORMAT
+                               ",\"pid\":%d,\"tid\":%u",
+                               event->category, event->phase, event->ts, pid, event->tid);
+        if (event->phase == 'X')
+            g_string_append_printf(json, ",\"dur\":%" G_GINT64_FORMAT, event->dur);
+        else
+            g_string_append(json, ",\"s\":\"t\"");
+        g_string_append(json, i + 1 < g_trace_events->len ? "},\n" : "}\n");
+    }
+    guint count = g_trace_events->len;
+    g_mutex_unlock(&g_trace_mutex);
+
+    g_string_append(json, "]}\n");
+
+    GError *error = NULL;
+    gboolean ok = g_file_set_contents(g_trace_path, json->str, -1, &error);
+    if (ok) {
+        LOG_INFO("Traza con %u eventos escrita en %s", count, g_trace_path);
+    } else {
+        LOG_ERROR("No se pudo escribir la traza: %s", error ? error->message : "Unknown error");
+        if (error) g_error_free(error);
+    }
+
+    g_string_free(json, TRUE);
+    return ok;
+}
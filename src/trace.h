@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <glib.h>
+
+/* Variable de entorno que activa el trazado. Su valor es la ruta del JSON
+ * de salida; con "1" se usa TRACE_DEFAULT_PATH en el directorio actual. */
+#define TRACE_ENV_VAR      "ARCRIS_TRACE"
+#define TRACE_DEFAULT_PATH "arcris-trace.json"
+
+/* Categorías usadas en las trazas */
+#define TRACE_CAT_STARTUP    "startup"
+#define TRACE_CAT_UI         "ui"
+#define TRACE_CAT_NAVIGATION "navigation"
+#define TRACE_CAT_SUBPROCESS "subprocess"
+#define TRACE_CAT_UDISKS     "udisks"
+#define TRACE_CAT_NETWORK    "network"
+#define TRACE_CAT_VARIABLES  "variables"
+
+/* Intervalo abierto. Con el trazado desactivado name queda en NULL y
+ * trace_span_end no hace nada, así que el coste es una comprobación. */
+typedef struct {
+    const gchar *category;
+    gchar       *name;
+    gint64       start;
+} TraceSpan;
+
+/* Lee TRACE_ENV_VAR; llamar una vez al inicio de main */
+void trace_init(void);
+gboolean trace_is_enabled(void);
+
+/* Abre un intervalo con tiempo monotónico; el nombre admite formato printf */
+TraceSpan trace_span_begin(const gchar *category, const gchar *format, ...) G_GNUC_PRINTF(2, 3);
+void trace_span_end(TraceSpan *span);
+
+/* Evento puntual (por ejemplo, una transición de página) */
+void trace_instant(const gchar *category, const gchar *format, ...) G_GNUC_PRINTF(2, 3);
+
+/* Escribe todos los eventos en formato Chrome trace (chrome://tracing, Perfetto) */
+gboolean trace_write(void);
+
+G_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(TraceSpan, trace_span_end)
+
+/* Intervalo que se cierra automáticamente al salir del bloque actual */
+#define TRACE_SCOPE(category, ...) \
+    g_auto(TraceSpan) G_PASTE(trace_scope_, __LINE__) = trace_span_begin(category, __VA_ARGS__)
+
+#endif /* TRACE_H */
@@ -0,0 +1,692 @@
+#include "unattended.h"
+#include "config.h"
+#include "variables_utils.h"
+#include "page4.h"
+#include "golden_image.h"
+#include "partition_plan.h"
+#include "wipe_strategy.h"
+#include "performance_profile.h"
+#include "install_log.h"
+#include "install_targets.h"
+#include "storage_profile.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* Variables que la interfaz siempre escribe antes de llegar a la página 8 */
+static const gchar *required_keys[] = {
+    "LOCALE",
+    "TIMEZONE",
+    "KEYMAP_TTY",
+    "KEYBOARD_LAYOUT",
+    "SELECTED_DISK",
+    "PARTITION_MODE",
+    "USER",
+    "PASSWORD_USER",
+    "HOSTNAME",
+    NULL
+};
+
+/* Mensaje de progreso en stdout, una línea por etapa para que sea fácil de parsear */
+static void unattended_progress(const gchar *stage, const gchar *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    gchar *msg = g_strdup_vprintf(fmt, args);
+    va_end(args);
+
+    g_print("[arcris] %s: %s\n", stage, msg);
+    LOG_INFO("unattended %s: %s", stage, msg);
+    g_free(msg);
+}
+
+gboolean unattended_requested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (g_strcmp0(argv[i], UNATTENDED_OPTION) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* Quita comillas simples o dobles alrededor del valor */
+static gchar *unquote(const gchar *raw)
+{
+    gchar *value = g_strstrip(g_strdup(raw));
+    gsize len = strlen(value);
+    if (len >= 2 && (value[0] == '"' || value[0] == '\'') && value[len - 1] == value[0]) {
+        value[len - 1] = '\0';
+        memmove(value, value + 1, len - 1);
+    }
+    return value;
+}
+
+GHashTable *unattended_load_answers(const gchar *path, GError **error)
+{
+    gchar *content = NULL;
+    if (!g_file_get_contents(path, &content, NULL, error))
+        return NULL;
+
+    GHashTable *answers = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    gchar **lines = g_strsplit(content, "\n", -1);
+    g_free(content);
+
+    /* Los arrays bash (PARTITIONS=( ... )) se guardan con un elemento por línea */
+    gchar *array_name = NULL;
+    GString *array_items = NULL;
+
+    for (int i = 0; lines[i]; i++) {
+        gchar *line = g_strstrip(lines[i]);
+
+        if (array_name) {
+            gboolean closes = g_str_has_suffix(line, ")");
+            if (closes)
+                line[strlen(line) - 1] = '\0';
+            gchar *item = unquote(line);
+            if (item[0] != '\0') {
+                if (array_items->len > 0) g_string_append_c(array_items, '\n');
+                g_string_append(array_items, item);
+            }
+            g_free(item);
+            if (closes) {
+                g_hash_table_replace(answers, array_name, g_string_free(array_items, FALSE));
+                array_name = NULL;
+                array_items = NULL;
+            }
+            continue;
+        }
+
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+        if (g_str_has_prefix(line, "export "))
+            line = g_strchug(line + strlen("export "));
+
+        gchar *eq = strchr(line, '=');
+        if (!eq || eq == line)
+            continue;
+        *eq = '\0';
+        const gchar *value = eq + 1;
+
+        if (value[0] == '(') {
+            /* Array en una sola línea: NAME=() o NAME=("a" "b") se tratan igual que los multilínea */
+            array_name = g_strdup(line);
+            array_items = g_string_new("");
+            if (g_str_has_suffix(value, ")")) {
+                gchar *inner = g_strndup(value + 1, strlen(value) - 2);
+                gchar *item = unquote(inner);
+                g_string_append(array_items, item);
+                g_free(item);
+                g_free(inner);
+                g_hash_table_replace(answers, array_name, g_string_free(array_items, FALSE));
+                array_name = NULL;
+                array_items = NULL;
+            } else if (value[1] != '\0') {
+                gchar *item = unquote(value + 1);
+                g_string_append(array_items, item);
+                g_free(item);
+            }
+            continue;
+        }
+
+        g_hash_table_replace(answers, g_strdup(line), unquote(value));
+    }
+
+    if (array_name) {
+        /* Array sin cerrar: lo descartamos en lugar de adivinar su contenido */
+        LOG_WARNING("Array %s sin cerrar en %s", array_name, path);
+        g_free(array_name);
+        g_string_free(array_items, TRUE);
+    }
+
+    g_strfreev(lines);
+    return answers;
+}
+
+static gboolean is_block_device(const gchar *path)
+{
+    struct stat st;
+    return path && stat(path, &st) == 0 && S_ISBLK(st.st_mode);
+}
+
+static void add_error(GPtrArray *errors, const gchar *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    gchar *msg = g_strdup_vprintf(fmt, args);
+    va_end(args);
+
+    LOG_WARNING("Respuesta inválida: %s", msg);
+    if (errors)
+        g_ptr_array_add(errors, msg);
+    else
+        g_free(msg);
+}
+
+/* Equivalente a la validación del modo manual de page3: al menos una partición
+ * montada en "/" y todos los dispositivos configurados presentes. */
+static gboolean validate_manual_partitions(GHashTable *answers, GPtrArray *errors)
+{
+    const gchar *partitions = g_hash_table_lookup(answers, "PARTITIONS");
+    if (!partitions || partitions[0] == '\0') {
+        add_error(errors, "PARTITION_MODE=manual requiere el array PARTITIONS");
+        return FALSE;
+    }
+
+    gboolean valid = TRUE;
+    gboolean has_root = FALSE;
+    gchar **entries = g_strsplit(partitions, "\n", -1);
+
+    for (int i = 0; entries[i]; i++) {
+        /* Formato escrito por partition_manager: "device filesystem mount_point" */
+        gchar **parts = g_strsplit(entries[i], " ", 3);
+        if (!parts[0] || !parts[1] || !parts[2]) {
+            add_error(errors, "Entrada de PARTITIONS mal formada: '%s'", entries[i]);
+            valid = FALSE;
+        } else {
+            if (!is_block_device(parts[0])) {
+                add_error(errors, "La partición %s no existe", parts[0]);
+                valid = FALSE;
+            }
+            if (g_strcmp0(parts[2], "/") == 0)
+                has_root = TRUE;
+        }
+        g_strfreev(parts);
+    }
+    g_strfreev(entries);
+
+    if (!has_root) {
+        add_error(errors, "PARTITIONS no contiene una partición raíz ('/')");
+        valid = FALSE;
+    }
+    return valid;
+}
+
+gboolean unattended_validate_answers(GHashTable *answers, GPtrArray *errors)
+{
+    if (!answers) return FALSE;
+
+    gboolean valid = TRUE;
+
+    for (int i = 0; required_keys[i]; i++) {
+        const gchar *value = g_hash_table_lookup(answers, required_keys[i]);
+        if (!value || value[0] == '\0') {
+            add_error(errors, "Falta la variable %s", required_keys[i]);
+            valid = FALSE;
+        }
+    }
+
+    /* Página 3: disco seleccionado y modo de particionado */
+    const gchar *disk = g_hash_table_lookup(answers, "SELECTED_DISK");
+    if (disk && disk[0] != '\0' && !is_block_device(disk)) {
+        add_error(errors, "SELECTED_DISK=%s no es un dispositivo de bloques", disk);
+        valid = FALSE;
+    }
+
+    const gchar *mode = g_hash_table_lookup(answers, "PARTITION_MODE");
+    if (g_strcmp0(mode, "manual") == 0) {
+        if (!validate_manual_partitions(answers, errors))
+            valid = FALSE;
+    } else if (mode && g_strcmp0(mode, "auto") != 0) {
+        add_error(errors, "PARTITION_MODE=%s no es válido (auto|manual)", mode);
+        valid = FALSE;
+    } else if (disk && is_block_device(disk)) {
+        /* Particionado automático: el plan tiene que caber en el disco */
+        GError *error = NULL;
+        PartitionPlan *plan = partition_plan_new(disk,
+                                                 g_hash_table_lookup(answers, "ENCRYPTION"),
+                                                 g_hash_table_lookup(answers, "HOME_PARTITION"),
+                                                 g_hash_table_lookup(answers, "ROOT_SIZE"),
+                                                 g_hash_table_lookup(answers, "SWAP_TYPE"),
+                                                 g_hash_table_lookup(answers, "SWAP_CUSTOM_SIZE"),
+                                                 &error);
+        if (!plan) {
+            add_error(errors, "%s", error->message);
+            g_error_free(error);
+            valid = FALSE;
+        }
+        partition_plan_free(plan);
+    }
+
+    /* Ventana de disco: mismas restricciones que imponen los radio buttons */
+    const gchar *fs = g_hash_table_lookup(answers, "FILESYSTEM_TYPE");
+    if (fs && g_strcmp0(fs, "ext4") != 0 && g_strcmp0(fs, "btrfs") != 0 && g_strcmp0(fs, "xfs") != 0) {
+        add_error(errors, "FILESYSTEM_TYPE=%s no es válido (ext4|btrfs|xfs)", fs);
+        valid = FALSE;
+    }
+    const gchar *home = g_hash_table_lookup(answers, "HOME_PARTITION");
+    if (g_strcmp0(home, "subvolume") == 0 && g_strcmp0(fs, "btrfs") != 0) {
+        add_error(errors, "HOME_PARTITION=subvolume solo está disponible con btrfs");
+        valid = FALSE;
+    }
+    if (g_strcmp0(g_hash_table_lookup(answers, "ENCRYPTION"), "true") == 0) {
+        const gchar *key = g_hash_table_lookup(answers, "ENCRYPTION_KEY");
+        gsize len = key ? strlen(key) : 0;
+        if (len < 3 || len > 15) {
+            add_error(errors, "ENCRYPTION_KEY debe tener entre 3 y 15 caracteres");
+            valid = FALSE;
+        }
+    }
+
+    /* Página 4: mismas reglas que page4_is_form_valid, sin widgets */
+    Page4Data *rules = g_new0(Page4Data, 1);
+    page4_load_reserved_usernames(rules);
+
+    const gchar *user = g_hash_table_lookup(answers, "USER");
+    if (user && user[0] != '\0' && !page4_is_username_valid(user, rules)) {
+        add_error(errors, "USER=%s no es un nombre de usuario válido", user);
+        valid = FALSE;
+    }
+    const gchar *hostname = g_hash_table_lookup(answers, "HOSTNAME");
+    if (hostname && hostname[0] != '\0' && !page4_is_hostname_valid(hostname, rules)) {
+        add_error(errors, "HOSTNAME=%s no es un hostname válido", hostname);
+        valid = FALSE;
+    }
+    const gchar *password = g_hash_table_lookup(answers, "PASSWORD_USER");
+    if (password && password[0] != '\0' && !page4_is_password_length_valid(password)) {
+        add_error(errors, "PASSWORD_USER es demasiado corta");
+        valid = FALSE;
+    }
+
+    g_strfreev(rules->reserved_usernames);
+    g_free(rules);
+
+    return valid;
+}
+
+/* Instancias de install.sh del modo multi-disco que siguen en marcha */
+typedef struct {
+    GMainLoop *loop;
+    GPtrArray *targets;     /* InstallTarget* */
+    guint      pending;
+} UnattendedRun;
+
+/* Imagen maestra elegida para esta ejecución (ver --image-dir) */
+typedef struct {
+    gchar *deploy_path;     /* imagen verificada que install.sh debe volcar, o NULL */
+    gchar *capture_path;    /* imagen que install.sh debe capturar al terminar, o NULL */
+} UnattendedImage;
+
+/* Busca la imagen de estas respuestas en image_dir. Si existe y supera la
+ * verificación se despliega; si falta o está dañada se instala con pacstrap
+ * y se captura una nueva al terminar. */
+static void prepare_image(const gchar *image_dir, GHashTable *answers, UnattendedImage *image)
+{
+    if (!image_dir)
+        return;
+
+    if (g_mkdir_with_parents(image_dir, 0755) != 0) {
+        unattended_progress("image", "no se pudo crear %s, se instalará sin imagen", image_dir);
+        return;
+    }
+
+    gchar *key = golden_image_key(answers);
+    gchar *path = golden_image_path(image_dir, key);
+    GError *error = NULL;
+
+    if (golden_image_verify(path, &error)) {
+        unattended_progress("image", "imagen verificada: %s", path);
+        image->deploy_path = path;
+    } else {
+        unattended_progress("image", "sin imagen válida (%s), se capturará en %s", error->message, path);
+        g_error_free(error);
+        image->capture_path = path;
+    }
+    g_free(key);
+}
+
+/* Entorno para install.sh: ARCRIS_GOLDEN_IMAGE hace que vuelque la imagen y
+ * ejecute solo los pasos propios de la máquina; ARCRIS_CAPTURE_IMAGE hace que
+ * guarde el sistema instalado antes de desmontarlo. */
+static gchar **image_environ(gchar **envp, const UnattendedImage *image, gboolean capture)
+{
+    if (image->deploy_path)
+        envp = g_environ_setenv(envp, "ARCRIS_GOLDEN_IMAGE", image->deploy_path, TRUE);
+    else if (capture && image->capture_path)
+        envp = g_environ_setenv(envp, "ARCRIS_CAPTURE_IMAGE", image->capture_path, TRUE);
+    return envp;
+}
+
+/* Tras una instalación correcta con captura, registra la suma de la imagen nueva */
+static void finish_capture(const UnattendedImage *image)
+{
+    if (!image->capture_path)
+        return;
+
+    if (!g_file_test(image->capture_path, G_FILE_TEST_IS_REGULAR)) {
+        unattended_progress("image", "install.sh no generó %s", image->capture_path);
+        return;
+    }
+
+    GError *error = NULL;
+    if (golden_image_write_manifest(image->capture_path, &error)) {
+        unattended_progress("image", "imagen capturada: %s", image->capture_path);
+    } else {
+        unattended_progress("image", "no se pudo escribir el manifiesto: %s", error->message);
+        g_error_free(error);
+    }
+}
+
+static gchar *install_script_path(void)
+{
+    return g_build_filename(g_get_current_dir(), "data", "bash", "install.sh", NULL);
+}
+
+/* Lanza install.sh igual que page8 (a través de script, con ~/install.log.gz),
+ * pero heredando stdout/stderr en lugar de una terminal VTE. */
+static int unattended_run_install(const UnattendedImage *image)
+{
+    gchar *script_path = install_script_path();
+    if (!g_file_test(script_path, G_FILE_TEST_EXISTS)) {
+        unattended_progress("install", "script no encontrado: %s", script_path);
+        g_free(script_path);
+        return UNATTENDED_EXIT_SCRIPT_MISSING;
+    }
+
+    gchar *log_path = install_log_path(NULL);
+    gchar **argv = install_log_build_argv(NULL, script_path, log_path);
+
+    unattended_progress("install", "ejecutando %s (registro: %s)", script_path, log_path);
+
+    gint wait_status = 0;
+    GError *error = NULL;
+    int exit_code = UNATTENDED_EXIT_OK;
+    gchar **envp = image_environ(g_get_environ(), image, TRUE);
+
+    if (!g_spawn_sync(NULL, argv, envp, G_SPAWN_CHILD_INHERITS_STDIN,
+                      NULL, NULL, NULL, NULL, &wait_status, &error)) {
+        unattended_progress("install", "no se pudo ejecutar: %s", error->message);
+        g_error_free(error);
+        exit_code = UNATTENDED_EXIT_INSTALL_FAILED;
+    } else if (!g_spawn_check_wait_status(wait_status, &error)) {
+        unattended_progress("install", "falló: %s", error->message);
+        g_error_free(error);
+        exit_code = UNATTENDED_EXIT_INSTALL_FAILED;
+    } else {
+        unattended_progress("install", "completado");
+        finish_capture(image);
+    }
+
+    g_strfreev(envp);
+    g_strfreev(argv);
+    g_free(log_path);
+    g_free(script_path);
+    return exit_code;
+}
+
+static void on_target_exited(GPid pid, gint wait_status, gpointer user_data)
+{
+    UnattendedRun *run = user_data;
+    InstallTarget *target = NULL;
+    GError *error = NULL;
+
+    for (guint i = 0; i < run->targets->len && !target; i++) {
+        InstallTarget *candidate = g_ptr_array_index(run->targets, i);
+        if (candidate->pid == pid)
+            target = candidate;
+    }
+    g_spawn_close_pid(pid);
+    if (!target)
+        return;
+
+    gchar *stage = g_strdup_printf("install[%s]", target->name);
+    if (g_spawn_check_wait_status(wait_status, &error)) {
+        target->exit_code = UNATTENDED_EXIT_OK;
+        unattended_progress(stage, "completado");
+    } else {
+        target->exit_code = UNATTENDED_EXIT_INSTALL_FAILED;
+        unattended_progress(stage, "falló: %s (registro: %s)", error->message, target->log_path);
+        g_error_free(error);
+    }
+    g_free(stage);
+
+    if (--run->pending == 0)
+        g_main_loop_quit(run->loop);
+}
+
+/* Lanza una instancia de install.sh por disco, todas en paralelo (ver
+ * install_targets.h). La salida va solo al registro de cada destino para no
+ * mezclar las terminales en stdout. */
+static int unattended_run_targets(GPtrArray *targets, const UnattendedImage *image)
+{
+    gchar *script_path = install_script_path();
+    if (!g_file_test(script_path, G_FILE_TEST_EXISTS)) {
+        unattended_progress("install", "script no encontrado: %s", script_path);
+        g_free(script_path);
+        return UNATTENDED_EXIT_SCRIPT_MISSING;
+    }
+
+    UnattendedRun run = { g_main_loop_new(NULL, FALSE), targets, 0 };
+
+    for (guint i = 0; i < targets->len; i++) {
+        InstallTarget *target = g_ptr_array_index(targets, i);
+        gchar *stage = g_strdup_printf("install[%s]", target->name);
+        /* La imagen nueva se captura solo desde el primer destino */
+        gchar **envp = image_environ(g_get_environ(), image, i == 0);
+        GError *error = NULL;
+
+        if (install_target_spawn(target, script_path, envp, &error)) {
+            unattended_progress(stage, "ejecutando en %s (registro: %s)", target->disk, target->log_path);
+            g_child_watch_add(target->pid, on_target_exited, &run);
+            run.pending++;
+        } else {
+            unattended_progress(stage, "no se pudo ejecutar: %s", error->message);
+            target->exit_code = UNATTENDED_EXIT_INSTALL_FAILED;
+            g_error_free(error);
+        }
+        g_free(stage);
+    }
+
+    if (run.pending > 0)
+        g_main_loop_run(run.loop);
+    g_main_loop_unref(run.loop);
+
+    guint failed = 0;
+    for (guint i = 0; i < targets->len; i++) {
+        InstallTarget *target = g_ptr_array_index(targets, i);
+        if (target->exit_code != UNATTENDED_EXIT_OK)
+            failed++;
+    }
+    unattended_progress("install", "%u de %u discos instalados correctamente",
+                        targets->len - failed, targets->len);
+    if (targets->len > 0 && ((InstallTarget *)g_ptr_array_index(targets, 0))->exit_code == UNATTENDED_EXIT_OK)
+        finish_capture(image);
+
+    g_free(script_path);
+    return failed == 0 ? UNATTENDED_EXIT_OK : UNATTENDED_EXIT_INSTALL_FAILED;
+}
+
+/* Valor de una opción "--opcion valor" en argv, o NULL */
+static const gchar *option_value(int argc, char *argv[], const gchar *option)
+{
+    for (int i = 1; i < argc - 1; i++) {
+        if (g_strcmp0(argv[i], option) == 0)
+            return argv[i + 1];
+    }
+    return NULL;
+}
+
+/* Construye los destinos de --targets y valida las respuestas para cada disco.
+ * Devuelve NULL si algún destino no es válido. */
+static GPtrArray *prepare_targets(const gchar *targets_arg, GHashTable *answers)
+{
+    GPtrArray *targets = g_ptr_array_new_with_free_func((GDestroyNotify)install_target_free);
+    gchar **disks = g_strsplit(targets_arg, ",", -1);
+    gboolean valid = TRUE;
+
+    /* PARTITIONS apunta a particiones de un disco concreto: no se puede replicar */
+    if (g_strcmp0(g_hash_table_lookup(answers, "PARTITION_MODE"), "manual") == 0) {
+        unattended_progress("validate", "%s requiere PARTITION_MODE=auto", INSTALL_TARGETS_OPTION);
+        valid = FALSE;
+    }
+
+    for (int i = 0; valid && disks[i]; i++) {
+        gchar *disk = g_strstrip(disks[i]);
+        if (disk[0] == '\0')
+            continue;
+
+        gchar *name = g_path_get_basename(disk);
+        for (guint j = 0; j < targets->len; j++) {
+            InstallTarget *other = g_ptr_array_index(targets, j);
+            if (g_strcmp0(other->name, name) == 0) {
+                unattended_progress("validate", "disco repetido en %s: %s", INSTALL_TARGETS_OPTION, disk);
+                valid = FALSE;
+            }
+        }
+
+        /* Se validan las respuestas comunes con SELECTED_DISK apuntando a este destino */
+        g_hash_table_replace(answers, g_strdup("SELECTED_DISK"), g_strdup(disk));
+        GPtrArray *errors = g_ptr_array_new_with_free_func(g_free);
+        if (!unattended_validate_answers(answers, errors))
+            valid = FALSE;
+        for (guint j = 0; j < errors->len; j++)
+            unattended_progress("validate", "[%s] %s", name, (const gchar *)g_ptr_array_index(errors, j));
+        g_ptr_array_unref(errors);
+
+        InstallTarget *target = install_target_new(disk);
+        target->exit_code = UNATTENDED_EXIT_INSTALL_FAILED;
+        g_ptr_array_add(targets, target);
+        g_free(name);
+    }
+    g_strfreev(disks);
+
+    if (valid && targets->len == 0) {
+        unattended_progress("validate", "%s no contiene ningún disco", INSTALL_TARGETS_OPTION);
+        valid = FALSE;
+    }
+    if (!valid) {
+        g_ptr_array_unref(targets);
+        return NULL;
+    }
+    return targets;
+}
+
+static int unattended_main_targets(const gchar *answers_path, const gchar *targets_arg,
+                                   GHashTable *answers, const UnattendedImage *image)
+{
+    GPtrArray *targets = prepare_targets(targets_arg, answers);
+    g_hash_table_unref(answers);
+    if (!targets) {
+        unattended_progress("validate", "respuestas inválidas, instalación cancelada");
+        return UNATTENDED_EXIT_VALIDATION;
+    }
+    unattended_progress("validate", "respuestas válidas para %u discos", targets->len);
+
+    gchar *content = NULL;
+    GError *error = NULL;
+    if (!g_file_get_contents(answers_path, &content, NULL, &error)) {
+        unattended_progress("answers", "no se pudo leer: %s", error->message);
+        g_error_free(error);
+        g_ptr_array_unref(targets);
+        return UNATTENDED_EXIT_ANSWERS;
+    }
+
+    for (guint i = 0; i < targets->len; i++) {
+        InstallTarget *target = g_ptr_array_index(targets, i);
+        if (!install_target_write_variables(target, content, &error)) {
+            unattended_progress("answers", "no se pudo escribir %s: %s",
+                                target->variables_path, error->message);
+            g_error_free(error);
+            g_free(content);
+            g_ptr_array_unref(targets);
+            return UNATTENDED_EXIT_ANSWERS;
+        }
+        unattended_progress("answers", "copiadas a %s", target->variables_path);
+    }
+    g_free(content);
+
+    int exit_code = unattended_run_targets(targets, image);
+    g_ptr_array_unref(targets);
+    return exit_code;
+}
+
+static int unattended_main_single(const gchar *answers_path, GHashTable *answers,
+                                  const UnattendedImage *image)
+{
+    GError *error = NULL;
+    GPtrArray *errors = g_ptr_array_new_with_free_func(g_free);
+    gboolean valid = unattended_validate_answers(answers, errors);
+    for (guint i = 0; i < errors->len; i++)
+        unattended_progress("validate", "%s", (const gchar *)g_ptr_array_index(errors, i));
+    g_ptr_array_unref(errors);
+    g_hash_table_unref(answers);
+
+    if (!valid) {
+        unattended_progress("validate", "respuestas inválidas, instalación cancelada");
+        return UNATTENDED_EXIT_VALIDATION;
+    }
+    unattended_progress("validate", "respuestas válidas");
+
+    /* install.sh y los scripts que incluye leen siempre VARIABLES_FILE_PATH;
+     * el perfil del disco y el plan de particiones se recalculan para este
+     * equipo, igual que en install_target_write_variables() */
+    gchar *raw = NULL;
+    GString *content = NULL;
+    if (g_file_get_contents(answers_path, &raw, NULL, &error)) {
+        content = g_string_new(raw);
+        gchar *disk = vars_get(content, "SELECTED_DISK");
+        StorageProfile profile;
+        storage_profile_detect(disk, &profile);
+        storage_profile_write_variables(content, &profile);
+        g_free(disk);
+        /* Los otros sistemas de las respuestas son los del equipo donde se
+         * capturaron: config_grub.sh los vuelve a buscar en este */
+        vars_remove(content, "OS_PROBER_NEEDED");
+        vars_remove(content, "OTHER_OS_ESPS");
+        vars_remove(content, "OTHER_OS_FOUND");
+        wipe_strategy_update_variables(content);
+        partition_plan_update_variables(content);
+        perf_profile_update_variables(content);
+        vars_trim_trailing_newlines(content);
+    }
+    if (!content || !g_file_set_contents(VARIABLES_FILE_PATH, content->str, -1, &error)) {
+        unattended_progress("answers", "no se pudo escribir %s: %s",
+                            VARIABLES_FILE_PATH, error ? error->message : "error desconocido");
+        g_clear_error(&error);
+        if (content) g_string_free(content, TRUE);
+        g_free(raw);
+        return UNATTENDED_EXIT_ANSWERS;
+    }
+    g_string_free(content, TRUE);
+    g_free(raw);
+    unattended_progress("answers", "copiadas a %s", VARIABLES_FILE_PATH);
+
+    return unattended_run_install(image);
+}
+
+int unattended_main(int argc, char *argv[])
+{
+    const gchar *answers_path = option_value(argc, argv, UNATTENDED_OPTION);
+    const gchar *targets_arg = option_value(argc, argv, INSTALL_TARGETS_OPTION);
+    const gchar *image_dir = option_value(argc, argv, GOLDEN_IMAGE_OPTION);
+
+    if (!answers_path || g_str_has_prefix(answers_path, "--")) {
+        g_printerr("Uso: %s %s <archivo de respuestas> [%s /dev/sdX,/dev/sdY] [%s <directorio>]\n",
+                   argv[0], UNATTENDED_OPTION, INSTALL_TARGETS_OPTION, GOLDEN_IMAGE_OPTION);
+        return UNATTENDED_EXIT_USAGE;
+    }
+
+    unattended_progress("answers", "cargando %s", answers_path);
+
+    GError *error = NULL;
+    GHashTable *answers = unattended_load_answers(answers_path, &error);
+    if (!answers) {
+        unattended_progress("answers", "no se pudo leer: %s", error ? error->message : "error desconocido");
+        g_clear_error(&error);
+        return UNATTENDED_EXIT_ANSWERS;
+    }
+
+    /* La clave de la imagen no depende de los valores propios de cada máquina */
+    UnattendedImage image = { NULL, NULL };
+    prepare_image(image_dir, answers, &image);
+
+    int exit_code;
+    if (targets_arg) {
+        exit_code = unattended_main_targets(answers_path, targets_arg, answers, &image);
+    } else {
+        exit_code = unattended_main_single(answers_path, answers, &image);
+    }
+
+    g_free(image.deploy_path);
+    g_free(image.capture_path);
+    return exit_code;
+}
@@ -0,0 +1,39 @@
+#ifndef UNATTENDED_H
+#define UNATTENDED_H
+
+#include <glib.h>
+
+/* Opción de línea de comandos que activa el modo desatendido */
+#define UNATTENDED_OPTION "--unattended"
+
+/* Con INSTALL_TARGETS_OPTION (install_targets.h) se instala la misma
+ * configuración en varios destinos a la vez ("--targets /dev/sdb,/dev/sdc") */
+
+/* Códigos de salida del modo desatendido (estables, pensados para scripts) */
+typedef enum {
+    UNATTENDED_EXIT_OK             = 0,  /* instalación completada */
+    UNATTENDED_EXIT_USAGE          = 2,  /* argumentos inválidos */
+    UNATTENDED_EXIT_ANSWERS        = 3,  /* archivo de respuestas ilegible */
+    UNATTENDED_EXIT_VALIDATION     = 4,  /* respuestas no superan la validación */
+    UNATTENDED_EXIT_SCRIPT_MISSING = 5,  /* install.sh no encontrado */
+    UNATTENDED_EXIT_INSTALL_FAILED = 6   /* install.sh terminó con error (en algún destino) */
+} UnattendedExitCode;
+
+/* Devuelve TRUE si argv contiene UNATTENDED_OPTION. */
+gboolean unattended_requested(int argc, char *argv[]);
+
+/* Ejecuta la instalación sin interfaz gráfica a partir de argv
+ * ("arcris --unattended <respuestas> [--targets <discos>]") y devuelve un
+ * UnattendedExitCode. Con varios destinos solo devuelve OK si todos terminan bien. */
+int unattended_main(int argc, char *argv[]);
+
+/* Carga un archivo estilo variables.sh en una tabla clave → valor.
+ * Ignora comentarios y el prefijo "export"; los arrays bash se guardan con
+ * un elemento por línea y un array sin cerrar se descarta. */
+GHashTable *unattended_load_answers(const gchar *path, GError **error);
+
+/* Aplica las mismas reglas que las páginas 3, 4 y la ventana de disco.
+ * Cada problema encontrado se agrega a errors (puede ser NULL). */
+gboolean unattended_validate_answers(GHashTable *answers, GPtrArray *errors);
+
+#endif /* UNATTENDED_H */
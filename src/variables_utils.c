@@ -1,5 +1,8 @@
 #include "variables_utils.h"
 #include "config.h"
+#include "trace.h"
+
+#include <string.h>
 
 void vars_upsert(GString *content, const gchar *name, const gchar *value)
 {
@@ -112,6 +115,73 @@ void vars_upsert_after_with_comment(GString *content, const gchar *name,
     g_string_free(result, TRUE);
 }
 
+void vars_upsert_array(GString *content, const gchar *name, const gchar *const *items)
+{
+    gchar **lines = g_strsplit(content->str, "\n", -1);
+    GString *result = g_string_new("");
+    gchar *needle = g_strdup_printf("%s=(", name);
+    gboolean in_array = FALSE;
+    gboolean replaced = FALSE;
+
+    GString *block = g_string_new("");
+    g_string_append_printf(block, "%s=(\n", name);
+    for (int i = 0; items && items[i]; i++)
+        g_string_append_printf(block, "    \"%s\"\n", items[i]);
+    g_string_append(block, ")\n");
+
+    for (int i = 0; lines[i] != NULL; i++) {
+        gchar *stripped = g_strstrip(g_strdup(lines[i]));
+
+        if (in_array) {
+            if (strchr(stripped, ')'))
+                in_array = FALSE;
+        } else if (g_str_has_prefix(stripped, needle)) {
+            /* El bloque nuevo ocupa el lugar del anterior */
+            in_array = !strchr(stripped + strlen(needle), ')');
+            if (!replaced)
+                g_string_append(result, block->str);
+            replaced = TRUE;
+        } else {
+            g_string_append_printf(result, "%s\n", lines[i]);
+        }
+
+        g_free(stripped);
+    }
+
+    if (!replaced)
+        g_string_append(result, block->str);
+
+    g_string_free(block, TRUE);
+    g_free(needle);
+    g_strfreev(lines);
+    g_string_assign(content, result->str);
+    g_string_free(result, TRUE);
+}
+
+gchar *vars_get(const GString *content, const gchar *name)
+{
+    gchar **lines = g_strsplit(content->str, "\n", -1);
+    gchar *needle = g_strdup_printf("%s=", name);
+    gchar *value = NULL;
+
+    for (int i = 0; lines[i] != NULL && !value; i++) {
+        gchar *stripped = g_strstrip(g_strdup(lines[i]));
+        if (g_str_has_prefix(stripped, needle)) {
+            const gchar *raw = stripped + strlen(needle);
+            gsize len = strlen(raw);
+            if (len >= 2 && raw[0] == '"' && raw[len - 1] == '"')
+                value = g_strndup(raw + 1, len - 2);
+            else
+                value = g_strdup(raw);
+        }
+        g_free(stripped);
+    }
+
+    g_free(needle);
+    g_strfreev(lines);
+    return value;
+}
+
 void vars_remove(GString *content, const gchar *name)
 {
     gchar **lines = g_strsplit(content->str, "\n", -1);
@@ -141,29 +211,362 @@ void vars_trim_trailing_newlines(GString *content)
     }
 }
 
-gboolean vars_update(void (*apply)(GString *, gpointer), gpointer user_data)
+/* ----------------------------------------------------------------------------
+ * Transacciones
+ *
+ * Entre vars_begin() y vars_commit() los vars_update() trabajan sobre una copia
+ * en memoria de variables.sh; el commit más externo la escribe una sola vez
+ * (archivo temporal + fsync + rename). Si otro proceso cambió el archivo
+ * mientras tanto, los cambios de la transacción se aplican sobre la versión
+ * actual sentencia a sentencia en lugar de pisarla entera.
+ * ------------------------------------------------------------------------- */
+
+/* Estado de content al abrir cada nivel anidado, para que vars_rollback()
+ * descarte solo los cambios de ese nivel */
+typedef struct {
+    gchar *content;
+    guint updates;
+} VarsLevel;
+
+static struct {
+    guint depth;
+    gboolean failed;
+    gchar *base;        /* variables.sh tal como estaba en vars_begin() */
+    GString *content;   /* copia con los cambios de la transacción */
+    guint updates;
+    GPtrArray *levels;  /* VarsLevel de los niveles 2..depth */
+} vars_tx;
+
+/* Una asignación NAME=... (con todas sus líneas si es un array de varias
+ * líneas) o una línea suelta (comentarios, líneas vacías) con name = NULL. */
+typedef struct {
+    gchar *name;
+    gchar *text;
+} VarsStatement;
+
+static void vars_statement_free(gpointer data)
+{
+    VarsStatement *st = data;
+    g_free(st->name);
+    g_free(st->text);
+    g_free(st);
+}
+
+static VarsStatement *vars_statement_new(const gchar *name, const gchar *text)
+{
+    VarsStatement *st = g_new0(VarsStatement, 1);
+    st->name = g_strdup(name);
+    st->text = g_strdup(text);
+    return st;
+}
+
+/* Nombre de la variable si la línea es NAME=..., o NULL. */
+static gchar *vars_line_name(const gchar *line)
+{
+    const gchar *p = line;
+    while (*p == ' ' || *p == '\t')
+        p++;
+
+    const gchar *start = p;
+    if (!g_ascii_isalpha(*p) && *p != '_')
+        return NULL;
+    while (g_ascii_isalnum(*p) || *p == '_')
+        p++;
+
+    return *p == '=' ? g_strndup(start, p - start) : NULL;
+}
+
+static GPtrArray *vars_parse(const gchar *content)
+{
+    GPtrArray *statements = g_ptr_array_new_with_free_func(vars_statement_free);
+    const gchar *p = content;
+
+    while (*p) {
+        const gchar *eol = strchr(p, '\n');
+        const gchar *end = eol ? eol + 1 : p + strlen(p);
+        gchar *name = vars_line_name(p);
+
+        /* NAME=( sin el ) en la misma línea: el bloque sigue hasta la línea con ) */
+        if (name) {
+            const gchar *value = strchr(p, '=') + 1;
+            if (*value == '(' && !memchr(value, ')', end - value)) {
+                while (*end) {
+                    const gchar *next = strchr(end, '\n');
+                    const gchar *next_end = next ? next + 1 : end + strlen(end);
+                    gboolean closes = memchr(end, ')', next_end - end) != NULL;
+                    end = next_end;
+                    if (closes)
+                        break;
+                }
+            }
+        }
+
+        gchar *text = g_strndup(p, end - p);
+        VarsStatement *st = vars_statement_new(NULL, text);
+        st->name = name;
+        g_free(text);
+        g_ptr_array_add(statements, st);
+        p = end;
+    }
+    return statements;
+}
+
+static gint vars_find(GPtrArray *statements, const gchar *name)
+{
+    for (guint i = 0; i < statements->len; i++) {
+        VarsStatement *st = g_ptr_array_index(statements, i);
+        if (g_strcmp0(st->name, name) == 0)
+            return (gint)i;
+    }
+    return -1;
+}
+
+/* Primera aparición de cada variable, como hace vars_get() */
+static GHashTable *vars_index(GPtrArray *statements)
 {
+    GHashTable *index = g_hash_table_new(g_str_hash, g_str_equal);
+    for (guint i = 0; i < statements->len; i++) {
+        VarsStatement *st = g_ptr_array_index(statements, i);
+        if (st->name && !g_hash_table_contains(index, st->name))
+            g_hash_table_insert(index, st->name, st);
+    }
+    return index;
+}
+
+/* Aplica sobre disk los cambios que llevaron de base a staged: variables
+ * modificadas, nuevas (junto con los comentarios que las preceden, detrás de
+ * la variable anterior) y eliminadas. Lo que cambió en disco y la transacción
+ * no tocó se conserva. Devuelve cuántas variables cambiaron en los dos lados. */
+static guint vars_rebase(GString *result, const gchar *base, const gchar *staged, const gchar *disk)
+{
+    GPtrArray *b = vars_parse(base);
+    GPtrArray *s = vars_parse(staged);
+    GPtrArray *d = vars_parse(disk);
+    GHashTable *base_index = vars_index(b);
+    GHashTable *staged_index = vars_index(s);
+    GHashTable *disk_index = vars_index(d);
+    guint conflicts = 0;
+    guint pending_comments = 0;
+
+    for (guint i = 0; i < s->len; i++) {
+        VarsStatement *st = g_ptr_array_index(s, i);
+        if (!st->name) {
+            pending_comments++;
+            continue;
+        }
+        guint comments = pending_comments;
+        pending_comments = 0;
+
+        if (g_hash_table_lookup(staged_index, st->name) != st)
+            continue;
+
+        VarsStatement *before = g_hash_table_lookup(base_index, st->name);
+        if (before && g_strcmp0(before->text, st->text) == 0)
+            continue;
+
+        gint pos = vars_find(d, st->name);
+        if (pos >= 0) {
+            VarsStatement *current = g_ptr_array_index(d, pos);
+            if (g_strcmp0(current->text, st->text) != 0 &&
+                (!before || g_strcmp0(current->text, before->text) != 0))
+                conflicts++;
+            g_free(current->text);
+            current->text = g_strdup(st->text);
+            continue;
+        }
+
+        /* Variable nueva: detrás de la anterior de la transacción que exista
+         * en disco, o al final */
+        gint anchor = (gint)d->len - 1;
+        for (gint k = (gint)i - 1 - (gint)comments; k >= 0; k--) {
+            VarsStatement *prev = g_ptr_array_index(s, k);
+            if (prev->name && g_hash_table_contains(disk_index, prev->name)) {
+                anchor = vars_find(d, prev->name);
+                break;
+            }
+        }
+        guint first = before ? i : i - comments;
+        for (guint k = first; k <= i; k++) {
+            VarsStatement *add = g_ptr_array_index(s, k);
+            g_ptr_array_insert(d, ++anchor, vars_statement_new(add->name, add->text));
+        }
+    }
+
+    /* Variables que la transacción eliminó */
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, base_index);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        if (g_hash_table_contains(staged_index, key))
+            continue;
+        gint pos;
+        while ((pos = vars_find(d, key)) >= 0)
+            g_ptr_array_remove_index(d, pos);
+    }
+
+    g_string_truncate(result, 0);
+    for (guint i = 0; i < d->len; i++) {
+        VarsStatement *st = g_ptr_array_index(d, i);
+        g_string_append(result, st->text);
+        if (result->len > 0 && result->str[result->len - 1] != '\n')
+            g_string_append_c(result, '\n');
+    }
+
+    g_hash_table_destroy(disk_index);
+    g_hash_table_destroy(staged_index);
+    g_hash_table_destroy(base_index);
+    g_ptr_array_free(d, TRUE);
+    g_ptr_array_free(s, TRUE);
+    g_ptr_array_free(b, TRUE);
+    return conflicts;
+}
+
+static void vars_level_free(gpointer data)
+{
+    VarsLevel *level = data;
+    g_free(level->content);
+    g_free(level);
+}
+
+static void vars_tx_clear(void)
+{
+    g_clear_pointer(&vars_tx.base, g_free);
+    g_clear_pointer(&vars_tx.levels, g_ptr_array_unref);
+    if (vars_tx.content)
+        g_string_free(vars_tx.content, TRUE);
+    vars_tx.content = NULL;
+    vars_tx.failed = FALSE;
+    vars_tx.updates = 0;
+}
+
+gboolean vars_begin(void)
+{
+    if (vars_tx.depth++ > 0) {
+        VarsLevel *level = g_new0(VarsLevel, 1);
+        level->content = vars_tx.content ? g_strdup(vars_tx.content->str) : NULL;
+        level->updates = vars_tx.updates;
+        if (!vars_tx.levels)
+            vars_tx.levels = g_ptr_array_new_with_free_func(vars_level_free);
+        g_ptr_array_add(vars_tx.levels, level);
+        return !vars_tx.failed;
+    }
+
     GError *error = NULL;
-    gchar *file_content = NULL;
+    if (!g_file_get_contents(VARIABLES_FILE_PATH, &vars_tx.base, NULL, &error)) {
+        LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
+        if (error) g_error_free(error);
+        vars_tx.failed = TRUE;
+        return FALSE;
+    }
+    vars_tx.content = g_string_new(vars_tx.base);
+    return TRUE;
+}
 
-    if (!g_file_get_contents(VARIABLES_FILE_PATH, &file_content, NULL, &error)) {
+static gboolean vars_flush(void)
+{
+    GError *error = NULL;
+    gchar *disk = NULL;
+
+    vars_trim_trailing_newlines(vars_tx.content);
+
+    if (!g_file_get_contents(VARIABLES_FILE_PATH, &disk, NULL, &error)) {
         LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
         if (error) g_error_free(error);
         return FALSE;
     }
 
-    GString *content = g_string_new(file_content);
-    g_free(file_content);
+    if (g_strcmp0(disk, vars_tx.base) != 0) {
+        guint conflicts = vars_rebase(vars_tx.content, vars_tx.base, vars_tx.content->str, disk);
+        vars_trim_trailing_newlines(vars_tx.content);
+        LOG_WARNING("variables.sh cambió durante la transacción; cambios aplicados sobre la versión actual "
+                    "(%u variables modificadas en ambos lados, gana la interfaz)", conflicts);
+    }
 
-    apply(content, user_data);
-    vars_trim_trailing_newlines(content);
+    if (g_strcmp0(disk, vars_tx.content->str) == 0) {
+        g_free(disk);
+        return TRUE;
+    }
+    g_free(disk);
 
-    gboolean ok = g_file_set_contents(VARIABLES_FILE_PATH, content->str, -1, &error);
+    gboolean ok = g_file_set_contents_full(VARIABLES_FILE_PATH,
+                                           vars_tx.content->str, vars_tx.content->len,
+                                           G_FILE_SET_CONTENTS_CONSISTENT | G_FILE_SET_CONTENTS_DURABLE,
+                                           0666, &error);
     if (!ok) {
         LOG_ERROR("Error guardando variables.sh: %s", error ? error->message : "Unknown error");
         if (error) g_error_free(error);
     }
+    return ok;
+}
+
+gboolean vars_commit(void)
+{
+    g_return_val_if_fail(vars_tx.depth > 0, FALSE);
+
+    if (--vars_tx.depth > 0) {
+        g_ptr_array_remove_index(vars_tx.levels, vars_tx.levels->len - 1);
+        return !vars_tx.failed;
+    }
 
-    g_string_free(content, TRUE);
+    TRACE_SCOPE(TRACE_CAT_VARIABLES, "vars_commit");
+
+    gboolean ok = !vars_tx.failed && (vars_tx.updates == 0 || vars_flush());
+    vars_tx_clear();
     return ok;
 }
+
+void vars_rollback(void)
+{
+    g_return_if_fail(vars_tx.depth > 0);
+
+    if (--vars_tx.depth == 0) {
+        vars_tx_clear();
+        return;
+    }
+
+    /* Nivel anidado: content vuelve a como estaba en su vars_begin() y el
+     * nivel exterior sigue adelante con lo suyo */
+    VarsLevel *level = g_ptr_array_index(vars_tx.levels, vars_tx.levels->len - 1);
+    if (vars_tx.content && level->content)
+        g_string_assign(vars_tx.content, level->content);
+    vars_tx.updates = level->updates;
+    g_ptr_array_remove_index(vars_tx.levels, vars_tx.levels->len - 1);
+}
+
+gboolean vars_update(void (*apply)(GString *, gpointer), gpointer user_data)
+{
+    TRACE_SCOPE(TRACE_CAT_VARIABLES, "vars_update");
+
+    /* Dentro de una transacción el cambio solo se prepara en memoria (sin
+     * abrir un nivel: no hay nada que deshacer por separado) */
+    if (vars_tx.depth > 0) {
+        if (vars_tx.failed)
+            return FALSE;
+        apply(vars_tx.content, user_data);
+        vars_tx.updates++;
+        return TRUE;
+    }
+
+    if (!vars_begin()) {
+        vars_rollback();
+        return FALSE;
+    }
+
+    apply(vars_tx.content, user_data);
+    vars_tx.updates++;
+    return vars_commit();
+}
+
+GString *vars_read(void)
+{
+    if (vars_tx.depth > 0 && vars_tx.content)
+        return g_string_new(vars_tx.content->str);
+
+    gchar *file_content = NULL;
+    if (!g_file_get_contents(VARIABLES_FILE_PATH, &file_content, NULL, NULL))
+        return NULL;
+
+    GString *content = g_string_new(file_content);
+    g_free(file_content);
+    return content;
+}
@@ -24,13 +24,45 @@ void vars_upsert_after_with_comment(GString *content, const gchar *name,
                                     const gchar *value, const gchar *after_name,
                                     const gchar *comment);
 
+/* Replace (or append) a bash array NAME=( "item" ... ), one item per line.
+ * An existing multi-line block with the same name is removed first. */
+void vars_upsert_array(GString *content, const gchar *name, const gchar *const *items);
+
+/* Return the value of NAME= in content without surrounding quotes
+ * (newly allocated), or NULL if the variable is not present. */
+gchar *vars_get(const GString *content, const gchar *name);
+
 /* Remove a variable line from file content (in-memory). */
 void vars_remove(GString *content, const gchar *name);
 
 /* Read VARIABLES_FILE_PATH into a GString, call apply(content, user_data),
- * then write the result back.  Returns FALSE on I/O error. */
+ * then write the result back.  Returns FALSE on I/O error.
+ * Inside a transaction the change is only staged in memory. */
 gboolean vars_update(void (*apply)(GString *, gpointer), gpointer user_data);
 
+/* Start a transaction: every vars_update() until the matching vars_commit()
+ * works on an in-memory copy of VARIABLES_FILE_PATH, so a save action that
+ * touches several variables writes the file once.  Transactions nest; only
+ * the outermost commit writes.  Every vars_begin() must be paired with
+ * vars_commit() or vars_rollback(), even when it returns FALSE. */
+gboolean vars_begin(void);
+
+/* Write the staged content (temporary file, fsync, rename) if it differs
+ * from the file on disk.  If the file changed since vars_begin(), the
+ * variables changed by the transaction are applied on top of the current
+ * version instead of overwriting it.  Returns FALSE if a vars_update() in
+ * the transaction failed or on I/O error. */
+gboolean vars_commit(void);
+
+/* Discard the changes staged since the matching vars_begin().  A nested
+ * rollback only undoes its own level and the outer transaction can still be
+ * committed; the outermost rollback discards the whole transaction. */
+void vars_rollback(void);
+
+/* Current content of VARIABLES_FILE_PATH, including the changes staged by an
+ * open transaction.  NULL if the file cannot be read. */
+GString *vars_read(void);
+
 /* Remove consecutive trailing blank lines, leaving at most one final newline. */
 void vars_trim_trailing_newlines(GString *content);
 
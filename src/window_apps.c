@@ -733,47 +733,17 @@ gboolean window_apps_load_selected_apps_from_file(WindowAppsData *data)
     }
 }
 
-gboolean window_apps_save_selected_apps_to_file(WindowAppsData *data)
+// Reemplaza la línea UTILITIES_APPS=(...) o la agrega detrás de UTILITIES_ENABLED=
+static void apply_utilities_apps(GString *content, gpointer user_data)
 {
-    if (!data || !data->selected_apps) return FALSE;
-
-    // Leer archivo variables.sh actual
-    GError *error = NULL;
-    gchar *content = NULL;
-    gsize length;
-
-    if (!g_file_get_contents(VARIABLES_FILE_PATH, &content, &length, &error)) {
-        LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-
-    // Crear contenido del array
-    GString *array_content = g_string_new("UTILITIES_APPS=(");
-
-    if (g_hash_table_size(data->selected_apps) > 0) {
-        GHashTableIter iter;
-        gpointer key, value;
-        gboolean first = TRUE;
-
-        g_hash_table_iter_init(&iter, data->selected_apps);
-        while (g_hash_table_iter_next(&iter, &key, &value)) {
-            if (!first) g_string_append(array_content, " ");
-            g_string_append_printf(array_content, "\"%s\"", (gchar*)key);
-            first = FALSE;
-        }
-    }
-
-    g_string_append(array_content, ")");
-
-    // Buscar y reemplazar línea UTILITIES_APPS o agregarla
-    gchar **lines = g_strsplit(content, "\n", -1);
+    const gchar *array_line = user_data;
+    gchar **lines = g_strsplit(content->str, "\n", -1);
     GString *new_content = g_string_new("");
     gboolean found = FALSE;
 
     for (int i = 0; lines[i] != NULL; i++) {
         if (g_str_has_prefix(g_strstrip(lines[i]), "UTILITIES_APPS=")) {
-            g_string_append_printf(new_content, "%s\n", array_content->str);
+            g_string_append_printf(new_content, "%s\n", array_line);
             found = TRUE;
         } else {
             g_string_append_printf(new_content, "%s\n", lines[i]);
@@ -789,35 +759,52 @@ gboolean window_apps_save_selected_apps_to_file(WindowAppsData *data)
             g_string_append_printf(fixed, "%s\n", lines2[i]);
             if (!inserted && g_str_has_prefix(g_strstrip(lines2[i]), "UTILITIES_ENABLED=")) {
                 g_string_append_printf(fixed, "\n# Utilities apps seleccionadas por el usuario\n%s\n",
-                                       array_content->str);
+                                       array_line);
                 inserted = TRUE;
             }
         }
         if (!inserted)
             g_string_append_printf(fixed, "\n# Utilities apps seleccionadas por el usuario\n%s\n",
-                                   array_content->str);
+                                   array_line);
         g_string_assign(new_content, fixed->str);
         g_string_free(fixed, TRUE);
         g_strfreev(lines2);
     }
 
-    // Guardar archivo actualizado
-    vars_trim_trailing_newlines(new_content);
-    gboolean success = g_file_set_contents(VARIABLES_FILE_PATH, new_content->str, -1, &error);
+    g_string_assign(content, new_content->str);
+    g_string_free(new_content, TRUE);
+    g_strfreev(lines);
+}
+
+gboolean window_apps_save_selected_apps_to_file(WindowAppsData *data)
+{
+    if (!data || !data->selected_apps) return FALSE;
+
+    // Crear contenido del array
+    GString *array_content = g_string_new("UTILITIES_APPS=(");
+
+    if (g_hash_table_size(data->selected_apps) > 0) {
+        GHashTableIter iter;
+        gpointer key, value;
+        gboolean first = TRUE;
+
+        g_hash_table_iter_init(&iter, data->selected_apps);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            if (!first) g_string_append(array_content, " ");
+            g_string_append_printf(array_content, "\"%s\"", (gchar*)key);
+            first = FALSE;
+        }
+    }
+
+    g_string_append(array_content, ")");
 
-    if (success) {
+    gboolean success = vars_update(apply_utilities_apps, array_content->str);
+    if (success)
         LOG_INFO("Utilities apps guardadas como array en variables.sh");
-    } else {
-        LOG_ERROR("Error guardando en variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-    }
+    else
+        LOG_ERROR("Error guardando utilities apps en variables.sh");
 
-    // Limpiar memoria
     g_string_free(array_content, TRUE);
-    g_string_free(new_content, TRUE);
-    g_strfreev(lines);
-    g_free(content);
-
     return success;
 }
 
@@ -2,6 +2,9 @@
 #include "variables_utils.h"
 #include "config.h"
 #include "i18n.h"
+#include "trace.h"
+#include "partition_plan.h"
+#include "performance_profile.h"
 
 static WindowDiskData *g_window_disk = NULL;
 
@@ -44,6 +47,8 @@ static gchar *disk_read_var(const gchar *name)
 /* Obtiene el tamaño del disco en bytes usando lsblk */
 static guint64 disk_get_size_bytes(const gchar *disk_path)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "lsblk size %s", disk_path ? disk_path : "(null)");
+
     if (!disk_path || disk_path[0] == '\0') return 0;
 
     gchar *command = g_strdup_printf("lsblk -b -d -n -o SIZE %s", disk_path);
@@ -116,6 +121,54 @@ static void update_swap_custom_sensitivity(WindowDiskData *data)
         gtk_widget_set_sensitive(GTK_WIDGET(data->swap_size_label), active);
 }
 
+static void update_encryption_benchmark_row(WindowDiskData *data)
+{
+    if (!data->encryption_benchmark_row) return;
+
+    if (data->luks_benchmark_state != WINDOW_DISK_BENCHMARK_DONE) {
+        adw_action_row_set_subtitle(data->encryption_benchmark_row,
+            i18n_t("Midiendo el rendimiento de los cifrados..."));
+        return;
+    }
+
+    const LuksCipherChoice *choice = &data->luks_choice;
+    guint sector_size = storage_profile_luks_sector_size(&data->storage_profile);
+    gchar *subtitle;
+    if (choice->measured)
+        subtitle = g_strdup_printf("%s • %u bits • %u B\n%.0f MiB/s %s • %.0f MiB/s %s",
+                                   choice->cipher, choice->key_size, sector_size,
+                                   choice->encrypt_mibs, i18n_t("cifrado"),
+                                   choice->decrypt_mibs, i18n_t("descifrado"));
+    else
+        subtitle = g_strdup_printf("%s • %u bits • %u B\n%s",
+                                   choice->cipher, choice->key_size, sector_size,
+                                   i18n_t("No se pudo medir el rendimiento, se usan los valores por defecto"));
+    adw_action_row_set_subtitle(data->encryption_benchmark_row, subtitle);
+    g_free(subtitle);
+}
+
+static void on_luks_benchmark_done(const LuksCipherChoice *choice, gpointer user_data)
+{
+    WindowDiskData *data = user_data;
+    data->luks_choice = *choice;
+    data->luks_benchmark_state = WINDOW_DISK_BENCHMARK_DONE;
+    update_encryption_benchmark_row(data);
+
+    /* Guardar el cifrado elegido si el usuario ya activó el cifrado */
+    if (data->encryption_switch && gtk_switch_get_active(data->encryption_switch))
+        window_disk_save_to_variables(data);
+}
+
+/* La medición tarda unos segundos: se lanza al activar el cifrado, mientras se escribe la clave */
+static void start_luks_benchmark(WindowDiskData *data)
+{
+    if (data->luks_benchmark_state != WINDOW_DISK_BENCHMARK_IDLE) return;
+
+    data->luks_benchmark_state = WINDOW_DISK_BENCHMARK_RUNNING;
+    update_encryption_benchmark_row(data);
+    luks_benchmark_start(on_luks_benchmark_done, data);
+}
+
 static void update_encryption_sensitivity(WindowDiskData *data);       /* forward decl */
 static gboolean encryption_is_valid(WindowDiskData *data);             /* forward decl */
 static void encryption_disable_switch(WindowDiskData *data);           /* forward decl */
@@ -124,12 +177,44 @@ static void on_encryption_close_dialog_response(AdwAlertDialog *dialog,
                                                 gpointer        user_data); /* forward decl */
 static void show_encryption_close_dialog(WindowDiskData *data);            /* forward decl */
 
+static void update_storage_profile_row(WindowDiskData *data)
+{
+    if (!data->storage_profile_row) return;
+
+    gchar *description = storage_profile_describe(&data->storage_profile);
+    gchar *options = storage_profile_mount_options(&data->storage_profile, "btrfs");
+    gchar *subtitle = g_strdup_printf("%s\nBTRFS: %s", description, options);
+    adw_action_row_set_subtitle(data->storage_profile_row, subtitle);
+    g_free(subtitle);
+    g_free(options);
+    g_free(description);
+}
+
+/* Método de borrado y duración estimada para el disco y el modo elegidos */
+static void update_wipe_method_row(WindowDiskData *data)
+{
+    if (!data->wipe_method_row) return;
+
+    gboolean full = data->wipe_full_switch && gtk_switch_get_active(data->wipe_full_switch);
+    WipePlan plan;
+    wipe_strategy_select(&data->storage_profile, full, &plan);
+
+    gchar *subtitle = wipe_plan_describe(&plan);
+    adw_action_row_set_subtitle(data->wipe_method_row, subtitle);
+    g_free(subtitle);
+}
+
 /* Calcula disk_total_gb desde SELECTED_DISK y actualiza el suffix del expander.
  * Se llama siempre al abrir la ventana, independientemente del modo home. */
 static void window_disk_refresh_disk_size(WindowDiskData *data)
 {
     gchar *disk_path = disk_read_var("SELECTED_DISK");
     guint64 size_bytes = disk_path ? disk_get_size_bytes(disk_path) : 0;
+
+    /* Perfil del almacenamiento (disk_manager lo escribe junto con SELECTED_DISK) */
+    storage_profile_detect(disk_path, &data->storage_profile);
+    update_storage_profile_row(data);
+    update_wipe_method_row(data);
     g_free(disk_path);
 
     guint total_gb = (size_bytes > 0) ? (guint)(size_bytes / (1024ULL * 1024 * 1024)) : 60;
@@ -200,6 +285,7 @@ static void apply_disk_defaults(GString *content, gpointer user_data)
     vars_upsert_after(content, "SWAP_CUSTOM_SIZE", "1",     "SWAP_TYPE");
     vars_upsert_after(content, "ENCRYPTION",     "false", "SWAP_CUSTOM_SIZE");
     vars_upsert_after(content, "ENCRYPTION_KEY", "",      "ENCRYPTION");
+    vars_upsert_after(content, "WIPE_FULL",      "false", "ENCRYPTION_KEY");
 }
 
 void window_disk_init_variables(void)
@@ -246,6 +332,7 @@ void window_disk_load_widgets(WindowDiskData *data)
     data->encryption_password_entry = ADW_ENTRY_ROW(gtk_builder_get_object(data->builder, "encryption_password_entry"));
     data->encryption_confirm_entry  = ADW_ENTRY_ROW(gtk_builder_get_object(data->builder, "encryption_confirm_entry"));
     data->encryption_error_row      = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "encryption_error_row"));
+    data->encryption_benchmark_row  = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "encryption_benchmark_row"));
 
     /* Swap */
     data->swap_none_radio      = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "swap_none_radio"));
@@ -257,6 +344,10 @@ void window_disk_load_widgets(WindowDiskData *data)
     data->swap_increase_button = GTK_BUTTON(gtk_builder_get_object(data->builder, "swap_increase_button"));
     data->swap_size_label      = GTK_LABEL(gtk_builder_get_object(data->builder, "swap_size_label"));
 
+    /* Borrado del disco */
+    data->wipe_full_switch = GTK_SWITCH(gtk_builder_get_object(data->builder, "wipe_full_switch"));
+    data->wipe_method_row  = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "wipe_method_row"));
+
     /* Widgets para traducción */
     data->title_widget       = ADW_WINDOW_TITLE(gtk_builder_get_object(data->builder, "disk_window_title"));
     data->filesystem_group   = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "filesystem_group"));
@@ -274,6 +365,9 @@ void window_disk_load_widgets(WindowDiskData *data)
     data->swap_disabled_row   = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "swap_disabled_row"));
     data->encryption_group    = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "encryption_group"));
     data->encryption_toggle_row = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "encryption_toggle_row"));
+    data->storage_profile_row   = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "storage_profile_row"));
+    data->wipe_group            = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "wipe_group"));
+    data->wipe_full_row         = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "wipe_full_row"));
 }
 
 /* ── conexión de señales ─────────────────────────────────────────────────── */
@@ -353,6 +447,11 @@ void window_disk_connect_signals(WindowDiskData *data)
     if (data->swap_increase_button)
         g_signal_connect(data->swap_increase_button, "clicked",
                          G_CALLBACK(on_disk_swap_increase_clicked), data);
+
+    /* Borrado completo */
+    if (data->wipe_full_switch)
+        g_signal_connect(data->wipe_full_switch, "state-set",
+                         G_CALLBACK(on_disk_wipe_full_switch_toggled), data);
 }
 
 /* ── inicialización ──────────────────────────────────────────────────────── */
@@ -373,6 +472,7 @@ void window_disk_init(WindowDiskData *data)
     }
 
     window_disk_connect_signals(data);
+    luks_cipher_choice_set_default(&data->luks_choice);
 
     data->is_initialized = TRUE;
     g_window_disk = data;
@@ -472,6 +572,7 @@ void window_disk_load_from_variables(WindowDiskData *data)
             adw_expander_row_set_expanded(data->encryption_expander, FALSE);
     }
     if (enc_active) {
+        start_luks_benchmark(data);
         gchar *key = disk_read_var("ENCRYPTION_KEY");
         if (key && data->encryption_password_entry) {
             gtk_editable_set_text(GTK_EDITABLE(data->encryption_password_entry), key);
@@ -481,9 +582,16 @@ void window_disk_load_from_variables(WindowDiskData *data)
         g_free(key);
     }
 
+    /* Borrado completo */
+    gchar *wipe_full = disk_read_var("WIPE_FULL");
+    if (data->wipe_full_switch)
+        gtk_switch_set_active(data->wipe_full_switch, g_strcmp0(wipe_full, "true") == 0);
+    g_free(wipe_full);
+
     update_home_partition_sensitivity(data);
     update_swap_custom_sensitivity(data);
     update_encryption_sensitivity(data);
+    update_wipe_method_row(data);
 }
 
 /* ── guardar en variables.sh ─────────────────────────────────────────────── */
@@ -496,6 +604,8 @@ typedef struct {
     const gchar *swap_custom;
     const gchar *encryption;
     const gchar *encryption_key;
+    const LuksCipherChoice *luks_choice;
+    const gchar *wipe_full;
 } DiskSaveCtx;
 
 static void apply_disk_save(GString *content, gpointer user_data)
@@ -508,6 +618,14 @@ static void apply_disk_save(GString *content, gpointer user_data)
     vars_upsert(content, "SWAP_CUSTOM_SIZE", ctx->swap_custom);
     vars_upsert(content, "ENCRYPTION",       ctx->encryption);
     vars_upsert(content, "ENCRYPTION_KEY",   ctx->encryption_key);
+    if (ctx->luks_choice)
+        luks_benchmark_write_variables(content, ctx->luks_choice);
+    vars_upsert(content, "WIPE_FULL", ctx->wipe_full);
+    wipe_strategy_update_variables(content);
+
+    /* Raíz, swap, /home y cifrado determinan el plan de particiones */
+    partition_plan_update_variables(content);
+    perf_profile_update_variables(content);
 }
 
 gboolean window_disk_save_to_variables(WindowDiskData *data)
@@ -566,16 +684,23 @@ gboolean window_disk_save_to_variables(WindowDiskData *data)
         ctx.encryption_key = (data->encryption_password_entry)
             ? gtk_editable_get_text(GTK_EDITABLE(data->encryption_password_entry))
             : "";
+        ctx.luks_choice = &data->luks_choice;
     } else {
         ctx.encryption = "false";
         ctx.encryption_key = "";
+        ctx.luks_choice = NULL;
     }
 
+    /* Borrado completo */
+    ctx.wipe_full = (data->wipe_full_switch && gtk_switch_get_active(data->wipe_full_switch))
+        ? "true" : "false";
+
     gboolean ok = vars_update(apply_disk_save, &ctx);
 
     if (ok)
-        LOG_INFO("window_disk: guardado — fs=%s home=%s root=%s swap=%s swap_custom=%s encryption=%s",
-                 ctx.filesystem, ctx.home, ctx.root_size_buf, ctx.swap, ctx.swap_custom, ctx.encryption);
+        LOG_INFO("window_disk: guardado — fs=%s home=%s root=%s swap=%s swap_custom=%s encryption=%s storage=%s",
+                 ctx.filesystem, ctx.home, ctx.root_size_buf, ctx.swap, ctx.swap_custom, ctx.encryption,
+                 storage_profile_class_id(data->storage_profile.storage_class));
     else
         LOG_ERROR("window_disk: error al guardar configuración");
 
@@ -812,6 +937,7 @@ gboolean on_disk_encryption_switch_toggled(GtkSwitch *sw, gboolean active, gpoin
     if (active) {
         gtk_widget_set_sensitive(GTK_WIDGET(data->encryption_expander), TRUE);
         adw_expander_row_set_expanded(data->encryption_expander, TRUE);
+        start_luks_benchmark(data);
     } else {
         adw_expander_row_set_expanded(data->encryption_expander, FALSE);
         gtk_widget_set_sensitive(GTK_WIDGET(data->encryption_expander), FALSE);
@@ -828,6 +954,18 @@ gboolean on_disk_encryption_switch_toggled(GtkSwitch *sw, gboolean active, gpoin
     return FALSE;  /* permite que el estado visual del switch se confirme */
 }
 
+gboolean on_disk_wipe_full_switch_toggled(GtkSwitch *sw, gboolean active, gpointer user_data)
+{
+    (void)sw;
+    (void)active;
+    WindowDiskData *data = user_data;
+    if (!data) return FALSE;
+
+    update_wipe_method_row(data);
+    window_disk_save_to_variables(data);
+    return FALSE;  /* permite que el estado visual del switch se confirme */
+}
+
 void on_disk_encryption_password_changed(AdwEntryRow *entry, gpointer user_data)
 {
     (void)entry;
@@ -895,6 +1033,12 @@ void window_disk_update_language(WindowDiskData *data)
             i18n_t("Formatear el almacenamiento como:"));
     }
 
+    if (data->storage_profile_row) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->storage_profile_row),
+            i18n_t("Perfil del dispositivo"));
+        update_storage_profile_row(data);
+    }
+
     /* Grupo: Directorio Personal */
     if (data->home_group) {
         adw_preferences_group_set_title(data->home_group,
@@ -980,11 +1124,35 @@ void window_disk_update_language(WindowDiskData *data)
         adw_expander_row_set_subtitle(data->encryption_expander,
             i18n_t("El cifrado del disco protege sus archivos en caso de extravío del equipo"));
     }
+    if (data->encryption_benchmark_row) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->encryption_benchmark_row),
+            i18n_t("Rendimiento del cifrado"));
+        update_encryption_benchmark_row(data);
+    }
     if (data->encryption_password_entry)
         adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->encryption_password_entry),
             i18n_t("Elija una contraseña"));
     if (data->encryption_confirm_entry)
         adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->encryption_confirm_entry),
             i18n_t("Confirme su contraseña"));
+
+    /* Grupo: Borrado del disco */
+    if (data->wipe_group) {
+        adw_preferences_group_set_title(data->wipe_group,
+            i18n_t("Borrado del Disco"));
+        adw_preferences_group_set_description(data->wipe_group,
+            i18n_t("Cómo se limpia el disco antes de crear las particiones"));
+    }
+    if (data->wipe_method_row) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->wipe_method_row),
+            i18n_t("Método de borrado"));
+        update_wipe_method_row(data);
+    }
+    if (data->wipe_full_row) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->wipe_full_row),
+            i18n_t("Borrado completo"));
+        adw_action_row_set_subtitle(data->wipe_full_row,
+            i18n_t("Elimina todos los datos anteriores; el progreso se muestra durante la instalación"));
+    }
 }
 
@@ -3,6 +3,16 @@
 
 #include <gtk/gtk.h>
 #include <adwaita.h>
+#include "storage_profile.h"
+#include "luks_benchmark.h"
+#include "wipe_strategy.h"
+
+/* Medición de cifrados LUKS (se lanza una sola vez al activar el cifrado) */
+typedef enum {
+    WINDOW_DISK_BENCHMARK_IDLE = 0,
+    WINDOW_DISK_BENCHMARK_RUNNING,
+    WINDOW_DISK_BENCHMARK_DONE
+} WindowDiskBenchmarkState;
 
 typedef struct _WindowDiskData {
     GtkWindow  *window;
@@ -32,6 +42,9 @@ typedef struct _WindowDiskData {
     AdwEntryRow        *encryption_password_entry;
     AdwEntryRow        *encryption_confirm_entry;
     AdwActionRow       *encryption_error_row;
+    AdwActionRow       *encryption_benchmark_row;
+    LuksCipherChoice    luks_choice;           /* cifrado elegido tras medir */
+    WindowDiskBenchmarkState luks_benchmark_state;
 
     /* Swap */
     GtkCheckButton *swap_none_radio;
@@ -43,7 +56,12 @@ typedef struct _WindowDiskData {
     GtkButton      *swap_increase_button;
     GtkLabel       *swap_size_label;
 
+    /* Borrado del disco */
+    GtkSwitch      *wipe_full_switch;
+    AdwActionRow   *wipe_method_row;
+
     guint    disk_total_gb;   /* tamaño del disco seleccionado en GB */
+    StorageProfile storage_profile;  /* clase del disco seleccionado (/sys/block) */
     gboolean is_initialized;
 
     /* Widgets para traducción */
@@ -63,6 +81,9 @@ typedef struct _WindowDiskData {
     AdwActionRow         *swap_disabled_row;
     AdwPreferencesGroup  *encryption_group;
     AdwActionRow         *encryption_toggle_row;
+    AdwActionRow         *storage_profile_row;
+    AdwPreferencesGroup  *wipe_group;
+    AdwActionRow         *wipe_full_row;
 } WindowDiskData;
 
 /* Ciclo de vida */
@@ -93,6 +114,7 @@ void on_disk_root_scale_value_changed(GtkRange *range, gpointer user_data);
 void on_disk_swap_decrease_clicked(GtkButton *button, gpointer user_data);
 void on_disk_swap_increase_clicked(GtkButton *button, gpointer user_data);
 gboolean on_disk_encryption_switch_toggled(GtkSwitch *sw, gboolean active, gpointer user_data);
+gboolean on_disk_wipe_full_switch_toggled(GtkSwitch *sw, gboolean active, gpointer user_data);
 gboolean on_disk_window_close_request(GtkWindow *window, gpointer user_data);
 void on_disk_encryption_password_changed(AdwEntryRow *entry, gpointer user_data);
 void on_disk_encryption_confirm_changed(AdwEntryRow *entry, gpointer user_data);
@@ -2,6 +2,8 @@
 #include "config.h"
 #include "variables_utils.h"
 #include "i18n.h"
+#include "trace.h"
+#include "performance_profile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -224,6 +226,8 @@ HardwareInfo* window_hardware_detect_hardware(void)
 
 char* window_hardware_get_graphics_card_info(void)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "window_hardware_get_graphics_card_info");
+
     char *result = NULL;
     FILE *fp;
     char buffer[512];
@@ -268,6 +272,8 @@ char* window_hardware_get_graphics_card_info(void)
 
 char* window_hardware_get_audio_card_info(void)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "window_hardware_get_audio_card_info");
+
     char *result = NULL;
     FILE *fp;
     char buffer[512];
@@ -301,6 +307,8 @@ char* window_hardware_get_audio_card_info(void)
 
 char* window_hardware_get_wifi_card_info(void)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "window_hardware_get_wifi_card_info");
+
     char *result = NULL;
     FILE *fp;
     char buffer[512];
@@ -326,6 +334,8 @@ char* window_hardware_get_wifi_card_info(void)
 
 char* window_hardware_get_bluetooth_card_info(void)
 {
+    TRACE_SCOPE(TRACE_CAT_SUBPROCESS, "window_hardware_get_bluetooth_card_info");
+
     char *result = NULL;
     FILE *fp;
     char buffer[512];
@@ -750,39 +760,25 @@ gboolean window_hardware_save_to_variables(WindowHardwareData *data)
     return window_hardware_save_driver_variables(data);
 }
 
-gboolean window_hardware_save_driver_variables(WindowHardwareData *data)
+static void apply_driver_variables(GString *content, gpointer user_data)
 {
-    if (!data) return FALSE;
-
-    const char *variables_path = "data/bash/variables.sh";
-    gchar *config_content = NULL;
-    GError *error = NULL;
-
-    // Leer el archivo actual
-    if (!g_file_get_contents(variables_path, &config_content, NULL, &error)) {
-        if (error) {
-            LOG_ERROR("No se pudo leer variables.sh: %s", error->message);
-            g_error_free(error);
-        }
-        return FALSE;
-    }
-
-    GString *content = g_string_new(config_content);
-    g_free(config_content);
+    WindowHardwareData *data = user_data;
 
     vars_upsert_after_with_comment(content, "DRIVER_VIDEO",     window_hardware_get_video_driver_name(data->current_video_driver),         "SELECTED_KERNEL", "Driver de Video");
     vars_upsert_after_with_comment(content, "DRIVER_AUDIO",     window_hardware_get_audio_driver_name(data->current_audio_driver),         "DRIVER_VIDEO",    "Driver de Audio");
     vars_upsert_after_with_comment(content, "DRIVER_WIFI",      window_hardware_get_wifi_driver_name(data->current_wifi_driver),           "DRIVER_AUDIO",    "Driver de WiFi");
     vars_upsert_after_with_comment(content, "DRIVER_BLUETOOTH", window_hardware_get_bluetooth_driver_name(data->current_bluetooth_driver), "DRIVER_WIFI",     "Driver de Bluetooth");
 
-    // Escribir el archivo actualizado
-    vars_trim_trailing_newlines(content);
-    if (!g_file_set_contents(variables_path, content->str, -1, &error)) {
-        if (error) {
-            LOG_ERROR("No se pudo escribir variables.sh: %s", error->message);
-            g_error_free(error);
-        }
-        g_string_free(content, TRUE);
+    // En máquina virtual el perfil de rendimiento deja E/S y CPU al anfitrión
+    perf_profile_update_variables(content);
+}
+
+gboolean window_hardware_save_driver_variables(WindowHardwareData *data)
+{
+    if (!data) return FALSE;
+
+    if (!vars_update(apply_driver_variables, data)) {
+        LOG_ERROR("No se pudieron guardar los drivers en variables.sh");
         return FALSE;
     }
 
@@ -792,7 +788,6 @@ gboolean window_hardware_save_driver_variables(WindowHardwareData *data)
     LOG_INFO("  WiFi: %s", window_hardware_get_wifi_driver_name(data->current_wifi_driver));
     LOG_INFO("  Bluetooth: %s", window_hardware_get_bluetooth_driver_name(data->current_bluetooth_driver));
 
-    g_string_free(content, TRUE);
     return TRUE;
 }
 
@@ -844,24 +839,9 @@ WindowHardwareData* window_hardware_get_instance(void)
     return g_hardware_instance;
 }
 
-// Función para inicializar las variables de drivers por defecto al inicio de la aplicación
-gboolean window_hardware_init_default_variables(void)
+static void apply_default_driver_variables(GString *content, gpointer user_data)
 {
-    const char *variables_path = "data/bash/variables.sh";
-    gchar *config_content = NULL;
-    GError *error = NULL;
-
-    // Leer el archivo actual
-    if (!g_file_get_contents(variables_path, &config_content, NULL, &error)) {
-        if (error) {
-            LOG_ERROR("No se pudo leer variables.sh: %s", error->message);
-            g_error_free(error);
-        }
-        return FALSE;
-    }
-
-    GString *content = g_string_new(config_content);
-    g_free(config_content);
+    gboolean *initialized = user_data;
 
     gboolean video_found     = strstr(content->str, "DRIVER_VIDEO=")     != NULL;
     gboolean audio_found     = strstr(content->str, "DRIVER_AUDIO=")     != NULL;
@@ -873,22 +853,24 @@ gboolean window_hardware_init_default_variables(void)
     if (!wifi_found)      vars_upsert_after_with_comment(content, "DRIVER_WIFI",      "Ninguno",     "DRIVER_AUDIO",    "Driver de WiFi");
     if (!bluetooth_found) vars_upsert_after_with_comment(content, "DRIVER_BLUETOOTH", "Ninguno",     "DRIVER_WIFI",     "Driver de Bluetooth");
 
-    if (!video_found || !audio_found || !wifi_found || !bluetooth_found) {
-        vars_trim_trailing_newlines(content);
-        if (!g_file_set_contents(variables_path, content->str, -1, &error)) {
-            if (error) {
-                LOG_ERROR("No se pudo escribir variables.sh: %s", error->message);
-                g_error_free(error);
-            }
-            g_string_free(content, TRUE);
-            return FALSE;
-        }
-        LOG_INFO("Variables de drivers de hardware inicializadas en variables.sh");
-    } else {
-        LOG_INFO("Variables de drivers ya existen en variables.sh");
+    *initialized = !video_found || !audio_found || !wifi_found || !bluetooth_found;
+}
+
+// Función para inicializar las variables de drivers por defecto al inicio de la aplicación
+gboolean window_hardware_init_default_variables(void)
+{
+    gboolean initialized = FALSE;
+
+    // Sin variables nuevas el contenido no cambia y no se escribe el archivo
+    if (!vars_update(apply_default_driver_variables, &initialized)) {
+        LOG_ERROR("No se pudieron inicializar los drivers en variables.sh");
+        return FALSE;
     }
 
-    g_string_free(content, TRUE);
+    if (initialized)
+        LOG_INFO("Variables de drivers de hardware inicializadas en variables.sh");
+    else
+        LOG_INFO("Variables de drivers ya existen en variables.sh");
     return TRUE;
 }
 
@@ -17,6 +17,19 @@ static const char* KERNEL_NAMES[] = {
     "linux-zen"
 };
 
+// Valores de BOOTLOADER para variables.sh
+static const char* BOOTLOADER_NAMES[] = {
+    "grub",
+    "systemd-boot"
+};
+
+// Valores de INITRAMFS_PROFILE para variables.sh (ver data/bash/config_initramfs.sh)
+static const char* INITRAMFS_PROFILE_NAMES[] = {
+    "default",
+    "zstd",
+    "lz4"
+};
+
 // Función para crear nueva instancia de WindowKernelData
 WindowKernelData* window_kernel_new(void)
 {
@@ -25,6 +38,9 @@ WindowKernelData* window_kernel_new(void)
     data->window = NULL;
     data->builder = NULL;
     data->current_kernel = KERNEL_LINUX; // Por defecto
+    data->current_bootloader = BOOTLOADER_GRUB;
+    data->current_initramfs_profile = INITRAMFS_PROFILE_DEFAULT;
+    data->initramfs_fallback = TRUE;
     data->is_initialized = FALSE;
     
     // Inicializar punteros de widgets
@@ -35,6 +51,12 @@ WindowKernelData* window_kernel_new(void)
     data->lts_radio = NULL;
     data->rt_lts_radio = NULL;
     data->zen_radio = NULL;
+    data->grub_radio = NULL;
+    data->sdboot_radio = NULL;
+    data->initramfs_default_radio = NULL;
+    data->initramfs_zstd_radio = NULL;
+    data->initramfs_lz4_radio = NULL;
+    data->initramfs_fallback_switch = NULL;
     
     LOG_INFO("WindowKernelData creada");
     return data;
@@ -95,6 +117,12 @@ void window_kernel_load_widgets_from_builder(WindowKernelData *data)
     data->lts_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "lts_radio"));
     data->rt_lts_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "rt_lts_radio"));
     data->zen_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "zen_radio"));
+    data->grub_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "grub_radio"));
+    data->sdboot_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "sdboot_radio"));
+    data->initramfs_default_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "initramfs_default_radio"));
+    data->initramfs_zstd_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "initramfs_zstd_radio"));
+    data->initramfs_lz4_radio = GTK_CHECK_BUTTON(gtk_builder_get_object(data->builder, "initramfs_lz4_radio"));
+    data->initramfs_fallback_switch = ADW_SWITCH_ROW(gtk_builder_get_object(data->builder, "initramfs_fallback_switch"));
 
     // Obtener widgets de traducción
     data->kernel_window_title = ADW_WINDOW_TITLE(gtk_builder_get_object(data->builder, "kernel_window_title"));
@@ -104,6 +132,13 @@ void window_kernel_load_widgets_from_builder(WindowKernelData *data)
     data->row_lts     = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_lts"));
     data->row_rt_lts  = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_rt_lts"));
     data->row_zen     = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_zen"));
+    data->bootloader_group = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "bootloader_group"));
+    data->row_grub    = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_grub"));
+    data->row_sdboot  = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_sdboot"));
+    data->initramfs_group = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "initramfs_group"));
+    data->row_initramfs_default = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_initramfs_default"));
+    data->row_initramfs_zstd    = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_initramfs_zstd"));
+    data->row_initramfs_lz4     = ADW_ACTION_ROW(gtk_builder_get_object(data->builder, "row_initramfs_lz4"));
     
     // Verificar que se obtuvieron correctamente
     if (!data->close_button) LOG_WARNING("No se pudo obtener close_button");
@@ -113,6 +148,10 @@ void window_kernel_load_widgets_from_builder(WindowKernelData *data)
     if (!data->lts_radio) LOG_WARNING("No se pudo obtener lts_radio");
     if (!data->rt_lts_radio) LOG_WARNING("No se pudo obtener rt_lts_radio");
     if (!data->zen_radio) LOG_WARNING("No se pudo obtener zen_radio");
+    if (!data->grub_radio) LOG_WARNING("No se pudo obtener grub_radio");
+    if (!data->sdboot_radio) LOG_WARNING("No se pudo obtener sdboot_radio");
+    if (!data->initramfs_default_radio) LOG_WARNING("No se pudo obtener initramfs_default_radio");
+    if (!data->initramfs_fallback_switch) LOG_WARNING("No se pudo obtener initramfs_fallback_switch");
     
     LOG_INFO("Widgets de WindowKernel cargados desde builder");
 }
@@ -130,6 +169,14 @@ void window_kernel_setup_widgets(WindowKernelData *data)
     
     // Configurar selección por defecto (linux)
     window_kernel_set_selected_kernel(data, KERNEL_LINUX);
+
+    // systemd-boot con UKI necesita firmware UEFI
+    if (data->row_sdboot && !g_file_test("/sys/firmware/efi", G_FILE_TEST_IS_DIR))
+        gtk_widget_set_sensitive(GTK_WIDGET(data->row_sdboot), FALSE);
+    window_kernel_set_selected_bootloader(data, BOOTLOADER_GRUB);
+    window_kernel_set_selected_initramfs_profile(data, INITRAMFS_PROFILE_DEFAULT);
+    if (data->initramfs_fallback_switch)
+        adw_switch_row_set_active(data->initramfs_fallback_switch, TRUE);
     
     LOG_INFO("Widgets de WindowKernel configurados");
 }
@@ -293,6 +340,89 @@ void window_kernel_update_ui_selection(WindowKernelData *data)
     }
 }
 
+// Función para obtener el cargador de arranque seleccionado
+BootloaderType window_kernel_get_selected_bootloader(WindowKernelData *data)
+{
+    if (!data) return BOOTLOADER_GRUB;
+
+    if (data->sdboot_radio && gtk_check_button_get_active(data->sdboot_radio))
+        return BOOTLOADER_SYSTEMD_BOOT;
+    return BOOTLOADER_GRUB;
+}
+
+// Función para establecer el cargador de arranque seleccionado
+void window_kernel_set_selected_bootloader(WindowKernelData *data, BootloaderType bootloader)
+{
+    if (!data) return;
+
+    // En BIOS Legacy solo hay GRUB
+    if (bootloader == BOOTLOADER_SYSTEMD_BOOT && !g_file_test("/sys/firmware/efi", G_FILE_TEST_IS_DIR)) {
+        LOG_WARNING("systemd-boot requiere UEFI, se usará GRUB");
+        bootloader = BOOTLOADER_GRUB;
+    }
+
+    data->current_bootloader = bootloader;
+    if (bootloader == BOOTLOADER_SYSTEMD_BOOT) {
+        if (data->sdboot_radio) gtk_check_button_set_active(data->sdboot_radio, TRUE);
+    } else {
+        if (data->grub_radio) gtk_check_button_set_active(data->grub_radio, TRUE);
+    }
+}
+
+const char* window_kernel_get_bootloader_name(BootloaderType bootloader)
+{
+    if (bootloader == BOOTLOADER_SYSTEMD_BOOT)
+        return BOOTLOADER_NAMES[BOOTLOADER_SYSTEMD_BOOT];
+    return BOOTLOADER_NAMES[BOOTLOADER_GRUB];
+}
+
+// Función para obtener el perfil de initramfs seleccionado
+InitramfsProfile window_kernel_get_selected_initramfs_profile(WindowKernelData *data)
+{
+    if (!data) return INITRAMFS_PROFILE_DEFAULT;
+
+    if (data->initramfs_zstd_radio && gtk_check_button_get_active(data->initramfs_zstd_radio))
+        return INITRAMFS_PROFILE_ZSTD;
+    if (data->initramfs_lz4_radio && gtk_check_button_get_active(data->initramfs_lz4_radio))
+        return INITRAMFS_PROFILE_LZ4;
+    return INITRAMFS_PROFILE_DEFAULT;
+}
+
+// Función para establecer el perfil de initramfs seleccionado
+void window_kernel_set_selected_initramfs_profile(WindowKernelData *data, InitramfsProfile profile)
+{
+    if (!data) return;
+
+    data->current_initramfs_profile = profile;
+    switch (profile) {
+        case INITRAMFS_PROFILE_ZSTD:
+            if (data->initramfs_zstd_radio) gtk_check_button_set_active(data->initramfs_zstd_radio, TRUE);
+            break;
+        case INITRAMFS_PROFILE_LZ4:
+            if (data->initramfs_lz4_radio) gtk_check_button_set_active(data->initramfs_lz4_radio, TRUE);
+            break;
+        default:
+            if (data->initramfs_default_radio) gtk_check_button_set_active(data->initramfs_default_radio, TRUE);
+            break;
+    }
+}
+
+const char* window_kernel_get_initramfs_profile_name(InitramfsProfile profile)
+{
+    if (profile >= INITRAMFS_PROFILE_DEFAULT && profile <= INITRAMFS_PROFILE_LZ4)
+        return INITRAMFS_PROFILE_NAMES[profile];
+    return INITRAMFS_PROFILE_NAMES[INITRAMFS_PROFILE_DEFAULT];
+}
+
+static InitramfsProfile initramfs_profile_from_name(const char *name)
+{
+    for (int i = 0; i < (int)G_N_ELEMENTS(INITRAMFS_PROFILE_NAMES); i++) {
+        if (g_strcmp0(name, INITRAMFS_PROFILE_NAMES[i]) == 0)
+            return (InitramfsProfile)i;
+    }
+    return INITRAMFS_PROFILE_DEFAULT;
+}
+
 // Función para obtener el nombre del kernel
 const char* window_kernel_get_kernel_name(KernelType kernel)
 {
@@ -361,7 +491,24 @@ gboolean window_kernel_load_from_variables(WindowKernelData *data)
     }
     
     g_strfreev(lines);
+
+    GString *content = g_string_new(config_content);
     g_free(config_content);
+    gchar *bootloader = vars_get(content, "BOOTLOADER");
+    window_kernel_set_selected_bootloader(data,
+        g_strcmp0(bootloader, BOOTLOADER_NAMES[BOOTLOADER_SYSTEMD_BOOT]) == 0
+            ? BOOTLOADER_SYSTEMD_BOOT : BOOTLOADER_GRUB);
+    g_free(bootloader);
+
+    gchar *initramfs_profile = vars_get(content, "INITRAMFS_PROFILE");
+    gchar *initramfs_fallback = vars_get(content, "INITRAMFS_FALLBACK");
+    window_kernel_set_selected_initramfs_profile(data, initramfs_profile_from_name(initramfs_profile));
+    data->initramfs_fallback = g_strcmp0(initramfs_fallback, "false") != 0;
+    if (data->initramfs_fallback_switch)
+        adw_switch_row_set_active(data->initramfs_fallback_switch, data->initramfs_fallback);
+    g_free(initramfs_profile);
+    g_free(initramfs_fallback);
+    g_string_free(content, TRUE);
     
     if (found) {
         window_kernel_set_selected_kernel(data, loaded_kernel);
@@ -373,25 +520,13 @@ gboolean window_kernel_load_from_variables(WindowKernelData *data)
     return found;
 }
 
-// Función para guardar en variables.sh
-gboolean window_kernel_save_kernel_variable(KernelType kernel)
+static void apply_kernel_variable(GString *content, gpointer user_data)
 {
-    GError *error = NULL;
-    gchar *config_content = NULL;
-    const gchar *config_path = "data/bash/variables.sh";
-    const char *kernel_name = window_kernel_get_kernel_name(kernel);
-    
-    // Leer el archivo actual
-    if (!g_file_get_contents(config_path, &config_content, NULL, &error)) {
-        LOG_ERROR("Error al leer archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        return FALSE;
-    }
-    
+    const char *kernel_name = user_data;
+
     /* Reescribir asegurando que "# Kernel seleccionado" siempre precede
      * a SELECTED_KERNEL=, tanto si ya existía como si no. */
-    gchar **lines = g_strsplit(config_content, "\n", -1);
-    g_free(config_content);
+    gchar **lines = g_strsplit(content->str, "\n", -1);
     GString *result = g_string_new("");
     gboolean found = FALSE;
     gboolean prev_is_comment = FALSE;
@@ -418,17 +553,71 @@ gboolean window_kernel_save_kernel_variable(KernelType kernel)
     }
 
     g_strfreev(lines);
-    vars_trim_trailing_newlines(result);
-    gboolean success = g_file_set_contents(config_path, result->str, -1, &error);
-    if (!success) {
-        LOG_ERROR("Error al escribir archivo de configuración: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-    } else {
-        LOG_INFO("SELECTED_KERNEL guardado en variables.sh: %s", kernel_name);
+    g_string_assign(content, result->str);
+    g_string_free(result, TRUE);
+}
+
+// Función para guardar en variables.sh
+gboolean window_kernel_save_kernel_variable(KernelType kernel)
+{
+    const char *kernel_name = window_kernel_get_kernel_name(kernel);
+
+    if (!vars_update(apply_kernel_variable, (gpointer)kernel_name)) {
+        LOG_ERROR("Error al guardar SELECTED_KERNEL en variables.sh");
+        return FALSE;
     }
+    LOG_INFO("SELECTED_KERNEL guardado en variables.sh: %s", kernel_name);
+    return TRUE;
+}
 
-    g_string_free(result, TRUE);
-    return success;
+static void apply_bootloader_variable(GString *content, gpointer user_data)
+{
+    BootloaderType bootloader = GPOINTER_TO_INT(user_data);
+
+    vars_upsert_after_with_comment(content, "BOOTLOADER",
+                                   window_kernel_get_bootloader_name(bootloader),
+                                   "SELECTED_KERNEL", "Cargador de arranque");
+}
+
+// Función para guardar BOOTLOADER en variables.sh
+gboolean window_kernel_save_bootloader_variable(BootloaderType bootloader)
+{
+    if (!vars_update(apply_bootloader_variable, GINT_TO_POINTER(bootloader))) {
+        LOG_ERROR("Error al guardar BOOTLOADER en variables.sh");
+        return FALSE;
+    }
+    LOG_INFO("BOOTLOADER guardado en variables.sh: %s", window_kernel_get_bootloader_name(bootloader));
+    return TRUE;
+}
+
+typedef struct {
+    InitramfsProfile profile;
+    gboolean fallback;
+} InitramfsSelection;
+
+static void apply_initramfs_variables(GString *content, gpointer user_data)
+{
+    const InitramfsSelection *selection = user_data;
+
+    vars_upsert_after_with_comment(content, "INITRAMFS_PROFILE",
+                                   window_kernel_get_initramfs_profile_name(selection->profile),
+                                   "BOOTLOADER", "Perfil del initramfs");
+    vars_upsert_after(content, "INITRAMFS_FALLBACK", selection->fallback ? "true" : "false",
+                      "INITRAMFS_PROFILE");
+}
+
+// Función para guardar INITRAMFS_PROFILE e INITRAMFS_FALLBACK en variables.sh
+gboolean window_kernel_save_initramfs_variables(InitramfsProfile profile, gboolean fallback)
+{
+    InitramfsSelection selection = { profile, fallback };
+
+    if (!vars_update(apply_initramfs_variables, &selection)) {
+        LOG_ERROR("Error al guardar INITRAMFS_PROFILE en variables.sh");
+        return FALSE;
+    }
+    LOG_INFO("INITRAMFS_PROFILE guardado en variables.sh: %s (fallback: %s)",
+             window_kernel_get_initramfs_profile_name(profile), fallback ? "sí" : "no");
+    return TRUE;
 }
 
 // Función para guardar a variables.sh (wrapper)
@@ -436,7 +625,16 @@ gboolean window_kernel_save_to_variables(WindowKernelData *data)
 {
     if (!data) return FALSE;
     
-    return window_kernel_save_kernel_variable(data->current_kernel);
+    // Kernel, cargador e initramfs en una sola escritura de variables.sh
+    vars_begin();
+    if (window_kernel_save_kernel_variable(data->current_kernel) &&
+        window_kernel_save_bootloader_variable(data->current_bootloader) &&
+        window_kernel_save_initramfs_variables(data->current_initramfs_profile,
+                                               data->initramfs_fallback))
+        return vars_commit();
+
+    vars_rollback();
+    return FALSE;
 }
 
 // Callbacks de botones
@@ -458,6 +656,10 @@ void on_kernel_save_button_clicked(GtkButton *button, gpointer user_data)
     // Obtener la selección actual
     KernelType selected = window_kernel_get_selected_kernel(data);
     data->current_kernel = selected;
+    data->current_bootloader = window_kernel_get_selected_bootloader(data);
+    data->current_initramfs_profile = window_kernel_get_selected_initramfs_profile(data);
+    if (data->initramfs_fallback_switch)
+        data->initramfs_fallback = adw_switch_row_get_active(data->initramfs_fallback_switch);
     
     // Guardar en variables.sh
     if (window_kernel_save_to_variables(data)) {
@@ -529,6 +731,11 @@ void window_kernel_reset_to_default(WindowKernelData *data)
     if (!data) return;
     
     window_kernel_set_selected_kernel(data, KERNEL_LINUX);
+    window_kernel_set_selected_bootloader(data, BOOTLOADER_GRUB);
+    window_kernel_set_selected_initramfs_profile(data, INITRAMFS_PROFILE_DEFAULT);
+    data->initramfs_fallback = TRUE;
+    if (data->initramfs_fallback_switch)
+        adw_switch_row_set_active(data->initramfs_fallback_switch, TRUE);
     LOG_INFO("WindowKernel reseteada a valores por defecto");
 }
 
@@ -600,4 +807,40 @@ void window_kernel_update_language(WindowKernelData *data)
     if (data->row_zen)
         adw_action_row_set_subtitle(data->row_zen,
             i18n_t("Linux optimizado para el rendimiento y la experiencia del usuario, con parches que mejoran la interactividad, velocidad y respuesta del sistema."));
+    if (data->bootloader_group) {
+        adw_preferences_group_set_title(data->bootloader_group,
+            i18n_t("Cargador de arranque"));
+        adw_preferences_group_set_description(data->bootloader_group,
+            i18n_t("systemd-boot arranca directamente una imagen unificada por kernel, sin menú ni detección de otros sistemas. Solo disponible en equipos UEFI."));
+    }
+    if (data->row_grub)
+        adw_action_row_set_subtitle(data->row_grub,
+            i18n_t("Menú de arranque con detección de otros sistemas operativos y snapshots"));
+    if (data->row_sdboot)
+        adw_action_row_set_subtitle(data->row_sdboot,
+            i18n_t("Arranque rápido: el firmware carga una imagen unificada del kernel generada en la instalación"));
+    if (data->initramfs_group) {
+        adw_preferences_group_set_title(data->initramfs_group,
+            i18n_t("Imagen de arranque (initramfs)"));
+        adw_preferences_group_set_description(data->initramfs_group,
+            i18n_t("Los perfiles rápidos generan una imagen solo para este equipo y todos los kernels a la vez. El informe de la instalación guarda el tiempo y el tamaño de cada imagen."));
+    }
+    if (data->row_initramfs_default) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->row_initramfs_default),
+            i18n_t("Por defecto"));
+        adw_action_row_set_subtitle(data->row_initramfs_default,
+            i18n_t("Configuración de mkinitcpio de Arch Linux, un kernel detrás de otro"));
+    }
+    if (data->row_initramfs_zstd)
+        adw_action_row_set_subtitle(data->row_initramfs_zstd,
+            i18n_t("Compresión zstd con todos los núcleos: la instalación termina antes"));
+    if (data->row_initramfs_lz4)
+        adw_action_row_set_subtitle(data->row_initramfs_lz4,
+            i18n_t("Compresión lz4: imagen algo mayor que se descomprime más rápido al arrancar"));
+    if (data->initramfs_fallback_switch) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->initramfs_fallback_switch),
+            i18n_t("Imagen de respaldo (fallback)"));
+        adw_action_row_set_subtitle(ADW_ACTION_ROW(data->initramfs_fallback_switch),
+            i18n_t("Imagen con todos los módulos por si el equipo cambia de hardware. Desactivarla ahorra una imagen por kernel."));
+    }
 }
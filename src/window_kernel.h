@@ -13,6 +13,19 @@ typedef enum {
     KERNEL_ZEN
 } KernelType;
 
+// Cargador de arranque (BOOTLOADER en variables.sh)
+typedef enum {
+    BOOTLOADER_GRUB = 0,
+    BOOTLOADER_SYSTEMD_BOOT
+} BootloaderType;
+
+// Perfil de generación del initramfs (INITRAMFS_PROFILE en variables.sh)
+typedef enum {
+    INITRAMFS_PROFILE_DEFAULT = 0,
+    INITRAMFS_PROFILE_ZSTD,
+    INITRAMFS_PROFILE_LZ4
+} InitramfsProfile;
+
 // Estructura para datos de la ventana de kernel
 typedef struct _WindowKernelData {
     GtkWindow *window;
@@ -29,6 +42,16 @@ typedef struct _WindowKernelData {
     GtkCheckButton *rt_lts_radio;
     GtkCheckButton *zen_radio;
 
+    // Radio buttons para el cargador de arranque
+    GtkCheckButton *grub_radio;
+    GtkCheckButton *sdboot_radio;
+
+    // Radio buttons del perfil de initramfs e imagen fallback
+    GtkCheckButton *initramfs_default_radio;
+    GtkCheckButton *initramfs_zstd_radio;
+    GtkCheckButton *initramfs_lz4_radio;
+    AdwSwitchRow *initramfs_fallback_switch;
+
     // Widgets para traducción
     AdwWindowTitle *kernel_window_title;
     AdwPreferencesGroup *kernel_group;
@@ -37,9 +60,19 @@ typedef struct _WindowKernelData {
     AdwActionRow *row_lts;
     AdwActionRow *row_rt_lts;
     AdwActionRow *row_zen;
+    AdwPreferencesGroup *bootloader_group;
+    AdwActionRow *row_grub;
+    AdwActionRow *row_sdboot;
+    AdwPreferencesGroup *initramfs_group;
+    AdwActionRow *row_initramfs_default;
+    AdwActionRow *row_initramfs_zstd;
+    AdwActionRow *row_initramfs_lz4;
     
     // Estado actual
     KernelType current_kernel;
+    BootloaderType current_bootloader;
+    InitramfsProfile current_initramfs_profile;
+    gboolean initramfs_fallback;
     gboolean is_initialized;
     
 } WindowKernelData;
@@ -62,10 +95,22 @@ void window_kernel_set_selected_kernel(WindowKernelData *data, KernelType kernel
 const char* window_kernel_get_kernel_name(KernelType kernel);
 KernelType window_kernel_get_kernel_from_name(const char* name);
 
+// Funciones del cargador de arranque (systemd-boot solo en UEFI)
+BootloaderType window_kernel_get_selected_bootloader(WindowKernelData *data);
+void window_kernel_set_selected_bootloader(WindowKernelData *data, BootloaderType bootloader);
+const char* window_kernel_get_bootloader_name(BootloaderType bootloader);
+
+// Funciones del perfil de initramfs
+InitramfsProfile window_kernel_get_selected_initramfs_profile(WindowKernelData *data);
+void window_kernel_set_selected_initramfs_profile(WindowKernelData *data, InitramfsProfile profile);
+const char* window_kernel_get_initramfs_profile_name(InitramfsProfile profile);
+
 // Funciones de persistencia (variables.sh)
 gboolean window_kernel_load_from_variables(WindowKernelData *data);
 gboolean window_kernel_save_to_variables(WindowKernelData *data);
 gboolean window_kernel_save_kernel_variable(KernelType kernel);
+gboolean window_kernel_save_bootloader_variable(BootloaderType bootloader);
+gboolean window_kernel_save_initramfs_variables(InitramfsProfile profile, gboolean fallback);
 
 // Callbacks de botones
 void on_kernel_close_button_clicked(GtkButton *button, gpointer user_data);
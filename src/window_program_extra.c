@@ -3,6 +3,7 @@
 #include "config.h"
 #include "variables_utils.h"
 #include "i18n.h"
+#include "package_index.h"
 #include <glib/gstdio.h>
 #include <string.h>
 
@@ -11,6 +12,10 @@ static WindowProgramExtraData *global_program_extra_data = NULL;
 
 // Constantes
 #define VARIABLES_FILE_PATH "./data/bash/variables.sh"
+#define PROGRAM_EXTRA_VALIDATE_DELAY_MS 300
+#define PROGRAM_EXTRA_MAX_SUGGESTIONS   6
+
+static void on_program_extra_index_ready(gpointer user_data);
 
 WindowProgramExtraData* window_program_extra_new(void)
 {
@@ -58,6 +63,9 @@ void window_program_extra_init(WindowProgramExtraData *data)
     window_program_extra_load_programs_from_file(data);
     
     data->is_initialized = TRUE;
+    
+    // Índice de paquetes en segundo plano; al terminar se comprueba la lista
+    package_index_load_async(on_program_extra_index_ready, data);
     window_program_extra_update_language(data);
     LOG_INFO("Ventana de programas extra inicializada correctamente");
 }
@@ -73,6 +81,17 @@ void window_program_extra_cleanup(WindowProgramExtraData *data)
         data->programs_text = NULL;
     }
     
+    if (data->validate_timeout_id) {
+        g_source_remove(data->validate_timeout_id);
+        data->validate_timeout_id = 0;
+    }
+    g_clear_pointer(&data->completion, g_free);
+    g_list_free(data->package_rows);
+    data->package_rows = NULL;
+    data->packages_group = NULL;
+    data->suggestions_label = NULL;
+    data->summary_label = NULL;
+    
     if (data->builder) {
         g_object_unref(data->builder);
         data->builder = NULL;
@@ -143,9 +162,15 @@ void window_program_extra_load_widgets_from_builder(WindowProgramExtraData *data
     // Cargar TextView
     data->hardware_textview = GTK_TEXT_VIEW(gtk_builder_get_object(data->builder, "programextra_textview"));
     
+    // Cargar sugerencias, lista de paquetes y resumen
+    data->suggestions_label = GTK_LABEL(gtk_builder_get_object(data->builder, "program_extra_suggestions_label"));
+    data->summary_label = GTK_LABEL(gtk_builder_get_object(data->builder, "program_extra_summary_label"));
+    data->packages_group = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "program_extra_packages_group"));
+    
     if (!data->close_button) LOG_WARNING("No se pudo cargar close_button");
     if (!data->save_button) LOG_WARNING("No se pudo cargar save_button");
     if (!data->hardware_textview) LOG_WARNING("No se pudo cargar programextra_textview");
+    if (!data->packages_group) LOG_WARNING("No se pudo cargar program_extra_packages_group");
     
     LOG_INFO("Widgets de ventana de programas extra cargados desde builder");
 }
@@ -157,7 +182,7 @@ void window_program_extra_setup_widgets(WindowProgramExtraData *data)
     // Configurar ventana
     if (data->window) {
         gtk_window_set_title(data->window, "Programas Extras");
-        gtk_window_set_default_size(data->window, 550, 500);
+        gtk_window_set_default_size(data->window, 550, 680);
         gtk_window_set_resizable(data->window, FALSE);
     }
     
@@ -200,6 +225,16 @@ void window_program_extra_connect_signals(WindowProgramExtraData *data)
                         G_CALLBACK(on_program_extra_textbuffer_changed), data);
     }
     
+    // Tab completa el nombre con la primera sugerencia; en la fase de captura
+    // para adelantarse al tabulador del TextView
+    if (data->hardware_textview) {
+        GtkEventController *key_controller = gtk_event_controller_key_new();
+        gtk_event_controller_set_propagation_phase(key_controller, GTK_PHASE_CAPTURE);
+        g_signal_connect(key_controller, "key-pressed",
+                        G_CALLBACK(on_program_extra_key_pressed), data);
+        gtk_widget_add_controller(GTK_WIDGET(data->hardware_textview), key_controller);
+    }
+    
 
     LOG_INFO("Señales de ventana de programas extra conectadas");
 }
@@ -280,61 +315,27 @@ gboolean window_program_extra_load_programs_from_file(WindowProgramExtraData *da
     }
 }
 
-gboolean window_program_extra_save_programs_to_file(WindowProgramExtraData *data)
+typedef struct {
+    const gchar *array_line;
+    gboolean has_program_text;
+} ProgramExtraVars;
+
+// Reemplaza EXTRA_PROGRAMS y PROGRAM_EXTRA o los agrega detrás de UTILITIES_APPS=
+static void apply_program_extra(GString *content, gpointer user_data)
 {
-    if (!data || !data->text_buffer) return FALSE;
-    
-    GtkTextIter start, end;
-    gtk_text_buffer_get_bounds(data->text_buffer, &start, &end);
-    gchar *text = gtk_text_buffer_get_text(data->text_buffer, &start, &end, FALSE);
-    
-    // Leer archivo variables.sh actual
-    GError *error = NULL;
-    gchar *content = NULL;
-    gsize length;
-    
-    if (!g_file_get_contents(VARIABLES_FILE_PATH, &content, &length, &error)) {
-        LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        if (text) g_free(text);
-        return FALSE;
-    }
-    
-    // Determinar si hay texto para PROGRAM_EXTRA
-    gboolean has_program_text = (text && strlen(g_strstrip(text)) > 0);
-    
-    // Procesar texto para extraer palabras
-    GString *array_content = g_string_new("EXTRA_PROGRAMS=(");
-    
-    if (has_program_text) {
-        // Dividir texto en palabras (separados por espacios, tabs, saltos de línea)
-        gchar **words = g_regex_split_simple("\\s+", g_strstrip(text), 0, 0);
-        
-        for (int i = 0; words[i] != NULL; i++) {
-            gchar *word = g_strstrip(words[i]);
-            if (strlen(word) > 0) {
-                if (i > 0) g_string_append(array_content, " ");
-                g_string_append_printf(array_content, "\"%s\"", word);
-            }
-        }
-        
-        g_strfreev(words);
-    }
-    
-    g_string_append(array_content, ")");
-    
-    // Buscar y reemplazar líneas EXTRA_PROGRAMS y PROGRAM_EXTRA o agregarlas
-    gchar **lines = g_strsplit(content, "\n", -1);
+    const ProgramExtraVars *vars = user_data;
+    const gchar *program_extra = vars->has_program_text ? "true" : "false";
+    gchar **lines = g_strsplit(content->str, "\n", -1);
     GString *new_content = g_string_new("");
     gboolean found_extra_programs = FALSE;
     gboolean found_program_extra = FALSE;
     
     for (int i = 0; lines[i] != NULL; i++) {
         if (g_str_has_prefix(g_strstrip(lines[i]), "EXTRA_PROGRAMS=")) {
-            g_string_append_printf(new_content, "%s\n", array_content->str);
+            g_string_append_printf(new_content, "%s\n", vars->array_line);
             found_extra_programs = TRUE;
         } else if (g_str_has_prefix(g_strstrip(lines[i]), "PROGRAM_EXTRA=")) {
-            g_string_append_printf(new_content, "PROGRAM_EXTRA=\"%s\"\n", has_program_text ? "true" : "false");
+            g_string_append_printf(new_content, "PROGRAM_EXTRA=\"%s\"\n", program_extra);
             found_program_extra = TRUE;
         } else {
             g_string_append_printf(new_content, "%s\n", lines[i]);
@@ -350,30 +351,63 @@ gboolean window_program_extra_save_programs_to_file(WindowProgramExtraData *data
             g_string_append_printf(fixed, "%s\n", lines2[i]);
             if (!inserted && g_str_has_prefix(g_strstrip(lines2[i]), "UTILITIES_APPS=")) {
                 if (!found_program_extra)
-                    g_string_append_printf(fixed, "\nPROGRAM_EXTRA=\"%s\"\n",
-                                           has_program_text ? "true" : "false");
+                    g_string_append_printf(fixed, "\nPROGRAM_EXTRA=\"%s\"\n", program_extra);
                 if (!found_extra_programs)
                     g_string_append_printf(fixed, "\n# Programas extra agregados por el usuario\n%s\n",
-                                           array_content->str);
+                                           vars->array_line);
                 inserted = TRUE;
             }
         }
         if (!inserted) {
             if (!found_program_extra)
-                g_string_append_printf(fixed, "\nPROGRAM_EXTRA=\"%s\"\n",
-                                       has_program_text ? "true" : "false");
+                g_string_append_printf(fixed, "\nPROGRAM_EXTRA=\"%s\"\n", program_extra);
             if (!found_extra_programs)
                 g_string_append_printf(fixed, "\n# Programas extra agregados por el usuario\n%s\n",
-                                       array_content->str);
+                                       vars->array_line);
         }
         g_string_assign(new_content, fixed->str);
         g_string_free(fixed, TRUE);
         g_strfreev(lines2);
     }
     
-    // Guardar archivo actualizado
-    vars_trim_trailing_newlines(new_content);
-    gboolean success = g_file_set_contents(VARIABLES_FILE_PATH, new_content->str, -1, &error);
+    g_string_assign(content, new_content->str);
+    g_string_free(new_content, TRUE);
+    g_strfreev(lines);
+}
+
+gboolean window_program_extra_save_programs_to_file(WindowProgramExtraData *data)
+{
+    if (!data || !data->text_buffer) return FALSE;
+    
+    GtkTextIter start, end;
+    gtk_text_buffer_get_bounds(data->text_buffer, &start, &end);
+    gchar *text = gtk_text_buffer_get_text(data->text_buffer, &start, &end, FALSE);
+    
+    // Determinar si hay texto para PROGRAM_EXTRA
+    gboolean has_program_text = (text && strlen(g_strstrip(text)) > 0);
+    
+    // Procesar texto para extraer palabras
+    GString *array_content = g_string_new("EXTRA_PROGRAMS=(");
+    
+    if (has_program_text) {
+        // Dividir texto en palabras (separados por espacios, tabs, saltos de línea)
+        gchar **words = g_regex_split_simple("\\s+", g_strstrip(text), 0, 0);
+        
+        for (int i = 0; words[i] != NULL; i++) {
+            gchar *word = g_strstrip(words[i]);
+            if (strlen(word) > 0) {
+                if (i > 0) g_string_append(array_content, " ");
+                g_string_append_printf(array_content, "\"%s\"", word);
+            }
+        }
+        
+        g_strfreev(words);
+    }
+    
+    g_string_append(array_content, ")");
+    
+    ProgramExtraVars vars = { array_content->str, has_program_text };
+    gboolean success = vars_update(apply_program_extra, &vars);
     
     if (success) {
         if (data->programs_text) g_free(data->programs_text);
@@ -381,15 +415,11 @@ gboolean window_program_extra_save_programs_to_file(WindowProgramExtraData *data
         LOG_INFO("Programas guardados como array en variables.sh");
         LOG_INFO("PROGRAM_EXTRA establecido a: %s", has_program_text ? "true" : "false");
     } else {
-        LOG_ERROR("Error guardando en variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
+        LOG_ERROR("Error guardando programas extra en variables.sh");
     }
     
     // Limpiar memoria
     g_string_free(array_content, TRUE);
-    g_string_free(new_content, TRUE);
-    g_strfreev(lines);
-    g_free(content);
     if (text) g_free(text);
     
     return success;
@@ -413,6 +443,221 @@ void window_program_extra_set_programs_text(WindowProgramExtraData *data, const
     }
 }
 
+// Índice de paquetes
+
+// Nombres de la lista sin repetir, en el orden en que se escribieron
+static gchar** window_program_extra_split_programs(const gchar *text)
+{
+    GPtrArray *names = g_ptr_array_new();
+    GHashTable *seen = g_hash_table_new(g_str_hash, g_str_equal);
+    gchar **words = g_regex_split_simple("\\s+", text ? text : "", 0, 0);
+    
+    for (int i = 0; words[i] != NULL; i++) {
+        if (words[i][0] != '\0' && g_hash_table_add(seen, words[i])) {
+            g_ptr_array_add(names, g_strdup(words[i]));
+        }
+    }
+    g_ptr_array_add(names, NULL);
+    
+    g_hash_table_destroy(seen);
+    g_strfreev(words);
+    return (gchar**)g_ptr_array_free(names, FALSE);
+}
+
+// Palabra que se está escribiendo: desde el último espacio hasta el cursor
+static gchar* window_program_extra_current_word(WindowProgramExtraData *data,
+                                                GtkTextIter *start, GtkTextIter *end)
+{
+    gtk_text_buffer_get_iter_at_mark(data->text_buffer, end,
+                                     gtk_text_buffer_get_insert(data->text_buffer));
+    *start = *end;
+    
+    while (gtk_text_iter_backward_char(start)) {
+        if (g_unichar_isspace(gtk_text_iter_get_char(start))) {
+            gtk_text_iter_forward_char(start);
+            break;
+        }
+    }
+    
+    // Solo al final de la palabra, no con el cursor en medio
+    if (!gtk_text_iter_is_end(end) && !g_unichar_isspace(gtk_text_iter_get_char(end))) {
+        *start = *end;
+    }
+    return gtk_text_buffer_get_text(data->text_buffer, start, end, FALSE);
+}
+
+static gchar* window_program_extra_describe(const PackageLookup *lookup)
+{
+    gchar *size = g_format_size(lookup->download_size);
+    gchar *description = NULL;
+    
+    switch (lookup->status) {
+        case PACKAGE_STATUS_REPO:
+            description = g_strdup_printf("%s · %s %s", lookup->repo, i18n_t("Descarga:"), size);
+            break;
+        case PACKAGE_STATUS_GROUP:
+            description = g_strdup_printf("%s %s · %u %s · %s %s", i18n_t("Grupo de"), lookup->repo,
+                                          lookup->member_count, i18n_t("paquetes"),
+                                          i18n_t("Descarga:"), size);
+            break;
+        case PACKAGE_STATUS_PROVIDED:
+            description = g_strdup_printf("%s %s (%s) · %s %s", i18n_t("Provisto por"),
+                                          lookup->provider, lookup->repo, i18n_t("Descarga:"), size);
+            break;
+        case PACKAGE_STATUS_AUR:
+            description = g_strdup_printf("AUR · %s", i18n_t("Se compila durante la instalación"));
+            break;
+        case PACKAGE_STATUS_MISSING:
+            description = g_strdup(i18n_t("No existe en los repositorios ni en el AUR"));
+            break;
+        case PACKAGE_STATUS_INVALID:
+            description = g_strdup(i18n_t("Nombre de paquete no válido"));
+            break;
+        case PACKAGE_STATUS_UNCHECKED:
+            description = g_strdup(i18n_t("No se pudo comprobar"));
+            break;
+        case PACKAGE_STATUS_PENDING:
+        default:
+            description = g_strdup(i18n_t("Comprobando..."));
+            break;
+    }
+    
+    g_free(size);
+    return description;
+}
+
+static void on_program_extra_aur_done(gpointer user_data)
+{
+    window_program_extra_refresh_packages((WindowProgramExtraData*)user_data);
+}
+
+static void on_program_extra_index_ready(gpointer user_data)
+{
+    WindowProgramExtraData *data = (WindowProgramExtraData*)user_data;
+    window_program_extra_refresh_packages(data);
+    window_program_extra_update_suggestions(data);
+}
+
+static gboolean window_program_extra_validate_timeout(gpointer user_data)
+{
+    WindowProgramExtraData *data = (WindowProgramExtraData*)user_data;
+    data->validate_timeout_id = 0;
+    window_program_extra_refresh_packages(data);
+    return G_SOURCE_REMOVE;
+}
+
+void window_program_extra_refresh_packages(WindowProgramExtraData *data)
+{
+    if (!data || !data->is_initialized || !data->packages_group) return;
+    
+    // Quitar las filas anteriores
+    for (GList *l = data->package_rows; l != NULL; l = l->next) {
+        adw_preferences_group_remove(data->packages_group, GTK_WIDGET(l->data));
+    }
+    g_list_free(data->package_rows);
+    data->package_rows = NULL;
+    
+    gchar *text = window_program_extra_get_programs_text(data);
+    gchar **names = window_program_extra_split_programs(text);
+    guint64 total_download = 0;
+    guint problems = 0;
+    guint pending = 0;
+    
+    for (int i = 0; names[i] != NULL; i++) {
+        PackageLookup lookup;
+        package_index_lookup(names[i], &lookup);
+        
+        AdwActionRow *row = ADW_ACTION_ROW(adw_action_row_new());
+        adw_preferences_row_set_use_markup(ADW_PREFERENCES_ROW(row), FALSE);
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), names[i]);
+        gchar *subtitle = window_program_extra_describe(&lookup);
+        adw_action_row_set_subtitle(row, subtitle);
+        g_free(subtitle);
+        
+        const gchar *icon_name = "object-select-symbolic";
+        gboolean is_problem = FALSE;
+        switch (lookup.status) {
+            case PACKAGE_STATUS_MISSING:
+            case PACKAGE_STATUS_INVALID:
+                icon_name = "dialog-error-symbolic";
+                is_problem = TRUE;
+                problems++;
+                break;
+            case PACKAGE_STATUS_PENDING:
+            case PACKAGE_STATUS_UNCHECKED:
+                icon_name = "dialog-question-symbolic";
+                pending++;
+                break;
+            default:
+                total_download += lookup.download_size;
+                break;
+        }
+        
+        GtkWidget *icon = gtk_image_new_from_icon_name(icon_name);
+        if (is_problem) {
+            gtk_widget_add_css_class(icon, "error");
+        }
+        adw_action_row_add_prefix(row, icon);
+        
+        adw_preferences_group_add(data->packages_group, GTK_WIDGET(row));
+        data->package_rows = g_list_append(data->package_rows, row);
+    }
+    
+    // Los que no están en los repositorios se consultan al AUR en un solo lote
+    package_index_query_aur((const gchar * const *)names, on_program_extra_aur_done, data);
+    
+    if (data->summary_label) {
+        gchar *summary = NULL;
+        if (problems > 0) {
+            summary = g_strdup(i18n_t("Corrige los paquetes marcados antes de guardar"));
+        } else if (names[0] != NULL) {
+            gchar *size = g_format_size(total_download);
+            summary = g_strdup_printf("%s %s%s%s", i18n_t("Descarga total desde los repositorios:"), size,
+                                      pending > 0 ? " · " : "",
+                                      pending > 0 ? i18n_t("Comprobando...") : "");
+            g_free(size);
+        }
+        gtk_label_set_text(data->summary_label, summary ? summary : "");
+        if (problems > 0) {
+            gtk_widget_add_css_class(GTK_WIDGET(data->summary_label), "error");
+        } else {
+            gtk_widget_remove_css_class(GTK_WIDGET(data->summary_label), "error");
+        }
+        g_free(summary);
+    }
+    
+    g_strfreev(names);
+    g_free(text);
+}
+
+void window_program_extra_update_suggestions(WindowProgramExtraData *data)
+{
+    if (!data || !data->is_initialized || !data->suggestions_label || !data->text_buffer) return;
+    
+    g_clear_pointer(&data->completion, g_free);
+    
+    GtkTextIter start, end;
+    gchar *word = window_program_extra_current_word(data, &start, &end);
+    const gchar *matches[PROGRAM_EXTRA_MAX_SUGGESTIONS];
+    guint count = (word && strlen(word) >= 2)
+                  ? package_index_complete(word, matches, PROGRAM_EXTRA_MAX_SUGGESTIONS) : 0;
+    
+    // Tab completa con el primer nombre más largo que lo escrito
+    GString *line = g_string_new("Tab →");
+    for (guint i = 0; i < count; i++) {
+        if (!data->completion && strcmp(matches[i], word) != 0) {
+            data->completion = g_strdup(matches[i]);
+        }
+        g_string_append_printf(line, "%s%s", i == 0 ? " " : " · ", matches[i]);
+    }
+    
+    gtk_label_set_text(data->suggestions_label, line->str);
+    gtk_widget_set_visible(GTK_WIDGET(data->suggestions_label), data->completion != NULL);
+    
+    g_string_free(line, TRUE);
+    g_free(word);
+}
+
 // Callbacks
 
 void on_program_extra_close_button_clicked(GtkButton *button, gpointer user_data)
@@ -440,6 +685,19 @@ void on_program_extra_save_button_clicked(GtkButton *button, gpointer user_data)
     is_saving = TRUE;
     LOG_INFO("Guardando programas extra");
     
+    // No guardar nombres que no existen: en la instalación se reintentarían
+    gchar *current_text = window_program_extra_get_programs_text(data);
+    gboolean has_text = current_text && strlen(g_strstrip(current_text)) > 0;
+    gboolean valid = !has_text || window_program_extra_validate_programs_text(current_text);
+    g_free(current_text);
+    
+    if (!valid) {
+        LOG_WARNING("Hay programas extra que no existen, no se guardan");
+        window_program_extra_refresh_packages(data);
+        is_saving = FALSE;
+        return;
+    }
+    
     if (window_program_extra_save_programs_to_file(data)) {
         LOG_INFO("Programas guardados exitosamente");
         
@@ -475,6 +733,36 @@ void on_program_extra_textbuffer_changed(GtkTextBuffer *buffer, gpointer user_da
     page7_update_programas_extras_subtitle(text);
     
     if (text) g_free(text);
+    
+    // Sugerencias al instante; la comprobación de la lista, al dejar de escribir
+    window_program_extra_update_suggestions(data);
+    if (data->validate_timeout_id) {
+        g_source_remove(data->validate_timeout_id);
+    }
+    data->validate_timeout_id = g_timeout_add(PROGRAM_EXTRA_VALIDATE_DELAY_MS,
+                                              window_program_extra_validate_timeout, data);
+}
+
+gboolean on_program_extra_key_pressed(GtkEventControllerKey *controller, guint keyval,
+                                      guint keycode, GdkModifierType state, gpointer user_data)
+{
+    WindowProgramExtraData *data = (WindowProgramExtraData*)user_data;
+    if (!data || !data->text_buffer || !data->completion) return FALSE;
+    if (keyval != GDK_KEY_Tab || (state & GDK_MODIFIER_MASK & ~GDK_LOCK_MASK)) return FALSE;
+    
+    GtkTextIter start, end;
+    gchar *word = window_program_extra_current_word(data, &start, &end);
+    gchar *completion = g_strconcat(data->completion, " ", NULL);
+    
+    // Sustituir la palabra a medio escribir por el nombre completo
+    gtk_text_buffer_begin_user_action(data->text_buffer);
+    gtk_text_buffer_delete(data->text_buffer, &start, &end);
+    gtk_text_buffer_insert(data->text_buffer, &start, completion, -1);
+    gtk_text_buffer_end_user_action(data->text_buffer);
+    
+    g_free(completion);
+    g_free(word);
+    return TRUE;
 }
 
 // Funciones de utilidad
@@ -495,11 +783,24 @@ gboolean window_program_extra_validate_programs_text(const gchar *text)
 {
     if (!text) return FALSE;
     
-    // Validación básica: no debe estar vacío
-    gchar *stripped = g_strstrip(g_strdup(text));
-    gboolean valid = (strlen(stripped) > 0);
+    // La lista no debe estar vacía ni tener nombres que no existen; los que no
+    // se pudieron comprobar (sin índice o sin respuesta del AUR) se aceptan
+    gchar **names = window_program_extra_split_programs(text);
+    gboolean valid = (names[0] != NULL);
+    
+    for (int i = 0; names[i] != NULL; i++) {
+        PackageLookup lookup;
+        package_index_lookup(names[i], &lookup);
+        
+        if (lookup.status == PACKAGE_STATUS_MISSING || lookup.status == PACKAGE_STATUS_INVALID) {
+            LOG_WARNING("Programa extra no válido: %s", names[i]);
+            valid = FALSE;
+        } else if (lookup.status == PACKAGE_STATUS_PENDING || lookup.status == PACKAGE_STATUS_UNCHECKED) {
+            LOG_WARNING("Programa extra sin comprobar, se guarda igualmente: %s", names[i]);
+        }
+    }
     
-    g_free(stripped);
+    g_strfreev(names);
     return valid;
 }
 
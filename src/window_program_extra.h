@@ -20,6 +20,14 @@ typedef struct _WindowProgramExtraData {
     GtkTextView *hardware_textview;
     GtkTextBuffer *text_buffer;
     
+    // Comprobación de paquetes contra el índice de repositorios y el AUR
+    GtkLabel *suggestions_label;
+    GtkLabel *summary_label;
+    AdwPreferencesGroup *packages_group;
+    GList *package_rows;
+    gchar *completion;
+    guint validate_timeout_id;
+    
     // Estado de inicialización
     gboolean is_initialized;
     
@@ -55,6 +63,12 @@ void on_program_extra_save_button_clicked(GtkButton *button, gpointer user_data)
 
 // Callbacks del TextView principal
 void on_program_extra_textbuffer_changed(GtkTextBuffer *buffer, gpointer user_data);
+gboolean on_program_extra_key_pressed(GtkEventControllerKey *controller, guint keyval,
+                                      guint keycode, GdkModifierType state, gpointer user_data);
+
+// Funciones del índice de paquetes
+void window_program_extra_refresh_packages(WindowProgramExtraData *data);
+void window_program_extra_update_suggestions(WindowProgramExtraData *data);
 
 // Funciones de utilidad
 void window_program_extra_reset_to_defaults(WindowProgramExtraData *data);
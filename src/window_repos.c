@@ -1,6 +1,7 @@
 #include "window_repos.h"
 #include "config.h"
 #include "variables_utils.h"
+#include "mirrorlist_utils.h"
 #include "i18n.h"
 #include <string.h>
 
@@ -19,54 +20,6 @@ static void show_error_dialog(WindowReposData *data, const gchar *title, const g
     adw_dialog_present(dialog, GTK_WIDGET(data->window));
 }
 
-
-
-
-/* Descomenta líneas "#Server =" → "Server =". */
-static gchar* process_mirrorlist(const gchar *text)
-{
-    gchar **lines = g_strsplit(text, "\n", -1);
-    GString *result = g_string_new("");
-
-    for (int i = 0; lines[i] != NULL; i++) {
-        gchar *line = lines[i];
-        if (g_str_has_prefix(line, "#Server ="))
-            line = line + 1;
-        g_string_append(result, line);
-        if (lines[i + 1] != NULL)
-            g_string_append_c(result, '\n');
-    }
-
-    g_strfreev(lines);
-    return g_string_free(result, FALSE);
-}
-
-/* Valida que el texto contenga al menos "$repo/os/$arch". */
-static gboolean validate_mirrorlist(const gchar *text)
-{
-    if (!text) return FALSE;
-    return strstr(text, "$repo/os/$arch") != NULL;
-}
-
-/* Escapa newlines y comillas para almacenar en una variable bash. */
-static gchar* escape_for_bash_var(const gchar *text)
-{
-    GString *result = g_string_new("");
-    for (const gchar *p = text; *p; p++) {
-        if (*p == '\n')
-            g_string_append(result, "\\n");
-        else if (*p == '"')
-            g_string_append(result, "\\\"");
-        else if (*p == '\\')
-            g_string_append(result, "\\\\");
-        else if (*p == '$')
-            g_string_append(result, "\\$");
-        else
-            g_string_append_c(result, *p);
-    }
-    return g_string_free(result, FALSE);
-}
-
 // ---------------------------------------------------------------------------
 // Auto-guardado de toggles/switches
 // ---------------------------------------------------------------------------
@@ -93,6 +46,11 @@ static void apply_toggles(GString *content, gpointer user_data)
         vars_remove(content, "REPOS_MIRROR_CUSTOM");
 }
 
+static void apply_mirror_custom(GString *content, gpointer user_data)
+{
+    vars_upsert_after(content, "REPOS_MIRROR_CUSTOM", (const gchar *)user_data, "REPOS_MIRROR_MODE");
+}
+
 static void on_switch_or_toggle_changed(GObject *obj, GParamSpec *pspec, gpointer user_data)
 {
     (void)obj; (void)pspec;
@@ -156,7 +114,7 @@ static void do_close_with_validation(WindowReposData *data)
         GtkTextIter start, end;
         gtk_text_buffer_get_bounds(buf, &start, &end);
         gchar *raw_text = gtk_text_buffer_get_text(buf, &start, &end, FALSE);
-        gboolean valid = validate_mirrorlist(raw_text);
+        gboolean valid = mirrorlist_validate(raw_text);
         g_free(raw_text);
 
         if (!valid) {
@@ -307,54 +265,39 @@ void window_repos_show(WindowReposData *data, GtkWindow *parent)
 // Callbacks
 // ---------------------------------------------------------------------------
 
-/* Escribe las variables de repos con sus valores por defecto si no existen. */
-void window_repos_init_defaults(void)
+static void apply_repos_defaults(GString *content, gpointer user_data)
 {
-    GError *error = NULL;
-    gchar *file_content = NULL;
+    gboolean *initialized = user_data;
 
-    if (!g_file_get_contents(VARIABLES_FILE_PATH, &file_content, NULL, &error)) {
-        LOG_ERROR("No se pudo leer variables.sh para defaults de repos: %s",
-                  error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
+    // Solo inserta cada variable si no existe ya
+    gboolean has_chaotic = strstr(content->str, "REPOS_CHAOTIC_AUR=")   != NULL;
+    gboolean has_archcn  = strstr(content->str, "REPOS_ARCHLINUXCN=")   != NULL;
+    gboolean has_cachyos = strstr(content->str, "REPOS_CACHYOS=")       != NULL;
+    gboolean has_mode    = strstr(content->str, "REPOS_MIRROR_MODE=")   != NULL;
+    gboolean has_custom  = strstr(content->str, "REPOS_MIRROR_CUSTOM=") != NULL;
+
+    *initialized = !has_chaotic || !has_archcn || !has_cachyos || !has_mode || !has_custom;
+    if (!*initialized)
         return;
-    }
 
-    GString *content = g_string_new(file_content);
-    g_free(file_content);
+    g_string_append(content, "\n# Configuración de repositorios\n");
 
-    // Solo inserta cada variable si no existe ya
-    gchar *needle_chaotic  = "REPOS_CHAOTIC_AUR=";
-    gchar *needle_archcn   = "REPOS_ARCHLINUXCN=";
-    gchar *needle_cachyos  = "REPOS_CACHYOS=";
-    gchar *needle_mode     = "REPOS_MIRROR_MODE=";
-    gchar *needle_custom   = "REPOS_MIRROR_CUSTOM=";
-
-    gboolean has_chaotic = strstr(content->str, needle_chaotic) != NULL;
-    gboolean has_archcn  = strstr(content->str, needle_archcn)  != NULL;
-    gboolean has_cachyos = strstr(content->str, needle_cachyos) != NULL;
-    gboolean has_mode    = strstr(content->str, needle_mode)    != NULL;
-    gboolean has_custom  = strstr(content->str, needle_custom)  != NULL;
-
-    if (!has_chaotic || !has_archcn || !has_cachyos || !has_mode || !has_custom) {
-        g_string_append(content, "\n# Configuración de repositorios\n");
-
-        if (!has_chaotic) g_string_append(content, "REPOS_CHAOTIC_AUR=\"false\"\n");
-        if (!has_archcn)  g_string_append(content, "REPOS_ARCHLINUXCN=\"false\"\n");
-        if (!has_cachyos) g_string_append(content, "REPOS_CACHYOS=\"false\"\n");
-        if (!has_mode)    g_string_append(content, "REPOS_MIRROR_MODE=\"auto\"\n");
-        if (!has_custom)  g_string_append(content, "\nREPOS_MIRROR_CUSTOM=\"\"\n");
-
-        if (!g_file_set_contents(VARIABLES_FILE_PATH, content->str, -1, &error)) {
-            LOG_ERROR("Error escribiendo defaults de repos: %s",
-                      error ? error->message : "Unknown error");
-            if (error) g_error_free(error);
-        } else {
-            LOG_INFO("Variables de repositorios inicializadas con defaults");
-        }
-    }
+    if (!has_chaotic) g_string_append(content, "REPOS_CHAOTIC_AUR=\"false\"\n");
+    if (!has_archcn)  g_string_append(content, "REPOS_ARCHLINUXCN=\"false\"\n");
+    if (!has_cachyos) g_string_append(content, "REPOS_CACHYOS=\"false\"\n");
+    if (!has_mode)    g_string_append(content, "REPOS_MIRROR_MODE=\"auto\"\n");
+    if (!has_custom)  g_string_append(content, "\nREPOS_MIRROR_CUSTOM=\"\"\n");
+}
+
+/* Escribe las variables de repos con sus valores por defecto si no existen. */
+void window_repos_init_defaults(void)
+{
+    gboolean initialized = FALSE;
 
-    g_string_free(content, TRUE);
+    if (!vars_update(apply_repos_defaults, &initialized))
+        LOG_ERROR("Error escribiendo defaults de repos en variables.sh");
+    else if (initialized)
+        LOG_INFO("Variables de repositorios inicializadas con defaults");
 }
 
 void on_repos_close_button_clicked(GtkButton *button, gpointer user_data)
@@ -391,7 +334,7 @@ void on_repos_save_button_clicked(GtkButton *button, gpointer user_data)
     gtk_text_buffer_get_bounds(buf, &start, &end);
     gchar *raw_text = gtk_text_buffer_get_text(buf, &start, &end, FALSE);
 
-    if (!validate_mirrorlist(raw_text)) {
+    if (!mirrorlist_validate(raw_text)) {
         show_error_dialog(data,
             i18n_t("Mirrorlist inválida"),
             i18n_t("El contenido no es válido. Debe contener al menos una entrada "
@@ -400,38 +343,22 @@ void on_repos_save_button_clicked(GtkButton *button, gpointer user_data)
         return;
     }
 
-    gchar *processed     = process_mirrorlist(raw_text);
-    gchar *mirror_escaped = escape_for_bash_var(processed);
+    gchar *processed     = mirrorlist_process(raw_text);
+    gchar *mirror_escaped = mirrorlist_escape_for_bash(processed);
     g_free(raw_text);
     g_free(processed);
 
-    // Leer → actualizar REPOS_MIRROR_CUSTOM → guardar
-    GError *error = NULL;
-    gchar *file_content = NULL;
-
-    if (!g_file_get_contents(VARIABLES_FILE_PATH, &file_content, NULL, &error)) {
-        LOG_ERROR("No se pudo leer variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
-        show_error_dialog(data, "Error", "No se pudo leer el archivo de configuración.");
-        g_free(mirror_escaped);
-        return;
-    }
-
-    GString *content = g_string_new(file_content);
-    g_free(file_content);
-
-    vars_upsert_after(content, "REPOS_MIRROR_CUSTOM", mirror_escaped, "REPOS_MIRROR_MODE");
+    // Modo, repositorios y REPOS_MIRROR_CUSTOM en una sola escritura
+    vars_begin();
+    vars_update(apply_toggles, data);
+    vars_update(apply_mirror_custom, mirror_escaped);
     g_free(mirror_escaped);
 
-    if (!g_file_set_contents(VARIABLES_FILE_PATH, content->str, -1, &error)) {
-        LOG_ERROR("Error guardando variables.sh: %s", error ? error->message : "Unknown error");
-        if (error) g_error_free(error);
+    if (!vars_commit()) {
         show_error_dialog(data, "Error", "No se pudo guardar el archivo de configuración.");
-        g_string_free(content, TRUE);
         return;
     }
 
-    g_string_free(content, TRUE);
     LOG_INFO("Mirrorlist guardada en variables.sh");
 
     gtk_widget_set_visible(GTK_WIDGET(data->window), FALSE);
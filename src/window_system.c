@@ -32,6 +32,7 @@ WindowSystemData* window_system_new(void)
     data->filesystems_enabled = FALSE;
     data->compression_enabled = FALSE;
     data->video_codecs_enabled = FALSE;
+    data->performance_profile = PERF_PROFILE_BALANCED;
     data->is_initialized = FALSE;
     data->is_visible = FALSE;
 
@@ -133,11 +134,15 @@ void window_system_load_widgets_from_builder(WindowSystemData *data)
         data->video_codecs_switch = ADW_SWITCH_ROW(obj);
     }
 
+    data->performance_group = ADW_PREFERENCES_GROUP(gtk_builder_get_object(data->builder, "performance_group"));
+    data->performance_combo = ADW_COMBO_ROW(gtk_builder_get_object(data->builder, "performance_combo"));
+
     // Verificar widgets críticos
     if (!data->window) LOG_WARNING("No se pudo obtener la ventana principal");
     if (!data->close_button) LOG_WARNING("No se pudo obtener close_button");
     if (!data->save_button) LOG_WARNING("No se pudo obtener save_button");
     if (!data->shell_combo) LOG_WARNING("No se pudo obtener shell_combo");
+    if (!data->performance_combo) LOG_WARNING("No se pudo obtener performance_combo");
 
     LOG_INFO("Widgets cargados desde el builder");
 }
@@ -164,6 +169,10 @@ void window_system_setup_widgets(WindowSystemData *data)
         adw_switch_row_set_active(data->video_codecs_switch, data->video_codecs_enabled);
     }
 
+    if (data->performance_combo) {
+        adw_combo_row_set_selected(data->performance_combo, data->performance_profile);
+    }
+
     LOG_INFO("Widgets configurados");
 }
 
@@ -204,6 +213,11 @@ void window_system_connect_signals(WindowSystemData *data)
                         G_CALLBACK(on_video_codecs_switch_toggled), data);
     }
 
+    if (data->performance_combo) {
+        g_signal_connect(data->performance_combo, "notify::selected",
+                        G_CALLBACK(on_performance_combo_changed), data);
+    }
+
     LOG_INFO("Señales conectadas");
 }
 
@@ -337,6 +351,45 @@ void on_video_codecs_switch_toggled(GObject *object, GParamSpec *pspec, gpointer
 }
 
 // Funciones de acceso
+/* Descripción del perfil elegido como subtítulo del combo */
+static void update_performance_subtitle(WindowSystemData *data)
+{
+    if (!data->performance_combo) return;
+
+    const gchar *description;
+    switch (data->performance_profile) {
+        case PERF_PROFILE_THROUGHPUT:
+            description = i18n_t("CPU a máxima frecuencia, escritura diferida amplia y búferes de red grandes con BBR");
+            break;
+        case PERF_PROFILE_DESKTOP:
+            description = i18n_t("bfq en discos SATA, CPU con respuesta rápida y poca escritura pendiente para evitar tirones");
+            break;
+        case PERF_PROFILE_SERVER:
+            description = i18n_t("mq-deadline, CPU a máxima frecuencia, escritura diferida acotada y red con BBR");
+            break;
+        default:
+            description = i18n_t("Ajustes moderados según la CPU, la RAM y el disco, con ahorro de energía");
+            break;
+    }
+    adw_action_row_set_subtitle(ADW_ACTION_ROW(data->performance_combo), description);
+}
+
+void on_performance_combo_changed(AdwComboRow *combo, GParamSpec *pspec, gpointer user_data)
+{
+    WindowSystemData *data = (WindowSystemData *)user_data;
+    if (!data || !combo) return;
+
+    guint selected = adw_combo_row_get_selected(combo);
+    if (selected <= PERF_PROFILE_SERVER) {
+        data->performance_profile = (PerfProfile)selected;
+        update_performance_subtitle(data);
+        LOG_INFO("Perfil de rendimiento cambiado a: %s", perf_profile_id(data->performance_profile));
+
+        // Guardar automáticamente en variables.sh
+        save_system_variables_to_file();
+    }
+}
+
 SystemShell window_system_get_shell(void)
 {
     WindowSystemData *data = window_system_get_instance();
@@ -361,6 +414,12 @@ gboolean window_system_get_video_codecs_enabled(void)
     return data ? data->video_codecs_enabled : FALSE;
 }
 
+PerfProfile window_system_get_performance_profile(void)
+{
+    WindowSystemData *data = window_system_get_instance();
+    return data ? data->performance_profile : PERF_PROFILE_BALANCED;
+}
+
 // Funciones de utilidad
 const char* window_system_shell_to_string(SystemShell shell)
 {
@@ -399,6 +458,7 @@ void load_system_variables_from_file(void)
     gboolean filesystems_enabled = FALSE;
     gboolean compression_enabled = FALSE;
     gboolean video_codecs_enabled = FALSE;
+    PerfProfile performance_profile = PERF_PROFILE_BALANCED;
 
     FILE *read_file = fopen(bash_file_path, "r");
     if (read_file) {
@@ -452,6 +512,17 @@ void load_system_variables_from_file(void)
                 video_codecs_enabled = (g_strcmp0(value, "true") == 0);
                 LOG_INFO("VIDEO_CODECS_ENABLED cargado: %s", video_codecs_enabled ? "true" : "false");
             }
+            // Leer PERFORMANCE_PROFILE
+            else if (g_str_has_prefix(line, "PERFORMANCE_PROFILE=")) {
+                line[strcspn(line, "\n")] = 0;
+                char *value = line + 20;
+                if (value[0] == '"' && strlen(value) > 1 && value[strlen(value)-1] == '"') {
+                    value[strlen(value)-1] = 0;
+                    value++;
+                }
+                performance_profile = perf_profile_from_id(value);
+                LOG_INFO("PERFORMANCE_PROFILE cargado: %s", perf_profile_id(performance_profile));
+            }
         }
         fclose(read_file);
     } else {
@@ -463,6 +534,7 @@ void load_system_variables_from_file(void)
     data->filesystems_enabled = filesystems_enabled;
     data->compression_enabled = compression_enabled;
     data->video_codecs_enabled = video_codecs_enabled;
+    data->performance_profile = performance_profile;
 
     // Actualizar widgets UI si están disponibles
     if (data->shell_combo) {
@@ -477,6 +549,10 @@ void load_system_variables_from_file(void)
     if (data->video_codecs_switch) {
         adw_switch_row_set_active(data->video_codecs_switch, video_codecs_enabled);
     }
+    if (data->performance_combo) {
+        adw_combo_row_set_selected(data->performance_combo, (guint)performance_profile);
+    }
+    update_performance_subtitle(data);
 
     g_free(bash_file_path);
     LOG_INFO("=== load_system_variables_from_file FINALIZADO ===");
@@ -506,6 +582,13 @@ static void apply_system_vars(GString *content, gpointer user_data)
         vars_upsert_after(content, "VIDEO_CODECS_ENABLED",
                           adw_switch_row_get_active(data->video_codecs_switch) ? "true" : "false",
                           "COMPRESSION_ENABLED");
+
+    if (data->performance_combo)
+        vars_upsert_after(content, "PERFORMANCE_PROFILE",
+                          perf_profile_id((PerfProfile)adw_combo_row_get_selected(data->performance_combo)),
+                          "VIDEO_CODECS_ENABLED");
+    /* Los valores PERF_* se recalculan para el hardware de este equipo */
+    perf_profile_update_variables(content);
 }
 
 void save_system_variables_to_file(void)
@@ -556,4 +639,31 @@ void window_system_update_language(WindowSystemData *data)
         adw_action_row_set_subtitle(ADW_ACTION_ROW(data->video_codecs_switch),
             i18n_t("Lectura de todos los formatos de vídeo"));
     }
+    if (data->performance_group) {
+        adw_preferences_group_set_title(data->performance_group,
+            i18n_t("Perfil de rendimiento"));
+        adw_preferences_group_set_description(data->performance_group,
+            i18n_t("Planificador de E/S, frecuencia de la CPU y parámetros del kernel ajustados a este equipo"));
+    }
+    if (data->performance_combo) {
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(data->performance_combo),
+            i18n_t("Perfil"));
+
+        /* Reemplazar las etiquetas sin disparar el guardado automático */
+        GtkStringList *model = GTK_STRING_LIST(adw_combo_row_get_model(data->performance_combo));
+        if (model) {
+            const char *labels[] = {
+                perf_profile_label(PERF_PROFILE_BALANCED),
+                perf_profile_label(PERF_PROFILE_THROUGHPUT),
+                perf_profile_label(PERF_PROFILE_DESKTOP),
+                perf_profile_label(PERF_PROFILE_SERVER),
+                NULL
+            };
+            g_signal_handlers_block_by_func(data->performance_combo, on_performance_combo_changed, data);
+            gtk_string_list_splice(model, 0, g_list_model_get_n_items(G_LIST_MODEL(model)), labels);
+            adw_combo_row_set_selected(data->performance_combo, data->performance_profile);
+            g_signal_handlers_unblock_by_func(data->performance_combo, on_performance_combo_changed, data);
+        }
+        update_performance_subtitle(data);
+    }
 }
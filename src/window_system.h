@@ -3,6 +3,7 @@
 
 #include <gtk/gtk.h>
 #include <adwaita.h>
+#include "performance_profile.h"
 
 // Enumeraciones para opciones del sistema
 typedef enum {
@@ -29,12 +30,15 @@ typedef struct _WindowSystemData {
     AdwSwitchRow *filesystems_switch;
     AdwSwitchRow *compression_switch;
     AdwSwitchRow *video_codecs_switch;
+    AdwPreferencesGroup *performance_group;
+    AdwComboRow *performance_combo;
     
     // Estados de configuración
     SystemShell current_shell;
     gboolean filesystems_enabled;
     gboolean compression_enabled;
     gboolean video_codecs_enabled;
+    PerfProfile performance_profile;
     
     // Estado de la ventana
     gboolean is_initialized;
@@ -68,12 +72,14 @@ void on_shell_combo_changed(AdwComboRow *combo, GParamSpec *pspec, gpointer user
 void on_filesystems_switch_toggled(GObject *object, GParamSpec *pspec, gpointer user_data);
 void on_compression_switch_toggled(GObject *object, GParamSpec *pspec, gpointer user_data);
 void on_video_codecs_switch_toggled(GObject *object, GParamSpec *pspec, gpointer user_data);
+void on_performance_combo_changed(AdwComboRow *combo, GParamSpec *pspec, gpointer user_data);
 
 // Funciones de acceso a configuración
 SystemShell window_system_get_shell(void);
 gboolean window_system_get_filesystems_enabled(void);
 gboolean window_system_get_compression_enabled(void);
 gboolean window_system_get_video_codecs_enabled(void);
+PerfProfile window_system_get_performance_profile(void);
 
 // Funciones de utilidad
 const char* window_system_shell_to_string(SystemShell shell);
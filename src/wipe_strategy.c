@@ -0,0 +1,152 @@
+#include "wipe_strategy.h"
+#include "variables_utils.h"
+#include "config.h"
+#include "i18n.h"
+
+#define MIB (1024.0 * 1024.0)
+
+/* Velocidad de escritura secuencial aproximada (MiB/s) para estimar el borrado con ceros */
+static gdouble zero_write_rate(const StorageProfile *profile)
+{
+    switch (profile->storage_class) {
+        case STORAGE_CLASS_NVME: return 1500.0;
+        case STORAGE_CLASS_SSD:  return 450.0;
+        case STORAGE_CLASS_HDD:  return 150.0;
+        default:                 return 100.0;
+    }
+}
+
+static guint estimate_seconds(const StorageProfile *profile, WipeMethod method)
+{
+    gdouble size_mib = profile->size_bytes / MIB;
+    gdouble seconds;
+
+    switch (method) {
+        case WIPE_METHOD_DISCARD:
+            /* El controlador solo marca los bloques como libres */
+            seconds = 2.0 + size_mib / 100000.0;
+            break;
+        case WIPE_METHOD_SECURE_DISCARD:
+            seconds = size_mib / 100.0;
+            break;
+        case WIPE_METHOD_NVME_SANITIZE:
+            /* Depende del firmware; el borrado por bloques suele ir a varios GiB/s */
+            seconds = 10.0 + size_mib / 2000.0;
+            break;
+        case WIPE_METHOD_ZEROOUT:
+            /* En NVMe "write zeroes" suele desasignar bloques en lugar de escribirlos */
+            seconds = size_mib / (profile->storage_class == STORAGE_CLASS_NVME
+                                  ? 4000.0 : zero_write_rate(profile));
+            break;
+        case WIPE_METHOD_ZERO:
+            seconds = size_mib / zero_write_rate(profile);
+            break;
+        default:
+            seconds = 3.0;
+            break;
+    }
+
+    return (guint)MAX(1.0, seconds);
+}
+
+void wipe_strategy_select(const StorageProfile *profile, gboolean full_erase, WipePlan *plan)
+{
+    g_return_if_fail(profile != NULL && plan != NULL);
+
+    plan->full_erase = full_erase;
+
+    if (!full_erase) {
+        /* En discos mecánicos discard no existe y en memoria flash deja todos
+         * los bloques libres para el controlador */
+        plan->method = profile->discard && profile->storage_class != STORAGE_CLASS_HDD
+            ? WIPE_METHOD_DISCARD : WIPE_METHOD_SIGNATURES;
+    } else if (profile->storage_class == STORAGE_CLASS_NVME) {
+        /* config_disk.sh comprueba SANICAP y recurre a zeroout si no está soportado */
+        plan->method = WIPE_METHOD_NVME_SANITIZE;
+    } else if (profile->secure_discard) {
+        plan->method = WIPE_METHOD_SECURE_DISCARD;
+    } else if (profile->write_zeroes) {
+        plan->method = WIPE_METHOD_ZEROOUT;
+    } else {
+        plan->method = WIPE_METHOD_ZERO;
+    }
+
+    plan->estimated_seconds = estimate_seconds(profile, plan->method);
+}
+
+const gchar *wipe_method_id(WipeMethod method)
+{
+    switch (method) {
+        case WIPE_METHOD_DISCARD:        return "discard";
+        case WIPE_METHOD_SECURE_DISCARD: return "secure_discard";
+        case WIPE_METHOD_NVME_SANITIZE:  return "sanitize";
+        case WIPE_METHOD_ZEROOUT:        return "zeroout";
+        case WIPE_METHOD_ZERO:           return "zero";
+        default:                         return "signatures";
+    }
+}
+
+static const gchar *wipe_method_label(WipeMethod method)
+{
+    switch (method) {
+        case WIPE_METHOD_DISCARD:        return i18n_t("Discard (TRIM) de todo el disco");
+        case WIPE_METHOD_SECURE_DISCARD: return i18n_t("Discard seguro de todo el disco");
+        case WIPE_METHOD_NVME_SANITIZE:  return i18n_t("Sanitize NVMe del controlador");
+        case WIPE_METHOD_ZEROOUT:        return i18n_t("Escritura de ceros delegada al disco");
+        case WIPE_METHOD_ZERO:           return i18n_t("Escritura de ceros en todo el disco");
+        default:                         return i18n_t("Solo tabla de particiones y firmas");
+    }
+}
+
+gchar *wipe_plan_describe(const WipePlan *plan)
+{
+    g_return_val_if_fail(plan != NULL, NULL);
+
+    guint seconds = plan->estimated_seconds;
+    gchar *duration;
+    if (seconds < 60)
+        duration = g_strdup_printf("≈ %u s", seconds);
+    else if (seconds < 3600)
+        duration = g_strdup_printf("≈ %u min", (seconds + 59) / 60);
+    else
+        duration = g_strdup_printf("≈ %u h %02u min", seconds / 3600, (seconds % 3600) / 60);
+
+    gchar *result = g_strdup_printf("%s • %s", wipe_method_label(plan->method), duration);
+    g_free(duration);
+    return result;
+}
+
+void wipe_strategy_update_variables(GString *content)
+{
+    g_return_if_fail(content != NULL);
+
+    gchar *disk = vars_get(content, "SELECTED_DISK");
+    gchar *full = vars_get(content, "WIPE_FULL");
+
+    StorageProfile profile;
+    WipePlan plan;
+    storage_profile_detect(disk, &profile);
+    wipe_strategy_select(&profile, g_strcmp0(full, "true") == 0, &plan);
+
+    vars_upsert(content, "WIPE_FULL", plan.full_erase ? "true" : "false");
+    vars_upsert(content, "WIPE_METHOD", wipe_method_id(plan.method));
+    LOG_INFO("Borrado de %s: %s (≈ %u s)", disk ? disk : "(ninguno)",
+             wipe_method_id(plan.method), plan.estimated_seconds);
+
+    g_free(full);
+    g_free(disk);
+}
+
+gboolean wipe_progress_read(gdouble *fraction)
+{
+    gchar *content = NULL;
+    if (!g_file_get_contents(WIPE_PROGRESS_PATH, &content, NULL, NULL))
+        return FALSE;
+
+    guint64 percent = g_ascii_strtoull(g_strstrip(content), NULL, 10);
+    g_free(content);
+
+    if (fraction)
+        *fraction = MIN(percent, 100) / 100.0;
+    return TRUE;
+}
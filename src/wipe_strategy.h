@@ -0,0 +1,44 @@
+#ifndef WIPE_STRATEGY_H
+#define WIPE_STRATEGY_H
+
+#include <glib.h>
+#include "storage_profile.h"
+
+/* Archivo donde config_disk.sh deja el porcentaje del borrado completo
+ * (una línea "0".."100"); la página 8 lo muestra en la barra de progreso */
+#define WIPE_PROGRESS_PATH "/tmp/arcris-wipe-progress"
+
+/* Cómo se prepara el disco antes de crear la tabla de particiones */
+typedef enum {
+    WIPE_METHOD_SIGNATURES = 0,  /* solo tabla de particiones y firmas (wipefs/sgdisk) */
+    WIPE_METHOD_DISCARD,         /* blkdiscard de todo el disco (TRIM) */
+    WIPE_METHOD_SECURE_DISCARD,  /* blkdiscard --secure (eMMC/SD) */
+    WIPE_METHOD_NVME_SANITIZE,   /* nvme sanitize, borrado por bloques del controlador */
+    WIPE_METHOD_ZEROOUT,         /* blkdiscard --zeroout (escritura de ceros delegada) */
+    WIPE_METHOD_ZERO             /* escribir ceros con dd */
+} WipeMethod;
+
+typedef struct {
+    WipeMethod method;
+    gboolean   full_erase;         /* borrado completo pedido por el usuario */
+    guint      estimated_seconds;
+} WipePlan;
+
+/* Elige el método según las capacidades del disco: en modo rápido discard si el
+ * dispositivo lo admite, y en borrado completo sanitize (NVMe), discard seguro
+ * (eMMC), escritura de ceros delegada o, como último recurso, dd. */
+void wipe_strategy_select(const StorageProfile *profile, gboolean full_erase, WipePlan *plan);
+
+/* Nombre estable del método tal como se escribe en WIPE_METHOD */
+const gchar *wipe_method_id(WipeMethod method);
+
+/* Resumen legible para la ventana de disco (p. ej. "Discard (TRIM) de todo el disco • ≈ 5 s") */
+gchar *wipe_plan_describe(const WipePlan *plan);
+
+/* Recalcula WIPE_METHOD a partir de SELECTED_DISK y WIPE_FULL del contenido de variables.sh */
+void wipe_strategy_update_variables(GString *content);
+
+/* Lee el progreso del borrado completo; FALSE si no hay ninguno en curso */
+gboolean wipe_progress_read(gdouble *fraction);
+
+#endif /* WIPE_STRATEGY_H */
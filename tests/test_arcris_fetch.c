@@ -0,0 +1,544 @@
+/*
+ * test_arcris_fetch.c - Pruebas de arcris-fetch contra espejos HTTP locales
+ *
+ * Cada prueba levanta varios SoupServer en 127.0.0.N (un host distinto por
+ * espejo, para distinguirlos en el diario) que sirven paquetes generados en
+ * memoria, escribe una mirrorlist que apunta a ellos y ejecuta el binario
+ * real (ruta en ARCRIS_FETCH) con la lista por stdin, como package_fetch.sh.
+ *
+ * Los espejos se pueden configurar para:
+ *   delay_ms       esperar entre cada bloque de 64 KiB (espejo lento)
+ *   stall          mandar un bloque y no volver a responder (espejo parado)
+ *   refuse         contestar 503 a todo
+ *   ignore_range   contestar 200 con el paquete entero aunque se pida Range
+ *   corrupt        alterar los datos (el sha256 no coincide)
+ *
+ * Uso:
+ *   meson test -C builddir arcris-fetch -v
+ */
+
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <libsoup/soup.h>
+#include <string.h>
+
+#define TEST_BLOCK_SIZE   (64 * 1024)
+#define TEST_TIMEOUT_SEC  90
+
+typedef struct {
+    gchar *name;
+    gsize size;
+    guint8 *data;
+    gchar *sha256;
+} TestPackage;
+
+typedef struct {
+    /* Comportamiento */
+    guint delay_ms;
+    gboolean stall;
+    gboolean refuse;
+    gboolean ignore_range;
+    gboolean corrupt;
+
+    /* Lo que vio el espejo */
+    guint requests;
+    guint range_requests;
+    guint64 bytes_served;
+
+    SoupServer *server;
+    gchar *host;
+    guint port;
+} TestMirror;
+
+typedef struct {
+    TestMirror *mirror;
+    SoupServerMessage *msg;
+    const guint8 *data;
+    goffset offset;
+    goffset end;
+    guint blocks;
+    gboolean completed;
+    guint source_id;
+} TestJob;
+
+typedef struct {
+    GPtrArray *packages;
+    GPtrArray *mirrors;
+    gchar *dir;
+    gchar *cachedir;
+    gchar *mirrorlist;
+    gchar *journal;
+
+    /* Resultado de la última ejecución */
+    gint exit_status;
+    gchar *stderr_text;
+    GMainLoop *loop;
+    gboolean timed_out;
+} TestFixture;
+
+/* Contenido determinista (no comprimible para no favorecer a nadie) */
+static TestPackage *test_package_new(const gchar *name, gsize size, guint32 seed)
+{
+    TestPackage *pkg = g_new0(TestPackage, 1);
+    pkg->name = g_strdup(name);
+    pkg->size = size;
+    pkg->data = g_malloc(size);
+    GRand *rand = g_rand_new_with_seed(seed);
+    for (gsize i = 0; i < size; i += 4) {
+        guint32 value = g_rand_int(rand);
+        memcpy(pkg->data + i, &value, MIN(4, size - i));
+    }
+    g_rand_free(rand);
+    pkg->sha256 = g_compute_checksum_for_data(G_CHECKSUM_SHA256, pkg->data, size);
+    return pkg;
+}
+
+static void test_package_free(TestPackage *pkg)
+{
+    g_free(pkg->name);
+    g_free(pkg->data);
+    g_free(pkg->sha256);
+    g_free(pkg);
+}
+
+static void test_mirror_free(TestMirror *mirror)
+{
+    if (mirror->server) {
+        soup_server_disconnect(mirror->server);
+        g_object_unref(mirror->server);
+    }
+    g_free(mirror->host);
+    g_free(mirror);
+}
+
+static void test_job_finished(SoupServerMessage *msg, gpointer user_data)
+{
+    TestJob *job = user_data;
+
+    if (job->source_id)
+        g_source_remove(job->source_id);
+    g_signal_handlers_disconnect_by_data(job->msg, job);
+    g_object_unref(job->msg);
+    g_free(job);
+}
+
+/* Agrega el siguiente bloque al cuerpo; al final lo da por completo */
+static void test_job_write(TestJob *job)
+{
+    SoupMessageBody *body = soup_server_message_get_response_body(job->msg);
+    gsize length = MIN(TEST_BLOCK_SIZE, job->end - job->offset);
+
+    if (job->completed)
+        return;
+    if (length == 0) {
+        job->completed = TRUE;
+        soup_message_body_complete(body);
+        return;
+    }
+
+    if (job->mirror->corrupt) {
+        guint8 *copy = g_memdup2(job->data + job->offset, length);
+        copy[0] ^= 0xff;
+        soup_message_body_append_take(body, copy, length);
+    } else {
+        soup_message_body_append(body, SOUP_MEMORY_STATIC, job->data + job->offset, length);
+    }
+    job->offset += length;
+    job->blocks++;
+    job->mirror->bytes_served += length;
+}
+
+static gboolean test_job_resume(gpointer user_data)
+{
+    TestJob *job = user_data;
+
+    job->source_id = 0;
+    test_job_write(job);
+    soup_server_message_unpause(job->msg);
+    return G_SOURCE_REMOVE;
+}
+
+/* wrote-headers y wrote-chunk: el servidor pide el siguiente bloque */
+static void test_job_next(SoupServerMessage *msg, gpointer user_data)
+{
+    TestJob *job = user_data;
+
+    if (job->completed)
+        return;
+
+    /* Parado: el mensaje queda en pausa hasta que el cliente se vaya */
+    if (job->mirror->stall && job->blocks > 0) {
+        soup_server_message_pause(msg);
+        return;
+    }
+    if (job->mirror->delay_ms > 0) {
+        soup_server_message_pause(msg);
+        job->source_id = g_timeout_add(job->mirror->delay_ms, test_job_resume, job);
+        return;
+    }
+    test_job_write(job);
+}
+
+static void test_mirror_handler(SoupServer *server, SoupServerMessage *msg, const char *path,
+                                GHashTable *query, gpointer user_data)
+{
+    TestFixture *fixture = user_data;
+    TestMirror *mirror = NULL;
+    for (guint i = 0; i < fixture->mirrors->len; i++) {
+        TestMirror *m = g_ptr_array_index(fixture->mirrors, i);
+        if (m->server == server)
+            mirror = m;
+    }
+    g_assert_nonnull(mirror);
+    mirror->requests++;
+
+    if (mirror->refuse) {
+        soup_server_message_set_status(msg, SOUP_STATUS_SERVICE_UNAVAILABLE, NULL);
+        return;
+    }
+
+    /* /$repo/os/$arch/<archivo> */
+    g_autofree gchar *name = g_path_get_basename(path);
+    TestPackage *pkg = NULL;
+    for (guint i = 0; i < fixture->packages->len; i++) {
+        TestPackage *p = g_ptr_array_index(fixture->packages, i);
+        if (g_strcmp0(p->name, name) == 0)
+            pkg = p;
+    }
+    if (!pkg || !g_str_has_prefix(path, "/core/os/x86_64/")) {
+        soup_server_message_set_status(msg, SOUP_STATUS_NOT_FOUND, NULL);
+        return;
+    }
+
+    SoupMessageHeaders *request = soup_server_message_get_request_headers(msg);
+    SoupMessageHeaders *response = soup_server_message_get_response_headers(msg);
+    TestJob *job = g_new0(TestJob, 1);
+    job->mirror = mirror;
+    job->msg = g_object_ref(msg);
+    job->data = pkg->data;
+    job->end = pkg->size;
+
+    SoupRange *ranges = NULL;
+    int count = 0;
+    if (soup_message_headers_get_ranges(request, pkg->size, &ranges, &count)) {
+        mirror->range_requests++;
+        if (!mirror->ignore_range) {
+            job->offset = ranges[0].start;
+            job->end = ranges[0].end + 1;
+            soup_message_headers_set_content_range(response, ranges[0].start, ranges[0].end, pkg->size);
+        }
+        soup_message_headers_free_ranges(request, ranges);
+    }
+
+    soup_server_message_set_status(msg, job->offset > 0 || job->end < (goffset)pkg->size
+                                        ? SOUP_STATUS_PARTIAL_CONTENT : SOUP_STATUS_OK, NULL);
+    soup_message_headers_set_encoding(response, SOUP_ENCODING_CHUNKED);
+    g_signal_connect(msg, "wrote-headers", G_CALLBACK(test_job_next), job);
+    g_signal_connect(msg, "wrote-chunk", G_CALLBACK(test_job_next), job);
+    g_signal_connect(msg, "finished", G_CALLBACK(test_job_finished), job);
+}
+
+static TestMirror *test_add_mirror(TestFixture *fixture)
+{
+    TestMirror *mirror = g_new0(TestMirror, 1);
+    g_autoptr(GError) error = NULL;
+
+    mirror->host = g_strdup_printf("127.0.0.%u", fixture->mirrors->len + 1);
+    mirror->server = soup_server_new(NULL);
+    soup_server_add_handler(mirror->server, NULL, test_mirror_handler, fixture, NULL);
+
+    g_autoptr(GSocketAddress) address = g_inet_socket_address_new_from_string(mirror->host, 0);
+    g_assert_true(soup_server_listen(mirror->server, address, 0, &error));
+    g_assert_no_error(error);
+
+    GSList *uris = soup_server_get_uris(mirror->server);
+    g_assert_nonnull(uris);
+    mirror->port = g_uri_get_port(uris->data);
+    g_slist_free_full(uris, (GDestroyNotify)g_uri_unref);
+
+    g_ptr_array_add(fixture->mirrors, mirror);
+    return mirror;
+}
+
+static void fixture_setup(TestFixture *fixture, gconstpointer user_data)
+{
+    g_autoptr(GError) error = NULL;
+
+    fixture->packages = g_ptr_array_new_with_free_func((GDestroyNotify)test_package_free);
+    fixture->mirrors = g_ptr_array_new_with_free_func((GDestroyNotify)test_mirror_free);
+    fixture->dir = g_dir_make_tmp("arcris-fetch-test-XXXXXX", &error);
+    g_assert_no_error(error);
+    fixture->cachedir = g_build_filename(fixture->dir, "pkg", NULL);
+    fixture->mirrorlist = g_build_filename(fixture->dir, "mirrorlist", NULL);
+    fixture->journal = g_build_filename(fixture->dir, "timing.tsv", NULL);
+}
+
+static void test_remove_tree(const gchar *path)
+{
+    GDir *dir = g_dir_open(path, 0, NULL);
+    if (dir) {
+        const gchar *name;
+        while ((name = g_dir_read_name(dir))) {
+            g_autofree gchar *child = g_build_filename(path, name, NULL);
+            test_remove_tree(child);
+        }
+        g_dir_close(dir);
+    }
+    g_remove(path);
+}
+
+static void fixture_teardown(TestFixture *fixture, gconstpointer user_data)
+{
+    test_remove_tree(fixture->dir);
+    g_ptr_array_unref(fixture->mirrors);
+    g_ptr_array_unref(fixture->packages);
+    g_free(fixture->dir);
+    g_free(fixture->cachedir);
+    g_free(fixture->mirrorlist);
+    g_free(fixture->journal);
+    g_free(fixture->stderr_text);
+}
+
+static void test_on_communicated(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    TestFixture *fixture = user_data;
+    g_autoptr(GError) error = NULL;
+
+    g_subprocess_communicate_utf8_finish(G_SUBPROCESS(source), result, NULL, &fixture->stderr_text, &error);
+    g_assert_no_error(error);
+    g_main_loop_quit(fixture->loop);
+}
+
+static gboolean test_on_timeout(gpointer user_data)
+{
+    TestFixture *fixture = user_data;
+    fixture->timed_out = TRUE;
+    g_main_loop_quit(fixture->loop);
+    return G_SOURCE_REMOVE;
+}
+
+/* Escribe la mirrorlist y ejecuta arcris-fetch con todos los paquetes; los
+ * servidores atienden en el mismo bucle principal mientras tanto */
+static void test_run_fetch(TestFixture *fixture)
+{
+    g_autoptr(GError) error = NULL;
+    const gchar *binary = g_getenv("ARCRIS_FETCH");
+    if (!binary)
+        binary = "arcris-fetch";
+
+    GString *mirrorlist = g_string_new("## Espejos de prueba\n");
+    for (guint i = 0; i < fixture->mirrors->len; i++) {
+        TestMirror *m = g_ptr_array_index(fixture->mirrors, i);
+        g_string_append_printf(mirrorlist, "Server = http://%s:%u/$repo/os/$arch\n", m->host, m->port);
+    }
+    g_assert_true(g_file_set_contents(fixture->mirrorlist, mirrorlist->str, -1, &error));
+    g_string_free(mirrorlist, TRUE);
+
+    GString *list = g_string_new(NULL);
+    for (guint i = 0; i < fixture->packages->len; i++) {
+        TestPackage *pkg = g_ptr_array_index(fixture->packages, i);
+        g_string_append_printf(list, "core %s %" G_GSIZE_FORMAT " %s\n", pkg->name, pkg->size, pkg->sha256);
+    }
+
+    GSubprocess *process = g_subprocess_new(G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_SILENCE |
+                                            G_SUBPROCESS_FLAGS_STDERR_PIPE, &error,
+                                            binary, "--mirrorlist", fixture->mirrorlist,
+                                            "--cachedir", fixture->cachedir,
+                                            "--journal", fixture->journal, NULL);
+    g_assert_no_error(error);
+
+    fixture->loop = g_main_loop_new(NULL, FALSE);
+    g_clear_pointer(&fixture->stderr_text, g_free);
+    g_subprocess_communicate_utf8_async(process, list->str, NULL, test_on_communicated, fixture);
+    guint timeout_id = g_timeout_add_seconds(TEST_TIMEOUT_SEC, test_on_timeout, fixture);
+    g_main_loop_run(fixture->loop);
+    g_assert_false(fixture->timed_out);
+    g_source_remove(timeout_id);
+
+    g_subprocess_wait(process, NULL, &error);
+    g_assert_no_error(error);
+    fixture->exit_status = g_subprocess_get_exit_status(process);
+    if (fixture->stderr_text && fixture->stderr_text[0])
+        g_test_message("arcris-fetch:\n%s", fixture->stderr_text);
+
+    g_main_loop_unref(fixture->loop);
+    fixture->loop = NULL;
+    g_object_unref(process);
+    g_string_free(list, TRUE);
+}
+
+/* El paquete quedó en la caché con el contenido exacto y sin .arcris-part */
+static void test_assert_cached(TestFixture *fixture, TestPackage *pkg)
+{
+    g_autofree gchar *path = g_build_filename(fixture->cachedir, pkg->name, NULL);
+    g_autofree gchar *part = g_strconcat(path, ".arcris-part", NULL);
+    g_autofree gchar *contents = NULL;
+    gsize length = 0;
+
+    g_assert_true(g_file_get_contents(path, &contents, &length, NULL));
+    g_assert_cmpuint(length, ==, pkg->size);
+    g_assert_cmpmem(contents, length, pkg->data, pkg->size);
+    g_assert_false(g_file_test(part, G_FILE_TEST_EXISTS));
+}
+
+/* Línea "mirror" del diario para el host; NULL si no la hay */
+static gchar **test_journal_mirror(TestFixture *fixture, const gchar *host)
+{
+    g_autofree gchar *contents = NULL;
+    if (!g_file_get_contents(fixture->journal, &contents, NULL, NULL))
+        return NULL;
+
+    g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+    for (guint i = 0; lines[i]; i++) {
+        gchar **fields = g_strsplit(lines[i], "\t", -1);
+        if (g_strv_length(fields) == 8 && g_strcmp0(fields[0], "mirror") == 0 &&
+            g_strcmp0(fields[1], host) == 0)
+            return fields;
+        g_strfreev(fields);
+    }
+    return NULL;
+}
+
+/* Un paquete grande se parte en trozos Range repartidos entre los espejos */
+static void test_range_split(TestFixture *fixture, gconstpointer user_data)
+{
+    TestPackage *big = test_package_new("big-1.0-1-x86_64.pkg.tar.zst", 40 * 1024 * 1024 + 123, 1);
+    TestPackage *small = test_package_new("small-1.0-1-x86_64.pkg.tar.zst", 300 * 1024, 2);
+    g_ptr_array_add(fixture->packages, big);
+    g_ptr_array_add(fixture->packages, small);
+    TestMirror *a = test_add_mirror(fixture);
+    TestMirror *b = test_add_mirror(fixture);
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 0);
+    test_assert_cached(fixture, big);
+    test_assert_cached(fixture, small);
+    g_assert_cmpuint(a->range_requests + b->range_requests, >=, 2);
+    g_assert_cmpuint(a->bytes_served, >, 0);
+    g_assert_cmpuint(b->bytes_served, >, 0);
+}
+
+/* Un espejo que ignora Range solo sirve los trozos que empiezan en 0 */
+static void test_range_ignored(TestFixture *fixture, gconstpointer user_data)
+{
+    TestPackage *big = test_package_new("big-1.0-1-x86_64.pkg.tar.zst", 24 * 1024 * 1024, 3);
+    g_ptr_array_add(fixture->packages, big);
+    TestMirror *a = test_add_mirror(fixture);
+    a->ignore_range = TRUE;
+    test_add_mirror(fixture);
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 0);
+    test_assert_cached(fixture, big);
+}
+
+/* Con un espejo lento y otro diez veces más rápido, la mayor parte va al
+ * rápido: los trozos que siguen en el lento a los 5 s se pasan al otro. El
+ * rápido también espera un poco entre bloques para que esté descargando
+ * cuando arcris-fetch mide la velocidad de cada espejo (cada segundo) */
+static void test_delayed_mirror(TestFixture *fixture, gconstpointer user_data)
+{
+    TestPackage *big = test_package_new("big-1.0-1-x86_64.pkg.tar.zst", 24 * 1024 * 1024, 4);
+    g_ptr_array_add(fixture->packages, big);
+    for (guint i = 0; i < 4; i++) {
+        g_autofree gchar *name = g_strdup_printf("small%u-1.0-1-x86_64.pkg.tar.zst", i);
+        g_ptr_array_add(fixture->packages, test_package_new(name, 512 * 1024, 10 + i));
+    }
+    TestMirror *slow = test_add_mirror(fixture);
+    slow->delay_ms = 400;
+    TestMirror *fast = test_add_mirror(fixture);
+    fast->delay_ms = 20;
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 0);
+    for (guint i = 0; i < fixture->packages->len; i++)
+        test_assert_cached(fixture, g_ptr_array_index(fixture->packages, i));
+    g_assert_cmpuint(fast->bytes_served, >, slow->bytes_served);
+}
+
+/* Un espejo que deja de mandar datos a mitad de descarga: lo que falta pasa
+ * al otro y queda anotado como cambio en el diario */
+static void test_stalled_mirror(TestFixture *fixture, gconstpointer user_data)
+{
+    TestPackage *pkg = test_package_new("stall-1.0-1-x86_64.pkg.tar.zst", 2 * 1024 * 1024, 5);
+    g_ptr_array_add(fixture->packages, pkg);
+    TestMirror *stalled = test_add_mirror(fixture);
+    stalled->stall = TRUE;
+    test_add_mirror(fixture);
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 0);
+    test_assert_cached(fixture, pkg);
+    g_assert_nonnull(strstr(fixture->stderr_text, "sin datos"));
+
+    g_auto(GStrv) line = test_journal_mirror(fixture, stalled->host);
+    g_assert_nonnull(line);
+    g_assert_cmpuint(g_ascii_strtoull(line[5], NULL, 10), >=, 1);
+}
+
+/* Un espejo que rechaza todo: los paquetes llegan por el otro */
+static void test_failover(TestFixture *fixture, gconstpointer user_data)
+{
+    for (guint i = 0; i < 6; i++) {
+        g_autofree gchar *name = g_strdup_printf("pkg%u-1.0-1-x86_64.pkg.tar.zst", i);
+        g_ptr_array_add(fixture->packages, test_package_new(name, 256 * 1024, 20 + i));
+    }
+    TestMirror *broken = test_add_mirror(fixture);
+    broken->refuse = TRUE;
+    TestMirror *good = test_add_mirror(fixture);
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 0);
+    for (guint i = 0; i < fixture->packages->len; i++)
+        test_assert_cached(fixture, g_ptr_array_index(fixture->packages, i));
+    g_assert_cmpuint(broken->requests, >=, 1);
+    g_assert_cmpuint(broken->bytes_served, ==, 0);
+    g_assert_cmpuint(good->bytes_served, >=, 6 * 256 * 1024);
+
+    g_auto(GStrv) line = test_journal_mirror(fixture, broken->host);
+    g_assert_nonnull(line);
+    g_assert_cmpuint(g_ascii_strtoull(line[5], NULL, 10), >=, 1);
+}
+
+/* Datos alterados: se reintenta una vez y el paquete queda para pacman, sin
+ * dejar nada en la caché */
+static void test_sha256_rejected(TestFixture *fixture, gconstpointer user_data)
+{
+    TestPackage *pkg = test_package_new("bad-1.0-1-x86_64.pkg.tar.zst", 200 * 1024, 6);
+    g_ptr_array_add(fixture->packages, pkg);
+    TestMirror *corrupt = test_add_mirror(fixture);
+    corrupt->corrupt = TRUE;
+
+    test_run_fetch(fixture);
+
+    g_assert_cmpint(fixture->exit_status, ==, 1);
+    g_assert_cmpuint(corrupt->requests, ==, 2);
+    g_assert_nonnull(strstr(fixture->stderr_text, "sha256 distinto"));
+
+    g_autofree gchar *path = g_build_filename(fixture->cachedir, pkg->name, NULL);
+    g_autofree gchar *part = g_strconcat(path, ".arcris-part", NULL);
+    g_assert_false(g_file_test(path, G_FILE_TEST_EXISTS));
+    g_assert_false(g_file_test(part, G_FILE_TEST_EXISTS));
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+#define FETCH_TEST(path, func) \
+    g_test_add("/arcris-fetch/" path, TestFixture, NULL, fixture_setup, func, fixture_teardown)
+    FETCH_TEST("range-split", test_range_split);
+    FETCH_TEST("range-ignored", test_range_ignored);
+    FETCH_TEST("delayed-mirror", test_delayed_mirror);
+    FETCH_TEST("stalled-mirror", test_stalled_mirror);
+    FETCH_TEST("failover", test_failover);
+    FETCH_TEST("sha256-rejected", test_sha256_rejected);
+#undef FETCH_TEST
+
+    return g_test_run();
+}
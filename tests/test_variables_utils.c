@@ -0,0 +1,360 @@
+/*
+ * test_variables_utils.c - Pruebas de las transacciones sobre variables.sh
+ *
+ * Cada prueba trabaja en un directorio temporal con data/bash/variables.sh
+ * (VARIABLES_FILE_PATH es relativo al directorio actual, como en la
+ * interfaz). Los casos de rebase abren una transacción, preparan cambios,
+ * reescriben variables.sh por detrás (como hacen los scripts de bash) y
+ * comprueban lo que queda en disco después de vars_commit().
+ *
+ * Uso:
+ *   meson test -C builddir variables-utils -v
+ */
+
+#include "variables_utils.h"
+
+#include <glib/gstdio.h>
+#include <unistd.h>
+
+#define TEST_BASE \
+    "# Disco\n" \
+    "SELECTED_DISK=\"/dev/sda\"\n" \
+    "FILESYSTEM_TYPE=\"ext4\"\n" \
+    "EXTRA_PACKAGES=(\n" \
+    "    \"git\"\n" \
+    "    \"vim\"\n" \
+    ")\n" \
+    "HOSTNAME=\"arcris\"\n"
+
+#define TEST_REBASE_WARNING "*cambió durante la transacción*"
+
+typedef struct {
+    gchar *old_cwd;
+    gchar *dir;
+} TestFixture;
+
+typedef struct {
+    const gchar *name;
+    const gchar *value;
+} TestVar;
+
+static void write_variables(const gchar *content)
+{
+    GError *error = NULL;
+    g_file_set_contents(VARIABLES_FILE_PATH, content, -1, &error);
+    g_assert_no_error(error);
+}
+
+static gchar *read_variables(void)
+{
+    GError *error = NULL;
+    gchar *content = NULL;
+    g_file_get_contents(VARIABLES_FILE_PATH, &content, NULL, &error);
+    g_assert_no_error(error);
+    return content;
+}
+
+static void fixture_setup(TestFixture *fx, gconstpointer data)
+{
+    GError *error = NULL;
+    (void)data;
+
+    fx->old_cwd = g_get_current_dir();
+    fx->dir = g_dir_make_tmp("arcris-vars-XXXXXX", &error);
+    g_assert_no_error(error);
+
+    gchar *bash_dir = g_build_filename(fx->dir, "data", "bash", NULL);
+    g_assert_cmpint(g_mkdir_with_parents(bash_dir, 0755), ==, 0);
+    g_free(bash_dir);
+
+    g_assert_cmpint(g_chdir(fx->dir), ==, 0);
+    write_variables(TEST_BASE);
+}
+
+static void fixture_teardown(TestFixture *fx, gconstpointer data)
+{
+    (void)data;
+
+    g_remove(VARIABLES_FILE_PATH);
+    g_assert_cmpint(g_chdir(fx->old_cwd), ==, 0);
+
+    gchar *bash_dir = g_build_filename(fx->dir, "data", "bash", NULL);
+    gchar *data_dir = g_build_filename(fx->dir, "data", NULL);
+    g_rmdir(bash_dir);
+    g_rmdir(data_dir);
+    g_rmdir(fx->dir);
+    g_free(data_dir);
+    g_free(bash_dir);
+    g_free(fx->dir);
+    g_free(fx->old_cwd);
+}
+
+static void apply_upsert(GString *content, gpointer user_data)
+{
+    const TestVar *var = user_data;
+    vars_upsert(content, var->name, var->value);
+}
+
+static void apply_remove(GString *content, gpointer user_data)
+{
+    vars_remove(content, user_data);
+}
+
+static void apply_upsert_kernel(GString *content, gpointer user_data)
+{
+    (void)user_data;
+    vars_upsert_after_with_comment(content, "KERNEL", "linux-lts", "FILESYSTEM_TYPE", "Kernel");
+}
+
+static void apply_upsert_packages(GString *content, gpointer user_data)
+{
+    static const gchar *const items[] = { "git", "htop", "tmux", NULL };
+    (void)user_data;
+    vars_upsert_array(content, "EXTRA_PACKAGES", items);
+}
+
+/* Commit con variables.sh modificado por detrás: avisa del rebase */
+static void commit_rebased(void)
+{
+    g_test_expect_message(NULL, G_LOG_LEVEL_WARNING, TEST_REBASE_WARNING);
+    g_assert_true(vars_commit());
+    g_test_assert_expected_messages();
+}
+
+static void assert_variables(const gchar *expected)
+{
+    gchar *content = read_variables();
+    g_assert_cmpstr(content, ==, expected);
+    g_free(content);
+}
+
+/* Variable nueva en la transacción (con su comentario) y otra nueva en disco */
+static void test_rebase_added(TestFixture *fx, gconstpointer data)
+{
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert_kernel, NULL));
+    write_variables(TEST_BASE "TIMEZONE=\"UTC\"\n");
+    commit_rebased();
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "FILESYSTEM_TYPE=\"ext4\"\n"
+                     "\n"
+                     "# Kernel\n"
+                     "KERNEL=\"linux-lts\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"arcris\"\n"
+                     "TIMEZONE=\"UTC\"\n");
+}
+
+/* Cada lado cambia una variable distinta: se conservan los dos cambios */
+static void test_rebase_changed(TestFixture *fx, gconstpointer data)
+{
+    TestVar var = { "HOSTNAME", "estacion" };
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &var));
+    write_variables("# Disco\n"
+                    "SELECTED_DISK=\"/dev/nvme0n1\"\n"
+                    "FILESYSTEM_TYPE=\"ext4\"\n"
+                    "EXTRA_PACKAGES=(\n"
+                    "    \"git\"\n"
+                    "    \"vim\"\n"
+                    ")\n"
+                    "HOSTNAME=\"arcris\"\n");
+    commit_rebased();
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/nvme0n1\"\n"
+                     "FILESYSTEM_TYPE=\"ext4\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"estacion\"\n");
+}
+
+/* La transacción elimina una variable que en disco sigue estando */
+static void test_rebase_removed(TestFixture *fx, gconstpointer data)
+{
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_remove, "FILESYSTEM_TYPE"));
+    write_variables("# Disco\n"
+                    "SELECTED_DISK=\"/dev/sda\"\n"
+                    "FILESYSTEM_TYPE=\"ext4\"\n"
+                    "EXTRA_PACKAGES=(\n"
+                    "    \"git\"\n"
+                    "    \"vim\"\n"
+                    ")\n"
+                    "HOSTNAME=\"servidor\"\n");
+    commit_rebased();
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"servidor\"\n");
+}
+
+/* Un array de varias líneas se reemplaza como un bloque */
+static void test_rebase_array(TestFixture *fx, gconstpointer data)
+{
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert_packages, NULL));
+    write_variables("# Disco\n"
+                    "SELECTED_DISK=\"/dev/sda\"\n"
+                    "FILESYSTEM_TYPE=\"btrfs\"\n"
+                    "EXTRA_PACKAGES=(\n"
+                    "    \"git\"\n"
+                    "    \"vim\"\n"
+                    ")\n"
+                    "HOSTNAME=\"arcris\"\n");
+    commit_rebased();
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "FILESYSTEM_TYPE=\"btrfs\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"htop\"\n"
+                     "    \"tmux\"\n"
+                     ")\n"
+                     "HOSTNAME=\"arcris\"\n");
+}
+
+/* Los dos lados cambian la misma variable: gana la interfaz */
+static void test_rebase_conflict(TestFixture *fx, gconstpointer data)
+{
+    TestVar var = { "FILESYSTEM_TYPE", "xfs" };
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &var));
+    write_variables("# Disco\n"
+                    "SELECTED_DISK=\"/dev/sda\"\n"
+                    "FILESYSTEM_TYPE=\"btrfs\"\n"
+                    "EXTRA_PACKAGES=(\n"
+                    "    \"git\"\n"
+                    "    \"vim\"\n"
+                    ")\n"
+                    "HOSTNAME=\"arcris\"\n");
+    g_test_expect_message(NULL, G_LOG_LEVEL_WARNING, "*(1 variables modificadas en ambos lados*");
+    g_assert_true(vars_commit());
+    g_test_assert_expected_messages();
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "FILESYSTEM_TYPE=\"xfs\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"arcris\"\n");
+}
+
+/* Variable borrada en disco: vuelve solo si la transacción la cambió */
+static void test_rebase_deleted_on_disk(TestFixture *fx, gconstpointer data)
+{
+    TestVar var = { "HOSTNAME", "estacion" };
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &var));
+    write_variables("# Disco\n"
+                    "SELECTED_DISK=\"/dev/sda\"\n"
+                    "EXTRA_PACKAGES=(\n"
+                    "    \"git\"\n"
+                    "    \"vim\"\n"
+                    ")\n");
+    commit_rebased();
+
+    /* FILESYSTEM_TYPE no se tocó y queda borrada; HOSTNAME se cambió y vuelve */
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"estacion\"\n");
+}
+
+/* Un vars_rollback() anidado descarta solo su nivel (como page4 al
+ * cancelar un diálogo dentro de la transacción de la página) */
+static void test_nested_rollback(TestFixture *fx, gconstpointer data)
+{
+    TestVar outer = { "HOSTNAME", "estacion" };
+    TestVar inner = { "FILESYSTEM_TYPE", "xfs" };
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &outer));
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &inner));
+    g_assert_true(vars_update(apply_remove, "SELECTED_DISK"));
+    vars_rollback();
+
+    g_assert_true(vars_commit());
+
+    assert_variables("# Disco\n"
+                     "SELECTED_DISK=\"/dev/sda\"\n"
+                     "FILESYSTEM_TYPE=\"ext4\"\n"
+                     "EXTRA_PACKAGES=(\n"
+                     "    \"git\"\n"
+                     "    \"vim\"\n"
+                     ")\n"
+                     "HOSTNAME=\"estacion\"\n");
+}
+
+/* Un nivel anidado que confirma deja sus cambios al nivel exterior, y el
+ * rollback exterior descarta todo */
+static void test_outer_rollback(TestFixture *fx, gconstpointer data)
+{
+    TestVar inner = { "FILESYSTEM_TYPE", "xfs" };
+    (void)fx; (void)data;
+
+    g_assert_true(vars_begin());
+    g_assert_true(vars_begin());
+    g_assert_true(vars_update(apply_upsert, &inner));
+    g_assert_true(vars_commit());
+
+    GString *staged = vars_read();
+    gchar *value = vars_get(staged, "FILESYSTEM_TYPE");
+    g_assert_cmpstr(value, ==, "xfs");
+    g_free(value);
+    g_string_free(staged, TRUE);
+
+    vars_rollback();
+    assert_variables(TEST_BASE);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+#define VARS_TEST(path, func) \
+    g_test_add("/variables-utils/" path, TestFixture, NULL, fixture_setup, func, fixture_teardown)
+    VARS_TEST("rebase/added", test_rebase_added);
+    VARS_TEST("rebase/changed", test_rebase_changed);
+    VARS_TEST("rebase/removed", test_rebase_removed);
+    VARS_TEST("rebase/array", test_rebase_array);
+    VARS_TEST("rebase/conflict", test_rebase_conflict);
+    VARS_TEST("rebase/deleted-on-disk", test_rebase_deleted_on_disk);
+    VARS_TEST("transaction/nested-rollback", test_nested_rollback);
+    VARS_TEST("transaction/outer-rollback", test_outer_rollback);
+#undef VARS_TEST
+
+    return g_test_run();
+}